@@ -1,23 +1,22 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* A Bison parser, made by GNU Bison 2.4.1.  */
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
-   
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -28,13 +27,17 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -42,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.4.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -60,22 +63,17 @@
 /* Pull parsers.  */
 #define YYPULL 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
 
 /* Substitute the variable and function names.  */
 #define yyparse         _asn1_yyparse
 #define yylex           _asn1_yylex
 #define yyerror         _asn1_yyerror
-#define yylval          _asn1_yylval
-#define yychar          _asn1_yychar
 #define yydebug         _asn1_yydebug
 #define yynerrs         _asn1_yynerrs
+#define yylval          _asn1_yylval
+#define yychar          _asn1_yychar
 
-
-/* Copy the first part of user declarations.  */
-
-/* Line 189 of yacc.c  */
+/* First part of user prologue.  */
 #line 1 "ASN1.y"
 
 /*
@@ -130,76 +128,93 @@ static int _asn1_yyerror (const char *);
 static int _asn1_yylex(void);
 
 
+#line 132 "ASN1.c"
 
-/* Line 189 of yacc.c  */
-#line 136 "ASN1.c"
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-/* Enabling traces.  */
+
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+#if YYDEBUG
+extern int _asn1_yydebug;
 #endif
 
-
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     ASSIG = 258,
-     NUM = 259,
-     IDENTIFIER = 260,
-     OPTIONAL = 261,
-     INTEGER = 262,
-     SIZE = 263,
-     OCTET = 264,
-     STRING = 265,
-     SEQUENCE = 266,
-     BIT = 267,
-     UNIVERSAL = 268,
-     PRIVATE = 269,
-     APPLICATION = 270,
-     DEFAULT = 271,
-     CHOICE = 272,
-     OF = 273,
-     OBJECT = 274,
-     STR_IDENTIFIER = 275,
-     BOOLEAN = 276,
-     ASN1_TRUE = 277,
-     ASN1_FALSE = 278,
-     TOKEN_NULL = 279,
-     ANY = 280,
-     DEFINED = 281,
-     BY = 282,
-     SET = 283,
-     EXPLICIT = 284,
-     IMPLICIT = 285,
-     DEFINITIONS = 286,
-     TAGS = 287,
-     BEGIN = 288,
-     END = 289,
-     UTCTime = 290,
-     GeneralizedTime = 291,
-     GeneralString = 292,
-     FROM = 293,
-     IMPORTS = 294,
-     ENUMERATED = 295
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ASSIG = 258,                   /* "::="  */
+    NUM = 259,                     /* NUM  */
+    IDENTIFIER = 260,              /* IDENTIFIER  */
+    OPTIONAL = 261,                /* OPTIONAL  */
+    INTEGER = 262,                 /* INTEGER  */
+    SIZE = 263,                    /* SIZE  */
+    OCTET = 264,                   /* OCTET  */
+    STRING = 265,                  /* STRING  */
+    SEQUENCE = 266,                /* SEQUENCE  */
+    BIT = 267,                     /* BIT  */
+    UNIVERSAL = 268,               /* UNIVERSAL  */
+    PRIVATE = 269,                 /* PRIVATE  */
+    APPLICATION = 270,             /* APPLICATION  */
+    DEFAULT = 271,                 /* DEFAULT  */
+    CHOICE = 272,                  /* CHOICE  */
+    OF = 273,                      /* OF  */
+    OBJECT = 274,                  /* OBJECT  */
+    STR_IDENTIFIER = 275,          /* STR_IDENTIFIER  */
+    BOOLEAN = 276,                 /* BOOLEAN  */
+    ASN1_TRUE = 277,               /* ASN1_TRUE  */
+    ASN1_FALSE = 278,              /* ASN1_FALSE  */
+    TOKEN_NULL = 279,              /* TOKEN_NULL  */
+    ANY = 280,                     /* ANY  */
+    DEFINED = 281,                 /* DEFINED  */
+    BY = 282,                      /* BY  */
+    SET = 283,                     /* SET  */
+    EXPLICIT = 284,                /* EXPLICIT  */
+    IMPLICIT = 285,                /* IMPLICIT  */
+    DEFINITIONS = 286,             /* DEFINITIONS  */
+    TAGS = 287,                    /* TAGS  */
+    BEGIN = 288,                   /* BEGIN  */
+    END = 289,                     /* END  */
+    UTCTime = 290,                 /* UTCTime  */
+    GeneralizedTime = 291,         /* GeneralizedTime  */
+    GeneralString = 292,           /* GeneralString  */
+    FROM = 293,                    /* FROM  */
+    IMPORTS = 294,                 /* IMPORTS  */
+    ENUMERATED = 295               /* ENUMERATED  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define ASSIG 258
 #define NUM 259
 #define IDENTIFIER 260
@@ -239,66 +254,222 @@ static int _asn1_yylex(void);
 #define IMPORTS 294
 #define ENUMERATED 295
 
-
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 214 of yacc.c  */
 #line 58 "ASN1.y"
 
   unsigned int constant;
   char str[ASN1_MAX_NAME_SIZE+1];
   ASN1_TYPE node;
 
+#line 268 "ASN1.c"
 
-
-/* Line 214 of yacc.c  */
-#line 260 "ASN1.c"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
 
-/* Copy the second part of user declarations.  */
+extern YYSTYPE _asn1_yylval;
+
+
+int _asn1_yyparse (void);
+
+
+
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ASSIG = 3,                      /* "::="  */
+  YYSYMBOL_NUM = 4,                        /* NUM  */
+  YYSYMBOL_IDENTIFIER = 5,                 /* IDENTIFIER  */
+  YYSYMBOL_OPTIONAL = 6,                   /* OPTIONAL  */
+  YYSYMBOL_INTEGER = 7,                    /* INTEGER  */
+  YYSYMBOL_SIZE = 8,                       /* SIZE  */
+  YYSYMBOL_OCTET = 9,                      /* OCTET  */
+  YYSYMBOL_STRING = 10,                    /* STRING  */
+  YYSYMBOL_SEQUENCE = 11,                  /* SEQUENCE  */
+  YYSYMBOL_BIT = 12,                       /* BIT  */
+  YYSYMBOL_UNIVERSAL = 13,                 /* UNIVERSAL  */
+  YYSYMBOL_PRIVATE = 14,                   /* PRIVATE  */
+  YYSYMBOL_APPLICATION = 15,               /* APPLICATION  */
+  YYSYMBOL_DEFAULT = 16,                   /* DEFAULT  */
+  YYSYMBOL_CHOICE = 17,                    /* CHOICE  */
+  YYSYMBOL_OF = 18,                        /* OF  */
+  YYSYMBOL_OBJECT = 19,                    /* OBJECT  */
+  YYSYMBOL_STR_IDENTIFIER = 20,            /* STR_IDENTIFIER  */
+  YYSYMBOL_BOOLEAN = 21,                   /* BOOLEAN  */
+  YYSYMBOL_ASN1_TRUE = 22,                 /* ASN1_TRUE  */
+  YYSYMBOL_ASN1_FALSE = 23,                /* ASN1_FALSE  */
+  YYSYMBOL_TOKEN_NULL = 24,                /* TOKEN_NULL  */
+  YYSYMBOL_ANY = 25,                       /* ANY  */
+  YYSYMBOL_DEFINED = 26,                   /* DEFINED  */
+  YYSYMBOL_BY = 27,                        /* BY  */
+  YYSYMBOL_SET = 28,                       /* SET  */
+  YYSYMBOL_EXPLICIT = 29,                  /* EXPLICIT  */
+  YYSYMBOL_IMPLICIT = 30,                  /* IMPLICIT  */
+  YYSYMBOL_DEFINITIONS = 31,               /* DEFINITIONS  */
+  YYSYMBOL_TAGS = 32,                      /* TAGS  */
+  YYSYMBOL_BEGIN = 33,                     /* BEGIN  */
+  YYSYMBOL_END = 34,                       /* END  */
+  YYSYMBOL_UTCTime = 35,                   /* UTCTime  */
+  YYSYMBOL_GeneralizedTime = 36,           /* GeneralizedTime  */
+  YYSYMBOL_GeneralString = 37,             /* GeneralString  */
+  YYSYMBOL_FROM = 38,                      /* FROM  */
+  YYSYMBOL_IMPORTS = 39,                   /* IMPORTS  */
+  YYSYMBOL_ENUMERATED = 40,                /* ENUMERATED  */
+  YYSYMBOL_41_ = 41,                       /* '+'  */
+  YYSYMBOL_42_ = 42,                       /* '-'  */
+  YYSYMBOL_43_ = 43,                       /* '('  */
+  YYSYMBOL_44_ = 44,                       /* ')'  */
+  YYSYMBOL_45_ = 45,                       /* ','  */
+  YYSYMBOL_46_ = 46,                       /* '['  */
+  YYSYMBOL_47_ = 47,                       /* ']'  */
+  YYSYMBOL_48_ = 48,                       /* '|'  */
+  YYSYMBOL_49_ = 49,                       /* '{'  */
+  YYSYMBOL_50_ = 50,                       /* '}'  */
+  YYSYMBOL_51_ = 51,                       /* '.'  */
+  YYSYMBOL_YYACCEPT = 52,                  /* $accept  */
+  YYSYMBOL_definitions = 53,               /* definitions  */
+  YYSYMBOL_pos_num = 54,                   /* pos_num  */
+  YYSYMBOL_neg_num = 55,                   /* neg_num  */
+  YYSYMBOL_pos_neg_num = 56,               /* pos_neg_num  */
+  YYSYMBOL_num_identifier = 57,            /* num_identifier  */
+  YYSYMBOL_pos_neg_identifier = 58,        /* pos_neg_identifier  */
+  YYSYMBOL_constant = 59,                  /* constant  */
+  YYSYMBOL_constant_list = 60,             /* constant_list  */
+  YYSYMBOL_obj_constant = 61,              /* obj_constant  */
+  YYSYMBOL_obj_constant_list = 62,         /* obj_constant_list  */
+  YYSYMBOL_class = 63,                     /* class  */
+  YYSYMBOL_tag_type = 64,                  /* tag_type  */
+  YYSYMBOL_tag = 65,                       /* tag  */
+  YYSYMBOL_default = 66,                   /* default  */
+  YYSYMBOL_pos_neg_list = 67,              /* pos_neg_list  */
+  YYSYMBOL_integer_def = 68,               /* integer_def  */
+  YYSYMBOL_boolean_def = 69,               /* boolean_def  */
+  YYSYMBOL_Time = 70,                      /* Time  */
+  YYSYMBOL_size_def2 = 71,                 /* size_def2  */
+  YYSYMBOL_size_def = 72,                  /* size_def  */
+  YYSYMBOL_generalstring_def = 73,         /* generalstring_def  */
+  YYSYMBOL_octet_string_def = 74,          /* octet_string_def  */
+  YYSYMBOL_bit_element = 75,               /* bit_element  */
+  YYSYMBOL_bit_element_list = 76,          /* bit_element_list  */
+  YYSYMBOL_bit_string_def = 77,            /* bit_string_def  */
+  YYSYMBOL_enumerated_def = 78,            /* enumerated_def  */
+  YYSYMBOL_object_def = 79,                /* object_def  */
+  YYSYMBOL_type_assig_right = 80,          /* type_assig_right  */
+  YYSYMBOL_type_assig_right_tag = 81,      /* type_assig_right_tag  */
+  YYSYMBOL_type_assig_right_tag_default = 82, /* type_assig_right_tag_default  */
+  YYSYMBOL_type_assig = 83,                /* type_assig  */
+  YYSYMBOL_type_assig_list = 84,           /* type_assig_list  */
+  YYSYMBOL_sequence_def = 85,              /* sequence_def  */
+  YYSYMBOL_set_def = 86,                   /* set_def  */
+  YYSYMBOL_choise_def = 87,                /* choise_def  */
+  YYSYMBOL_any_def = 88,                   /* any_def  */
+  YYSYMBOL_type_def = 89,                  /* type_def  */
+  YYSYMBOL_constant_def = 90,              /* constant_def  */
+  YYSYMBOL_type_constant = 91,             /* type_constant  */
+  YYSYMBOL_type_constant_list = 92,        /* type_constant_list  */
+  YYSYMBOL_definitions_id = 93,            /* definitions_id  */
+  YYSYMBOL_explicit_implicit = 94          /* explicit_implicit  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
 
 
-/* Line 264 of yacc.c  */
-#line 272 "ASN1.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -306,55 +477,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int yyi)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (yyi)
-    int yyi;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return yyi;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -371,11 +593,11 @@ YYID (yyi)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -383,8 +605,8 @@ YYID (yyi)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -398,88 +620,89 @@ YYID (yyi)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack_alloc, Stack)				\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack_alloc, Stack, yysize);			\
-	Stack = &yyptr->Stack_alloc;					\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  5
 /* YYLAST -- Last index in YYTABLE.  */
@@ -491,18 +714,23 @@ union yyalloc
 #define YYNNTS  43
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  99
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  190
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   295
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -537,62 +765,8 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
-{
-       0,     0,     3,    12,    14,    17,    20,    22,    24,    26,
-      28,    30,    32,    36,    41,    43,    47,    49,    54,    56,
-      59,    61,    63,    65,    69,    74,    76,    79,    82,    85,
-      88,    91,    93,    97,    99,   104,   109,   117,   119,   121,
-     123,   128,   136,   138,   142,   144,   147,   150,   154,   159,
-     161,   165,   168,   172,   178,   183,   186,   188,   191,   193,
-     195,   197,   199,   201,   203,   205,   207,   209,   211,   213,
-     215,   217,   219,   222,   224,   227,   230,   233,   235,   239,
-     244,   248,   253,   258,   262,   267,   272,   274,   279,   283,
-     291,   298,   303,   305,   307,   309,   312,   317,   321,   323
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      53,     0,    -1,    93,    31,    94,    32,     3,    33,    92,
-      34,    -1,     4,    -1,    41,     4,    -1,    42,     4,    -1,
-      54,    -1,    55,    -1,     4,    -1,     5,    -1,    56,    -1,
-       5,    -1,    43,    56,    44,    -1,     5,    43,    56,    44,
-      -1,    59,    -1,    60,    45,    59,    -1,    57,    -1,     5,
-      43,     4,    44,    -1,    61,    -1,    62,    61,    -1,    13,
-      -1,    14,    -1,    15,    -1,    46,     4,    47,    -1,    46,
-      63,     4,    47,    -1,    64,    -1,    64,    29,    -1,    64,
-      30,    -1,    16,    58,    -1,    16,    22,    -1,    16,    23,
-      -1,    56,    -1,    67,    48,    56,    -1,     7,    -1,     7,
-      49,    60,    50,    -1,    68,    43,    67,    44,    -1,    68,
-      43,    57,    51,    51,    57,    44,    -1,    21,    -1,    35,
-      -1,    36,    -1,     8,    43,    57,    44,    -1,     8,    43,
-      57,    51,    51,    57,    44,    -1,    71,    -1,    43,    71,
-      44,    -1,    37,    -1,    37,    72,    -1,     9,    10,    -1,
-       9,    10,    72,    -1,     5,    43,     4,    44,    -1,    75,
-      -1,    76,    45,    75,    -1,    12,    10,    -1,    12,    10,
-      72,    -1,    12,    10,    49,    76,    50,    -1,    40,    49,
-      76,    50,    -1,    19,    20,    -1,     5,    -1,     5,    72,
-      -1,    68,    -1,    78,    -1,    69,    -1,    70,    -1,    74,
-      -1,    77,    -1,    73,    -1,    85,    -1,    79,    -1,    87,
-      -1,    88,    -1,    86,    -1,    24,    -1,    80,    -1,    65,
-      80,    -1,    81,    -1,    81,    66,    -1,    81,     6,    -1,
-       5,    82,    -1,    83,    -1,    84,    45,    83,    -1,    11,
-      49,    84,    50,    -1,    11,    18,    80,    -1,    11,    72,
-      18,    80,    -1,    28,    49,    84,    50,    -1,    28,    18,
-      80,    -1,    28,    72,    18,    80,    -1,    17,    49,    84,
-      50,    -1,    25,    -1,    25,    26,    27,     5,    -1,     5,
-       3,    81,    -1,     5,    19,    20,     3,    49,    62,    50,
-      -1,     5,     5,     3,    49,    62,    50,    -1,     5,     7,
-       3,    56,    -1,    89,    -1,    90,    -1,    91,    -1,    92,
-      91,    -1,     5,    49,    62,    50,    -1,     5,    49,    50,
-      -1,    29,    -1,    30,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
        0,   119,   119,   132,   133,   136,   140,   141,   144,   145,
      148,   149,   152,   154,   159,   160,   164,   166,   171,   172,
@@ -607,116 +781,58 @@ static const yytype_uint16 yyrline[] =
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "\"::=\"", "NUM", "IDENTIFIER",
-  "OPTIONAL", "INTEGER", "SIZE", "OCTET", "STRING", "SEQUENCE", "BIT",
-  "UNIVERSAL", "PRIVATE", "APPLICATION", "DEFAULT", "CHOICE", "OF",
-  "OBJECT", "STR_IDENTIFIER", "BOOLEAN", "ASN1_TRUE", "ASN1_FALSE",
-  "TOKEN_NULL", "ANY", "DEFINED", "BY", "SET", "EXPLICIT", "IMPLICIT",
-  "DEFINITIONS", "TAGS", "BEGIN", "END", "UTCTime", "GeneralizedTime",
-  "GeneralString", "FROM", "IMPORTS", "ENUMERATED", "'+'", "'-'", "'('",
-  "')'", "','", "'['", "']'", "'|'", "'{'", "'}'", "'.'", "$accept",
-  "definitions", "pos_num", "neg_num", "pos_neg_num", "num_identifier",
-  "pos_neg_identifier", "constant", "constant_list", "obj_constant",
-  "obj_constant_list", "class", "tag_type", "tag", "default",
-  "pos_neg_list", "integer_def", "boolean_def", "Time", "size_def2",
-  "size_def", "generalstring_def", "octet_string_def", "bit_element",
-  "bit_element_list", "bit_string_def", "enumerated_def", "object_def",
-  "type_assig_right", "type_assig_right_tag",
+  "\"end of file\"", "error", "\"invalid token\"", "\"::=\"", "NUM",
+  "IDENTIFIER", "OPTIONAL", "INTEGER", "SIZE", "OCTET", "STRING",
+  "SEQUENCE", "BIT", "UNIVERSAL", "PRIVATE", "APPLICATION", "DEFAULT",
+  "CHOICE", "OF", "OBJECT", "STR_IDENTIFIER", "BOOLEAN", "ASN1_TRUE",
+  "ASN1_FALSE", "TOKEN_NULL", "ANY", "DEFINED", "BY", "SET", "EXPLICIT",
+  "IMPLICIT", "DEFINITIONS", "TAGS", "BEGIN", "END", "UTCTime",
+  "GeneralizedTime", "GeneralString", "FROM", "IMPORTS", "ENUMERATED",
+  "'+'", "'-'", "'('", "')'", "','", "'['", "']'", "'|'", "'{'", "'}'",
+  "'.'", "$accept", "definitions", "pos_num", "neg_num", "pos_neg_num",
+  "num_identifier", "pos_neg_identifier", "constant", "constant_list",
+  "obj_constant", "obj_constant_list", "class", "tag_type", "tag",
+  "default", "pos_neg_list", "integer_def", "boolean_def", "Time",
+  "size_def2", "size_def", "generalstring_def", "octet_string_def",
+  "bit_element", "bit_element_list", "bit_string_def", "enumerated_def",
+  "object_def", "type_assig_right", "type_assig_right_tag",
   "type_assig_right_tag_default", "type_assig", "type_assig_list",
   "sequence_def", "set_def", "choise_def", "any_def", "type_def",
   "constant_def", "type_constant", "type_constant_list", "definitions_id",
-  "explicit_implicit", 0
+  "explicit_implicit", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,    43,    45,    40,    41,    44,    91,    93,   124,   123,
-     125,    46
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    52,    53,    54,    54,    55,    56,    56,    57,    57,
-      58,    58,    59,    59,    60,    60,    61,    61,    62,    62,
-      63,    63,    63,    64,    64,    65,    65,    65,    66,    66,
-      66,    67,    67,    68,    68,    68,    68,    69,    70,    70,
-      71,    71,    72,    72,    73,    73,    74,    74,    75,    76,
-      76,    77,    77,    77,    78,    79,    80,    80,    80,    80,
-      80,    80,    80,    80,    80,    80,    80,    80,    80,    80,
-      80,    81,    81,    82,    82,    82,    83,    84,    84,    85,
-      85,    85,    86,    86,    86,    87,    88,    88,    89,    90,
-      90,    90,    91,    91,    92,    92,    93,    93,    94,    94
-};
+#define YYPACT_NINF (-96)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     8,     1,     2,     2,     1,     1,     1,     1,
-       1,     1,     3,     4,     1,     3,     1,     4,     1,     2,
-       1,     1,     1,     3,     4,     1,     2,     2,     2,     2,
-       2,     1,     3,     1,     4,     4,     7,     1,     1,     1,
-       4,     7,     1,     3,     1,     2,     2,     3,     4,     1,
-       3,     2,     3,     5,     4,     2,     1,     2,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     2,     1,     2,     2,     2,     1,     3,     4,
-       3,     4,     4,     3,     4,     4,     1,     4,     3,     7,
-       6,     4,     1,     1,     1,     2,     4,     3,     1,     1
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     0,     0,     0,     0,     1,     0,     8,     9,    97,
-      16,    18,     0,    98,    99,     0,     0,    96,    19,     0,
-       0,     0,    17,     0,     0,    92,    93,    94,     0,     0,
-       0,     0,     0,     2,    95,    56,    33,     0,     0,     0,
-       0,     0,    37,    70,    86,     0,    38,    39,    44,     0,
-       0,    25,     0,    58,    60,    61,    64,    62,    63,    59,
-      66,    71,    88,    65,    69,    67,    68,     0,     0,     0,
-       0,     0,    42,    57,     0,    46,     0,     0,     0,    51,
-       0,    55,     0,     0,     0,     0,    45,     0,     0,    20,
-      21,    22,     0,    26,    27,    72,     0,     0,     3,     0,
-       0,     6,     7,    91,     0,     0,     0,     0,     0,    14,
-       0,    47,    80,     0,    77,     0,     0,     0,    52,     0,
-       0,    83,     0,     0,     0,    49,     0,    23,     0,     3,
-       9,    31,     0,     0,     0,     4,     5,     0,     0,    43,
-       0,     0,     0,    34,    73,    76,     0,    79,    81,     0,
-      85,    87,    82,    84,     0,     0,    54,    24,     0,    35,
-       0,    90,     0,    40,     0,     0,    12,    15,    75,     0,
-      74,    78,    53,     0,    50,     0,    32,    89,     0,    13,
-      11,    29,    30,    10,    28,    48,     0,     0,    36,    41
-};
+#define YYTABLE_NINF (-9)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
-{
-      -1,     2,   101,   102,   103,    10,   184,   109,   110,    11,
-      12,    92,    51,    52,   170,   133,    53,    54,    55,    72,
-      73,    56,    57,   125,   126,    58,    59,    60,    61,    62,
-     145,   114,   115,    63,    64,    65,    66,    25,    26,    27,
-      28,     3,    15
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -96
 static const yytype_int16 yypact[] =
 {
       24,   -14,    48,    56,     0,   -96,   -10,   -96,    -2,   -96,
@@ -740,6 +856,32 @@ static const yytype_int16 yypact[] =
      -96,   -96,   -96,   -96,   -96,   -96,   141,   146,   -96,   -96
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     1,     0,     8,     9,    97,
+      16,    18,     0,    98,    99,     0,     0,    96,    19,     0,
+       0,     0,    17,     0,     0,    92,    93,    94,     0,     0,
+       0,     0,     0,     2,    95,    56,    33,     0,     0,     0,
+       0,     0,    37,    70,    86,     0,    38,    39,    44,     0,
+       0,    25,     0,    58,    60,    61,    64,    62,    63,    59,
+      66,    71,    88,    65,    69,    67,    68,     0,     0,     0,
+       0,     0,    42,    57,     0,    46,     0,     0,     0,    51,
+       0,    55,     0,     0,     0,     0,    45,     0,     0,    20,
+      21,    22,     0,    26,    27,    72,     0,     0,     3,     0,
+       0,     6,     7,    91,     0,     0,     0,     0,     0,    14,
+       0,    47,    80,     0,    77,     0,     0,     0,    52,     0,
+       0,    83,     0,     0,     0,    49,     0,    23,     0,     3,
+       9,    31,     0,     0,     0,     4,     5,     0,     0,    43,
+       0,     0,     0,    34,    73,    76,     0,    79,    81,     0,
+      85,    87,    82,    84,     0,     0,    54,    24,     0,    35,
+       0,    90,     0,    40,     0,     0,    12,    15,    75,     0,
+      74,    78,    53,     0,    50,     0,    32,    89,     0,    13,
+      11,    29,    30,    10,    28,    48,     0,     0,    36,    41
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
@@ -750,11 +892,19 @@ static const yytype_int16 yypgoto[] =
      -96,   -96,   -96
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -9
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
+{
+       0,     2,   101,   102,   103,    10,   184,   109,   110,    11,
+      12,    92,    51,    52,   170,   133,    53,    54,    55,    72,
+      73,    56,    57,   125,   126,    58,    59,    60,    61,    62,
+     145,   114,   115,    63,    64,    65,    66,    25,    26,    27,
+      28,     3,    15
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       18,   132,   131,    95,     7,     8,     7,     8,     7,     8,
@@ -803,9 +953,9 @@ static const yytype_int16 yycheck[] =
       44,    -1,    28
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     5,    53,    93,    49,     0,    31,     4,     5,    50,
       57,    61,    62,    29,    30,    94,    43,    50,    61,    32,
@@ -828,95 +978,71 @@ static const yytype_uint8 yystos[] =
        5,    22,    23,    56,    58,    44,    57,    57,    44,    44
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
-
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    52,    53,    54,    54,    55,    56,    56,    57,    57,
+      58,    58,    59,    59,    60,    60,    61,    61,    62,    62,
+      63,    63,    63,    64,    64,    65,    65,    65,    66,    66,
+      66,    67,    67,    68,    68,    68,    68,    69,    70,    70,
+      71,    71,    72,    72,    73,    73,    74,    74,    75,    76,
+      76,    77,    77,    77,    78,    79,    80,    80,    80,    80,
+      80,    80,    80,    80,    80,    80,    80,    80,    80,    80,
+      80,    81,    81,    82,    82,    82,    83,    84,    84,    85,
+      85,    85,    86,    86,    86,    87,    88,    88,    89,    90,
+      90,    90,    91,    91,    92,    92,    93,    93,    94,    94
+};
 
-#define YYFAIL		goto yyerrlab
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     8,     1,     2,     2,     1,     1,     1,     1,
+       1,     1,     3,     4,     1,     3,     1,     4,     1,     2,
+       1,     1,     1,     3,     4,     1,     2,     2,     2,     2,
+       2,     1,     3,     1,     4,     4,     7,     1,     1,     1,
+       4,     7,     1,     3,     1,     2,     2,     3,     4,     1,
+       3,     2,     3,     5,     4,     2,     1,     2,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     2,     1,     2,     2,     2,     1,     3,     4,
+       3,     4,     4,     3,     4,     4,     1,     4,     3,     7,
+       6,     4,     1,     1,     1,     2,     4,     3,     1,     1
+};
 
-#define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
 
+#define YYRECOVERING()  (!!yyerrstatus)
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -926,80 +1052,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1007,16 +1111,8 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
-#else
 static void
-yy_stack_print (yybottom, yytop)
-    yytype_int16 *yybottom;
-    yytype_int16 *yytop;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1027,63 +1123,56 @@ yy_stack_print (yybottom, yytop)
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
       YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1098,342 +1187,78 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
-/* Prevent warnings from -Wmissing-prototypes.  */
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
 
-/*-------------------------.
-| yyparse or yypush_parse.  |
-`-------------------------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/*----------.
+| yyparse.  |
+`----------*/
+
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-
-
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       `yyss': related to states.
-       `yyvs': related to semantic values.
-
-       Refer to the stacks thru separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1441,133 +1266,140 @@ yyparse ()
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yytoken = 0;
-  yyss = yyssa;
-  yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-  yyssp = yyss;
-  yyvsp = yyvs;
-
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss_alloc, yyss);
-	YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
   /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1582,8 +1414,8 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
@@ -1595,13 +1427,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1616,14 +1448,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1636,827 +1468,707 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-
-/* Line 1455 of yacc.c  */
+  case 2: /* definitions: definitions_id DEFINITIONS explicit_implicit TAGS "::=" BEGIN type_constant_list END  */
 #line 122 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_DEFINITIONS|(yyvsp[(3) - (8)].constant));
-                    _asn1_set_name((yyval.node),_asn1_get_name((yyvsp[(1) - (8)].node)));
-                    _asn1_set_name((yyvsp[(1) - (8)].node),"");
-                    _asn1_set_right((yyvsp[(1) - (8)].node),(yyvsp[(7) - (8)].node));
-                    _asn1_set_down((yyval.node),(yyvsp[(1) - (8)].node));
+                   {(yyval.node)=_asn1_add_node(TYPE_DEFINITIONS|(yyvsp[-5].constant));
+                    _asn1_set_name((yyval.node),_asn1_get_name((yyvsp[-7].node)));
+                    _asn1_set_name((yyvsp[-7].node),"");
+                    _asn1_set_right((yyvsp[-7].node),(yyvsp[-1].node));
+                    _asn1_set_down((yyval.node),(yyvsp[-7].node));
 
 		    p_tree=(yyval.node);
 		    }
+#line 1482 "ASN1.c"
     break;
 
-  case 3:
-
-/* Line 1455 of yacc.c  */
+  case 3: /* pos_num: NUM  */
 #line 132 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                      {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1488 "ASN1.c"
     break;
 
-  case 4:
-
-/* Line 1455 of yacc.c  */
+  case 4: /* pos_num: '+' NUM  */
 #line 133 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(2) - (2)].str));}
+                      {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1494 "ASN1.c"
     break;
 
-  case 5:
-
-/* Line 1455 of yacc.c  */
+  case 5: /* neg_num: '-' NUM  */
 #line 136 "ASN1.y"
-    {strcpy((yyval.str),"-");
-                       strcat((yyval.str),(yyvsp[(2) - (2)].str));}
+                      {strcpy((yyval.str),"-");
+                       strcat((yyval.str),(yyvsp[0].str));}
+#line 1501 "ASN1.c"
     break;
 
-  case 6:
-
-/* Line 1455 of yacc.c  */
+  case 6: /* pos_neg_num: pos_num  */
 #line 140 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                        {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1507 "ASN1.c"
     break;
 
-  case 7:
-
-/* Line 1455 of yacc.c  */
+  case 7: /* pos_neg_num: neg_num  */
 #line 141 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                        {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1513 "ASN1.c"
     break;
 
-  case 8:
-
-/* Line 1455 of yacc.c  */
+  case 8: /* num_identifier: NUM  */
 #line 144 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                                 {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1519 "ASN1.c"
     break;
 
-  case 9:
-
-/* Line 1455 of yacc.c  */
+  case 9: /* num_identifier: IDENTIFIER  */
 #line 145 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                                 {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1525 "ASN1.c"
     break;
 
-  case 10:
-
-/* Line 1455 of yacc.c  */
+  case 10: /* pos_neg_identifier: pos_neg_num  */
 #line 148 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                                     {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1531 "ASN1.c"
     break;
 
-  case 11:
-
-/* Line 1455 of yacc.c  */
+  case 11: /* pos_neg_identifier: IDENTIFIER  */
 #line 149 "ASN1.y"
-    {strcpy((yyval.str),(yyvsp[(1) - (1)].str));}
+                                     {strcpy((yyval.str),(yyvsp[0].str));}
+#line 1537 "ASN1.c"
     break;
 
-  case 12:
-
-/* Line 1455 of yacc.c  */
+  case 12: /* constant: '(' pos_neg_num ')'  */
 #line 152 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
-                                       _asn1_set_value((yyval.node),(yyvsp[(2) - (3)].str),strlen((yyvsp[(2) - (3)].str))+1);}
+                                      {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
+                                       _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1544 "ASN1.c"
     break;
 
-  case 13:
-
-/* Line 1455 of yacc.c  */
+  case 13: /* constant: IDENTIFIER '(' pos_neg_num ')'  */
 #line 154 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
-	                               _asn1_set_name((yyval.node),(yyvsp[(1) - (4)].str));
-                                       _asn1_set_value((yyval.node),(yyvsp[(3) - (4)].str),strlen((yyvsp[(3) - (4)].str))+1);}
+                                      {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
+	                               _asn1_set_name((yyval.node),(yyvsp[-3].str));
+                                       _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1552 "ASN1.c"
     break;
 
-  case 14:
-
-/* Line 1455 of yacc.c  */
+  case 14: /* constant_list: constant  */
 #line 159 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                           {(yyval.node)=(yyvsp[0].node);}
+#line 1558 "ASN1.c"
     break;
 
-  case 15:
-
-/* Line 1455 of yacc.c  */
+  case 15: /* constant_list: constant_list ',' constant  */
 #line 160 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (3)].node);
-                                            _asn1_set_right(_asn1_get_last_right((yyvsp[(1) - (3)].node)),(yyvsp[(3) - (3)].node));}
+                                           {(yyval.node)=(yyvsp[-2].node);
+                                            _asn1_set_right(_asn1_get_last_right((yyvsp[-2].node)),(yyvsp[0].node));}
+#line 1565 "ASN1.c"
     break;
 
-  case 16:
-
-/* Line 1455 of yacc.c  */
+  case 16: /* obj_constant: num_identifier  */
 #line 164 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
-                                   _asn1_set_value((yyval.node),(yyvsp[(1) - (1)].str),strlen((yyvsp[(1) - (1)].str))+1);}
+                                  {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
+                                   _asn1_set_value((yyval.node),(yyvsp[0].str),strlen((yyvsp[0].str))+1);}
+#line 1572 "ASN1.c"
     break;
 
-  case 17:
-
-/* Line 1455 of yacc.c  */
+  case 17: /* obj_constant: IDENTIFIER '(' NUM ')'  */
 #line 166 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
-	                            _asn1_set_name((yyval.node),(yyvsp[(1) - (4)].str));
-                                    _asn1_set_value((yyval.node),(yyvsp[(3) - (4)].str),strlen((yyvsp[(3) - (4)].str))+1);}
+                                   {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
+	                            _asn1_set_name((yyval.node),(yyvsp[-3].str));
+                                    _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1580 "ASN1.c"
     break;
 
-  case 18:
-
-/* Line 1455 of yacc.c  */
+  case 18: /* obj_constant_list: obj_constant  */
 #line 171 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                                   {(yyval.node)=(yyvsp[0].node);}
+#line 1586 "ASN1.c"
     break;
 
-  case 19:
-
-/* Line 1455 of yacc.c  */
+  case 19: /* obj_constant_list: obj_constant_list obj_constant  */
 #line 172 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (2)].node);
-                                                    _asn1_set_right(_asn1_get_last_right((yyvsp[(1) - (2)].node)),(yyvsp[(2) - (2)].node));}
+                                                   {(yyval.node)=(yyvsp[-1].node);
+                                                    _asn1_set_right(_asn1_get_last_right((yyvsp[-1].node)),(yyvsp[0].node));}
+#line 1593 "ASN1.c"
     break;
 
-  case 20:
-
-/* Line 1455 of yacc.c  */
+  case 20: /* class: UNIVERSAL  */
 #line 176 "ASN1.y"
-    {(yyval.constant)=CONST_UNIVERSAL;}
+                      {(yyval.constant)=CONST_UNIVERSAL;}
+#line 1599 "ASN1.c"
     break;
 
-  case 21:
-
-/* Line 1455 of yacc.c  */
+  case 21: /* class: PRIVATE  */
 #line 177 "ASN1.y"
-    {(yyval.constant)=CONST_PRIVATE;}
+                      {(yyval.constant)=CONST_PRIVATE;}
+#line 1605 "ASN1.c"
     break;
 
-  case 22:
-
-/* Line 1455 of yacc.c  */
+  case 22: /* class: APPLICATION  */
 #line 178 "ASN1.y"
-    {(yyval.constant)=CONST_APPLICATION;}
+                      {(yyval.constant)=CONST_APPLICATION;}
+#line 1611 "ASN1.c"
     break;
 
-  case 23:
-
-/* Line 1455 of yacc.c  */
+  case 23: /* tag_type: '[' NUM ']'  */
 #line 181 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_TAG);
-                            _asn1_set_value((yyval.node),(yyvsp[(2) - (3)].str),strlen((yyvsp[(2) - (3)].str))+1);}
+                           {(yyval.node)=_asn1_add_node(TYPE_TAG);
+                            _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1618 "ASN1.c"
     break;
 
-  case 24:
-
-/* Line 1455 of yacc.c  */
+  case 24: /* tag_type: '[' class NUM ']'  */
 #line 183 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_TAG | (yyvsp[(2) - (4)].constant));
-                                _asn1_set_value((yyval.node),(yyvsp[(3) - (4)].str),strlen((yyvsp[(3) - (4)].str))+1);}
+                               {(yyval.node)=_asn1_add_node(TYPE_TAG | (yyvsp[-2].constant));
+                                _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1625 "ASN1.c"
     break;
 
-  case 25:
-
-/* Line 1455 of yacc.c  */
+  case 25: /* tag: tag_type  */
 #line 187 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                          {(yyval.node)=(yyvsp[0].node);}
+#line 1631 "ASN1.c"
     break;
 
-  case 26:
-
-/* Line 1455 of yacc.c  */
+  case 26: /* tag: tag_type EXPLICIT  */
 #line 188 "ASN1.y"
-    {(yyval.node)=_asn1_mod_type((yyvsp[(1) - (2)].node),CONST_EXPLICIT);}
+                          {(yyval.node)=_asn1_mod_type((yyvsp[-1].node),CONST_EXPLICIT);}
+#line 1637 "ASN1.c"
     break;
 
-  case 27:
-
-/* Line 1455 of yacc.c  */
+  case 27: /* tag: tag_type IMPLICIT  */
 #line 189 "ASN1.y"
-    {(yyval.node)=_asn1_mod_type((yyvsp[(1) - (2)].node),CONST_IMPLICIT);}
+                          {(yyval.node)=_asn1_mod_type((yyvsp[-1].node),CONST_IMPLICIT);}
+#line 1643 "ASN1.c"
     break;
 
-  case 28:
-
-/* Line 1455 of yacc.c  */
+  case 28: /* default: DEFAULT pos_neg_identifier  */
 #line 192 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_DEFAULT);
-                                       _asn1_set_value((yyval.node),(yyvsp[(2) - (2)].str),strlen((yyvsp[(2) - (2)].str))+1);}
+                                      {(yyval.node)=_asn1_add_node(TYPE_DEFAULT);
+                                       _asn1_set_value((yyval.node),(yyvsp[0].str),strlen((yyvsp[0].str))+1);}
+#line 1650 "ASN1.c"
     break;
 
-  case 29:
-
-/* Line 1455 of yacc.c  */
+  case 29: /* default: DEFAULT ASN1_TRUE  */
 #line 194 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_DEFAULT|CONST_TRUE);}
+                                       {(yyval.node)=_asn1_add_node(TYPE_DEFAULT|CONST_TRUE);}
+#line 1656 "ASN1.c"
     break;
 
-  case 30:
-
-/* Line 1455 of yacc.c  */
+  case 30: /* default: DEFAULT ASN1_FALSE  */
 #line 195 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_DEFAULT|CONST_FALSE);}
+                                       {(yyval.node)=_asn1_add_node(TYPE_DEFAULT|CONST_FALSE);}
+#line 1662 "ASN1.c"
     break;
 
-  case 33:
-
-/* Line 1455 of yacc.c  */
+  case 33: /* integer_def: INTEGER  */
 #line 204 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_INTEGER);}
+                                        {(yyval.node)=_asn1_add_node(TYPE_INTEGER);}
+#line 1668 "ASN1.c"
     break;
 
-  case 34:
-
-/* Line 1455 of yacc.c  */
+  case 34: /* integer_def: INTEGER '{' constant_list '}'  */
 #line 205 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_LIST);
-	                                 _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));}
+                                        {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_LIST);
+	                                 _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1675 "ASN1.c"
     break;
 
-  case 35:
-
-/* Line 1455 of yacc.c  */
+  case 35: /* integer_def: integer_def '(' pos_neg_list ')'  */
 #line 207 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_INTEGER);}
+                                             {(yyval.node)=_asn1_add_node(TYPE_INTEGER);}
+#line 1681 "ASN1.c"
     break;
 
-  case 36:
-
-/* Line 1455 of yacc.c  */
+  case 36: /* integer_def: integer_def '(' num_identifier '.' '.' num_identifier ')'  */
 #line 209 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_MIN_MAX);
+                                        {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_MIN_MAX);
                                          _asn1_set_down((yyval.node),_asn1_add_node(TYPE_SIZE));
-                                         _asn1_set_value(_asn1_get_down((yyval.node)),(yyvsp[(6) - (7)].str),strlen((yyvsp[(6) - (7)].str))+1);
-                                         _asn1_set_name(_asn1_get_down((yyval.node)),(yyvsp[(3) - (7)].str));}
+                                         _asn1_set_value(_asn1_get_down((yyval.node)),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);
+                                         _asn1_set_name(_asn1_get_down((yyval.node)),(yyvsp[-4].str));}
+#line 1690 "ASN1.c"
     break;
 
-  case 37:
-
-/* Line 1455 of yacc.c  */
+  case 37: /* boolean_def: BOOLEAN  */
 #line 215 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_BOOLEAN);}
+                       {(yyval.node)=_asn1_add_node(TYPE_BOOLEAN);}
+#line 1696 "ASN1.c"
     break;
 
-  case 38:
-
-/* Line 1455 of yacc.c  */
+  case 38: /* Time: UTCTime  */
 #line 218 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_TIME|CONST_UTC);}
+                         {(yyval.node)=_asn1_add_node(TYPE_TIME|CONST_UTC);}
+#line 1702 "ASN1.c"
     break;
 
-  case 39:
-
-/* Line 1455 of yacc.c  */
+  case 39: /* Time: GeneralizedTime  */
 #line 219 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_TIME|CONST_GENERALIZED);}
+                         {(yyval.node)=_asn1_add_node(TYPE_TIME|CONST_GENERALIZED);}
+#line 1708 "ASN1.c"
     break;
 
-  case 40:
-
-/* Line 1455 of yacc.c  */
+  case 40: /* size_def2: SIZE '(' num_identifier ')'  */
 #line 222 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SIZE|CONST_1_PARAM);
-	                              _asn1_set_value((yyval.node),(yyvsp[(3) - (4)].str),strlen((yyvsp[(3) - (4)].str))+1);}
+                                     {(yyval.node)=_asn1_add_node(TYPE_SIZE|CONST_1_PARAM);
+	                              _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1715 "ASN1.c"
     break;
 
-  case 41:
-
-/* Line 1455 of yacc.c  */
+  case 41: /* size_def2: SIZE '(' num_identifier '.' '.' num_identifier ')'  */
 #line 225 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SIZE|CONST_MIN_MAX);
-	                              _asn1_set_value((yyval.node),(yyvsp[(3) - (7)].str),strlen((yyvsp[(3) - (7)].str))+1);
-                                      _asn1_set_name((yyval.node),(yyvsp[(6) - (7)].str));}
+                                     {(yyval.node)=_asn1_add_node(TYPE_SIZE|CONST_MIN_MAX);
+	                              _asn1_set_value((yyval.node),(yyvsp[-4].str),strlen((yyvsp[-4].str))+1);
+                                      _asn1_set_name((yyval.node),(yyvsp[-1].str));}
+#line 1723 "ASN1.c"
     break;
 
-  case 42:
-
-/* Line 1455 of yacc.c  */
+  case 42: /* size_def: size_def2  */
 #line 230 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                               {(yyval.node)=(yyvsp[0].node);}
+#line 1729 "ASN1.c"
     break;
 
-  case 43:
-
-/* Line 1455 of yacc.c  */
+  case 43: /* size_def: '(' size_def2 ')'  */
 #line 231 "ASN1.y"
-    {(yyval.node)=(yyvsp[(2) - (3)].node);}
+                               {(yyval.node)=(yyvsp[-1].node);}
+#line 1735 "ASN1.c"
     break;
 
-  case 44:
-
-/* Line 1455 of yacc.c  */
+  case 44: /* generalstring_def: GeneralString  */
 #line 234 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_GENERALSTRING);}
+                                 {(yyval.node)=_asn1_add_node(TYPE_GENERALSTRING);}
+#line 1741 "ASN1.c"
     break;
 
-  case 45:
-
-/* Line 1455 of yacc.c  */
+  case 45: /* generalstring_def: GeneralString size_def  */
 #line 235 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_GENERALSTRING|CONST_SIZE);
-					  _asn1_set_down((yyval.node),(yyvsp[(2) - (2)].node));}
+                                         {(yyval.node)=_asn1_add_node(TYPE_GENERALSTRING|CONST_SIZE);
+					  _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1748 "ASN1.c"
     break;
 
-  case 46:
-
-/* Line 1455 of yacc.c  */
+  case 46: /* octet_string_def: OCTET STRING  */
 #line 239 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OCTET_STRING);}
+                                          {(yyval.node)=_asn1_add_node(TYPE_OCTET_STRING);}
+#line 1754 "ASN1.c"
     break;
 
-  case 47:
-
-/* Line 1455 of yacc.c  */
+  case 47: /* octet_string_def: OCTET STRING size_def  */
 #line 240 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OCTET_STRING|CONST_SIZE);
-                                           _asn1_set_down((yyval.node),(yyvsp[(3) - (3)].node));}
+                                          {(yyval.node)=_asn1_add_node(TYPE_OCTET_STRING|CONST_SIZE);
+                                           _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1761 "ASN1.c"
     break;
 
-  case 48:
-
-/* Line 1455 of yacc.c  */
+  case 48: /* bit_element: IDENTIFIER '(' NUM ')'  */
 #line 244 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
-	                           _asn1_set_name((yyval.node),(yyvsp[(1) - (4)].str));
-                                    _asn1_set_value((yyval.node),(yyvsp[(3) - (4)].str),strlen((yyvsp[(3) - (4)].str))+1);}
+                                   {(yyval.node)=_asn1_add_node(TYPE_CONSTANT);
+	                           _asn1_set_name((yyval.node),(yyvsp[-3].str));
+                                    _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);}
+#line 1769 "ASN1.c"
     break;
 
-  case 49:
-
-/* Line 1455 of yacc.c  */
+  case 49: /* bit_element_list: bit_element  */
 #line 249 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                  {(yyval.node)=(yyvsp[0].node);}
+#line 1775 "ASN1.c"
     break;
 
-  case 50:
-
-/* Line 1455 of yacc.c  */
+  case 50: /* bit_element_list: bit_element_list ',' bit_element  */
 #line 250 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (3)].node);
-                                                       _asn1_set_right(_asn1_get_last_right((yyvsp[(1) - (3)].node)),(yyvsp[(3) - (3)].node));}
+                                                      {(yyval.node)=(yyvsp[-2].node);
+                                                       _asn1_set_right(_asn1_get_last_right((yyvsp[-2].node)),(yyvsp[0].node));}
+#line 1782 "ASN1.c"
     break;
 
-  case 51:
-
-/* Line 1455 of yacc.c  */
+  case 51: /* bit_string_def: BIT STRING  */
 #line 254 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING);}
+                               {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING);}
+#line 1788 "ASN1.c"
     break;
 
-  case 52:
-
-/* Line 1455 of yacc.c  */
+  case 52: /* bit_string_def: BIT STRING size_def  */
 #line 255 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING|CONST_SIZE);}
+                                     {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING|CONST_SIZE);}
+#line 1794 "ASN1.c"
     break;
 
-  case 53:
-
-/* Line 1455 of yacc.c  */
+  case 53: /* bit_string_def: BIT STRING '{' bit_element_list '}'  */
 #line 257 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING|CONST_LIST);
-                                _asn1_set_down((yyval.node),(yyvsp[(4) - (5)].node));}
+                               {(yyval.node)=_asn1_add_node(TYPE_BIT_STRING|CONST_LIST);
+                                _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1801 "ASN1.c"
     break;
 
-  case 54:
-
-/* Line 1455 of yacc.c  */
+  case 54: /* enumerated_def: ENUMERATED '{' bit_element_list '}'  */
 #line 262 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_ENUMERATED|CONST_LIST);
-                                _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));}
+                               {(yyval.node)=_asn1_add_node(TYPE_ENUMERATED|CONST_LIST);
+                                _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1808 "ASN1.c"
     break;
 
-  case 55:
-
-/* Line 1455 of yacc.c  */
+  case 55: /* object_def: OBJECT STR_IDENTIFIER  */
 #line 267 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);}
+                                    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);}
+#line 1814 "ASN1.c"
     break;
 
-  case 56:
-
-/* Line 1455 of yacc.c  */
+  case 56: /* type_assig_right: IDENTIFIER  */
 #line 270 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_IDENTIFIER);
-                                       _asn1_set_value((yyval.node),(yyvsp[(1) - (1)].str),strlen((yyvsp[(1) - (1)].str))+1);}
+                                      {(yyval.node)=_asn1_add_node(TYPE_IDENTIFIER);
+                                       _asn1_set_value((yyval.node),(yyvsp[0].str),strlen((yyvsp[0].str))+1);}
+#line 1821 "ASN1.c"
     break;
 
-  case 57:
-
-/* Line 1455 of yacc.c  */
+  case 57: /* type_assig_right: IDENTIFIER size_def  */
 #line 272 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_IDENTIFIER|CONST_SIZE);
-                                       _asn1_set_value((yyval.node),(yyvsp[(1) - (2)].str),strlen((yyvsp[(1) - (2)].str))+1);
-                                       _asn1_set_down((yyval.node),(yyvsp[(2) - (2)].node));}
+                                      {(yyval.node)=_asn1_add_node(TYPE_IDENTIFIER|CONST_SIZE);
+                                       _asn1_set_value((yyval.node),(yyvsp[-1].str),strlen((yyvsp[-1].str))+1);
+                                       _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1829 "ASN1.c"
     break;
 
-  case 58:
-
-/* Line 1455 of yacc.c  */
+  case 58: /* type_assig_right: integer_def  */
 #line 275 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1835 "ASN1.c"
     break;
 
-  case 59:
-
-/* Line 1455 of yacc.c  */
+  case 59: /* type_assig_right: enumerated_def  */
 #line 276 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1841 "ASN1.c"
     break;
 
-  case 60:
-
-/* Line 1455 of yacc.c  */
+  case 60: /* type_assig_right: boolean_def  */
 #line 277 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1847 "ASN1.c"
     break;
 
-  case 62:
-
-/* Line 1455 of yacc.c  */
+  case 62: /* type_assig_right: octet_string_def  */
 #line 279 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1853 "ASN1.c"
     break;
 
-  case 63:
-
-/* Line 1455 of yacc.c  */
+  case 63: /* type_assig_right: bit_string_def  */
 #line 280 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1859 "ASN1.c"
     break;
 
-  case 64:
-
-/* Line 1455 of yacc.c  */
+  case 64: /* type_assig_right: generalstring_def  */
 #line 281 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1865 "ASN1.c"
     break;
 
-  case 65:
-
-/* Line 1455 of yacc.c  */
+  case 65: /* type_assig_right: sequence_def  */
 #line 282 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1871 "ASN1.c"
     break;
 
-  case 66:
-
-/* Line 1455 of yacc.c  */
+  case 66: /* type_assig_right: object_def  */
 #line 283 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1877 "ASN1.c"
     break;
 
-  case 67:
-
-/* Line 1455 of yacc.c  */
+  case 67: /* type_assig_right: choise_def  */
 #line 284 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1883 "ASN1.c"
     break;
 
-  case 68:
-
-/* Line 1455 of yacc.c  */
+  case 68: /* type_assig_right: any_def  */
 #line 285 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1889 "ASN1.c"
     break;
 
-  case 69:
-
-/* Line 1455 of yacc.c  */
+  case 69: /* type_assig_right: set_def  */
 #line 286 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1895 "ASN1.c"
     break;
 
-  case 70:
-
-/* Line 1455 of yacc.c  */
+  case 70: /* type_assig_right: TOKEN_NULL  */
 #line 287 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_NULL);}
+                                      {(yyval.node)=_asn1_add_node(TYPE_NULL);}
+#line 1901 "ASN1.c"
     break;
 
-  case 71:
-
-/* Line 1455 of yacc.c  */
+  case 71: /* type_assig_right_tag: type_assig_right  */
 #line 290 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                              {(yyval.node)=(yyvsp[0].node);}
+#line 1907 "ASN1.c"
     break;
 
-  case 72:
-
-/* Line 1455 of yacc.c  */
+  case 72: /* type_assig_right_tag: tag type_assig_right  */
 #line 291 "ASN1.y"
-    {(yyval.node)=_asn1_mod_type((yyvsp[(2) - (2)].node),CONST_TAG);
-                                               _asn1_set_right((yyvsp[(1) - (2)].node),_asn1_get_down((yyval.node)));
-                                               _asn1_set_down((yyval.node),(yyvsp[(1) - (2)].node));}
+                                              {(yyval.node)=_asn1_mod_type((yyvsp[0].node),CONST_TAG);
+                                               _asn1_set_right((yyvsp[-1].node),_asn1_get_down((yyval.node)));
+                                               _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1915 "ASN1.c"
     break;
 
-  case 73:
-
-/* Line 1455 of yacc.c  */
+  case 73: /* type_assig_right_tag_default: type_assig_right_tag  */
 #line 296 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                                      {(yyval.node)=(yyvsp[0].node);}
+#line 1921 "ASN1.c"
     break;
 
-  case 74:
-
-/* Line 1455 of yacc.c  */
+  case 74: /* type_assig_right_tag_default: type_assig_right_tag default  */
 #line 297 "ASN1.y"
-    {(yyval.node)=_asn1_mod_type((yyvsp[(1) - (2)].node),CONST_DEFAULT);
-                                                       _asn1_set_right((yyvsp[(2) - (2)].node),_asn1_get_down((yyval.node)));
-						       _asn1_set_down((yyval.node),(yyvsp[(2) - (2)].node));}
+                                                      {(yyval.node)=_asn1_mod_type((yyvsp[-1].node),CONST_DEFAULT);
+                                                       _asn1_set_right((yyvsp[0].node),_asn1_get_down((yyval.node)));
+						       _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1929 "ASN1.c"
     break;
 
-  case 75:
-
-/* Line 1455 of yacc.c  */
+  case 75: /* type_assig_right_tag_default: type_assig_right_tag OPTIONAL  */
 #line 300 "ASN1.y"
-    {(yyval.node)=_asn1_mod_type((yyvsp[(1) - (2)].node),CONST_OPTION);}
+                                                      {(yyval.node)=_asn1_mod_type((yyvsp[-1].node),CONST_OPTION);}
+#line 1935 "ASN1.c"
     break;
 
-  case 76:
-
-/* Line 1455 of yacc.c  */
+  case 76: /* type_assig: IDENTIFIER type_assig_right_tag_default  */
 #line 303 "ASN1.y"
-    {(yyval.node)=_asn1_set_name((yyvsp[(2) - (2)].node),(yyvsp[(1) - (2)].str));}
+                                                      {(yyval.node)=_asn1_set_name((yyvsp[0].node),(yyvsp[-1].str));}
+#line 1941 "ASN1.c"
     break;
 
-  case 77:
-
-/* Line 1455 of yacc.c  */
+  case 77: /* type_assig_list: type_assig  */
 #line 306 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                               {(yyval.node)=(yyvsp[0].node);}
+#line 1947 "ASN1.c"
     break;
 
-  case 78:
-
-/* Line 1455 of yacc.c  */
+  case 78: /* type_assig_list: type_assig_list ',' type_assig  */
 #line 307 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (3)].node);
-                                                _asn1_set_right(_asn1_get_last_right((yyvsp[(1) - (3)].node)),(yyvsp[(3) - (3)].node));}
+                                               {(yyval.node)=(yyvsp[-2].node);
+                                                _asn1_set_right(_asn1_get_last_right((yyvsp[-2].node)),(yyvsp[0].node));}
+#line 1954 "ASN1.c"
     break;
 
-  case 79:
-
-/* Line 1455 of yacc.c  */
+  case 79: /* sequence_def: SEQUENCE '{' type_assig_list '}'  */
 #line 311 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE);
-                                              _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));}
+                                             {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE);
+                                              _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1961 "ASN1.c"
     break;
 
-  case 80:
-
-/* Line 1455 of yacc.c  */
+  case 80: /* sequence_def: SEQUENCE OF type_assig_right  */
 #line 313 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE_OF);
-                                              _asn1_set_down((yyval.node),(yyvsp[(3) - (3)].node));}
+                                             {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE_OF);
+                                              _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1968 "ASN1.c"
     break;
 
-  case 81:
-
-/* Line 1455 of yacc.c  */
+  case 81: /* sequence_def: SEQUENCE size_def OF type_assig_right  */
 #line 315 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE_OF|CONST_SIZE);
-                                            _asn1_set_right((yyvsp[(2) - (4)].node),(yyvsp[(4) - (4)].node));
-                                            _asn1_set_down((yyval.node),(yyvsp[(2) - (4)].node));}
+                                           {(yyval.node)=_asn1_add_node(TYPE_SEQUENCE_OF|CONST_SIZE);
+                                            _asn1_set_right((yyvsp[-2].node),(yyvsp[0].node));
+                                            _asn1_set_down((yyval.node),(yyvsp[-2].node));}
+#line 1976 "ASN1.c"
     break;
 
-  case 82:
-
-/* Line 1455 of yacc.c  */
+  case 82: /* set_def: SET '{' type_assig_list '}'  */
 #line 320 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SET);
-                                     _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));}
+                                    {(yyval.node)=_asn1_add_node(TYPE_SET);
+                                     _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 1983 "ASN1.c"
     break;
 
-  case 83:
-
-/* Line 1455 of yacc.c  */
+  case 83: /* set_def: SET OF type_assig_right  */
 #line 322 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SET_OF);
-                                     _asn1_set_down((yyval.node),(yyvsp[(3) - (3)].node));}
+                                    {(yyval.node)=_asn1_add_node(TYPE_SET_OF);
+                                     _asn1_set_down((yyval.node),(yyvsp[0].node));}
+#line 1990 "ASN1.c"
     break;
 
-  case 84:
-
-/* Line 1455 of yacc.c  */
+  case 84: /* set_def: SET size_def OF type_assig_right  */
 #line 324 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_SET_OF|CONST_SIZE);
-                                       _asn1_set_right((yyvsp[(2) - (4)].node),(yyvsp[(4) - (4)].node));
-                                       _asn1_set_down((yyval.node),(yyvsp[(2) - (4)].node));}
+                                      {(yyval.node)=_asn1_add_node(TYPE_SET_OF|CONST_SIZE);
+                                       _asn1_set_right((yyvsp[-2].node),(yyvsp[0].node));
+                                       _asn1_set_down((yyval.node),(yyvsp[-2].node));}
+#line 1998 "ASN1.c"
     break;
 
-  case 85:
-
-/* Line 1455 of yacc.c  */
+  case 85: /* choise_def: CHOICE '{' type_assig_list '}'  */
 #line 329 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_CHOICE);
-                                             _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));}
+                                            {(yyval.node)=_asn1_add_node(TYPE_CHOICE);
+                                             _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 2005 "ASN1.c"
     break;
 
-  case 86:
-
-/* Line 1455 of yacc.c  */
+  case 86: /* any_def: ANY  */
 #line 333 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_ANY);}
+                                       {(yyval.node)=_asn1_add_node(TYPE_ANY);}
+#line 2011 "ASN1.c"
     break;
 
-  case 87:
-
-/* Line 1455 of yacc.c  */
+  case 87: /* any_def: ANY DEFINED BY IDENTIFIER  */
 #line 334 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_ANY|CONST_DEFINED_BY);
+                                       {(yyval.node)=_asn1_add_node(TYPE_ANY|CONST_DEFINED_BY);
                                         _asn1_set_down((yyval.node),_asn1_add_node(TYPE_CONSTANT));
-	                                _asn1_set_name(_asn1_get_down((yyval.node)),(yyvsp[(4) - (4)].str));}
+	                                _asn1_set_name(_asn1_get_down((yyval.node)),(yyvsp[0].str));}
+#line 2019 "ASN1.c"
     break;
 
-  case 88:
-
-/* Line 1455 of yacc.c  */
+  case 88: /* type_def: IDENTIFIER "::=" type_assig_right_tag  */
 #line 339 "ASN1.y"
-    {(yyval.node)=_asn1_set_name((yyvsp[(3) - (3)].node),(yyvsp[(1) - (3)].str));}
+                                                  {(yyval.node)=_asn1_set_name((yyvsp[0].node),(yyvsp[-2].str));}
+#line 2025 "ASN1.c"
     break;
 
-  case 89:
-
-/* Line 1455 of yacc.c  */
+  case 89: /* constant_def: IDENTIFIER OBJECT STR_IDENTIFIER "::=" '{' obj_constant_list '}'  */
 #line 343 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID|CONST_ASSIGN);
-                         _asn1_set_name((yyval.node),(yyvsp[(1) - (7)].str));
-                         _asn1_set_down((yyval.node),(yyvsp[(6) - (7)].node));}
+                        {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID|CONST_ASSIGN);
+                         _asn1_set_name((yyval.node),(yyvsp[-6].str));
+                         _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 2033 "ASN1.c"
     break;
 
-  case 90:
-
-/* Line 1455 of yacc.c  */
+  case 90: /* constant_def: IDENTIFIER IDENTIFIER "::=" '{' obj_constant_list '}'  */
 #line 347 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID|CONST_ASSIGN|CONST_1_PARAM);
-                         _asn1_set_name((yyval.node),(yyvsp[(1) - (6)].str));
-                         _asn1_set_value((yyval.node),(yyvsp[(2) - (6)].str),strlen((yyvsp[(2) - (6)].str))+1);
-                         _asn1_set_down((yyval.node),(yyvsp[(5) - (6)].node));}
+                        {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID|CONST_ASSIGN|CONST_1_PARAM);
+                         _asn1_set_name((yyval.node),(yyvsp[-5].str));
+                         _asn1_set_value((yyval.node),(yyvsp[-4].str),strlen((yyvsp[-4].str))+1);
+                         _asn1_set_down((yyval.node),(yyvsp[-1].node));}
+#line 2042 "ASN1.c"
     break;
 
-  case 91:
-
-/* Line 1455 of yacc.c  */
+  case 91: /* constant_def: IDENTIFIER INTEGER "::=" pos_neg_num  */
 #line 352 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_ASSIGN);
-                         _asn1_set_name((yyval.node),(yyvsp[(1) - (4)].str));
-                         _asn1_set_value((yyval.node),(yyvsp[(4) - (4)].str),strlen((yyvsp[(4) - (4)].str))+1);}
+                        {(yyval.node)=_asn1_add_node(TYPE_INTEGER|CONST_ASSIGN);
+                         _asn1_set_name((yyval.node),(yyvsp[-3].str));
+                         _asn1_set_value((yyval.node),(yyvsp[0].str),strlen((yyvsp[0].str))+1);}
+#line 2050 "ASN1.c"
     break;
 
-  case 92:
-
-/* Line 1455 of yacc.c  */
+  case 92: /* type_constant: type_def  */
 #line 357 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                              {(yyval.node)=(yyvsp[0].node);}
+#line 2056 "ASN1.c"
     break;
 
-  case 93:
-
-/* Line 1455 of yacc.c  */
+  case 93: /* type_constant: constant_def  */
 #line 358 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                              {(yyval.node)=(yyvsp[0].node);}
+#line 2062 "ASN1.c"
     break;
 
-  case 94:
-
-/* Line 1455 of yacc.c  */
+  case 94: /* type_constant_list: type_constant  */
 #line 361 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (1)].node);}
+                                        {(yyval.node)=(yyvsp[0].node);}
+#line 2068 "ASN1.c"
     break;
 
-  case 95:
-
-/* Line 1455 of yacc.c  */
+  case 95: /* type_constant_list: type_constant_list type_constant  */
 #line 362 "ASN1.y"
-    {(yyval.node)=(yyvsp[(1) - (2)].node);
-                                                          _asn1_set_right(_asn1_get_last_right((yyvsp[(1) - (2)].node)),(yyvsp[(2) - (2)].node));}
+                                                         {(yyval.node)=(yyvsp[-1].node);
+                                                          _asn1_set_right(_asn1_get_last_right((yyvsp[-1].node)),(yyvsp[0].node));}
+#line 2075 "ASN1.c"
     break;
 
-  case 96:
-
-/* Line 1455 of yacc.c  */
+  case 96: /* definitions_id: IDENTIFIER '{' obj_constant_list '}'  */
 #line 366 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);
-                                                          _asn1_set_down((yyval.node),(yyvsp[(3) - (4)].node));
-                                                          _asn1_set_name((yyval.node),(yyvsp[(1) - (4)].str));}
+                                                         {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);
+                                                          _asn1_set_down((yyval.node),(yyvsp[-1].node));
+                                                          _asn1_set_name((yyval.node),(yyvsp[-3].str));}
+#line 2083 "ASN1.c"
     break;
 
-  case 97:
-
-/* Line 1455 of yacc.c  */
+  case 97: /* definitions_id: IDENTIFIER '{' '}'  */
 #line 369 "ASN1.y"
-    {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);
-                                                          _asn1_set_name((yyval.node),(yyvsp[(1) - (3)].str));}
+                                                         {(yyval.node)=_asn1_add_node(TYPE_OBJECT_ID);
+                                                          _asn1_set_name((yyval.node),(yyvsp[-2].str));}
+#line 2090 "ASN1.c"
     break;
 
-  case 98:
-
-/* Line 1455 of yacc.c  */
+  case 98: /* explicit_implicit: EXPLICIT  */
 #line 393 "ASN1.y"
-    {(yyval.constant)=CONST_EXPLICIT;}
+                               {(yyval.constant)=CONST_EXPLICIT;}
+#line 2096 "ASN1.c"
     break;
 
-  case 99:
-
-/* Line 1455 of yacc.c  */
+  case 99: /* explicit_implicit: IMPLICIT  */
 #line 394 "ASN1.y"
-    {(yyval.constant)=CONST_IMPLICIT;}
+                               {(yyval.constant)=CONST_IMPLICIT;}
+#line 2102 "ASN1.c"
     break;
 
 
+#line 2106 "ASN1.c"
 
-/* Line 1455 of yacc.c  */
-#line 2371 "ASN1.c"
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
-	 error, discard it.  */
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
   /* Else will try to reuse lookahead token after shifting the error
@@ -2468,14 +2180,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2488,39 +2199,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2531,54 +2245,56 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined(yyoverflow) || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
-
 
+  return yyresult;
+}
 
-/* Line 1675 of yacc.c  */
 #line 398 "ASN1.y"
 
 
@@ -2751,6 +2467,9 @@ _asn1_create_errorDescription(int error,char *errorDescription)
  *
  * Function used to start the parse algorithm.  Creates the structures
  * needed to manage the definitions included in @file_name file.
+ * The parser is not reentrant, calls must not run concurrently.  The
+ * returned definitions are not modified by the other functions and
+ * can be shared by several threads.
  *
  * Returns: %ASN1_SUCCESS if the file has a correct syntax and every
  *   identifier is known, %ASN1_ELEMENT_NOT_EMPTY if @definitions not
@@ -2764,6 +2483,7 @@ _asn1_create_errorDescription(int error,char *errorDescription)
 asn1_retCode
 asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
 		 char *errorDescription){
+  int site;
 
   p_tree=ASN1_TYPE_EMPTY;
 
@@ -2772,6 +2492,8 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
 
   *definitions=ASN1_TYPE_EMPTY;
 
+  site=_asn1_enter_site(ASN1_ALLOC_PARSE);
+
   fileName = file_name;
 
   /* open the file to parse */
@@ -2796,12 +2518,17 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
       /* check the identifier definitions */
       result_parse=_asn1_check_identifier(p_tree);
       if(result_parse==ASN1_SUCCESS){ /* all identifier defined */
-	/* Delete the list and keep the ASN1 structure */
-	_asn1_delete_list();
+	/* Delete the list and the elements left out of the
+	   ASN1 structure */
+	_asn1_delete_list_and_unused_nodes(p_tree);
 	/* Convert into DER coding the value assign to INTEGER constants */
 	_asn1_change_integer_value(p_tree);
 	/* Expand the IDs of OBJECT IDENTIFIER constants */
 	_asn1_expand_object_id(p_tree);
+	/* Precompute the encoding of INTEGER DEFAULT values */
+	_asn1_expand_default_value(p_tree);
+	/* Index the OBJECT IDENTIFIER assignments */
+	_asn1_create_oid_index(p_tree);
 
 	*definitions=p_tree;
       }
@@ -2814,6 +2541,8 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
       _asn1_delete_list_and_nodes();
   }
 
+  _asn1_leave_site(site);
+
   if (errorDescription!=NULL)
 	_asn1_create_errorDescription(result_parse,errorDescription);
 
@@ -2850,9 +2579,12 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
   char *file_out_name=NULL;
   char *vector_name=NULL;
   const char *char_p,*slash_p,*dot_p;
+  int site;
 
   p_tree=NULL;
 
+  site=_asn1_enter_site(ASN1_ALLOC_PARSE);
+
   fileName = inputFileName;
 
   /* open the file to parse */
@@ -2896,7 +2628,7 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 
 	if(outputFileName == NULL){
 	  /* file_out_name = inputFileName + _asn1_tab.c */
-	  file_out_name=(char *)malloc(dot_p-inputFileName+1+
+	  file_out_name=(char *)_asn1_malloc(dot_p-inputFileName+1+
 				       strlen("_asn1_tab.c"));
 	  memcpy(file_out_name,inputFileName,dot_p-inputFileName);
 	  file_out_name[dot_p-inputFileName]=0;
@@ -2904,13 +2636,13 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	}
 	else{
 	  /* file_out_name = inputFileName */
-	  file_out_name=(char *)malloc(strlen(outputFileName)+1);
+	  file_out_name=(char *)_asn1_malloc(strlen(outputFileName)+1);
 	  strcpy(file_out_name,outputFileName);
 	}
 
 	if(vectorName == NULL){
 	  /* vector_name = file name + _asn1_tab */
-	  vector_name=(char *)malloc(dot_p-slash_p+1+
+	  vector_name=(char *)_asn1_malloc(dot_p-slash_p+1+
 				     strlen("_asn1_tab"));
 	  memcpy(vector_name,slash_p,dot_p-slash_p);
 	  vector_name[dot_p-slash_p]=0;
@@ -2918,7 +2650,7 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	}
 	else{
 	  /* vector_name = vectorName */
-	  vector_name=(char *)malloc(strlen(vectorName)+1);
+	  vector_name=(char *)_asn1_malloc(strlen(vectorName)+1);
 	  strcpy(vector_name,vectorName);
 	}
 
@@ -2926,8 +2658,8 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	_asn1_create_static_structure(p_tree,
 				      file_out_name,vector_name);
 
-	free(file_out_name);
-	free(vector_name);
+	_asn1_free(file_out_name);
+	_asn1_free(vector_name);
       } /* result == OK */
     }   /* result == OK */
 
@@ -2935,6 +2667,8 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
     _asn1_delete_list_and_nodes();
   } /* inputFile exist */
 
+  _asn1_leave_site(site);
+
   if (errorDescription!=NULL)
 	_asn1_create_errorDescription(result_parse,errorDescription);
 
@@ -2963,4 +2697,3 @@ static int _asn1_yyerror (const char *s)
 
   return 0;
 }
-
@@ -566,6 +566,9 @@ _asn1_create_errorDescription(int error,char *errorDescription)
  *
  * Function used to start the parse algorithm.  Creates the structures
  * needed to manage the definitions included in @file_name file.
+ * The parser is not reentrant, calls must not run concurrently.  The
+ * returned definitions are not modified by the other functions and
+ * can be shared by several threads.
  *
  * Returns: %ASN1_SUCCESS if the file has a correct syntax and every
  *   identifier is known, %ASN1_ELEMENT_NOT_EMPTY if @definitions not
@@ -579,6 +582,7 @@ _asn1_create_errorDescription(int error,char *errorDescription)
 asn1_retCode
 asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
 		 char *errorDescription){
+  int site;
 
   p_tree=ASN1_TYPE_EMPTY;
 
@@ -587,6 +591,8 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
 
   *definitions=ASN1_TYPE_EMPTY;
 
+  site=_asn1_enter_site(ASN1_ALLOC_PARSE);
+
   fileName = file_name;
 
   /* open the file to parse */
@@ -611,12 +617,17 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
       /* check the identifier definitions */
       result_parse=_asn1_check_identifier(p_tree);
       if(result_parse==ASN1_SUCCESS){ /* all identifier defined */
-	/* Delete the list and keep the ASN1 structure */
-	_asn1_delete_list();
+	/* Delete the list and the elements left out of the
+	   ASN1 structure */
+	_asn1_delete_list_and_unused_nodes(p_tree);
 	/* Convert into DER coding the value assign to INTEGER constants */
 	_asn1_change_integer_value(p_tree);
 	/* Expand the IDs of OBJECT IDENTIFIER constants */
 	_asn1_expand_object_id(p_tree);
+	/* Precompute the encoding of INTEGER DEFAULT values */
+	_asn1_expand_default_value(p_tree);
+	/* Index the OBJECT IDENTIFIER assignments */
+	_asn1_create_oid_index(p_tree);
 
 	*definitions=p_tree;
       }
@@ -629,6 +640,8 @@ asn1_parser2tree(const char *file_name, ASN1_TYPE *definitions,
       _asn1_delete_list_and_nodes();
   }
 
+  _asn1_leave_site(site);
+
   if (errorDescription!=NULL)
 	_asn1_create_errorDescription(result_parse,errorDescription);
 
@@ -665,9 +678,12 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
   char *file_out_name=NULL;
   char *vector_name=NULL;
   const char *char_p,*slash_p,*dot_p;
+  int site;
 
   p_tree=NULL;
 
+  site=_asn1_enter_site(ASN1_ALLOC_PARSE);
+
   fileName = inputFileName;
 
   /* open the file to parse */
@@ -711,7 +727,7 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 
 	if(outputFileName == NULL){
 	  /* file_out_name = inputFileName + _asn1_tab.c */
-	  file_out_name=(char *)malloc(dot_p-inputFileName+1+
+	  file_out_name=(char *)_asn1_malloc(dot_p-inputFileName+1+
 				       strlen("_asn1_tab.c"));
 	  memcpy(file_out_name,inputFileName,dot_p-inputFileName);
 	  file_out_name[dot_p-inputFileName]=0;
@@ -719,13 +735,13 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	}
 	else{
 	  /* file_out_name = inputFileName */
-	  file_out_name=(char *)malloc(strlen(outputFileName)+1);
+	  file_out_name=(char *)_asn1_malloc(strlen(outputFileName)+1);
 	  strcpy(file_out_name,outputFileName);
 	}
 
 	if(vectorName == NULL){
 	  /* vector_name = file name + _asn1_tab */
-	  vector_name=(char *)malloc(dot_p-slash_p+1+
+	  vector_name=(char *)_asn1_malloc(dot_p-slash_p+1+
 				     strlen("_asn1_tab"));
 	  memcpy(vector_name,slash_p,dot_p-slash_p);
 	  vector_name[dot_p-slash_p]=0;
@@ -733,7 +749,7 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	}
 	else{
 	  /* vector_name = vectorName */
-	  vector_name=(char *)malloc(strlen(vectorName)+1);
+	  vector_name=(char *)_asn1_malloc(strlen(vectorName)+1);
 	  strcpy(vector_name,vectorName);
 	}
 
@@ -741,8 +757,8 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
 	_asn1_create_static_structure(p_tree,
 				      file_out_name,vector_name);
 
-	free(file_out_name);
-	free(vector_name);
+	_asn1_free(file_out_name);
+	_asn1_free(vector_name);
       } /* result == OK */
     }   /* result == OK */
 
@@ -750,6 +766,8 @@ int asn1_parser2array(const char *inputFileName,const char *outputFileName,
     _asn1_delete_list_and_nodes();
   } /* inputFile exist */
 
+  _asn1_leave_site(site);
+
   if (errorDescription!=NULL)
 	_asn1_create_errorDescription(result_parse,errorDescription);
 
@@ -0,0 +1,1928 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+
+/*****************************************************/
+/* File: codegen.c                                   */
+/* Description: Functions to generate C structures   */
+/*  and specialized DER coding functions from an     */
+/*  ASN1 definitions tree.                           */
+/*****************************************************/
+
+#include <int.h>
+#include <stdarg.h>
+#include "parser_aux.h"
+#include "gstr.h"
+
+#define GEN_MAX_TAGS   8	/* maximum number of tags of one element */
+#define GEN_MAX_DEPTH 32	/* maximum depth of identifier references */
+#define GEN_MAX_PATH 512	/* maximum length of a C member path */
+
+/* Kind of C representation of an element.  */
+#define GEN_BLOB     1		/* content octets, P_blob */
+#define GEN_TLV      2		/* complete encoding, P_blob */
+#define GEN_BOOL     3		/* int */
+#define GEN_NULL     4		/* no member */
+#define GEN_CALL     5		/* struct of a named type */
+#define GEN_SEQUENCE 6		/* inline SEQUENCE */
+#define GEN_CHOICE   7		/* inline CHOICE */
+#define GEN_INT      8		/* int64_t */
+#define GEN_LIST     9		/* SEQUENCE OF or SET OF, struct of a list */
+
+/* What _gen_iterators writes.  */
+#define GEN_ITER_NAMES      0	/* only checks the names */
+#define GEN_ITER_PROTOTYPES 1
+#define GEN_ITER_FUNCTIONS  2
+
+typedef struct
+{
+  unsigned char cls;
+  unsigned long tag;
+  int implicit;			/* not EXPLICIT */
+} gen_tag;
+
+typedef struct
+{
+  ASN1_TYPE node;
+  int visiting;
+  int order;
+} gen_type;
+
+typedef struct
+{
+  ASN1_TYPE base;		/* type after following the identifiers */
+  gen_tag raw[GEN_MAX_TAGS];	/* tags in the definitions */
+  int n_raw;
+  gen_tag tags[GEN_MAX_TAGS];	/* tags of the encoding, outermost first */
+  int n_tags;
+  int header;			/* the last tag has no length */
+  int kind;
+} gen_elem;
+
+typedef struct
+{
+  char *c_name;
+  char *asn1_name;		/* the identifier it was made from */
+} gen_name;
+
+typedef struct
+{
+  FILE *file;
+  ASN1_TYPE root;
+  const char *prefix;
+  gen_type *types;
+  int n_types;
+  int order;			/* order of the type being generated */
+  int counter;			/* suffix for local variable names */
+  int indent;
+  gen_name *names;		/* C names of the scope being checked */
+  int n_names;
+  int size_names;
+  char *error;			/* error description, or NULL */
+} gen_ctx;
+
+static const char *gen_reserved[] = {
+  "auto", "break", "case", "char", "choice", "const", "continue",
+  "default", "do", "double", "else", "enum", "extern", "float", "for",
+  "goto", "if", "int", "long", "register", "return", "short", "signed",
+  "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned",
+  "void", "volatile", "while", NULL
+};
+
+static void _gen_print (gen_ctx * ctx, const char *fmt, ...)
+  __attribute__ ((format (printf, 2, 3)));
+
+static void
+_gen_print (gen_ctx * ctx, const char *fmt, ...)
+{
+  va_list args;
+  int k;
+
+  for (k = 0; k < ctx->indent; k++)
+    fputs ("  ", ctx->file);
+
+  va_start (args, fmt);
+  vfprintf (ctx->file, fmt, args);
+  va_end (args);
+
+  fputc ('\n', ctx->file);
+}
+
+/* Copy NAME into DEST (ASN1_MAX_NAME_SIZE + 2 bytes) as a valid C
+   identifier.  Different names can give the same identifier, as "a-b"
+   and "a_b" do: _gen_add_name tells it.  */
+static void
+_gen_c_name (char *dest, const char *name)
+{
+  int k;
+
+  for (k = 0; name[k] && k < ASN1_MAX_NAME_SIZE; k++)
+    dest[k] = isalnum ((unsigned char) name[k]) ? name[k] : '_';
+  dest[k] = 0;
+
+  for (k = 0; gen_reserved[k]; k++)
+    if (!strcmp (dest, gen_reserved[k]))
+      {
+	strcat (dest, "_");
+	break;
+      }
+}
+
+/* Add C_NAME, made from the ASN.1 identifier ASN1_NAME, to the names
+   of the scope being checked.  Return ASN1_VALUE_NOT_VALID, and set
+   the error description, if the scope has it already.  */
+static asn1_retCode
+_gen_add_name (gen_ctx * ctx, const char *c_name, const char *asn1_name)
+{
+  gen_name *names;
+  int k;
+
+  for (k = 0; k < ctx->n_names; k++)
+    if (!strcmp (ctx->names[k].c_name, c_name))
+      {
+	if (ctx->error)
+	  {
+	    _asn1_str_cpy (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   ctx->names[k].asn1_name);
+	    _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   " and ");
+	    _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   asn1_name);
+	    _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   " are both ");
+	    _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   c_name);
+	    _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			   " in C");
+	  }
+	return ASN1_VALUE_NOT_VALID;
+      }
+
+  if (ctx->n_names == ctx->size_names)
+    {
+      names = _asn1_realloc (ctx->names, (ctx->size_names * 2 + 16)
+			     * sizeof (gen_name));
+      if (names == NULL)
+	return ASN1_MEM_ALLOC_ERROR;
+      ctx->names = names;
+      ctx->size_names = ctx->size_names * 2 + 16;
+    }
+
+  ctx->names[ctx->n_names].c_name = _asn1_strdup (c_name);
+  ctx->names[ctx->n_names].asn1_name = _asn1_strdup (asn1_name);
+  if (ctx->names[ctx->n_names].c_name == NULL
+      || ctx->names[ctx->n_names].asn1_name == NULL)
+    {
+      _asn1_free (ctx->names[ctx->n_names].c_name);
+      _asn1_free (ctx->names[ctx->n_names].asn1_name);
+      return ASN1_MEM_ALLOC_ERROR;
+    }
+  ctx->n_names++;
+
+  return ASN1_SUCCESS;
+}
+
+/* Forget the names of the scope after the first N.  */
+static void
+_gen_drop_names (gen_ctx * ctx, int n)
+{
+  while (ctx->n_names > n)
+    {
+      ctx->n_names--;
+      _asn1_free (ctx->names[ctx->n_names].c_name);
+      _asn1_free (ctx->names[ctx->n_names].asn1_name);
+    }
+}
+
+/* Set DEST to PREFIX followed by NAME.  */
+static asn1_retCode
+_gen_path (char *dest, const char *prefix, const char *name)
+{
+  if (strlen (prefix) + strlen (name) >= GEN_MAX_PATH)
+    return ASN1_MEM_ERROR;
+
+  strcpy (dest, prefix);
+  strcat (dest, name);
+
+  return ASN1_SUCCESS;
+}
+
+static ASN1_TYPE
+_gen_find (gen_ctx * ctx, const char *name)
+{
+  ASN1_TYPE p;
+
+  if (name == NULL)
+    return NULL;
+
+  for (p = ctx->root->down; p; p = p->right)
+    if (p->name && !strcmp (p->name, name))
+      return p;
+
+  return NULL;
+}
+
+/* Follow the chain of TYPE_IDENTIFIER nodes starting at NODE.  */
+static ASN1_TYPE
+_gen_resolve (gen_ctx * ctx, ASN1_TYPE node)
+{
+  int k;
+
+  for (k = 0; node && type_field (node->type) == TYPE_IDENTIFIER; k++)
+    {
+      if (k == GEN_MAX_DEPTH)
+	return NULL;
+      node = _gen_find (ctx, (char *) node->value);
+    }
+
+  return node;
+}
+
+static gen_type *
+_gen_type (gen_ctx * ctx, ASN1_TYPE node)
+{
+  int k;
+
+  for (k = 0; k < ctx->n_types; k++)
+    if (ctx->types[k].node == node)
+      return &ctx->types[k];
+
+  return NULL;
+}
+
+static int
+_gen_is_component (ASN1_TYPE node)
+{
+  switch (type_field (node->type))
+    {
+    case TYPE_TAG:
+    case TYPE_SIZE:
+    case TYPE_DEFAULT:
+    case TYPE_CONSTANT:
+      return 0;
+    default:
+      return 1;
+    }
+}
+
+static ASN1_TYPE
+_gen_next_component (ASN1_TYPE node)
+{
+  while (node && !_gen_is_component (node))
+    node = node->right;
+
+  return node;
+}
+
+#define FIRST_COMPONENT(n) _gen_next_component ((n)->down)
+#define NEXT_COMPONENT(n)  _gen_next_component ((n)->right)
+
+/* Append to TAGS, starting at position N, the tags written in the
+   definitions for NODE and for the types it refers to, the outermost
+   first.  Return the new number of tags, or -1.  */
+static int
+_gen_raw_tags (gen_ctx * ctx, ASN1_TYPE node, gen_tag * tags, int n,
+	       int depth)
+{
+  ASN1_TYPE p;
+
+  if (node == NULL || n < 0 || depth > GEN_MAX_DEPTH)
+    return -1;
+
+  for (p = node->down; p; p = p->right)
+    if (type_field (p->type) == TYPE_TAG)
+      {
+	if (n == GEN_MAX_TAGS)
+	  return -1;
+	if (p->type & CONST_APPLICATION)
+	  tags[n].cls = ASN1_CLASS_APPLICATION;
+	else if (p->type & CONST_UNIVERSAL)
+	  tags[n].cls = ASN1_CLASS_UNIVERSAL;
+	else if (p->type & CONST_PRIVATE)
+	  tags[n].cls = ASN1_CLASS_PRIVATE;
+	else
+	  tags[n].cls = ASN1_CLASS_CONTEXT_SPECIFIC;
+	tags[n].tag = strtoul ((char *) p->value, NULL, 10);
+	tags[n].implicit = (p->type & CONST_EXPLICIT) ? 0 : 1;
+	n++;
+      }
+
+  if (type_field (node->type) == TYPE_IDENTIFIER)
+    return _gen_raw_tags (ctx, _gen_find (ctx, (char *) node->value), tags,
+			  n, depth + 1);
+
+  return n;
+}
+
+/* Set TAG to the universal tag of the type NODE.  Return 1, 0 if the
+   type has no tag of its own (CHOICE and ANY), or -1.  */
+static int
+_gen_universal_tag (ASN1_TYPE node, gen_tag * tag)
+{
+  tag->cls = ASN1_CLASS_UNIVERSAL;
+  tag->implicit = 0;
+
+  switch (type_field (node->type))
+    {
+    case TYPE_CHOICE:
+    case TYPE_ANY:
+      return 0;
+    case TYPE_BOOLEAN:
+      tag->tag = ASN1_TAG_BOOLEAN;
+      break;
+    case TYPE_INTEGER:
+      tag->tag = ASN1_TAG_INTEGER;
+      break;
+    case TYPE_ENUMERATED:
+      tag->tag = ASN1_TAG_ENUMERATED;
+      break;
+    case TYPE_BIT_STRING:
+      tag->tag = ASN1_TAG_BIT_STRING;
+      break;
+    case TYPE_OCTET_STRING:
+      tag->tag = ASN1_TAG_OCTET_STRING;
+      break;
+    case TYPE_GENERALSTRING:
+      tag->tag = ASN1_TAG_GENERALSTRING;
+      break;
+    case TYPE_NULL:
+      tag->tag = ASN1_TAG_NULL;
+      break;
+    case TYPE_OBJECT_ID:
+      tag->tag = ASN1_TAG_OBJECT_ID;
+      break;
+    case TYPE_TIME:
+      if (node->type & CONST_UTC)
+	tag->tag = ASN1_TAG_UTCTime;
+      else
+	tag->tag = ASN1_TAG_GENERALIZEDTime;
+      break;
+    case TYPE_SEQUENCE:
+    case TYPE_SEQUENCE_OF:
+      tag->cls |= ASN1_CLASS_STRUCTURED;
+      tag->tag = ASN1_TAG_SEQUENCE;
+      break;
+    case TYPE_SET:
+    case TYPE_SET_OF:
+      tag->cls |= ASN1_CLASS_STRUCTURED;
+      tag->tag = ASN1_TAG_SET;
+      break;
+    default:
+      return -1;
+    }
+
+  return 1;
+}
+
+/******************************************************************/
+/* Function : _gen_element                                        */
+/* Description: computes how NODE is encoded.  PREFIX holds the   */
+/*   tags of the enclosing CHOICE, that are moved on its          */
+/*   alternatives.  The tags are applied as _asn1_insert_tag_der  */
+/*   does: the first IMPLICIT tag replaces the universal one, an  */
+/*   EXPLICIT tag after it is written with the implicit tag, and  */
+/*   an implicitly tagged ANY has the tag followed by its value,  */
+/*   without length.                                              */
+/******************************************************************/
+static void
+_gen_element (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+	      int n_prefix, int top, gen_elem * e)
+{
+  gen_tag universal;
+  gen_type *t;
+  unsigned char structured;
+  int k, pending = -1, has_tag;
+
+  e->n_tags = 0;
+  e->header = 0;
+  e->base = _gen_resolve (ctx, node);
+
+  if (n_prefix > 0)
+    memcpy (e->raw, prefix, n_prefix * sizeof (gen_tag));
+  e->n_raw = _gen_raw_tags (ctx, node, e->raw, n_prefix, 0);
+
+  has_tag = e->base ? _gen_universal_tag (e->base, &universal) : -1;
+  if (e->n_raw < 0 || has_tag < 0)
+    {
+      e->n_raw = 0;
+      e->kind = GEN_TLV;
+      return;
+    }
+
+  t = _gen_type (ctx, e->base);
+  switch (type_field (e->base->type))
+    {
+    case TYPE_BOOLEAN:
+      e->kind = GEN_BOOL;
+      break;
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+      e->kind = GEN_INT;
+      break;
+    case TYPE_SEQUENCE_OF:
+    case TYPE_SET_OF:
+      e->kind = GEN_LIST;
+      break;
+    case TYPE_NULL:
+      e->kind = GEN_NULL;
+      break;
+    case TYPE_ANY:
+      e->kind = GEN_TLV;
+      break;
+    case TYPE_SEQUENCE:
+      /* a type can contain only the types generated before it,
+         recursive references are left as octets */
+      if (t == NULL)
+	e->kind = GEN_SEQUENCE;
+      else if (top || t->order < ctx->order)
+	e->kind = GEN_CALL;
+      else
+	e->kind = GEN_BLOB;
+      break;
+    case TYPE_CHOICE:
+      /* the tags of a CHOICE go on its alternatives */
+      if (t == NULL)
+	e->kind = GEN_CHOICE;
+      else if (top || t->order < ctx->order)
+	e->kind = (e->n_raw > 0) ? GEN_CHOICE : GEN_CALL;
+      else
+	e->kind = GEN_TLV;
+      return;
+    default:
+      e->kind = GEN_BLOB;
+      break;
+    }
+
+  structured = (universal.cls & ASN1_CLASS_STRUCTURED);
+  for (k = 0; k < e->n_raw; k++)
+    if (!e->raw[k].implicit)
+      {
+	if (pending >= 0)
+	  {
+	    e->tags[e->n_tags].cls = e->raw[pending].cls | structured;
+	    e->tags[e->n_tags].tag = e->raw[pending].tag;
+	  }
+	else
+	  {
+	    e->tags[e->n_tags].cls = e->raw[k].cls | ASN1_CLASS_STRUCTURED;
+	    e->tags[e->n_tags].tag = e->raw[k].tag;
+	  }
+	e->n_tags++;
+	pending = -1;
+      }
+    else if (pending < 0)
+      pending = k;
+
+  if (pending >= 0)
+    {
+      e->tags[e->n_tags].cls = e->raw[pending].cls | structured;
+      e->tags[e->n_tags].tag = e->raw[pending].tag;
+      e->n_tags++;
+      if (has_tag == 0)
+	e->header = 1;
+    }
+  else if (has_tag)
+    e->tags[e->n_tags++] = universal;
+}
+
+/* Find the order in which the named types must be declared.  The
+   elements of the lists come first too, as the lists have arrays of
+   them.  */
+static void _gen_order_type (gen_ctx * ctx, gen_type * t);
+
+static void
+_gen_order_components (gen_ctx * ctx, ASN1_TYPE node, int depth)
+{
+  ASN1_TYPE p, base;
+  gen_type *t;
+
+  if (depth > GEN_MAX_DEPTH)
+    return;
+
+  for (p = FIRST_COMPONENT (node); p; p = NEXT_COMPONENT (p))
+    switch (type_field (p->type))
+      {
+      case TYPE_SEQUENCE:
+      case TYPE_CHOICE:
+      case TYPE_SEQUENCE_OF:
+      case TYPE_SET_OF:
+	_gen_order_components (ctx, p, depth + 1);
+	break;
+      case TYPE_IDENTIFIER:
+	base = _gen_resolve (ctx, p);
+	t = _gen_type (ctx, base);
+	if (t && t->order < 0 && !t->visiting)
+	  _gen_order_type (ctx, t);
+	else if (t == NULL && base
+		 && (type_field (base->type) == TYPE_SEQUENCE_OF
+		     || type_field (base->type) == TYPE_SET_OF))
+	  _gen_order_components (ctx, base, depth + 1);
+	break;
+      default:
+	break;
+      }
+}
+
+static void
+_gen_order_type (gen_ctx * ctx, gen_type * t)
+{
+  t->visiting = 1;
+  _gen_order_components (ctx, t->node, 0);
+  t->visiting = 0;
+  t->order = ctx->order++;
+}
+
+/* Set E to the encoding of the elements of the SEQUENCE OF or SET OF
+   NODE.  Return 1 if they are kept as complete encodings, as inline
+   structures, nested lists and NULL are.  */
+static int
+_gen_item (gen_ctx * ctx, ASN1_TYPE node, gen_elem * e)
+{
+  ASN1_TYPE item = FIRST_COMPONENT (node);
+
+  if (item == NULL)
+    {
+      memset (e, 0, sizeof (*e));
+      e->kind = GEN_TLV;
+      return 1;
+    }
+
+  _gen_element (ctx, item, NULL, 0, 0, e);
+  switch (e->kind)
+    {
+    case GEN_SEQUENCE:
+    case GEN_CHOICE:
+      return _gen_type (ctx, e->base) == NULL;
+    case GEN_LIST:
+    case GEN_NULL:
+      return 1;
+    default:
+      return 0;
+    }
+}
+
+/* Set DEST (GEN_MAX_PATH bytes) to the C type of the elements E of a
+   list, RAW as returned by _gen_item.  */
+static void
+_gen_item_type (gen_ctx * ctx, const gen_elem * e, int raw, char *dest)
+{
+  char type_name[ASN1_MAX_NAME_SIZE + 2];
+
+  if (raw || e->kind == GEN_BLOB || e->kind == GEN_TLV)
+    sprintf (dest, "%s_blob", ctx->prefix);
+  else if (e->kind == GEN_INT)
+    strcpy (dest, "int64_t");
+  else if (e->kind == GEN_BOOL)
+    strcpy (dest, "int");
+  else
+    {
+      _gen_c_name (type_name, e->base->name);
+      sprintf (dest, "struct %s_%s", ctx->prefix, type_name);
+    }
+}
+
+/******************************************************************/
+/* Function : _gen_check_members                                  */
+/* Description: checks that the members of the structure of the   */
+/*   SEQUENCE or CHOICE NODE, and those of its inline structures, */
+/*   have different C names.                                      */
+/******************************************************************/
+static asn1_retCode
+_gen_check_members (gen_ctx * ctx, ASN1_TYPE node)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2], present[ASN1_MAX_NAME_SIZE + 16];
+  const char *asn1_name;
+  asn1_retCode result = ASN1_SUCCESS;
+  gen_elem e;
+  ASN1_TYPE p;
+  int n = ctx->n_names;
+
+  if (type_field (node->type) == TYPE_CHOICE)
+    result = _gen_add_name (ctx, "choice", "the CHOICE selector");
+
+  for (p = FIRST_COMPONENT (node); p && result == ASN1_SUCCESS;
+       p = NEXT_COMPONENT (p))
+    {
+      asn1_name = p->name ? p->name : "unnamed";
+      _gen_c_name (name, asn1_name);
+      _gen_element (ctx, p, NULL, 0, 0, &e);
+      if (e.kind != GEN_NULL)
+	result = _gen_add_name (ctx, name, asn1_name);
+      if (result == ASN1_SUCCESS && (p->type & (CONST_OPTION | CONST_DEFAULT)))
+	{
+	  strcpy (present, name);
+	  strcat (present, "_present");
+	  result = _gen_add_name (ctx, present, asn1_name);
+	}
+    }
+  _gen_drop_names (ctx, n);
+
+  for (p = FIRST_COMPONENT (node); p && result == ASN1_SUCCESS;
+       p = NEXT_COMPONENT (p))
+    {
+      _gen_element (ctx, p, NULL, 0, 0, &e);
+      if ((e.kind == GEN_SEQUENCE || e.kind == GEN_CHOICE)
+	  && _gen_type (ctx, e.base) == NULL)
+	result = _gen_check_members (ctx, e.base);
+    }
+
+  return result;
+}
+
+/******************************************************************/
+/* Function : _gen_members                                        */
+/* Description: writes the C members of a SEQUENCE or a CHOICE.   */
+/* Return: the number of members written.                         */
+/******************************************************************/
+static int
+_gen_members (gen_ctx * ctx, ASN1_TYPE node)
+{
+  gen_elem e, item;
+  char name[ASN1_MAX_NAME_SIZE + 2], type_name[ASN1_MAX_NAME_SIZE + 2];
+  char item_type[GEN_MAX_PATH];
+  ASN1_TYPE p;
+  int count = 0, position = 0, m, raw;
+
+  if (type_field (node->type) == TYPE_CHOICE)
+    {
+      _gen_print (ctx, "unsigned int choice;");
+      count++;
+    }
+
+  for (p = FIRST_COMPONENT (node); p; p = NEXT_COMPONENT (p))
+    {
+      position++;
+      _gen_element (ctx, p, NULL, 0, 0, &e);
+      _gen_c_name (name, p->name ? p->name : "unnamed");
+
+      if (type_field (node->type) == TYPE_CHOICE)
+	_gen_print (ctx, "/* choice == %d */", position);
+
+      if (p->type & (CONST_OPTION | CONST_DEFAULT))
+	{
+	  _gen_print (ctx, "int %s_present;", name);
+	  count++;
+	}
+
+      switch (e.kind)
+	{
+	case GEN_BOOL:
+	  _gen_print (ctx, "int %s;", name);
+	  break;
+	case GEN_INT:
+	  _gen_print (ctx, "int64_t %s;", name);
+	  break;
+	case GEN_NULL:
+	  continue;
+	case GEN_LIST:
+	  raw = _gen_item (ctx, e.base, &item);
+	  _gen_item_type (ctx, &item, raw, item_type);
+	  _gen_print (ctx, "struct");
+	  _gen_print (ctx, "{");
+	  ctx->indent++;
+	  _gen_print (ctx, "const unsigned char *data;\t/* content octets */");
+	  _gen_print (ctx, "int len;");
+	  _gen_print (ctx, "int count;");
+	  _gen_print (ctx, "const %s *items;\t/* to encode, or NULL */",
+		      item_type);
+	  ctx->indent--;
+	  _gen_print (ctx, "} %s;", name);
+	  break;
+	case GEN_SEQUENCE:
+	case GEN_CHOICE:
+	case GEN_CALL:
+	  if (_gen_type (ctx, e.base))
+	    {
+	      _gen_c_name (type_name, e.base->name);
+	      _gen_print (ctx, "struct %s_%s %s;", ctx->prefix, type_name,
+			  name);
+	      break;
+	    }
+	  _gen_print (ctx, "struct");
+	  _gen_print (ctx, "{");
+	  ctx->indent++;
+	  m = _gen_members (ctx, e.base);
+	  if (m == 0)
+	    _gen_print (ctx, "int unused;");
+	  ctx->indent--;
+	  _gen_print (ctx, "} %s;", name);
+	  break;
+	case GEN_TLV:
+	  _gen_print (ctx, "%s_blob %s;\t/* complete encoding */",
+		      ctx->prefix, name);
+	  break;
+	default:
+	  _gen_print (ctx, "%s_blob %s;", ctx->prefix, name);
+	  break;
+	}
+      count++;
+    }
+
+  return count;
+}
+
+/* Append to BUF the C condition that is true when the next element
+   in the input is an encoding of NODE.  */
+static asn1_retCode
+_gen_peek (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+	   int n_prefix, const char *end, char *buf, int depth)
+{
+  gen_elem e;
+  char tmp[GEN_MAX_PATH];
+  ASN1_TYPE p;
+  asn1_retCode result;
+
+  _gen_element (ctx, node, prefix, n_prefix, 0, &e);
+
+  if (e.n_tags > 0)
+    sprintf (tmp, "%s_peek (p, %.64s, 0x%02x, %lu)", ctx->prefix, end,
+	     e.tags[0].cls, e.tags[0].tag);
+  else if (e.base && type_field (e.base->type) == TYPE_CHOICE
+	   && depth < GEN_MAX_DEPTH)
+    {
+      if (strlen (buf) + 1 >= GEN_MAX_PATH)
+	return ASN1_MEM_ERROR;
+      strcat (buf, "(");
+      for (p = FIRST_COMPONENT (e.base); p; p = NEXT_COMPONENT (p))
+	{
+	  if (p != FIRST_COMPONENT (e.base))
+	    {
+	      if (strlen (buf) + 4 >= GEN_MAX_PATH)
+		return ASN1_MEM_ERROR;
+	      strcat (buf, " || ");
+	    }
+	  result = _gen_peek (ctx, p, e.raw, e.n_raw, end, buf, depth + 1);
+	  if (result != ASN1_SUCCESS)
+	    return result;
+	}
+      strcpy (tmp, ")");
+    }
+  else
+    sprintf (tmp, "p < %.64s", end);
+
+  if (strlen (buf) + strlen (tmp) >= GEN_MAX_PATH)
+    return ASN1_MEM_ERROR;
+  strcat (buf, tmp);
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode _gen_dec_value (gen_ctx * ctx, ASN1_TYPE node,
+				    const gen_tag * prefix, int n_prefix,
+				    const char *lvalue, const char *end,
+				    int top);
+
+/******************************************************************/
+/* Function : _gen_dec_components                                 */
+/* Description: writes the decoding of the components of the      */
+/*   SEQUENCE or CHOICE NODE.  PREFIX holds the tags of a CHOICE, */
+/*   MEMBER is the C prefix of the members ("out->" or "out->x."),*/
+/*   END the name of the variable with the end of the input.      */
+/******************************************************************/
+static asn1_retCode
+_gen_dec_components (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+		     int n_prefix, const char *member, const char *end)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2], lvalue[GEN_MAX_PATH];
+  char cond[GEN_MAX_PATH];
+  int choice = (type_field (node->type) == TYPE_CHOICE);
+  int position = 0;
+  asn1_retCode result;
+  ASN1_TYPE p;
+
+  if (!choice)
+    n_prefix = 0;
+
+  for (p = FIRST_COMPONENT (node); p; p = NEXT_COMPONENT (p))
+    {
+      position++;
+      _gen_c_name (name, p->name ? p->name : "unnamed");
+      result = _gen_path (lvalue, member, name);
+      if (result != ASN1_SUCCESS)
+	return result;
+
+      if (!choice && !(p->type & (CONST_OPTION | CONST_DEFAULT)))
+	{
+	  result = _gen_dec_value (ctx, p, NULL, 0, lvalue, end, 0);
+	  if (result != ASN1_SUCCESS)
+	    return result;
+	  continue;
+	}
+
+      cond[0] = 0;
+      if (_gen_peek (ctx, p, prefix, n_prefix, end, cond, 0) != ASN1_SUCCESS)
+	sprintf (cond, "p < %.64s", end);
+
+      if (choice && position > 1)
+	_gen_print (ctx, "else if (%s)", cond);
+      else
+	_gen_print (ctx, "if (%s)", cond);
+      ctx->indent++;
+      _gen_print (ctx, "{");
+      ctx->indent++;
+      if (choice)
+	_gen_print (ctx, "%schoice = %d;", member, position);
+      else
+	_gen_print (ctx, "%s_present = 1;", lvalue);
+      result = _gen_dec_value (ctx, p, prefix, n_prefix, lvalue, end, 0);
+      if (result != ASN1_SUCCESS)
+	return result;
+      ctx->indent--;
+      _gen_print (ctx, "}");
+      ctx->indent--;
+    }
+
+  if (choice)
+    {
+      _gen_print (ctx, "else");
+      ctx->indent++;
+      _gen_print (ctx, "return ASN1_TAG_ERROR;");
+      ctx->indent--;
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/******************************************************************/
+/* Function : _gen_dec_value                                      */
+/* Description: writes the decoding of NODE into LVALUE.  The     */
+/*   generated code reads from 'p' up to END.  If TOP is set,     */
+/*   NODE is the named type being generated and LVALUE a pointer. */
+/******************************************************************/
+static asn1_retCode
+_gen_dec_value (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+		int n_prefix, const char *lvalue, const char *end, int top)
+{
+  gen_elem e;
+  gen_type *t;
+  char type_name[ASN1_MAX_NAME_SIZE + 2], member[GEN_MAX_PATH];
+  char inner[GEN_MAX_TAGS][16];
+  const char *cur = end;
+  asn1_retCode result;
+  int n, k, order;
+
+  _gen_element (ctx, node, prefix, n_prefix, top, &e);
+  n = e.n_tags - e.header;
+
+  for (k = 0; k < n; k++)
+    {
+      sprintf (inner[k], "end%d", ++ctx->counter);
+      _gen_print (ctx, "{");
+      ctx->indent++;
+      _gen_print (ctx, "const unsigned char *%s;", inner[k]);
+      _gen_print (ctx, "result = %s_get_tl (&p, %s, 0x%02x, %lu, &%s);",
+		  ctx->prefix, cur, e.tags[k].cls, e.tags[k].tag, inner[k]);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      cur = inner[k];
+    }
+
+  if (e.header)
+    {
+      _gen_print (ctx, "result = %s_get_tag (&p, %s, 0x%02x, %lu);",
+		  ctx->prefix, cur, e.tags[n].cls, e.tags[n].tag);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+    }
+
+  switch (e.kind)
+    {
+    case GEN_BLOB:
+      _gen_print (ctx, "%s.data = p;", lvalue);
+      _gen_print (ctx, "%s.len = %s - p;", lvalue, cur);
+      _gen_print (ctx, "p = %s;", cur);
+      break;
+    case GEN_TLV:
+      _gen_print (ctx, "result = %s_get_tlv (&p, %s, &%s);", ctx->prefix,
+		  cur, lvalue);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      break;
+    case GEN_BOOL:
+      _gen_print (ctx, "if (%s - p != 1)", cur);
+      _gen_print (ctx, "  return ASN1_DER_ERROR;");
+      _gen_print (ctx, "%s = (*p++ != 0);", lvalue);
+      break;
+    case GEN_INT:
+      _gen_print (ctx, "result = %s_get_int (p, %s, &%s);", ctx->prefix,
+		  cur, lvalue);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      _gen_print (ctx, "p = %s;", cur);
+      break;
+    case GEN_LIST:
+      _gen_print (ctx, "%s.data = p;", lvalue);
+      _gen_print (ctx, "%s.len = %s - p;", lvalue, cur);
+      _gen_print (ctx, "result = %s_count (p, %s, &%s.count);", ctx->prefix,
+		  cur, lvalue);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      _gen_print (ctx, "p = %s;", cur);
+      break;
+    case GEN_NULL:
+      break;
+    case GEN_CALL:
+      _gen_c_name (type_name, e.base->name);
+      _gen_print (ctx, "result = %s_dec_%s (&p, %s, %s%s);", ctx->prefix,
+		  type_name, cur, top ? "" : "&", lvalue);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      break;
+    case GEN_SEQUENCE:
+    case GEN_CHOICE:
+      result = _gen_path (member, lvalue, top ? "->" : ".");
+      if (result != ASN1_SUCCESS)
+	return result;
+      /* the members of a named CHOICE are those of its structure */
+      order = ctx->order;
+      t = _gen_type (ctx, e.base);
+      if (t)
+	ctx->order = t->order;
+      result = _gen_dec_components (ctx, e.base, e.raw, e.n_raw, member, cur);
+      ctx->order = order;
+      if (result != ASN1_SUCCESS)
+	return result;
+      if (e.kind == GEN_SEQUENCE)
+	{
+	  _gen_print (ctx, "if (p != %s)", cur);
+	  _gen_print (ctx, "  return ASN1_DER_ERROR;");
+	}
+      break;
+    default:
+      break;
+    }
+
+  for (k = n - 1; k >= 0; k--)
+    {
+      /* the content octets must be used up */
+      if (k < n - 1 || (e.kind != GEN_BLOB && e.kind != GEN_SEQUENCE
+			 && e.kind != GEN_INT && e.kind != GEN_LIST))
+	{
+	  _gen_print (ctx, "if (p != %s)", inner[k]);
+	  _gen_print (ctx, "  return ASN1_DER_ERROR;");
+	}
+      ctx->indent--;
+      _gen_print (ctx, "}");
+    }
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode _gen_enc_value (gen_ctx * ctx, ASN1_TYPE node,
+				    const gen_tag * prefix, int n_prefix,
+				    const char *lvalue, int top);
+
+/* Write the encoding of the components of the SEQUENCE starting with
+   NODE, the last one first.  */
+static asn1_retCode
+_gen_enc_sequence (gen_ctx * ctx, ASN1_TYPE node, const char *member)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2], lvalue[GEN_MAX_PATH];
+  asn1_retCode result;
+  int optional;
+
+  if (node == NULL)
+    return ASN1_SUCCESS;
+
+  result = _gen_enc_sequence (ctx, NEXT_COMPONENT (node), member);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  _gen_c_name (name, node->name ? node->name : "unnamed");
+  result = _gen_path (lvalue, member, name);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  optional = (node->type & (CONST_OPTION | CONST_DEFAULT)) ? 1 : 0;
+  if (optional)
+    {
+      _gen_print (ctx, "if (%s_present)", lvalue);
+      ctx->indent++;
+      _gen_print (ctx, "{");
+      ctx->indent++;
+    }
+
+  result = _gen_enc_value (ctx, node, NULL, 0, lvalue, 0);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  if (optional)
+    {
+      ctx->indent--;
+      _gen_print (ctx, "}");
+      ctx->indent--;
+    }
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode
+_gen_enc_choice (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+		 int n_prefix, const char *member)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2], lvalue[GEN_MAX_PATH];
+  asn1_retCode result;
+  int position = 0;
+  ASN1_TYPE p;
+
+  _gen_print (ctx, "switch (%schoice)", member);
+  ctx->indent++;
+  _gen_print (ctx, "{");
+  for (p = FIRST_COMPONENT (node); p; p = NEXT_COMPONENT (p))
+    {
+      _gen_c_name (name, p->name ? p->name : "unnamed");
+      result = _gen_path (lvalue, member, name);
+      if (result != ASN1_SUCCESS)
+	return result;
+
+      _gen_print (ctx, "case %d:", ++position);
+      ctx->indent++;
+      result = _gen_enc_value (ctx, p, prefix, n_prefix, lvalue, 0);
+      if (result != ASN1_SUCCESS)
+	return result;
+      _gen_print (ctx, "break;");
+      ctx->indent--;
+    }
+  _gen_print (ctx, "default:");
+  _gen_print (ctx, "  return ASN1_VALUE_NOT_FOUND;");
+  _gen_print (ctx, "}");
+  ctx->indent--;
+
+  return ASN1_SUCCESS;
+}
+
+/******************************************************************/
+/* Function : _gen_enc_value                                      */
+/* Description: writes the encoding of LVALUE as NODE.  The       */
+/*   generated code writes backwards with the writer 'w'.         */
+/******************************************************************/
+static asn1_retCode
+_gen_enc_value (gen_ctx * ctx, ASN1_TYPE node, const gen_tag * prefix,
+		int n_prefix, const char *lvalue, int top)
+{
+  gen_elem e, item;
+  gen_type *t;
+  char type_name[ASN1_MAX_NAME_SIZE + 2], member[GEN_MAX_PATH];
+  int mark[GEN_MAX_TAGS];
+  asn1_retCode result;
+  int n, k, order, i, raw;
+
+  _gen_element (ctx, node, prefix, n_prefix, top, &e);
+  n = e.n_tags - e.header;
+
+  for (k = 0; k < n; k++)
+    {
+      mark[k] = ++ctx->counter;
+      _gen_print (ctx, "{");
+      ctx->indent++;
+      _gen_print (ctx, "int mark%d = w->pos;", mark[k]);
+    }
+
+  switch (e.kind)
+    {
+    case GEN_BLOB:
+    case GEN_TLV:
+      _gen_print (ctx, "%s_put (w, %s.data, %s.len);", ctx->prefix, lvalue,
+		  lvalue);
+      break;
+    case GEN_BOOL:
+      _gen_print (ctx, "%s_put_byte (w, %s ? 0xff : 0x00);", ctx->prefix,
+		  lvalue);
+      break;
+    case GEN_INT:
+      _gen_print (ctx, "%s_put_int (w, %s);", ctx->prefix, lvalue);
+      break;
+    case GEN_LIST:
+      /* the elements are written from the last one */
+      raw = _gen_item (ctx, e.base, &item);
+      i = ++ctx->counter;
+      if (strlen (lvalue) + 32 >= GEN_MAX_PATH)
+	return ASN1_MEM_ERROR;
+      sprintf (member, "%s.items[i%d]", lvalue, i);
+      _gen_print (ctx, "if (%s.items)", lvalue);
+      ctx->indent++;
+      _gen_print (ctx, "{");
+      ctx->indent++;
+      _gen_print (ctx, "int i%d;", i);
+      fputc ('\n', ctx->file);
+      _gen_print (ctx, "for (i%d = %s.count - 1; i%d >= 0; i%d--)", i, lvalue,
+		  i, i);
+      ctx->indent++;
+      _gen_print (ctx, "{");
+      ctx->indent++;
+      if (raw)
+	_gen_print (ctx, "%s_put (w, %s.data, %s.len);", ctx->prefix, member,
+		    member);
+      else
+	{
+	  result = _gen_enc_value (ctx, FIRST_COMPONENT (e.base), NULL, 0,
+				   member, 0);
+	  if (result != ASN1_SUCCESS)
+	    return result;
+	}
+      ctx->indent--;
+      _gen_print (ctx, "}");
+      ctx->indent--;
+      ctx->indent--;
+      _gen_print (ctx, "}");
+      ctx->indent--;
+      _gen_print (ctx, "else");
+      _gen_print (ctx, "  %s_put (w, %s.data, %s.len);", ctx->prefix, lvalue,
+		  lvalue);
+      break;
+    case GEN_NULL:
+      break;
+    case GEN_CALL:
+      _gen_c_name (type_name, e.base->name);
+      _gen_print (ctx, "result = %s_enc_%s (%s%s, w);", ctx->prefix,
+		  type_name, top ? "" : "&", lvalue);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+      break;
+    case GEN_SEQUENCE:
+    case GEN_CHOICE:
+      result = _gen_path (member, lvalue, top ? "->" : ".");
+      if (result != ASN1_SUCCESS)
+	return result;
+      order = ctx->order;
+      t = _gen_type (ctx, e.base);
+      if (t)
+	ctx->order = t->order;
+      if (e.kind == GEN_SEQUENCE)
+	result = _gen_enc_sequence (ctx, FIRST_COMPONENT (e.base), member);
+      else
+	result = _gen_enc_choice (ctx, e.base, e.raw, e.n_raw, member);
+      ctx->order = order;
+      if (result != ASN1_SUCCESS)
+	return result;
+      break;
+    default:
+      break;
+    }
+
+  if (e.header)
+    _gen_print (ctx, "%s_put_tag (w, 0x%02x, %lu);", ctx->prefix,
+		e.tags[n].cls, e.tags[n].tag);
+
+  for (k = n - 1; k >= 0; k--)
+    {
+      _gen_print (ctx, "%s_put_tl (w, 0x%02x, %lu, mark%d - w->pos);",
+		  ctx->prefix, e.tags[k].cls, e.tags[k].tag, mark[k]);
+      ctx->indent--;
+      _gen_print (ctx, "}");
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/* Write the types and the helper functions used by every generated
+   type.  */
+static void
+_gen_helpers (gen_ctx * ctx)
+{
+  const char *P = ctx->prefix;
+  FILE *f = ctx->file;
+
+  fprintf (f, "typedef struct\n{\n"
+	   "  const unsigned char *data;\n"
+	   "  int len;\n"
+	   "} %s_blob;\n\n", P);
+  fprintf (f, "typedef struct\n{\n"
+	   "  unsigned char *buf;\n"
+	   "  int size;\n"
+	   "  int pos;\n"
+	   "} %s_writer;\n\n", P);
+  fprintf (f, "typedef struct\n{\n"
+	   "  const unsigned char *p;\n"
+	   "  const unsigned char *end;\n"
+	   "} %s_iter;\n\n", P);
+
+  fprintf (f, "int %s_get_tag (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag);\n", P);
+  fprintf (f, "int %s_get_tl (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag, "
+	   "const unsigned char **content_end);\n", P);
+  fprintf (f, "int %s_get_tlv (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\t%s_blob *tlv);\n", P, P);
+  fprintf (f, "int %s_get_int (const unsigned char *p, "
+	   "const unsigned char *end,\n"
+	   "\tint64_t *value);\n", P);
+  fprintf (f, "int %s_count (const unsigned char *p, "
+	   "const unsigned char *end, int *count);\n", P);
+  fprintf (f, "void %s_iter_init (%s_iter *it, const unsigned char *data, "
+	   "int len);\n", P, P);
+  fprintf (f, "int %s_peek (const unsigned char *p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag);\n", P);
+  fprintf (f, "void %s_put (%s_writer *w, const unsigned char *data, "
+	   "int len);\n", P, P);
+  fprintf (f, "void %s_put_byte (%s_writer *w, unsigned char c);\n", P, P);
+  fprintf (f, "void %s_put_int (%s_writer *w, int64_t value);\n", P, P);
+  fprintf (f, "void %s_put_tag (%s_writer *w, unsigned char cls, "
+	   "unsigned long tag);\n", P, P);
+  fprintf (f, "void %s_put_tl (%s_writer *w, unsigned char cls, "
+	   "unsigned long tag,\n\tint len);\n", P, P);
+  fprintf (f, "int %s_finish (%s_writer *w, int *der_len);\n\n", P, P);
+
+  fprintf (f, "int\n%s_get_tag (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag)\n{\n"
+	   "  unsigned char c;\n"
+	   "  unsigned long t;\n"
+	   "  int tag_len;\n\n"
+	   "  if (asn1_get_tag_der (*p, end - *p, &c, &tag_len, &t) "
+	   "!= ASN1_SUCCESS)\n"
+	   "    return ASN1_DER_ERROR;\n"
+	   "  if (c != cls || t != tag)\n"
+	   "    return ASN1_TAG_ERROR;\n"
+	   "  *p += tag_len;\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P);
+
+  fprintf (f, "int\n%s_get_tl (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag, "
+	   "const unsigned char **content_end)\n{\n"
+	   "  int result, len_len;\n"
+	   "  long len;\n\n"
+	   "  result = %s_get_tag (p, end, cls, tag);\n"
+	   "  if (result != ASN1_SUCCESS)\n"
+	   "    return result;\n"
+	   "  len = asn1_get_length_der (*p, end - *p, &len_len);\n"
+	   "  if (len < 0 || len_len == 0 || len > end - *p - len_len)\n"
+	   "    return ASN1_DER_ERROR;\n"
+	   "  *p += len_len;\n"
+	   "  *content_end = *p + len;\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P, P);
+
+  fprintf (f, "int\n%s_get_tlv (const unsigned char **p, "
+	   "const unsigned char *end,\n"
+	   "\t%s_blob *tlv)\n{\n"
+	   "  unsigned char c;\n"
+	   "  unsigned long t;\n"
+	   "  int tag_len, len_len;\n"
+	   "  long len;\n\n"
+	   "  if (asn1_get_tag_der (*p, end - *p, &c, &tag_len, &t) "
+	   "!= ASN1_SUCCESS)\n"
+	   "    return ASN1_DER_ERROR;\n"
+	   "  len = asn1_get_length_der (*p + tag_len, end - *p - tag_len, "
+	   "&len_len);\n"
+	   "  if (len < 0 || len_len == 0 "
+	   "|| len > end - *p - tag_len - len_len)\n"
+	   "    return ASN1_DER_ERROR;\n"
+	   "  tlv->data = *p;\n"
+	   "  tlv->len = tag_len + len_len + len;\n"
+	   "  *p += tlv->len;\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P, P);
+
+  fprintf (f, "int\n%s_get_int (const unsigned char *p, "
+	   "const unsigned char *end,\n"
+	   "\tint64_t *value)\n{\n"
+	   "  uint64_t v;\n\n"
+	   "  if (p >= end)\n"
+	   "    return ASN1_DER_ERROR;\n"
+	   "  if (end - p > 8)\n"
+	   "    return ASN1_DER_OVERFLOW;\n"
+	   "  v = (*p & 0x80) ? ~(uint64_t) 0 : 0;\n"
+	   "  for (; p < end; p++)\n"
+	   "    v = (v << 8) | *p;\n"
+	   "  *value = (int64_t) v;\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P);
+
+  fprintf (f, "int\n%s_count (const unsigned char *p, "
+	   "const unsigned char *end, int *count)\n{\n"
+	   "  %s_blob tlv;\n"
+	   "  int result;\n\n"
+	   "  for (*count = 0; p < end; (*count)++)\n"
+	   "    {\n"
+	   "      result = %s_get_tlv (&p, end, &tlv);\n"
+	   "      if (result != ASN1_SUCCESS)\n"
+	   "\treturn result;\n"
+	   "    }\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P, P, P);
+
+  fprintf (f, "void\n%s_iter_init (%s_iter *it, const unsigned char *data, "
+	   "int len)\n{\n"
+	   "  it->p = data;\n"
+	   "  it->end = data + len;\n}\n\n", P, P);
+
+  fprintf (f, "int\n%s_peek (const unsigned char *p, "
+	   "const unsigned char *end,\n"
+	   "\tunsigned char cls, unsigned long tag)\n{\n"
+	   "  unsigned char c;\n"
+	   "  unsigned long t;\n"
+	   "  int len;\n\n"
+	   "  if (asn1_get_tag_der (p, end - p, &c, &len, &t) "
+	   "!= ASN1_SUCCESS)\n"
+	   "    return 0;\n"
+	   "  return c == cls && t == tag;\n}\n\n", P);
+
+  fprintf (f, "void\n%s_put (%s_writer *w, const unsigned char *data, "
+	   "int len)\n{\n"
+	   "  w->pos -= len;\n"
+	   "  if (w->pos >= 0 && len > 0)\n"
+	   "    memcpy (w->buf + w->pos, data, len);\n}\n\n", P, P);
+
+  fprintf (f, "void\n%s_put_byte (%s_writer *w, unsigned char c)\n{\n"
+	   "  %s_put (w, &c, 1);\n}\n\n", P, P, P);
+
+  fprintf (f, "void\n%s_put_int (%s_writer *w, int64_t value)\n{\n"
+	   "  unsigned char tmp[8];\n"
+	   "  int k = sizeof (tmp);\n\n"
+	   "  do\n"
+	   "    {\n"
+	   "      tmp[--k] = value & 0xff;\n"
+	   "      value = (value < 0) ? ~(~value >> 8) : value >> 8;\n"
+	   "    }\n"
+	   "  while (k > 0 && value != ((tmp[k] & 0x80) ? -1 : 0));\n"
+	   "  %s_put (w, tmp + k, sizeof (tmp) - k);\n}\n\n", P, P, P);
+
+  fprintf (f, "void\n%s_put_tag (%s_writer *w, unsigned char cls, "
+	   "unsigned long tag)\n{\n"
+	   "  unsigned char tmp[16];\n"
+	   "  int k;\n\n"
+	   "  if (tag < 31)\n"
+	   "    {\n"
+	   "      %s_put_byte (w, cls | tag);\n"
+	   "      return;\n"
+	   "    }\n"
+	   "  k = sizeof (tmp);\n"
+	   "  tmp[--k] = tag & 0x7f;\n"
+	   "  for (tag >>= 7; tag; tag >>= 7)\n"
+	   "    tmp[--k] = 0x80 | (tag & 0x7f);\n"
+	   "  tmp[--k] = cls | 0x1f;\n"
+	   "  %s_put (w, tmp + k, sizeof (tmp) - k);\n}\n\n", P, P, P, P);
+
+  fprintf (f, "void\n%s_put_tl (%s_writer *w, unsigned char cls, "
+	   "unsigned long tag,\n\tint len)\n{\n"
+	   "  unsigned char tmp[32];\n"
+	   "  int k;\n\n"
+	   "  asn1_length_der (len, tmp, &k);\n"
+	   "  %s_put (w, tmp, k);\n"
+	   "  %s_put_tag (w, cls, tag);\n}\n\n", P, P, P, P);
+
+  fprintf (f, "int\n%s_finish (%s_writer *w, int *der_len)\n{\n"
+	   "  *der_len = w->size - w->pos;\n"
+	   "  if (w->pos < 0)\n"
+	   "    return ASN1_MEM_ERROR;\n"
+	   "  if (w->pos > 0)\n"
+	   "    memmove (w->buf, w->buf + w->pos, *der_len);\n"
+	   "  return ASN1_SUCCESS;\n}\n\n", P, P);
+}
+
+/* Write the functions that decode and encode the content octets of
+   the named type T, used by the types that contain it.  */
+static asn1_retCode
+_gen_content_functions (gen_ctx * ctx, gen_type * t, const char *name,
+			int choice)
+{
+  FILE *f = ctx->file;
+  asn1_retCode result;
+
+  /* Decoding of the content */
+  fprintf (f, "static int\n%s_dec_%s (const unsigned char **pp, "
+	   "const unsigned char *end,\n\tstruct %s_%s *out)\n{\n",
+	   ctx->prefix, name, ctx->prefix, name);
+  fprintf (f, "  const unsigned char *p = *pp;\n"
+	   "  int result = ASN1_SUCCESS;\n\n");
+  ctx->counter = 0;
+  result = _gen_dec_components (ctx, t->node, NULL, 0, "out->", "end");
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (!choice)
+    fprintf (f, "  if (p != end)\n    return ASN1_DER_ERROR;\n");
+  fprintf (f, "  *pp = p;\n  return result;\n}\n\n");
+
+  /* Encoding of the content */
+  fprintf (f, "static int\n%s_enc_%s (const struct %s_%s *in, "
+	   "%s_writer *w)\n{\n"
+	   "  int result = ASN1_SUCCESS;\n\n", ctx->prefix, name,
+	   ctx->prefix, name, ctx->prefix);
+  ctx->counter = 0;
+  if (choice)
+    result = _gen_enc_choice (ctx, t->node, NULL, 0, "in->");
+  else
+    result = _gen_enc_sequence (ctx, FIRST_COMPONENT (t->node), "in->");
+  if (result != ASN1_SUCCESS)
+    return result;
+  fprintf (f, "  return result;\n}\n\n");
+
+  return ASN1_SUCCESS;
+}
+
+/* Write the decoding and the encoding functions of the named type
+   T.  */
+static asn1_retCode
+_gen_functions (gen_ctx * ctx, gen_type * t)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2];
+  FILE *f = ctx->file;
+  asn1_retCode result;
+  gen_elem e;
+  int choice;
+
+  _gen_c_name (name, t->node->name);
+  choice = (type_field (t->node->type) == TYPE_CHOICE);
+  ctx->order = t->order;
+  ctx->indent = 1;
+
+  /* A tagged CHOICE is always coded together with its tags, it has no
+     functions for the content alone.  */
+  _gen_element (ctx, t->node, NULL, 0, 1, &e);
+  if (e.kind == GEN_CALL)
+    {
+      result = _gen_content_functions (ctx, t, name, choice);
+      if (result != ASN1_SUCCESS)
+	return result;
+    }
+
+  /* Decoding */
+  fprintf (f, "int\n%s_decode_%s (const unsigned char *der, int der_len,\n"
+	   "\tstruct %s_%s *out)\n{\n", ctx->prefix, name, ctx->prefix,
+	   name);
+  fprintf (f, "  const unsigned char *p = der;\n"
+	   "  const unsigned char *end = der + der_len;\n"
+	   "  int result = ASN1_SUCCESS;\n\n"
+	   "  memset (out, 0, sizeof (*out));\n");
+  ctx->counter = 0;
+  result = _gen_dec_value (ctx, t->node, NULL, 0, "out", "end", 1);
+  if (result != ASN1_SUCCESS)
+    return result;
+  fprintf (f, "  if (p != end)\n    return ASN1_DER_ERROR;\n"
+	   "  return result;\n}\n\n");
+
+  /* Encoding */
+  fprintf (f, "int\n%s_encode_%s (const struct %s_%s *in, "
+	   "unsigned char *der,\n\tint *der_len)\n{\n", ctx->prefix, name,
+	   ctx->prefix, name);
+  fprintf (f, "  %s_writer writer, *w = &writer;\n"
+	   "  int result = ASN1_SUCCESS;\n\n"
+	   "  w->buf = der;\n"
+	   "  w->size = der ? *der_len : 0;\n"
+	   "  w->pos = w->size;\n", ctx->prefix);
+  ctx->counter = 0;
+  result = _gen_enc_value (ctx, t->node, NULL, 0, "in", 1);
+  if (result != ASN1_SUCCESS)
+    return result;
+  fprintf (f, "  result = %s_finish (w, der_len);\n"
+	   "  return result;\n}\n\n", ctx->prefix);
+
+  return ASN1_SUCCESS;
+}
+
+/* Write the prototype or the function, following MODE, of the
+   iterator NAME over the elements of the SEQUENCE OF or SET OF
+   NODE.  */
+static asn1_retCode
+_gen_iterator (gen_ctx * ctx, ASN1_TYPE node, const char *name, int mode)
+{
+  char item_type[GEN_MAX_PATH];
+  FILE *f = ctx->file;
+  asn1_retCode result;
+  gen_elem e;
+  int raw;
+
+  raw = _gen_item (ctx, node, &e);
+  _gen_item_type (ctx, &e, raw, item_type);
+
+  if (mode == GEN_ITER_PROTOTYPES)
+    {
+      fprintf (f, "int %s_next_%s (%s_iter *it, %s *out);\n", ctx->prefix,
+	       name, ctx->prefix, item_type);
+      return ASN1_SUCCESS;
+    }
+
+  fprintf (f, "int\n%s_next_%s (%s_iter *it, %s *out)\n{\n", ctx->prefix,
+	   name, ctx->prefix, item_type);
+  fprintf (f, "  const unsigned char *p = it->p;\n"
+	   "  int result = ASN1_SUCCESS;\n\n"
+	   "  if (p >= it->end)\n"
+	   "    return ASN1_ELEMENT_NOT_FOUND;\n"
+	   "  memset (out, 0, sizeof (*out));\n");
+  ctx->counter = 0;
+  ctx->indent = 1;
+  if (raw)
+    {
+      _gen_print (ctx, "result = %s_get_tlv (&p, it->end, out);",
+		  ctx->prefix);
+      _gen_print (ctx, "if (result != ASN1_SUCCESS)");
+      _gen_print (ctx, "  return result;");
+    }
+  else
+    {
+      result = _gen_dec_value (ctx, FIRST_COMPONENT (node), NULL, 0, "(*out)",
+			       "it->end", 0);
+      if (result != ASN1_SUCCESS)
+	return result;
+    }
+  fprintf (f, "  it->p = p;\n  return result;\n}\n\n");
+
+  return ASN1_SUCCESS;
+}
+
+/******************************************************************/
+/* Function : _gen_iterators                                      */
+/* Description: for each SEQUENCE OF and SET OF member of the     */
+/*   structure of NODE, or of its inline structures, checks the   */
+/*   name of its iterator PREFIX_next_<PATH>_<member>, or writes  */
+/*   its prototype or its function, following MODE.  ASN1_PATH   */
+/*   is the path of NODE in the definitions.                      */
+/******************************************************************/
+static asn1_retCode
+_gen_iterators (gen_ctx * ctx, ASN1_TYPE node, const char *path,
+		const char *asn1_path, int mode)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2];
+  char sub[GEN_MAX_PATH], asn1_sub[GEN_MAX_PATH];
+  const char *asn1_name;
+  asn1_retCode result;
+  gen_elem e;
+  ASN1_TYPE p;
+
+  for (p = FIRST_COMPONENT (node); p; p = NEXT_COMPONENT (p))
+    {
+      _gen_element (ctx, p, NULL, 0, 0, &e);
+      if (e.kind != GEN_LIST
+	  && ((e.kind != GEN_SEQUENCE && e.kind != GEN_CHOICE)
+	      || _gen_type (ctx, e.base)))
+	continue;
+
+      asn1_name = p->name ? p->name : "unnamed";
+      _gen_c_name (name, asn1_name);
+      if (strlen (path) + strlen (name) + 1 >= GEN_MAX_PATH
+	  || strlen (asn1_path) + strlen (asn1_name) + 1 >= GEN_MAX_PATH)
+	return ASN1_MEM_ERROR;
+      sprintf (sub, "%s_%s", path, name);
+      sprintf (asn1_sub, "%s.%s", asn1_path, asn1_name);
+
+      if (e.kind != GEN_LIST)
+	result = _gen_iterators (ctx, e.base, sub, asn1_sub, mode);
+      else if (mode == GEN_ITER_NAMES)
+	result = _gen_add_name (ctx, sub, asn1_sub);
+      else
+	result = _gen_iterator (ctx, e.base, sub, mode);
+      if (result != ASN1_SUCCESS)
+	return result;
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/* Check that PREFIX is a C identifier and that the generated names do
+   not collide: those of the types, of the iterators and of the members
+   of each structure.  */
+static asn1_retCode
+_gen_check_names (gen_ctx * ctx)
+{
+  char name[ASN1_MAX_NAME_SIZE + 2];
+  asn1_retCode result = ASN1_SUCCESS;
+  const char *c;
+  int k;
+
+  if (strlen (ctx->prefix) > ASN1_MAX_NAME_SIZE)
+    {
+      if (ctx->error)
+	_asn1_str_cpy (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+		       "the prefix is too long");
+      return ASN1_NAME_TOO_LONG;
+    }
+  for (c = ctx->prefix; *c; c++)
+    if (!isalnum ((unsigned char) *c) && *c != '_')
+      break;
+  if (*c || ctx->prefix[0] == 0 || isdigit ((unsigned char) ctx->prefix[0]))
+    {
+      if (ctx->error)
+	{
+	  _asn1_str_cpy (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			 "the prefix '");
+	  _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			 ctx->prefix);
+	  _asn1_str_cat (ctx->error, ASN1_MAX_ERROR_DESCRIPTION_SIZE,
+			 "' is not a C identifier");
+	}
+      return ASN1_VALUE_NOT_VALID;
+    }
+
+  for (k = 0; k < ctx->n_types && result == ASN1_SUCCESS; k++)
+    {
+      _gen_c_name (name, ctx->types[k].node->name);
+      result = _gen_add_name (ctx, name, ctx->types[k].node->name);
+    }
+  _gen_drop_names (ctx, 0);
+
+  for (k = 0; k < ctx->n_types && result == ASN1_SUCCESS; k++)
+    {
+      ctx->order = ctx->types[k].order;
+      _gen_c_name (name, ctx->types[k].node->name);
+      result = _gen_iterators (ctx, ctx->types[k].node, name,
+			       ctx->types[k].node->name, GEN_ITER_NAMES);
+    }
+  _gen_drop_names (ctx, 0);
+
+  for (k = 0; k < ctx->n_types && result == ASN1_SUCCESS; k++)
+    {
+      ctx->order = ctx->types[k].order;
+      result = _gen_check_members (ctx, ctx->types[k].node);
+    }
+
+  _asn1_free (ctx->names);
+  ctx->names = NULL;
+  ctx->size_names = 0;
+
+  return result;
+}
+
+/******************************************************************/
+/* Function : _asn1_create_static_code                            */
+/* Description: creates a C file with a structure for each        */
+/*   SEQUENCE and CHOICE type of DEFINITIONS, plus the functions  */
+/*   PREFIX_decode_<type> and PREFIX_encode_<type> that convert   */
+/*   between the structures and DER without an ASN1 tree.         */
+/* Parameters:                                                    */
+/*   definitions: the tree returned by asn1_parser2tree.          */
+/*   output_file_name: name of the C file to create.              */
+/*   prefix: prefix of every generated identifier.                */
+/*   error_desc: set to the error description, or NULL.           */
+/* Return: ASN1_SUCCESS, ASN1_FILE_NOT_FOUND if the file cannot   */
+/*   be created, ASN1_MEM_ERROR if an element name is too long,   */
+/*   ASN1_VALUE_NOT_VALID if two names are the same in C or the   */
+/*   prefix is not a C identifier.                                */
+/******************************************************************/
+static asn1_retCode
+_asn1_create_static_code (ASN1_TYPE definitions,
+			  const char *output_file_name, const char *prefix,
+			  char *error_desc)
+{
+  gen_ctx ctx;
+  ASN1_TYPE p;
+  char name[ASN1_MAX_NAME_SIZE + 2];
+  asn1_retCode result = ASN1_SUCCESS;
+  int k, order, m;
+
+  if (definitions == NULL
+      || type_field (definitions->type) != TYPE_DEFINITIONS)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  memset (&ctx, 0, sizeof (ctx));
+  ctx.root = definitions;
+  ctx.prefix = prefix;
+  ctx.error = error_desc;
+
+  for (p = definitions->down; p; p = p->right)
+    ctx.n_types++;
+  ctx.types = _asn1_calloc (ctx.n_types + 1, sizeof (gen_type));
+  if (ctx.types == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
+
+  ctx.n_types = 0;
+  for (p = definitions->down; p; p = p->right)
+    if (p->name && !(p->type & CONST_ASSIGN)
+	&& (type_field (p->type) == TYPE_SEQUENCE
+	    || type_field (p->type) == TYPE_CHOICE))
+      {
+	ctx.types[ctx.n_types].node = p;
+	ctx.types[ctx.n_types].order = -1;
+	ctx.n_types++;
+      }
+
+  for (k = 0; k < ctx.n_types; k++)
+    if (ctx.types[k].order < 0)
+      _gen_order_type (&ctx, &ctx.types[k]);
+
+  result = _gen_check_names (&ctx);
+  if (result != ASN1_SUCCESS)
+    {
+      _asn1_free (ctx.types);
+      return result;
+    }
+
+  ctx.file = fopen (output_file_name, "w");
+  if (ctx.file == NULL)
+    {
+      _asn1_free (ctx.types);
+      return ASN1_FILE_NOT_FOUND;
+    }
+
+  fprintf (ctx.file, "/* Generated from the ASN.1 module %s.\n"
+	   "   Each SEQUENCE and CHOICE type has a structure, "
+	   "a %s_decode_<type>\n"
+	   "   and a %s_encode_<type> function.  BOOLEAN elements are "
+	   "int, INTEGER\n"
+	   "   and ENUMERATED ones int64_t: larger values fail with "
+	   "ASN1_DER_OVERFLOW.\n"
+	   "   Strings, OBJECT IDENTIFIER, time and SET elements point to "
+	   "their\n"
+	   "   content octets inside the decoded buffer, ANY elements to "
+	   "their\n"
+	   "   complete encoding.  SEQUENCE OF and SET OF elements point to "
+	   "their\n"
+	   "   content octets and have the number of elements, that "
+	   "%s_iter_init\n"
+	   "   and %s_next_<type>_<element> decode one at a time; they are "
+	   "encoded\n"
+	   "   from the items array instead if it is set, in the order of "
+	   "DER for a\n"
+	   "   SET OF.  Inline structures, lists and NULL inside a list are "
+	   "kept as\n"
+	   "   complete encodings.  OPTIONAL and DEFAULT elements have a "
+	   "_present\n"
+	   "   flag, a DEFAULT value must be left out by the caller to "
+	   "obtain DER.  */\n\n",
+	   definitions->name, prefix, prefix, prefix, prefix);
+
+  fprintf (ctx.file, "#if HAVE_CONFIG_H\n");
+  fprintf (ctx.file, "# include \"config.h\"\n");
+  fprintf (ctx.file, "#endif\n\n");
+  fprintf (ctx.file, "#include <string.h>\n");
+  fprintf (ctx.file, "#include <libtasn1.h>\n\n");
+
+  _gen_helpers (&ctx);
+
+  /* Structures, in dependency order */
+  for (order = 0; order < ctx.n_types; order++)
+    for (k = 0; k < ctx.n_types; k++)
+      if (ctx.types[k].order == order)
+	{
+	  ctx.order = order;
+	  _gen_c_name (name, ctx.types[k].node->name);
+	  fprintf (ctx.file, "struct %s_%s\n{\n", prefix, name);
+	  ctx.indent = 1;
+	  m = _gen_members (&ctx, ctx.types[k].node);
+	  if (m == 0)
+	    _gen_print (&ctx, "int unused;");
+	  fprintf (ctx.file, "};\n\n");
+	}
+
+  for (k = 0; k < ctx.n_types; k++)
+    {
+      _gen_c_name (name, ctx.types[k].node->name);
+      fprintf (ctx.file, "int %s_decode_%s (const unsigned char *der, "
+	       "int der_len,\n\tstruct %s_%s *out);\n", prefix, name,
+	       prefix, name);
+      fprintf (ctx.file, "int %s_encode_%s (const struct %s_%s *in, "
+	       "unsigned char *der,\n\tint *der_len);\n", prefix, name,
+	       prefix, name);
+      ctx.order = ctx.types[k].order;
+      result = _gen_iterators (&ctx, ctx.types[k].node, name,
+			       ctx.types[k].node->name, GEN_ITER_PROTOTYPES);
+      if (result != ASN1_SUCCESS)
+	break;
+    }
+  fprintf (ctx.file, "\n");
+
+  for (order = 0; order < ctx.n_types && result == ASN1_SUCCESS; order++)
+    for (k = 0; k < ctx.n_types; k++)
+      if (ctx.types[k].order == order)
+	{
+	  result = _gen_functions (&ctx, &ctx.types[k]);
+	  if (result == ASN1_SUCCESS)
+	    {
+	      ctx.order = order;
+	      _gen_c_name (name, ctx.types[k].node->name);
+	      result = _gen_iterators (&ctx, ctx.types[k].node, name,
+				       ctx.types[k].node->name,
+				       GEN_ITER_FUNCTIONS);
+	    }
+	  break;
+	}
+
+  fclose (ctx.file);
+  _asn1_free (ctx.types);
+
+  return result;
+}
+
+/**
+ * asn1_parser2code:
+ * @inputFileName: specify the path and the name of file that
+ *   contains ASN.1 declarations.
+ * @outputFileName: specify the path and the name of file that will
+ *   contain the generated C code.
+ * @prefix: specify the prefix of the generated C identifiers.
+ * @errorDescription : return the error description or an empty
+ *   string if success.
+ *
+ * Function that generates C structures and specialized DER coding
+ * functions from an ASN1 file.  For every SEQUENCE and CHOICE type
+ * "Type" in @inputFileName the created file contains a "struct
+ * prefix_Type" and the functions prefix_decode_Type() and
+ * prefix_encode_Type(), which work directly on DER without creating
+ * an ASN1 structure.  If @inputFileName is "/aa/bb/xx.yy" and
+ * @outputFileName is %NULL, the file created is
+ * "/aa/bb/xx_asn1_code.c".  If @prefix is %NULL the prefix will be
+ * "xx", which must then be a C identifier.
+ *
+ * INTEGER and ENUMERATED elements are int64_t members, and the
+ * decoding of values that do not fit fails with %ASN1_DER_OVERFLOW.
+ * SEQUENCE OF and SET OF elements have their content octets and their
+ * number of elements, the function prefix_next_Type_element() decodes
+ * them one at a time, and an array of elements can be given to the
+ * encoding instead.  Identifiers that are the same once converted to
+ * C, as "a-b" and "a_b", are not accepted.
+ *
+ * Returns: %ASN1_SUCCESS if the file has a correct syntax and every
+ *   identifier is known, %ASN1_FILE_NOT_FOUND if an error occured
+ *   while opening @inputFileName or creating the output file,
+ *   %ASN1_SYNTAX_ERROR if the syntax is not correct,
+ *   %ASN1_IDENTIFIER_NOT_FOUND if in the file there is an identifier
+ *   that is not defined, %ASN1_NAME_TOO_LONG if in the file there is
+ *   an identifier whith more than %ASN1_MAX_NAME_SIZE characters,
+ *   %ASN1_VALUE_NOT_VALID if two identifiers give the same C name or
+ *   the prefix is not a C identifier, with @errorDescription telling
+ *   which.
+ **/
+asn1_retCode
+asn1_parser2code (const char *inputFileName, const char *outputFileName,
+		  const char *prefix, char *errorDescription)
+{
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+  char *file_out_name = NULL;
+  char *prefix_name = NULL;
+  const char *char_p, *slash_p, *dot_p;
+  asn1_retCode result;
+  int k;
+
+  result = asn1_parser2tree (inputFileName, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  /* searching the last '/' and '.' in inputFileName */
+  char_p = inputFileName;
+  slash_p = inputFileName;
+  while ((char_p = strchr (char_p, '/')))
+    {
+      char_p++;
+      slash_p = char_p;
+    }
+
+  char_p = slash_p;
+  dot_p = inputFileName + strlen (inputFileName);
+
+  while ((char_p = strchr (char_p, '.')))
+    {
+      dot_p = char_p;
+      char_p++;
+    }
+
+  if (outputFileName == NULL)
+    {
+      /* file_out_name = inputFileName + _asn1_code.c */
+      file_out_name = _asn1_malloc (dot_p - inputFileName + 1 +
+				    strlen ("_asn1_code.c"));
+      if (file_out_name)
+	{
+	  memcpy (file_out_name, inputFileName, dot_p - inputFileName);
+	  file_out_name[dot_p - inputFileName] = 0;
+	  strcat (file_out_name, "_asn1_code.c");
+	}
+    }
+  else
+    file_out_name = _asn1_strdup (outputFileName);
+
+  if (prefix == NULL)
+    {
+      /* prefix_name = file name, as a C identifier */
+      prefix_name = _asn1_malloc (dot_p - slash_p + 1);
+      if (prefix_name)
+	{
+	  for (k = 0; k < dot_p - slash_p; k++)
+	    prefix_name[k] = isalnum ((unsigned char) slash_p[k]) ?
+	      slash_p[k] : '_';
+	  prefix_name[k] = 0;
+	}
+    }
+  else
+    prefix_name = _asn1_strdup (prefix);
+
+  if (file_out_name == NULL || prefix_name == NULL)
+    result = ASN1_MEM_ALLOC_ERROR;
+  else
+    result = _asn1_create_static_code (definitions, file_out_name,
+				       prefix_name, errorDescription);
+
+  _asn1_free (file_out_name);
+  _asn1_free (prefix_name);
+  asn1_delete_structure (&definitions);
+
+  return result;
+}
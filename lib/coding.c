@@ -28,10 +28,12 @@
 /*****************************************************/
 
 #include <int.h>
+#include <limits.h>
 #include "parser_aux.h"
 #include <gstr.h>
 #include "element.h"
 #include <structure.h>
+#include "coding.h"
 
 #define MAX_TAG_LEN 16
 
@@ -235,89 +237,180 @@ _asn1_get_utctime_der(unsigned char *der,int *der_len,unsigned char *str)
 }
 */
 
-/******************************************************/
-/* Function : _asn1_objectid_der                      */
-/* Description: creates the DER coding for an         */
-/* OBJECT IDENTIFIER  type (length included).         */
-/* Parameters:                                        */
-/*   str: OBJECT IDENTIFIER null-terminated string.   */
-/*   der: string returned.                            */
-/*   der_len: number of meaningful bytes of DER       */
-/*            (der[0]..der[ans_len-1]). Initially it  */
-/*            must store the length of DER.           */
-/* Return:                                            */
-/*   ASN1_MEM_ERROR when DER isn't big enough         */
-/*   ASN1_SUCCESS otherwise                           */
-/******************************************************/
-static asn1_retCode
-_asn1_objectid_der (unsigned char *str, unsigned char *der, int *der_len)
+/**
+ * asn1_oid_der:
+ * @oid: OBJECT IDENTIFIER in dotted decimal form, e.g. "1.2.840.113549".
+ * @der: buffer to hold the content octets.
+ * @der_len: initially the size of @der, on return the number of
+ *   content octets of @oid.
+ *
+ * Converts an OBJECT IDENTIFIER to the content octets of its DER
+ * encoding, i.e. without tag and length.  The conversion is done in
+ * place and needs no temporary allocation.  With a @der_len of zero
+ * only the needed size is computed.
+ *
+ * Returns: %ASN1_SUCCESS on success, %ASN1_VALUE_NOT_VALID if @oid is
+ *   not a valid OBJECT IDENTIFIER, or %ASN1_MEM_ERROR if @der is too
+ *   small; in that case @der_len holds the needed size.
+ **/
+asn1_retCode
+asn1_oid_der (const char *oid, unsigned char *der, int *der_len)
 {
-  int len_len, counter, k, first, max_len;
-  char *temp, *n_end, *n_start;
-  unsigned char bit7;
+  const char *p = oid;
   unsigned long val, val1 = 0;
-  int str_len = strlen(str);
+  int max_len, counter, k, n;
 
   max_len = *der_len;
+  *der_len = 0;
 
-  temp = _asn1_malloc (str_len + 2);
-  if (temp == NULL)
-    return ASN1_MEM_ALLOC_ERROR;
-
-  memcpy (temp, str, str_len);
-  temp[str_len] = '.';
-  temp[str_len+1] = 0;
-
-  counter = 0;
-  n_start = temp;
-  while ((n_end = strchr (n_start, '.')))
+  for (counter = 1;; counter++)
     {
-      *n_end = 0;
-      val = strtoul (n_start, NULL, 10);
-      counter++;
+      if (!isdigit ((unsigned char) *p))
+	return ASN1_VALUE_NOT_VALID;
+      for (val = 0; isdigit ((unsigned char) *p); p++)
+	{
+	  if (val > (ULONG_MAX - (*p - '0')) / 10)
+	    return ASN1_VALUE_NOT_VALID;
+	  val = val * 10 + (*p - '0');
+	}
 
       if (counter == 1)
-	val1 = val;
-      else if (counter == 2)
 	{
-	  if (max_len > 0)
-	    der[0] = 40 * val1 + val;
-	  *der_len = 1;
+	  if (val > 2)
+	    return ASN1_VALUE_NOT_VALID;
+	  val1 = val;
 	}
       else
 	{
-	  first = 0;
-	  for (k = 4; k >= 0; k--)
+	  /* the first two arcs share one subidentifier */
+	  if (counter == 2)
 	    {
-	      bit7 = (val >> (k * 7)) & 0x7F;
-	      if (bit7 || first || !k)
-		{
-		  if (k)
-		    bit7 |= 0x80;
-		  if (max_len > (*der_len))
-		    der[*der_len] = bit7;
-		  (*der_len)++;
-		  first = 1;
-		}
+	      if ((val1 < 2 && val > 39) || val > ULONG_MAX - 80)
+		return ASN1_VALUE_NOT_VALID;
+	      val += 40 * val1;
 	    }
 
+	  /* base 128, most significant group first */
+	  for (n = 1; n < (int) ((sizeof (val) * 8 + 6) / 7)
+	       && (val >> (7 * n)); n++)
+	    ;
+	  for (k = n - 1; k >= 0; k--)
+	    {
+	      if (*der_len < max_len)
+		der[*der_len] = ((val >> (7 * k)) & 0x7F) | (k ? 0x80 : 0);
+	      (*der_len)++;
+	    }
 	}
-      n_start = n_end + 1;
+
+      if (*p != '.')
+	break;
+      p++;
     }
 
-  asn1_length_der (*der_len, NULL, &len_len);
-  if (max_len >= (*der_len + len_len))
+  if (*p != 0 || counter < 2)
+    return ASN1_VALUE_NOT_VALID;
+
+  if (max_len < *der_len)
+    return ASN1_MEM_ERROR;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_oid_der_cmp:
+ * @oid1: content octets of the first OBJECT IDENTIFIER.
+ * @oid1_len: number of octets in @oid1.
+ * @oid2: content octets of the second OBJECT IDENTIFIER.
+ * @oid2_len: number of octets in @oid2.
+ *
+ * Compares two OBJECT IDENTIFIERs given as the content octets of their
+ * DER encoding, as returned by asn1_oid_der() or asn1_read_oid_der().
+ * The arcs are compared in order without converting them to numbers:
+ * in DER a subidentifier has no leading 0x80 octets, so a longer one
+ * is the larger one and subidentifiers of the same length compare like
+ * their octets.  An OBJECT IDENTIFIER sorts before the ones it is a
+ * prefix of.
+ *
+ * Returns: a negative value, zero or a positive value if @oid1 is
+ *   less than, equal to or greater than @oid2.
+ **/
+int
+asn1_oid_der_cmp (const unsigned char *oid1, int oid1_len,
+		  const unsigned char *oid2, int oid2_len)
+{
+  int i, j, end1, end2, result;
+
+  if (oid1_len == oid2_len && !memcmp (oid1, oid2, oid1_len))
+    return 0;
+
+  i = j = 0;
+  while (i < oid1_len && j < oid2_len)
     {
-      memmove (der + len_len, der, *der_len);
-      asn1_length_der (*der_len, der, &len_len);
+      end1 = i;
+      while (end1 < oid1_len && (oid1[end1++] & 0x80))
+	;
+      end2 = j;
+      while (end2 < oid2_len && (oid2[end2++] & 0x80))
+	;
+
+      if (end1 - i != end2 - j)
+	return (end1 - i < end2 - j) ? -1 : 1;
+
+      result = memcmp (oid1 + i, oid2 + j, end1 - i);
+      if (result)
+	return (result < 0) ? -1 : 1;
+
+      i = end1;
+      j = end2;
     }
-  *der_len += len_len;
 
-  _asn1_free (temp);
+  if (i < oid1_len)
+    return 1;
+  if (j < oid2_len)
+    return -1;
 
-  if (max_len < (*der_len))
+  return 0;
+}
+
+/******************************************************/
+/* Function : _asn1_objectid_der                      */
+/* Description: creates the DER coding for an         */
+/* OBJECT IDENTIFIER  type (length included).         */
+/* Parameters:                                        */
+/*   str: OBJECT IDENTIFIER null-terminated string.   */
+/*   der: string returned.                            */
+/*   der_len: number of meaningful bytes of DER       */
+/*            (der[0]..der[ans_len-1]). Initially it  */
+/*            must store the length of DER.           */
+/* Return:                                            */
+/*   ASN1_MEM_ERROR when DER isn't big enough         */
+/*   ASN1_VALUE_NOT_VALID when STR isn't an OID       */
+/*   ASN1_SUCCESS otherwise                           */
+/******************************************************/
+static asn1_retCode
+_asn1_objectid_der (const char *str, unsigned char *der, int *der_len)
+{
+  int len_len, len, max_len;
+  asn1_retCode result;
+
+  max_len = *der_len;
+
+  /* the content octets are written at the start of DER and moved
+     behind the length once that is known */
+  len = max_len;
+  result = asn1_oid_der (str, der, &len);
+  if (result != ASN1_SUCCESS && result != ASN1_MEM_ERROR)
+    return result;
+
+  asn1_length_der (len, NULL, &len_len);
+  *der_len = len + len_len;
+
+  if (max_len < *der_len)
     return ASN1_MEM_ERROR;
 
+  memmove (der + len_len, der, len);
+  asn1_length_der (len, der, &len_len);
+
   return ASN1_SUCCESS;
 }
 
@@ -442,6 +535,7 @@ _asn1_complete_explicit_tag (ASN1_TYPE node, unsigned char *der,
 /* Return:                                            */
 /*   ASN1_GENERIC_ERROR if the type is unknown,       */
 /*   ASN1_MEM_ERROR if der vector isn't big enough,   */
+/*   ASN1_MEM_ALLOC_ERROR if out of memory,           */
 /*   otherwise ASN1_SUCCESS.                          */
 /******************************************************/
 static asn1_retCode
@@ -488,7 +582,8 @@ _asn1_insert_tag_der (ASN1_TYPE node, unsigned char *der, int *counter,
 		  *counter += tag_len;
 
 		  _asn1_ltostr (*counter, temp);
-		  _asn1_set_name (p, temp);
+		  if (_asn1_set_name (p, temp) == NULL)
+		    return ASN1_MEM_ALLOC_ERROR;
 
 		  is_tag_implicit = 0;
 		}
@@ -586,7 +681,7 @@ _asn1_insert_tag_der (ASN1_TYPE node, unsigned char *der, int *counter,
     }
 
   *max_len -= tag_len;
-  if (*max_len >= 0)
+  if ((*max_len >= 0) && (tag_len > 0))
     memcpy (der + *counter, tag_der, tag_len);
   *counter += tag_len;
 
@@ -639,7 +734,7 @@ _asn1_ordering_set (unsigned char *der, int der_len, ASN1_TYPE node)
     {
       p_vet = (struct vet *) _asn1_malloc (sizeof (struct vet));
       if (p_vet == NULL)
-	return;
+	goto error;
 
       p_vet->next = NULL;
       p_vet->prev = last;
@@ -653,14 +748,14 @@ _asn1_ordering_set (unsigned char *der, int der_len, ASN1_TYPE node)
       if (asn1_get_tag_der
 	  (der + counter, der_len - counter, &class, &len2,
 	   &tag) != ASN1_SUCCESS)
-	return;
+	goto error;
       p_vet->value = (class << 24) | tag;
       counter += len2;
 
       /* extraction and length */
       len2 = asn1_get_length_der (der + counter, der_len - counter, &len);
       if (len2 < 0)
-	return;
+	goto error;
       counter += len + len2;
 
       p_vet->end = counter;
@@ -680,7 +775,7 @@ _asn1_ordering_set (unsigned char *der, int der_len, ASN1_TYPE node)
 	      /* change position */
 	      temp = (unsigned char *) _asn1_malloc (p_vet->end - counter);
 	      if (temp == NULL)
-		return;
+		goto error;
 
 	      memcpy (temp, der + counter, p_vet->end - counter);
 	      memcpy (der + counter, der + p_vet->end,
@@ -708,6 +803,16 @@ _asn1_ordering_set (unsigned char *der, int der_len, ASN1_TYPE node)
       _asn1_free (p_vet);
       p_vet = first;
     }
+  return;
+
+error:
+  /* the encoding is left unordered */
+  while (first)
+    {
+      p_vet = first->next;
+      _asn1_free (first);
+      first = p_vet;
+    }
 }
 
 /******************************************************/
@@ -753,7 +858,7 @@ _asn1_ordering_set_of (unsigned char *der, int der_len, ASN1_TYPE node)
     {
       p_vet = (struct vet *) _asn1_malloc (sizeof (struct vet));
       if (p_vet == NULL)
-	return;
+	goto error;
 
       p_vet->next = NULL;
       p_vet->prev = last;
@@ -770,12 +875,12 @@ _asn1_ordering_set_of (unsigned char *der, int der_len, ASN1_TYPE node)
 	  if (asn1_get_tag_der
 	      (der + counter, der_len - counter, &class, &len,
 	       NULL) != ASN1_SUCCESS)
-	    return;
+	    goto error;
 	  counter += len;
 
 	  len2 = asn1_get_length_der (der + counter, der_len - counter, &len);
 	  if (len2 < 0)
-	    return;
+	    goto error;
 	  counter += len + len2;
 	}
 
@@ -818,7 +923,7 @@ _asn1_ordering_set_of (unsigned char *der, int der_len, ASN1_TYPE node)
 	      /* change position */
 	      temp = (unsigned char *) _asn1_malloc (p_vet->end - counter);
 	      if (temp == NULL)
-		return;
+		goto error;
 
 	      memcpy (temp, der + counter, (p_vet->end) - counter);
 	      memcpy (der + counter, der + (p_vet->end),
@@ -842,8 +947,519 @@ _asn1_ordering_set_of (unsigned char *der, int der_len, ASN1_TYPE node)
       _asn1_free (p_vet);
       p_vet = first;
     }
+  return;
+
+error:
+  /* the encoding is left unordered */
+  while (first)
+    {
+      p_vet = first->next;
+      _asn1_free (first);
+      first = p_vet;
+    }
+}
+
+/* Returns 1 if NODE holds no value or the value of its DEFAULT, so
+   DER leaves it out.  */
+static int
+_asn1_is_default_value (ASN1_TYPE node)
+{
+  ASN1_TYPE p;
+  const unsigned char *default_value;
+  int len, len_len, default_len;
+
+  if (!(node->type & CONST_DEFAULT))
+    return 0;
+  if (node->value == NULL)
+    return 1;
+
+  p = node->down;
+  while (p && (type_field (p->type) != TYPE_DEFAULT))
+    p = p->right;
+  if (p == NULL)
+    return 0;
+
+  switch (type_field (node->type))
+    {
+    case TYPE_BOOLEAN:
+      if (p->type & CONST_TRUE)
+	return node->value[0] == 'T';
+      if (p->type & CONST_FALSE)
+	return node->value[0] == 'F';
+      break;
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+      default_value = _asn1_value_der (p, &default_len);
+      if (default_value == NULL)
+	break;
+      len = asn1_get_length_der (node->value, node->value_len, &len_len);
+      return (len == default_len)
+	&& !memcmp (node->value + len_len, default_value, len);
+    case TYPE_OBJECT_ID:
+      return (p->value != NULL) && !strcmp ((char *) node->value,
+					    (char *) p->value);
+    default:
+      break;
+    }
+
+  return 0;
 }
 
+/* State of _asn1_match_der.  */
+typedef struct
+{
+  const unsigned char *der;
+  int der_len;
+  int verify;			/* compare the bytes, not only their lengths */
+  struct der_cache_st *cache;	/* copy of DER, made when first needed */
+} der_match;
+
+static int _asn1_match_der (ASN1_TYPE node, der_match * ctx, int *counter,
+			    int end);
+
+/* Matches the LEN bytes of DATA at CTX->der[*COUNTER].  */
+static int
+_asn1_match_bytes (der_match * ctx, int *counter, int end,
+		   const unsigned char *data, int len)
+{
+  if (len > end - *counter)
+    return 0;
+  if (ctx->verify && memcmp (ctx->der + *counter, data, len))
+    return 0;
+
+  *counter += len;
+  return 1;
+}
+
+/* Reads length octets in the shortest definite form, as
+   asn1_length_der writes them.  Returns the length or -1.  */
+static int
+_asn1_match_length (der_match * ctx, int *counter, int end)
+{
+  int len, len_len, der_len_len;
+
+  if (*counter >= end)
+    return -1;
+  len = asn1_get_length_der (ctx->der + *counter, end - *counter, &len_len);
+  if (len < 0 || len > end - *counter - len_len)
+    return -1;
+  asn1_length_der (len, NULL, &der_len_len);
+  if (len_len != der_len_len)
+    return -1;
+
+  *counter += len_len;
+  return len;
+}
+
+/* Matches the tags of NODE as _asn1_insert_tag_der writes them.  The
+   EXPLICIT ones come with their length, which sets *EXPLICIT_END.  */
+static int
+_asn1_match_tags (ASN1_TYPE node, der_match * ctx, int *counter, int end,
+		  int *explicit_end)
+{
+  ASN1_TYPE p;
+  int tag_len, is_tag_implicit, len;
+  unsigned char class, class_implicit = 0, tag_der[MAX_TAG_LEN];
+  unsigned long tag_implicit = 0;
+
+  is_tag_implicit = 0;
+  *explicit_end = -1;
+
+  if (node->type & CONST_TAG)
+    for (p = node->down; p; p = p->right)
+      {
+	if (type_field (p->type) != TYPE_TAG)
+	  continue;
+
+	if (p->type & CONST_APPLICATION)
+	  class = ASN1_CLASS_APPLICATION;
+	else if (p->type & CONST_UNIVERSAL)
+	  class = ASN1_CLASS_UNIVERSAL;
+	else if (p->type & CONST_PRIVATE)
+	  class = ASN1_CLASS_PRIVATE;
+	else
+	  class = ASN1_CLASS_CONTEXT_SPECIFIC;
+
+	if (p->type & CONST_EXPLICIT)
+	  {
+	    if (is_tag_implicit)
+	      _asn1_tag_der (class_implicit, tag_implicit, tag_der, &tag_len);
+	    else
+	      _asn1_tag_der (class | ASN1_CLASS_STRUCTURED,
+			     strtoul (p->value, NULL, 10), tag_der, &tag_len);
+	    if (!_asn1_match_bytes (ctx, counter, end, tag_der, tag_len))
+	      return 0;
+
+	    /* nested EXPLICIT tags all end with the element */
+	    len = _asn1_match_length (ctx, counter, end);
+	    if (len < 0
+		|| (*explicit_end >= 0 && *counter + len != *explicit_end))
+	      return 0;
+	    *explicit_end = end = *counter + len;
+	    is_tag_implicit = 0;
+	  }
+	else if (!is_tag_implicit)
+	  {
+	    if ((type_field (node->type) == TYPE_SEQUENCE) ||
+		(type_field (node->type) == TYPE_SEQUENCE_OF) ||
+		(type_field (node->type) == TYPE_SET) ||
+		(type_field (node->type) == TYPE_SET_OF))
+	      class |= ASN1_CLASS_STRUCTURED;
+	    class_implicit = class;
+	    tag_implicit = strtoul (p->value, NULL, 10);
+	    is_tag_implicit = 1;
+	  }
+      }
+
+  if (is_tag_implicit)
+    _asn1_tag_der (class_implicit, tag_implicit, tag_der, &tag_len);
+  else
+    switch (type_field (node->type))
+      {
+      case TYPE_NULL:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_NULL, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_BOOLEAN:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_BOOLEAN, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_INTEGER:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_INTEGER, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_ENUMERATED:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_ENUMERATED, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_OBJECT_ID:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_OBJECT_ID, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_TIME:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, (node->type & CONST_UTC) ?
+		       ASN1_TAG_UTCTime : ASN1_TAG_GENERALIZEDTime, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_OCTET_STRING:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_OCTET_STRING, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_GENERALSTRING:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_GENERALSTRING,
+		       tag_der, &tag_len);
+	break;
+      case TYPE_BIT_STRING:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL, ASN1_TAG_BIT_STRING, tag_der,
+		       &tag_len);
+	break;
+      case TYPE_SEQUENCE:
+      case TYPE_SEQUENCE_OF:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL | ASN1_CLASS_STRUCTURED,
+		       ASN1_TAG_SEQUENCE, tag_der, &tag_len);
+	break;
+      case TYPE_SET:
+      case TYPE_SET_OF:
+	_asn1_tag_der (ASN1_CLASS_UNIVERSAL | ASN1_CLASS_STRUCTURED,
+		       ASN1_TAG_SET, tag_der, &tag_len);
+	break;
+      case TYPE_CHOICE:
+      case TYPE_ANY:
+	tag_len = 0;
+	break;
+      default:
+	return 0;
+      }
+
+  return _asn1_match_bytes (ctx, counter, end, tag_der, tag_len);
+}
+
+/* Returns 1 if the elements of the SET or SET OF NODE encoded at DER1
+   and DER2 are in the order _asn1_ordering_set(_of) puts them.  */
+static int
+_asn1_match_order (ASN1_TYPE node, const unsigned char *der1, int len1,
+		   const unsigned char *der2, int len2)
+{
+  unsigned char class1, class2;
+  unsigned long tag1, tag2;
+  int tag_len;
+
+  if (type_field (node->type) == TYPE_SET_OF)
+    return memcmp (der1, der2, (len1 < len2) ? len1 : len2) <= 0;
+
+  if (asn1_get_tag_der (der1, len1, &class1, &tag_len, &tag1) != ASN1_SUCCESS
+      || asn1_get_tag_der (der2, len2, &class2, &tag_len,
+			   &tag2) != ASN1_SUCCESS)
+    return 0;
+
+  /* equal tags keep the order of the structure */
+  return ((class1 << 24) | tag1) < ((class2 << 24) | tag2);
+}
+
+/* Matches the elements of the SET or SET OF NODE, from FIRST on,
+   which may come in any order, with the content octets up to END.  */
+static int
+_asn1_match_set (ASN1_TYPE node, ASN1_TYPE first, der_match * ctx,
+		 int *counter, int end)
+{
+  ASN1_TYPE p, *elements;
+  int n, k, i, pos, verify, prev, prev_len, result;
+
+  for (n = 0, p = first; p; p = p->right)
+    if (type_field (p->type) != TYPE_TAG)
+      n++;
+  if (n == 0)
+    return 1;
+
+  elements = _asn1_pool_malloc (n * sizeof (ASN1_TYPE));
+  if (elements == NULL)
+    return 0;
+  for (k = 0, p = first; p; p = p->right)
+    if (type_field (p->type) != TYPE_TAG)
+      elements[k++] = p;
+
+  /* the bytes decide which element is which */
+  verify = ctx->verify;
+  ctx->verify = 1;
+
+  result = 1;
+  prev = prev_len = -1;
+  for (k = 0, i = 0; k < n && result; k++)
+    {
+      /* most often the elements are already in order */
+      for (result = 0; result < n; result++, i = (i + 1) % n)
+	{
+	  pos = *counter;
+	  if (elements[i] && _asn1_match_der (elements[i], ctx, &pos, end))
+	    break;
+	}
+      if (result == n)
+	{
+	  result = 0;
+	  break;
+	}
+      elements[i] = NULL;
+      i = (i + 1) % n;
+      result = 1;
+
+      if (pos == *counter)
+	continue;		/* a DEFAULT value, not encoded */
+      if (prev >= 0 && !_asn1_match_order (node, ctx->der + prev, prev_len,
+					   ctx->der + *counter,
+					   pos - *counter))
+	result = 0;
+      prev = *counter;
+      prev_len = pos - *counter;
+      *counter = pos;
+    }
+
+  ctx->verify = verify;
+  _asn1_pool_free (elements, n * sizeof (ASN1_TYPE));
+
+  return result;
+}
+
+/* Matches the encoding of NODE, as asn1_der_coding writes it, with the
+   bytes at CTX->der[*COUNTER] up to END.  On success *COUNTER moves
+   past them and the constructed elements cache their encoding.  */
+static int
+_asn1_match_der (ASN1_TYPE node, der_match * ctx, int *counter, int end)
+{
+  ASN1_TYPE p;
+  int start, pos, len, len_len, explicit_end;
+  unsigned char temp[256];	/* encoded OIDs and times */
+  asn1_retCode result;
+
+  start = pos = *counter;
+
+  if (node->der != NULL)
+    {
+      if (!_asn1_match_bytes (ctx, &pos, end,
+			      node->der->data + node->der_start,
+			      node->der_len))
+	return 0;
+      *counter = pos;
+      return 1;
+    }
+
+  switch (type_field (node->type))
+    {
+    case TYPE_BOOLEAN:
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+    case TYPE_OBJECT_ID:
+      if (_asn1_is_default_value (node))
+	return 1;
+      break;
+    default:
+      break;
+    }
+
+  if (!_asn1_match_tags (node, ctx, &pos, end, &explicit_end))
+    return 0;
+  if (explicit_end >= 0)
+    end = explicit_end;
+
+  switch (type_field (node->type))
+    {
+    case TYPE_NULL:
+      temp[0] = 0;
+      if (!_asn1_match_bytes (ctx, &pos, end, temp, 1))
+	return 0;
+      break;
+    case TYPE_BOOLEAN:
+      if (node->value == NULL)
+	return 0;
+      temp[0] = 1;
+      temp[1] = (node->value[0] == 'F') ? 0 : 0xFF;
+      if (!_asn1_match_bytes (ctx, &pos, end, temp, 2))
+	return 0;
+      break;
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+    case TYPE_OCTET_STRING:
+    case TYPE_GENERALSTRING:
+    case TYPE_BIT_STRING:
+      if (node->value == NULL)
+	return 0;
+      len = asn1_get_length_der (node->value, node->value_len, &len_len);
+      if (len < 0
+	  || !_asn1_match_bytes (ctx, &pos, end, node->value, len_len + len))
+	return 0;
+      break;
+    case TYPE_ANY:
+      if (node->value == NULL)
+	return 0;
+      len = asn1_get_length_der (node->value, node->value_len, &len_len);
+      if (len < 0
+	  || !_asn1_match_bytes (ctx, &pos, end, node->value + len_len, len))
+	return 0;
+      break;
+    case TYPE_OBJECT_ID:
+    case TYPE_TIME:
+      if (node->value == NULL)
+	return 0;
+      len = sizeof (temp);
+      if (type_field (node->type) == TYPE_OBJECT_ID)
+	result = _asn1_objectid_der ((char *) node->value, temp, &len);
+      else
+	result = _asn1_time_der (node->value, temp, &len);
+      if (result != ASN1_SUCCESS
+	  || !_asn1_match_bytes (ctx, &pos, end, temp, len))
+	return 0;
+      break;
+    case TYPE_SEQUENCE:
+    case TYPE_SET:
+    case TYPE_SEQUENCE_OF:
+    case TYPE_SET_OF:
+      len = _asn1_match_length (ctx, &pos, end);
+      if (len < 0)
+	return 0;
+      end = pos + len;
+
+      p = node->down;
+      if ((type_field (node->type) == TYPE_SEQUENCE_OF)
+	  || (type_field (node->type) == TYPE_SET_OF))
+	{
+	  /* the first element is the type of the others */
+	  while (p && ((type_field (p->type) == TYPE_TAG)
+		       || (type_field (p->type) == TYPE_SIZE)))
+	    p = p->right;
+	  if (p)
+	    p = p->right;
+	}
+
+      if ((type_field (node->type) == TYPE_SET)
+	  || (type_field (node->type) == TYPE_SET_OF))
+	{
+	  if (!_asn1_match_set (node, p, ctx, &pos, end))
+	    return 0;
+	}
+      else
+	{
+	  for (; p; p = p->right)
+	    if (type_field (p->type) != TYPE_TAG
+		&& !_asn1_match_der (p, ctx, &pos, end))
+	      return 0;
+	}
+      if (pos != end)
+	return 0;
+      break;
+    case TYPE_CHOICE:
+      for (p = node->down; p; p = p->right)
+	if (type_field (p->type) != TYPE_TAG
+	    && !_asn1_match_der (p, ctx, &pos, end))
+	  return 0;
+      break;
+    default:
+      return 0;
+    }
+
+  if (explicit_end >= 0 && pos != explicit_end)
+    return 0;
+
+  switch (type_field (node->type))
+    {
+    case TYPE_SEQUENCE:
+    case TYPE_SET:
+    case TYPE_SEQUENCE_OF:
+    case TYPE_SET_OF:
+    case TYPE_CHOICE:
+      if (ctx->cache == NULL)
+	{
+	  ctx->cache = _asn1_new_der_cache (ctx->der, ctx->der_len);
+	  if (ctx->cache == NULL)
+	    return 0;
+	}
+      _asn1_set_der_cache (node, ctx->cache, start, pos - start);
+      break;
+    default:
+      break;
+    }
+
+  *counter = pos;
+  return 1;
+}
+
+/******************************************************/
+/* Function : _asn1_cache_der                         */
+/* Description: keeps in the constructed elements of  */
+/*   NODE their encoding found in DER, so that        */
+/*   asn1_der_coding copies it while they do not      */
+/*   change.                                          */
+/* Parameters:                                        */
+/*   node: the element encoded in DER.                */
+/*   der: the encoding written by asn1_der_coding, or */
+/*     the one decoded when VERIFY is set: then only  */
+/*     the bytes asn1_der_coding would write again    */
+/*     are kept.                                      */
+/******************************************************/
+void
+_asn1_cache_der (ASN1_TYPE node, const unsigned char *der, int der_len,
+		 int verify)
+{
+  der_match ctx;
+  int counter;
+
+  ctx.der = der;
+  ctx.der_len = der_len;
+  ctx.verify = verify;
+  ctx.cache = NULL;
+
+  if (verify)
+    _asn1_clear_der_cache (node);
+
+  counter = 0;
+  _asn1_match_der (node, &ctx, &counter, der_len);
+
+  if (ctx.cache != NULL)
+    _asn1_put_der_cache (ctx.cache);
+}
+
+static asn1_retCode
+_asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
+		  char *ErrorDescription);
+
 /**
  * asn1_der_coding:
  * @element: pointer to an ASN1 element
@@ -859,6 +1475,11 @@ _asn1_ordering_set_of (unsigned char *der, int der_len, ASN1_TYPE node)
  * Creates the DER encoding for the NAME structure (inside *POINTER
  * structure).
  *
+ * The constructed elements keep their encoding, as do those of a
+ * structure decoded with %ASN1_DECODE_KEEP_DER where its input was
+ * DER, and later calls copy it for the elements that did not change
+ * since.
+ *
  * Returns: %ASN1_SUCCESS if DER encoding OK, %ASN1_ELEMENT_NOT_FOUND
  *   if @name is not a valid element, %ASN1_VALUE_NOT_FOUND if there
  *   is an element without a value, %ASN1_MEM_ERROR if the @ider
@@ -869,23 +1490,39 @@ asn1_retCode
 asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 		 char *ErrorDescription)
 {
-  ASN1_TYPE node, p, p2;
+  int site = _asn1_enter_site (ASN1_ALLOC_ENCODE);
+  const char *caller = _asn1_trace_begin ("asn1_der_coding", element);
+  asn1_retCode result;
+
+  result = _asn1_der_coding (element, name, ider, len, ErrorDescription);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
+		  char *ErrorDescription)
+{
+  ASN1_TYPE source, node, p, p2;
   char temp[SIZEOF_UNSIGNED_LONG_INT * 3 + 1];
   int counter, counter_old, len2, len3, tlen, move, max_len, max_len_old;
   asn1_retCode err;
   unsigned char *der = ider;
 
-  node = asn1_find_node (element, name);
-  if (node == NULL)
+  source = asn1_find_node (element, name);
+  if (source == NULL)
     return ASN1_ELEMENT_NOT_FOUND;
 
   /* Node is now a locally allocated variable.
    * That is because in some point we modify the
    * structure, and I don't know why! --nmav
+   * The copy stops at the elements with a cached encoding.
    */
-  node = _asn1_copy_structure3 (node);
+  node = _asn1_copy_structure3 (source);
   if (node == NULL)
-    return ASN1_ELEMENT_NOT_FOUND;
+    return ASN1_MEM_ALLOC_ERROR;
 
   max_len = *len;
 
@@ -897,6 +1534,28 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 
       counter_old = counter;
       max_len_old = max_len;
+      if ((move != UP) && (p->der != NULL))
+	{
+	  /* unchanged since it was encoded, tags included */
+	  max_len -= p->der_len;
+	  if (max_len >= 0)
+	    memcpy (der + counter, p->der->data + p->der_start, p->der_len);
+	  counter += p->der_len;
+
+	  if (p == node)
+	    break;
+	  if (p->right)
+	    {
+	      p = p->right;
+	      move = RIGHT;
+	    }
+	  else
+	    {
+	      p = _asn1_find_up (p);
+	      move = UP;
+	    }
+	  continue;
+	}
       if (move != UP)
 	{
 	  err = _asn1_insert_tag_der (p, der, &counter, &max_len);
@@ -913,7 +1572,7 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 	  move = RIGHT;
 	  break;
 	case TYPE_BOOLEAN:
-	  if ((p->type & CONST_DEFAULT) && (p->value == NULL))
+	  if (_asn1_is_default_value (p))
 	    {
 	      counter = counter_old;
 	      max_len = max_len_old;
@@ -943,7 +1602,7 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 	  break;
 	case TYPE_INTEGER:
 	case TYPE_ENUMERATED:
-	  if ((p->type & CONST_DEFAULT) && (p->value == NULL))
+	  if (_asn1_is_default_value (p))
 	    {
 	      counter = counter_old;
 	      max_len = max_len_old;
@@ -971,7 +1630,7 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 	  move = RIGHT;
 	  break;
 	case TYPE_OBJECT_ID:
-	  if ((p->type & CONST_DEFAULT) && (p->value == NULL))
+	  if (_asn1_is_default_value (p))
 	    {
 	      counter = counter_old;
 	      max_len = max_len_old;
@@ -986,7 +1645,8 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
 		  goto error;
 		}
 	      len2 = max_len;
-	      err = _asn1_objectid_der (p->value, der + counter, &len2);
+	      err = _asn1_objectid_der ((char *) p->value, der + counter,
+					&len2);
 	      if (err != ASN1_SUCCESS && err != ASN1_MEM_ERROR)
 		goto error;
 
@@ -1216,6 +1876,8 @@ asn1_der_coding (ASN1_TYPE element, const char *name, void *ider, int *len,
       goto error;
     }
 
+  _asn1_cache_der (source, der, counter, 0);
+
   err = ASN1_SUCCESS;
 
 error:
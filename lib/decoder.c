@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+
+/*****************************************************/
+/* File: decoder.c                                   */
+/* Description: Decoders of many encodings of one    */
+/*  type, which keep the memory of the elements they */
+/*  decoded for the next ones.                       */
+/*****************************************************/
+
+#include <int.h>
+#include "structure.h"
+#include "decoding.h"
+
+/* Bytes of the elements a decoder keeps, unless its options say.  */
+#define DECODER_POOL_BYTES (1024 * 1024)
+
+struct asn1_decoder_st
+{
+  ASN1_TYPE prototype;		/* Copied for each decoding */
+  ASN1_TYPE element;		/* Last element decoded, or empty */
+  asn1_decode_options options;
+  struct asn1_pool_st *pool;	/* Memory of the elements deleted */
+};
+
+/**
+ * asn1_decoder_init:
+ * @definitions: the definitions, as for asn1_create_element().
+ * @source_name: the type of the encodings, as for
+ *   asn1_create_element().
+ * @options: the flags and the limits of the decodings, see
+ *   asn1_der_decoding_options(), or %NULL for none.
+ * @decoder: return the new decoder.
+ *
+ * Creates a decoder of encodings of type @source_name, for a thread
+ * decoding many of them.  The element is instantiated once, and each
+ * decoding copies it with the memory of the elements decoded before,
+ * so that once the decoder has decoded an encoding like the next one,
+ * such as a message of the same size, it no longer allocates memory.
+ * The memory kept is at most the max_pool_bytes of @options, or 1 MB
+ * if it is 0, the rest being freed; a decoder of larger messages
+ * needs a larger one to stop allocating.
+ *
+ * A decoder must be used by one thread at a time.  The definitions
+ * can be shared by several decoders, and must not be deleted before
+ * them.
+ *
+ * Returns: %ASN1_SUCCESS if the decoder was created,
+ *   %ASN1_ELEMENT_NOT_FOUND if @source_name is not known,
+ *   %ASN1_GENERIC_ERROR if the size of @options is not valid, and
+ *   %ASN1_MEM_ALLOC_ERROR if out of memory.
+ **/
+asn1_retCode
+asn1_decoder_init (ASN1_TYPE definitions, const char *source_name,
+		   const asn1_decode_options * options,
+		   asn1_decoder ** decoder)
+{
+  asn1_decoder *new_decoder;
+  asn1_retCode result;
+
+  *decoder = NULL;
+
+  new_decoder = _asn1_calloc (1, sizeof (*new_decoder));
+  if (new_decoder == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
+
+  result = _asn1_get_decode_options (options, &new_decoder->options);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_decoder_deinit (&new_decoder);
+      return result;
+    }
+
+  new_decoder->pool =
+    _asn1_new_pool (new_decoder->options.max_pool_bytes > 0
+		    ? new_decoder->options.max_pool_bytes
+		    : DECODER_POOL_BYTES);
+  if (new_decoder->pool == NULL)
+    {
+      asn1_decoder_deinit (&new_decoder);
+      return ASN1_MEM_ALLOC_ERROR;
+    }
+
+  result = asn1_create_element (definitions, source_name,
+				&new_decoder->prototype);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_decoder_deinit (&new_decoder);
+      return result;
+    }
+
+  *decoder = new_decoder;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_decoder_decode:
+ * @decoder: a decoder of asn1_decoder_init().
+ * @ider: vector that contains the DER encoding.
+ * @len: number of bytes of *@ider: @ider[0]..@ider[len-1].
+ * @element: return the element decoded.
+ * @error: if not %NULL, filled with where the decoding failed when
+ *   an error occurred.
+ *
+ * Decodes @ider as asn1_der_decoding_options() does, in a new element
+ * of the type and with the options of @decoder.
+ *
+ * The element belongs to @decoder: it can be read, encoded and
+ * changed, but not deleted.  The next call of asn1_decoder_decode()
+ * deletes it, keeping its memory for the next element, as does
+ * asn1_decoder_deinit().  On errors the element partially decoded is
+ * kept the same way, so that @error can be described until then.
+ *
+ * Returns: as asn1_der_decoding_options(); on errors *@ELEMENT is
+ *   %ASN1_TYPE_EMPTY.
+ **/
+asn1_retCode
+asn1_decoder_decode (asn1_decoder * decoder, const void *ider, int len,
+		     ASN1_TYPE * element, asn1_error * error)
+{
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller =
+    _asn1_trace_begin ("asn1_decoder_decode", decoder->prototype);
+  struct asn1_pool_st *previous = _asn1_enter_pool (decoder->pool);
+  asn1_retCode result;
+
+  asn1_delete_structure (&decoder->element);
+
+  decoder->element = _asn1_copy_structure3 (decoder->prototype);
+  if (decoder->element == NULL)
+    {
+      result = ASN1_MEM_ALLOC_ERROR;
+      if (error != NULL)
+	{
+	  memset (error, 0, sizeof (*error));
+	  error->code = result;
+	  error->offset = -1;
+	}
+    }
+  else
+    result = asn1_der_decoding_options (&decoder->element, ider, len,
+					&decoder->options, error);
+
+  *element = result == ASN1_SUCCESS ? decoder->element : ASN1_TYPE_EMPTY;
+
+  _asn1_leave_pool (previous);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+/**
+ * asn1_decoder_deinit:
+ * @decoder: a decoder of asn1_decoder_init(), or %NULL.
+ *
+ * Deletes *@DECODER, with the last element it decoded and the memory
+ * it kept, and sets it to %NULL.
+ **/
+void
+asn1_decoder_deinit (asn1_decoder ** decoder)
+{
+  if (*decoder == NULL)
+    return;
+
+  asn1_delete_structure (&(*decoder)->element);
+  asn1_delete_structure (&(*decoder)->prototype);
+  _asn1_delete_pool ((*decoder)->pool);
+  _asn1_free (*decoder);
+  *decoder = NULL;
+}
@@ -31,9 +31,20 @@
 #include <gstr.h>
 #include "structure.h"
 #include "element.h"
+#include "coding.h"
+#include "decoding.h"
 
 static asn1_retCode
-_asn1_get_indefinite_length_string (const unsigned char *der, int *len);
+_asn1_get_indefinite_length_string (const unsigned char *der, int *len,
+				    int max_indefinite);
+
+/* Whether DER, of DER_LEN bytes, starts with the end-of-contents
+   octets of an indefinite length.  */
+static int
+_asn1_is_eoc (const unsigned char *der, int der_len)
+{
+  return der_len >= 2 && der[0] == 0 && der[1] == 0;
+}
 
 static void
 _asn1_error_description_tag_error (ASN1_TYPE node, char *ErrorDescription)
@@ -54,8 +65,15 @@ _asn1_error_description_tag_error (ASN1_TYPE node, char *ErrorDescription)
  *
  * Extract a length field from DER data.
  *
+ * Before version 2.10 a length was returned even when the contents
+ * it announces did not fit in @der_len, and -2 only when it did not
+ * fit in an unsigned long.  Callers that check a negative result
+ * need no change.
+ *
  * Returns: Return the decoded length value, or -1 on indefinite
- *   length, or -2 when the value was too big.
+ *   length, or -2 when the value was too big to fit in an int, or -4
+ *   when the length or the value would exceed the @der_len octets of
+ *   @der.
  **/
 signed long
 asn1_get_length_der (const unsigned char *der, int der_len, int *len)
@@ -71,7 +89,7 @@ asn1_get_length_der (const unsigned char *der, int der_len, int *len)
     {
       /* short form */
       *len = 1;
-      return der[0];
+      ans = der[0];
     }
   else
     {
@@ -83,22 +101,29 @@ asn1_get_length_der (const unsigned char *der, int der_len, int *len)
 	  ans = 0;
 	  while (punt <= k && punt < der_len)
 	    {
-	      unsigned long last = ans;
-
-	      ans = ans * 256 + der[punt++];
-	      if (ans < last)
-		/* we wrapped around, no bignum support... */
+	      /* the callers keep lengths in an int */
+	      if (ans > (unsigned long) INT_MAX / 256)
 		return -2;
+	      ans = ans * 256 + der[punt++];
 	    }
+	  /* the octets of the length itself are cut */
+	  if (punt <= k)
+	    return -4;
 	}
       else
 	{			/* indefinite length method */
-	  ans = -1;
+	  *len = punt;
+	  return -1;
 	}
 
       *len = punt;
-      return ans;
     }
+
+  /* the contents follow the length in DER */
+  if (ans > (unsigned long) (der_len - *len))
+    return -4;
+
+  return ans;
 }
 
 /**
@@ -111,7 +136,9 @@ asn1_get_length_der (const unsigned char *der, int der_len, int *len)
  *
  * Decode the class and TAG from DER code.
  *
- * Returns: Returns %ASN1_SUCCESS on success, or an error.
+ * Returns: Returns %ASN1_SUCCESS on success, or %ASN1_DER_ERROR when
+ *   the tag does not fit in the @der_len octets of @der, or its
+ *   number in an int.
  **/
 int
 asn1_get_tag_der (const unsigned char *der, int der_len,
@@ -134,23 +161,18 @@ asn1_get_tag_der (const unsigned char *der, int der_len,
       /* Long form */
       punt = 1;
       ris = 0;
-      while (punt <= der_len && der[punt] & 128)
+      while (punt < der_len && der[punt] & 128)
 	{
-	  int last = ris;
-	  ris = ris * 128 + (der[punt++] & 0x7F);
-	  if (ris < last)
-	    /* wrapper around, and no bignums... */
+	  /* no bignums... */
+	  if (ris > INT_MAX / 128)
 	    return ASN1_DER_ERROR;
+	  ris = ris * 128 + (der[punt++] & 0x7F);
 	}
       if (punt >= der_len)
 	return ASN1_DER_ERROR;
-      {
-	int last = ris;
-	ris = ris * 128 + (der[punt++] & 0x7F);
-	if (ris < last)
-	  /* wrapper around, and no bignums... */
-	  return ASN1_DER_ERROR;
-      }
+      if (ris > INT_MAX / 128)
+	return ASN1_DER_ERROR;
+      ris = ris * 128 + (der[punt++] & 0x7F);
       *len = punt;
     }
   if (tag)
@@ -158,6 +180,73 @@ asn1_get_tag_der (const unsigned char *der, int der_len,
   return ASN1_SUCCESS;
 }
 
+/* Returns the length at BER as asn1_get_length_ber() does, or -5
+   when it is indefinite and more than MAX_INDEFINITE indefinite
+   lengths are nested there, itself included, unless MAX_INDEFINITE
+   is negative.  The decoding passes its own limit, so that the
+   contents of an EXPLICIT tag are not walked beyond it.  */
+static signed long
+_asn1_get_length_ber (const unsigned char *ber, int ber_len, int *len,
+		      int max_indefinite)
+{
+  const unsigned char *p;
+  unsigned long tag;
+  unsigned char class;
+  int ret, rest, tag_len, len_len, tlv_len;
+  asn1_retCode result;
+  long content;
+
+  ret = asn1_get_length_der (ber, ber_len, len);
+  if (ret == -1)
+    {				/* indefinite length method */
+      if (max_indefinite == 0)
+	return -5;
+
+      /* the elements of the contents, one after the other */
+      ret = 0;
+      while (1)
+	{
+	  p = ber + *len + ret;
+	  rest = ber_len - *len - ret;
+	  if (rest < 2)
+	    return -3;
+	  if ((p[0] == 0) && (p[1] == 0))
+	    return ret + 2;
+
+	  if (asn1_get_tag_der (p, rest, &class, &tag_len, &tag) !=
+	      ASN1_SUCCESS)
+	    return -3;
+	  content = asn1_get_length_der (p + tag_len, rest - tag_len,
+					 &len_len);
+	  if (content == -1)
+	    {
+	      /* the element is nested in the contents, and a negative
+	         limit is none for both functions */
+	      if (max_indefinite == 1)
+		return -5;
+	      tlv_len = rest;
+	      result =
+		_asn1_get_indefinite_length_string (p, &tlv_len,
+						    max_indefinite - 1);
+	      if (result == ASN1_LIMIT_EXCEEDED)
+		return -5;
+	      if (result != ASN1_SUCCESS)
+		return -3;
+	    }
+	  else if ((content < 0) || (content > rest))
+	    return -3;
+	  else
+	    tlv_len = tag_len + len_len + content;
+
+	  if ((tlv_len < 0) || (tlv_len > rest))
+	    return -3;
+	  ret += tlv_len;
+	}
+    }
+
+  return ret;
+}
+
 /**
  * asn1_get_length_ber:
  * @ber: BER data to decode.
@@ -166,29 +255,22 @@ asn1_get_tag_der (const unsigned char *der, int der_len,
  *
  * Extract a length field from BER data.  The difference to
  * asn1_get_length_der() is that this function will return a length
- * even if the value has indefinite encoding.
+ * even if the value has indefinite encoding, the length of the
+ * contents up to and including the end-of-contents octets.  The
+ * contents are then read element by element, with no limit on the
+ * indefinite lengths nested, so this takes time in proportion to
+ * their size.
  *
  * Returns: Return the decoded length value, or negative value when
- *   the value was too big.
+ *   the value was too big, and -3 when the contents of an indefinite
+ *   length are not well formed.
  *
  * Since: 2.0
  **/
 signed long
 asn1_get_length_ber (const unsigned char *ber, int ber_len, int *len)
 {
-  int ret;
-  long err;
-
-  ret = asn1_get_length_der (ber, ber_len, len);
-  if (ret == -1)
-    {				/* indefinite length method */
-      ret = ber_len;
-      err = _asn1_get_indefinite_length_string (ber + 1, &ret);
-      if (err != ASN1_SUCCESS)
-	return -3;
-    }
-
-  return ret;
+  return _asn1_get_length_ber (ber, ber_len, len, -1);
 }
 
 /**
@@ -251,67 +333,170 @@ _asn1_get_time_der (const unsigned char *der, int der_len, int *ret_len,
   return ASN1_SUCCESS;
 }
 
-static int
-_asn1_get_objectid_der (const unsigned char *der, int der_len, int *ret_len,
-			char *str, int str_size)
+/* Appends SEP, unless it is zero, and the decimal form of VAL to the
+   OBJECT IDENTIFIER being built in STR.  *POS counts the characters
+   even when they no longer fit in STR_SIZE.  */
+static void
+_asn1_oid_append (char *str, int str_size, int *pos, char sep,
+		  unsigned long val)
 {
-  int len_len, len, k;
-  int leading;
-  char temp[20];
-  unsigned long val, val1, prev_val;
+  char temp[3 * sizeof (val) + 1];
+  int k = sizeof (temp);
 
-  *ret_len = 0;
-  if (str && str_size > 0)
-    str[0] = 0;			/* no oid */
+  if (sep)
+    {
+      if (*pos < str_size - 1)
+	str[*pos] = sep;
+      (*pos)++;
+    }
 
-  if (str == NULL || der_len <= 0)
-    return ASN1_GENERIC_ERROR;
-  len = asn1_get_length_der (der, der_len, &len_len);
+  do
+    {
+      temp[--k] = '0' + (val % 10);
+      val /= 10;
+    }
+  while (val);
 
-  if (len < 0 || len > der_len || len_len > der_len)
-    return ASN1_DER_ERROR;
+  for (; k < (int) sizeof (temp); k++, (*pos)++)
+    if (*pos < str_size - 1)
+      str[*pos] = temp[k];
+}
+
+/**
+ * asn1_get_oid_der:
+ * @der: content octets of an OBJECT IDENTIFIER.
+ * @der_len: number of octets in @der.
+ * @oid: buffer to hold the dotted decimal form.
+ * @oid_len: initially the size of @oid, on return the size of the
+ *   dotted decimal form including the terminating zero.
+ *
+ * Converts the content octets of the DER encoding of an OBJECT
+ * IDENTIFIER, i.e. without tag and length, to dotted decimal form.
+ * This is the inverse of asn1_oid_der().
+ *
+ * Returns: %ASN1_SUCCESS on success, %ASN1_DER_ERROR if @der is not a
+ *   valid encoding, or %ASN1_MEM_ERROR if @oid is too small; in that
+ *   case @oid_len holds the needed size and @oid, if not empty, the
+ *   truncated value.
+ **/
+asn1_retCode
+asn1_get_oid_der (const unsigned char *der, int der_len, char *oid,
+		  int *oid_len)
+{
+  int k, pos, leading, first;
+  unsigned long val, val1;
+  int oid_size = *oid_len;
 
-  val1 = der[len_len] / 40;
-  val = der[len_len] - val1 * 40;
+  if (oid_size > 0)
+    oid[0] = 0;
+  *oid_len = 0;
 
-  _asn1_str_cpy (str, str_size, _asn1_ltostr (val1, temp));
-  _asn1_str_cat (str, str_size, ".");
-  _asn1_str_cat (str, str_size, _asn1_ltostr (val, temp));
+  if (der_len <= 0)
+    return ASN1_DER_ERROR;
 
-  prev_val = 0;
+  pos = 0;
   val = 0;
   leading = 1;
-  for (k = 1; k < len; k++)
+  first = 1;
+  for (k = 0; k < der_len; k++)
     {
       /* X.690 mandates that the leading byte must never be 0x80
        */
-      if (leading != 0 && der[len_len + k] == 0x80)
+      if (leading && der[k] == 0x80)
 	return ASN1_DER_ERROR;
       leading = 0;
 
       /* check for wrap around */
-      val = val << 7;
-      val |= der[len_len + k] & 0x7F;
-
-      if (val < prev_val)
+      if (val >> (sizeof (val) * 8 - 7))
 	return ASN1_DER_ERROR;
 
-      prev_val = val;
+      val = (val << 7) | (der[k] & 0x7F);
+      if (der[k] & 0x80)
+	continue;
 
-      if (!(der[len_len + k] & 0x80))
+      if (first)
 	{
-	  _asn1_str_cat (str, str_size, ".");
-	  _asn1_str_cat (str, str_size, _asn1_ltostr (val, temp));
-	  val = 0;
-	  prev_val = 0;
-	  leading = 1;
+	  val1 = (val < 80) ? val / 40 : 2;
+	  _asn1_oid_append (oid, oid_size, &pos, 0, val1);
+	  _asn1_oid_append (oid, oid_size, &pos, '.', val - val1 * 40);
+	  first = 0;
 	}
+      else
+	_asn1_oid_append (oid, oid_size, &pos, '.', val);
+
+      val = 0;
+      leading = 1;
     }
+
+  /* the last subidentifier is incomplete */
+  if (!leading)
+    {
+      if (oid_size > 0)
+	oid[0] = 0;
+      return ASN1_DER_ERROR;
+    }
+
+  if (oid_size > 0)
+    oid[(pos < oid_size) ? pos : oid_size - 1] = 0;
+  *oid_len = pos + 1;
+
+  if (oid_size < *oid_len)
+    return ASN1_MEM_ERROR;
+
+  return ASN1_SUCCESS;
+}
+
+static int
+_asn1_get_objectid_der (const unsigned char *der, int der_len, int *ret_len,
+			char *str, int str_size)
+{
+  int len_len, len, str_len;
+  asn1_retCode result;
+
+  *ret_len = 0;
+  if (str && str_size > 0)
+    str[0] = 0;			/* no oid */
+
+  if (str == NULL || der_len <= 0)
+    return ASN1_GENERIC_ERROR;
+  len = asn1_get_length_der (der, der_len, &len_len);
+
+  if (len < 0 || len > der_len || len_len > der_len)
+    return ASN1_DER_ERROR;
+
+  /* values longer than STR are truncated */
+  str_len = str_size;
+  result = asn1_get_oid_der (der + len_len, len, str, &str_len);
+  if (result != ASN1_SUCCESS && result != ASN1_MEM_ERROR)
+    return result;
+
   *ret_len = len + len_len;
 
   return ASN1_SUCCESS;
 }
 
+/* Decodes the OBJECT IDENTIFIER at DER into NODE, keeping its content
+   octets for asn1_read_oid_der.  Sets RET_LEN to the octets read.  */
+static asn1_retCode
+_asn1_decode_objectid (ASN1_TYPE node, const unsigned char *der, int der_len,
+		       int *ret_len)
+{
+  char temp[128];
+  int len_len, len;
+  asn1_retCode result;
+
+  result = _asn1_get_objectid_der (der, der_len, ret_len, temp,
+				   sizeof (temp));
+  if (result != ASN1_SUCCESS || temp[0] == 0)
+    return result;
+
+  len = asn1_get_length_der (der, der_len, &len_len);
+  if (_asn1_set_value_oid (node, temp, der + len_len, len) == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
+
+  return ASN1_SUCCESS;
+}
+
 /**
  * asn1_get_bit_der:
  * @der: DER data to decode containing the BIT SEQUENCE.
@@ -351,9 +536,14 @@ asn1_get_bit_der (const unsigned char *der, int der_len,
   return ASN1_SUCCESS;
 }
 
+/* Reads the tags of NODE at DER, of DER_LEN bytes, and returns in
+   *RET_LEN their length.  MAX_INDEFINITE is the most indefinite
+   lengths that can be nested there, or -1 if there is no limit.
+   Fails with ASN1_LIMIT_EXCEEDED when an EXPLICIT tag goes beyond
+   it.  */
 static int
 _asn1_extract_tag_der (ASN1_TYPE node, const unsigned char *der, int der_len,
-		       int *ret_len)
+		       int *ret_len, int max_indefinite)
 {
   ASN1_TYPE p;
   int counter, len2, len3, is_tag_implicit;
@@ -393,11 +583,16 @@ _asn1_extract_tag_der (ASN1_TYPE node, const unsigned char *der, int der_len,
 		  counter += len2;
 
 		  len3 =
-		    asn1_get_length_ber (der + counter, der_len - counter,
-					 &len2);
+		    _asn1_get_length_ber (der + counter, der_len - counter,
+					  &len2, max_indefinite);
+		  if (len3 == -5)
+		    return ASN1_LIMIT_EXCEEDED;
 		  if (len3 < 0)
 		    return ASN1_DER_ERROR;
 
+		  /* the tags within this one are nested in its length */
+		  if ((max_indefinite > 0) && (der[counter] == 0x80))
+		    max_indefinite--;
 		  counter += len2;
 		  if (counter > der_len)
 		    return ASN1_DER_ERROR;
@@ -608,115 +803,88 @@ _asn1_delete_not_used (ASN1_TYPE node)
   return ASN1_SUCCESS;
 }
 
+/* Walks the segments of a constructed OCTET STRING, DER being its
+   length octets and LEN the bytes that can be read.  Copies their
+   contents to VALUE unless it is NULL, and returns the length of the
+   encoding in *RET_LEN and that of the contents in *VALUE_LEN.  */
 static asn1_retCode
-_asn1_extract_der_octet (ASN1_TYPE node, const unsigned char *der,
-			 int der_len)
+_asn1_get_octet_segments (const unsigned char *der, int len,
+			  unsigned char *value, int *ret_len, int *value_len)
 {
-  int len2, len3;
-  int counter2, counter_end;
+  int len2, len3, counter, tot_len, indefinite;
 
-  len2 = asn1_get_length_der (der, der_len, &len3);
-  if (len2 < -1)
+  indefinite = asn1_get_length_der (der, len, &len3);
+  if (indefinite < -1)
     return ASN1_DER_ERROR;
 
-  counter2 = len3 + 1;
+  counter = len3;
+  tot_len = 0;
+  if (indefinite >= 0)
+    indefinite += len3;
 
-  if (len2 == -1)
-    counter_end = der_len - 2;
-  else
-    counter_end = der_len;
-
-  while (counter2 < counter_end)
+  while (1)
     {
-      len2 = asn1_get_length_der (der + counter2, der_len - counter2, &len3);
+      if (indefinite == -1)
+	{
+	  if (_asn1_is_eoc (der + counter, len - counter))
+	    {
+	      counter += 2;
+	      break;
+	    }
+	}
+      else if (counter >= indefinite)
+	{
+	  if (counter > indefinite)
+	    return ASN1_DER_ERROR;
+	  break;
+	}
 
-      if (len2 < -1)
+      if (counter >= len || der[counter] != ASN1_TAG_OCTET_STRING)
 	return ASN1_DER_ERROR;
 
-      if (len2 > 0)
-	{
-	  _asn1_append_value (node, der + counter2 + len3, len2);
-	}
-      else
-	{			/* indefinite */
+      counter++;
 
-	  len2 =
-	    _asn1_extract_der_octet (node, der + counter2 + len3,
-				     der_len - counter2 - len3);
-	  if (len2 < 0)
-	    return len2;
-	}
+      len2 = asn1_get_length_der (der + counter, len - counter, &len3);
+      if (len2 <= 0)
+	return ASN1_DER_ERROR;
 
-      counter2 += len2 + len3 + 1;
+      if (value)
+	memcpy (value + tot_len, der + counter + len3, len2);
+      counter += len3 + len2;
+      tot_len += len2;
     }
 
+  *ret_len = counter;
+  *value_len = tot_len;
   return ASN1_SUCCESS;
 }
 
 static asn1_retCode
 _asn1_get_octet_string (const unsigned char *der, ASN1_TYPE node, int *len)
 {
-  int len2, len3, counter, tot_len, indefinite;
-
-  counter = 0;
+  int len2, len3, counter, tot_len;
+  unsigned char *value;
+  asn1_retCode ris;
 
   if (*(der - 1) & ASN1_CLASS_STRUCTURED)
     {
-      tot_len = 0;
-      indefinite = asn1_get_length_der (der, *len, &len3);
-      if (indefinite < -1)
-	return ASN1_DER_ERROR;
-
-      counter += len3;
-      if (indefinite >= 0)
-	indefinite += len3;
-
-      while (1)
-	{
-	  if (counter > (*len))
-	    return ASN1_DER_ERROR;
-
-	  if (indefinite == -1)
-	    {
-	      if ((der[counter] == 0) && (der[counter + 1] == 0))
-		{
-		  counter += 2;
-		  break;
-		}
-	    }
-	  else if (counter >= indefinite)
-	    break;
-
-	  if (der[counter] != ASN1_TAG_OCTET_STRING)
-	    return ASN1_DER_ERROR;
-
-	  counter++;
+      ris = _asn1_get_octet_segments (der, *len, NULL, &counter, &tot_len);
+      if (ris != ASN1_SUCCESS)
+	return ris;
 
-	  len2 = asn1_get_length_der (der + counter, *len - counter, &len3);
-	  if (len2 <= 0)
-	    return ASN1_DER_ERROR;
-
-	  counter += len3 + len2;
-	  tot_len += len2;
-	}
-
-      /* copy */
+      /* the contents of the segments, after their length, in one
+	 allocation */
       if (node)
 	{
-	  unsigned char temp[DER_LEN];
-	  int ret;
-
-	  len2 = sizeof (temp);
-
-	  asn1_length_der (tot_len, temp, &len2);
-	  _asn1_set_value (node, temp, len2);
-
-	  tot_len += len2;
-
-	  ret = _asn1_extract_der_octet (node, der, *len);
-	  if (ret != ASN1_SUCCESS)
-	    return ret;
-
+	  asn1_length_der (tot_len, NULL, &len2);
+	  value = _asn1_pool_malloc (len2 + tot_len);
+	  if (value == NULL)
+	    return ASN1_MEM_ALLOC_ERROR;
+
+	  asn1_length_der (tot_len, value, &len2);
+	  _asn1_get_octet_segments (der, *len, value + len2, &len3,
+				    &tot_len);
+	  _asn1_set_value_m (node, value, len2 + tot_len);
 	}
     }
   else
@@ -736,8 +904,13 @@ _asn1_get_octet_string (const unsigned char *der, ASN1_TYPE node, int *len)
 
 }
 
+/* Returns in *LEN the length of the encoding with an indefinite
+   length at DER, *LEN being the bytes that can be read.  Fails with
+   ASN1_LIMIT_EXCEEDED when more than MAX_INDEFINITE indefinite
+   lengths are nested, unless MAX_INDEFINITE is 0 or less.  */
 static asn1_retCode
-_asn1_get_indefinite_length_string (const unsigned char *der, int *len)
+_asn1_get_indefinite_length_string (const unsigned char *der, int *len,
+				    int max_indefinite)
 {
   int len2, len3, counter, indefinite;
   unsigned long tag;
@@ -747,7 +920,7 @@ _asn1_get_indefinite_length_string (const unsigned char *der, int *len)
 
   while (1)
     {
-      if ((*len) < counter)
+      if (counter + 2 > (*len))
 	return ASN1_DER_ERROR;
 
       if ((der[counter] == 0) && (der[counter + 1] == 0))
@@ -773,6 +946,8 @@ _asn1_get_indefinite_length_string (const unsigned char *der, int *len)
       if (len2 == -1)
 	{
 	  indefinite++;
+	  if (max_indefinite > 0 && indefinite > max_indefinite)
+	    return ASN1_LIMIT_EXCEEDED;
 	  counter += 1;
 	}
       else
@@ -786,6 +961,90 @@ _asn1_get_indefinite_length_string (const unsigned char *der, int *len)
 
 }
 
+/* Record in ERROR that the decoding failed with CODE on NODE, at
+   OFFSET of the LEN bytes of DER.  NODE is NULL if there is none.  The
+   tags and the name are only read when asked for.  */
+static void
+_asn1_set_error (asn1_error * error, asn1_retCode code, ASN1_TYPE node,
+		 const unsigned char *der, int len, int offset)
+{
+  error->code = code;
+  error->offset = node ? offset : -1;
+  error->node = node;
+  error->der = der;
+  error->der_len = len;
+}
+
+/**
+ * asn1_error_tags:
+ * @error: the error filled by asn1_der_decoding2().
+ * @expected_class: return the class of the tag the element starts
+ *   with, or -1 if it has none.
+ * @expected_tag: return that tag.
+ * @found_class: return the class of the tag at the offset of the
+ *   error, or -1 if none could be read.
+ * @found_tag: return that tag, with the %ASN1_CLASS_STRUCTURED bit.
+ *
+ * Reads the tags of an %ASN1_TAG_ERROR: the one expected by the
+ * element where the decoding stopped, and the one found in the DER.
+ * As for asn1_error_description(), the element and the DER must not
+ * have been deleted since the decoding.
+ **/
+void
+asn1_error_tags (const asn1_error * error, int *expected_class,
+		 unsigned long *expected_tag, int *found_class,
+		 unsigned long *found_tag)
+{
+  ASN1_TYPE p, node = error->node;
+  unsigned char class;
+  unsigned long tag;
+  int tag_len, tag_value, class_value;
+
+  *expected_class = *found_class = -1;
+  *expected_tag = *found_tag = 0;
+
+  if (node == NULL)
+    return;
+
+  if (error->offset < error->der_len
+      && asn1_get_tag_der (error->der + error->offset,
+			   error->der_len - error->offset, &class, &tag_len,
+			   &tag) == ASN1_SUCCESS)
+    {
+      *found_class = class;
+      *found_tag = tag;
+    }
+
+  /* the outer tag, before the one asn1_read_tag() returns */
+  p = NULL;
+  if (node->type & CONST_TAG)
+    for (p = node->down; p && type_field (p->type) != TYPE_TAG; p = p->right)
+      ;
+  if (p)
+    {
+      tag_value = strtoul ((char *) p->value, NULL, 10);
+      if (p->type & CONST_APPLICATION)
+	class_value = ASN1_CLASS_APPLICATION;
+      else if (p->type & CONST_UNIVERSAL)
+	class_value = ASN1_CLASS_UNIVERSAL;
+      else if (p->type & CONST_PRIVATE)
+	class_value = ASN1_CLASS_PRIVATE;
+      else
+	class_value = ASN1_CLASS_CONTEXT_SPECIFIC;
+    }
+  else
+    {
+      tag_value = -1;
+      _asn1_read_tag (node, &tag_value, &class_value);
+    }
+
+  if (tag_value != -1)
+    {
+      *expected_class = class_value;
+      *expected_tag = tag_value;
+    }
+}
+
 /**
  * asn1_der_decoding:
  * @element: pointer to an ASN1 structure.
@@ -809,42 +1068,300 @@ asn1_retCode
 asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		   char *errorDescription)
 {
-  ASN1_TYPE node, p, p2, p3;
+  asn1_error error;
+  asn1_retCode result;
+
+  if (errorDescription == NULL)
+    return asn1_der_decoding2 (element, ider, len, 0, NULL);
+
+  result = asn1_der_decoding2 (element, ider, len, 0, &error);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_error_description (&error, errorDescription);
+      asn1_delete_structure (element);
+    }
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_der_decoding2 (ASN1_TYPE * element, const void *ider, int len,
+		     const asn1_decode_options * options,
+		     asn1_error * error);
+
+/**
+ * asn1_der_decoding2:
+ * @element: pointer to an ASN1 structure.
+ * @ider: vector that contains the DER encoding.
+ * @len: number of bytes of *@ider: @ider[0]..@ider[len-1].
+ * @flags: bitwise or of %ASN1_DECODE_* flags, or 0.
+ * @error: if not %NULL, filled with where the decoding failed when
+ *   an error occurred.
+ *
+ * Same as asn1_der_decoding(), with options.  With
+ * %ASN1_DECODE_KEEP_OFFSETS, the position in @ider of every element
+ * is recorded while decoding, and asn1_read_der_offsets() returns it
+ * without walking @ider again as asn1_der_decoding_startEnd() does.
+ * With %ASN1_DECODE_KEEP_DER, the elements keep a copy of the parts
+ * of @ider that are DER, and asn1_der_coding() copies them while the
+ * elements do not change instead of encoding them again.
+ *
+ * The error records the element and the position where the decoding
+ * stopped, and nothing else: asn1_error_description() builds the text
+ * asn1_der_decoding() returns, and asn1_error_tags() reads the tag
+ * that was expected and the one found.  So that they can, *@ELEMENT
+ * is not deleted on errors when @error is not %NULL, but left
+ * partially decoded for the caller to delete.
+ *
+ * Returns: as asn1_der_decoding(), *@ELEMENT being deleted on errors
+ *   only if @error is %NULL.
+ **/
+asn1_retCode
+asn1_der_decoding2 (ASN1_TYPE * element, const void *ider, int len,
+		    unsigned int flags, asn1_error * error)
+{
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller = _asn1_trace_begin ("asn1_der_decoding2", *element);
+  asn1_decode_options options;
+  asn1_retCode result;
+
+  memset (&options, 0, sizeof (options));
+  options.size = sizeof (options);
+  options.flags = flags;
+
+  result = _asn1_der_decoding2 (element, ider, len, &options, error);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+/**
+ * asn1_der_decoding_options:
+ * @element: pointer to an ASN1 structure.
+ * @ider: vector that contains the DER encoding.
+ * @len: number of bytes of *@ider: @ider[0]..@ider[len-1].
+ * @options: the flags and the limits of the decoding, or %NULL for
+ *   none.
+ * @error: if not %NULL, filled with where the decoding failed when
+ *   an error occurred.
+ *
+ * Same as asn1_der_decoding2(), the flags being those of @options,
+ * with limits on the resources the decoding uses, so that an
+ * application decoding untrusted data bounds the memory and the time
+ * a request takes.  A limit of 0 is no limit.
+ *
+ * The field size must be set to sizeof (asn1_decode_options), so that
+ * the options can grow: the fields that a smaller structure does not
+ * have are 0, and those of a larger one that this version does not
+ * know must be 0.
+ *
+ * The field max_depth limits the levels of elements nested in
+ * *@ELEMENT, max_nodes its elements, those of the type and those
+ * added for the items of the SEQUENCE OF and SET OF, max_value_bytes
+ * the bytes of the values stored in the elements, and max_indefinite
+ * the indefinite lengths nested, including those within an ANY.  The
+ * decoding stops at the element which goes beyond a limit.  The field
+ * max_pool_bytes is only used by asn1_decoder_init().
+ *
+ * Returns: as asn1_der_decoding2(), %ASN1_LIMIT_EXCEEDED if the
+ *   encoding goes beyond a limit of @options, and %ASN1_GENERIC_ERROR
+ *   if the size of @options is not valid.
+ **/
+asn1_retCode
+asn1_der_decoding_options (ASN1_TYPE * element, const void *ider, int len,
+			   const asn1_decode_options * options,
+			   asn1_error * error)
+{
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller =
+    _asn1_trace_begin ("asn1_der_decoding_options", *element);
+  asn1_decode_options known;
+  asn1_retCode result;
+
+  result = _asn1_get_decode_options (options, &known);
+  if (result == ASN1_SUCCESS)
+    result = _asn1_der_decoding2 (element, ider, len, &known, error);
+  else if (error != NULL)
+    _asn1_set_error (error, result, NULL, ider, len, 0);
+  else
+    asn1_delete_structure (element);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+/* Copies OPTIONS, of OPTIONS->size bytes, to *KNOWN, the fields it
+   does not have being 0.  Returns ASN1_GENERIC_ERROR if OPTIONS is too
+   small for the fields of the first version, or sets fields that this
+   version does not know.  */
+asn1_retCode
+_asn1_get_decode_options (const asn1_decode_options * options,
+			  asn1_decode_options * known)
+{
+  const unsigned char *extra;
+  size_t k;
+
+  memset (known, 0, sizeof (*known));
+  known->size = sizeof (*known);
+  if (options == NULL)
+    return ASN1_SUCCESS;
+
+  if (options->size < offsetof (asn1_decode_options, max_indefinite)
+      + sizeof (options->max_indefinite))
+    return ASN1_GENERIC_ERROR;
+
+  extra = (const unsigned char *) options;
+  for (k = sizeof (*known); k < options->size; k++)
+    if (extra[k] != 0)
+      return ASN1_GENERIC_ERROR;
+
+  memcpy (known, options,
+	  options->size < sizeof (*known) ? options->size : sizeof (*known));
+  known->size = sizeof (*known);
+
+  return ASN1_SUCCESS;
+}
+
+/* Returns the number of elements of NODE and below it.  */
+static long
+_asn1_count_nodes (ASN1_TYPE node)
+{
+  ASN1_TYPE p = node;
+  long count = 1;
+
+  while (1)
+    {
+      if (p->down)
+	p = p->down;
+      else
+	{
+	  while (p != node && p->right == NULL)
+	    p = p->up;
+	  if (p == node)
+	    break;
+	  p = p->right;
+	}
+      count++;
+    }
+
+  return count;
+}
+
+/* Checks the limits of OPTIONS on the nesting before the decoding
+   goes into the contents of a structure at level DEPTH, within
+   INDEFINITE structures of indefinite length, itself included.  */
+static asn1_retCode
+_asn1_check_nesting (int depth, int indefinite,
+		     const asn1_decode_options * options)
+{
+  if ((options->max_depth > 0 && depth + 1 > options->max_depth)
+      || (options->max_indefinite > 0
+	  && indefinite > options->max_indefinite))
+    return ASN1_LIMIT_EXCEEDED;
+
+  return ASN1_SUCCESS;
+}
+
+/* Returns the indefinite lengths OPTIONS let nest within INDEFINITE
+   ones, for _asn1_extract_tag_der.  */
+static int
+_asn1_indefinite_left (int indefinite, const asn1_decode_options * options)
+{
+  if (options->max_indefinite <= 0)
+    return -1;
+  if (indefinite >= options->max_indefinite)
+    return 0;
+
+  return options->max_indefinite - indefinite;
+}
+
+/* Adds to *NODES the elements of ITEM, an item just added to a
+   SEQUENCE OF or SET OF, and checks the limit of OPTIONS.  *NODES
+   starts with the elements of the type.  */
+static asn1_retCode
+_asn1_count_item (ASN1_TYPE item, const asn1_decode_options * options,
+		  long *nodes)
+{
+  if (options->max_nodes <= 0)
+    return ASN1_SUCCESS;
+
+  *nodes += _asn1_count_nodes (item);
+  if (*nodes > options->max_nodes)
+    return ASN1_LIMIT_EXCEEDED;
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode
+_asn1_der_decoding2 (ASN1_TYPE * element, const void *ider, int len,
+		     const asn1_decode_options * options,
+		     asn1_error * error)
+{
+  ASN1_TYPE node, p, p2, p3, last, from = NULL;
   char temp[128];
   int counter, len2, len3, len4, move, ris, tlen;
   unsigned char class;
   unsigned long tag;
-  int indefinite, result;
+  int indefinite, max_indefinite, result;
+  /* the level of P under NODE, and the structures it is in which have
+     an indefinite length */
+  int depth = 0, nested_indefinite = 0;
+  unsigned int flags = options->flags;
+  long nodes = 0, value_bytes = 0;
   const unsigned char *der = ider;
 
   node = *element;
 
   if (node == ASN1_TYPE_EMPTY)
-    return ASN1_ELEMENT_NOT_FOUND;
-
-  if (node->type & CONST_OPTION)
     {
-      asn1_delete_structure (element);
-      return ASN1_GENERIC_ERROR;
+      if (error != NULL)
+	_asn1_set_error (error, ASN1_ELEMENT_NOT_FOUND, NULL, der, len, 0);
+      return ASN1_ELEMENT_NOT_FOUND;
     }
 
   counter = 0;
   move = DOWN;
   p = node;
+
+  if (node->type & CONST_OPTION)
+    {
+      result = ASN1_GENERIC_ERROR;
+      goto cleanup;
+    }
+
+  /* the elements of the type count as those of the items */
+  if (options->max_nodes > 0)
+    {
+      nodes = _asn1_count_nodes (node);
+      if (nodes > options->max_nodes)
+	{
+	  result = ASN1_LIMIT_EXCEEDED;
+	  goto cleanup;
+	}
+    }
+
+  _asn1_set_modified (node);
+
   while (1)
     {
       ris = ASN1_SUCCESS;
       if (move != UP)
 	{
+	  /* for the EXPLICIT tags of p */
+	  max_indefinite = _asn1_indefinite_left (nested_indefinite, options);
+
 	  if (p->type & CONST_SET)
 	    {
 	      p2 = _asn1_find_up (p);
 	      len2 = strtol (p2->value, NULL, 10);
 	      if (len2 == -1)
 		{
-		  if (!der[counter] && !der[counter + 1])
+		  if (_asn1_is_eoc (der + counter, len - counter))
 		    {
 		      p = p2;
+		      depth--;
 		      move = UP;
 		      counter += 2;
 		      continue;
@@ -853,36 +1370,48 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      else if (counter == len2)
 		{
 		  p = p2;
+		  depth--;
 		  move = UP;
 		  continue;
 		}
 	      else if (counter > len2)
 		{
-		  asn1_delete_structure (element);
-		  return ASN1_DER_ERROR;
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
 		}
 	      p2 = p2->down;
 	      while (p2)
 		{
 		  if ((p2->type & CONST_SET) && (p2->type & CONST_NOT_USED))
 		    {
+		      _asn1_trace (ASN1_TRACE_SET, set, p2, counter);
 		      if (type_field (p2->type) != TYPE_CHOICE)
 			ris =
 			  _asn1_extract_tag_der (p2, der + counter,
-						 len - counter, &len2);
+						 len - counter, &len2,
+						 max_indefinite);
 		      else
 			{
 			  p3 = p2->down;
 			  while (p3)
 			    {
+			      _asn1_trace (ASN1_TRACE_CHOICE, choice, p3,
+					   counter);
 			      ris =
 				_asn1_extract_tag_der (p3, der + counter,
-						       len - counter, &len2);
-			      if (ris == ASN1_SUCCESS)
+						       len - counter, &len2,
+						       max_indefinite);
+			      if ((ris == ASN1_SUCCESS)
+				  || (ris == ASN1_LIMIT_EXCEEDED))
 				break;
 			      p3 = p3->right;
 			    }
 			}
+		      if (ris == ASN1_LIMIT_EXCEEDED)
+			{
+			  result = ris;
+			  goto cleanup;
+			}
 		      if (ris == ASN1_SUCCESS)
 			{
 			  p2->type &= ~CONST_NOT_USED;
@@ -894,8 +1423,8 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		}
 	      if (p2 == NULL)
 		{
-		  asn1_delete_structure (element);
-		  return ASN1_DER_ERROR;
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
 		}
 	    }
 
@@ -911,7 +1440,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		      move = RIGHT;
 		    }
 		  else
-		    move = UP;
+		    {
+		      move = UP;
+		      depth--;
+		    }
 
 		  if (p->type & CONST_OPTION)
 		    asn1_delete_structure (&p);
@@ -923,12 +1455,16 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 
 	  if (type_field (p->type) == TYPE_CHOICE)
 	    {
+	      if (flags & ASN1_DECODE_KEEP_OFFSETS)
+		p->offset_start = counter;
 	      while (p->down)
 		{
+		  _asn1_trace (ASN1_TRACE_CHOICE, choice, p->down, counter);
 		  if (counter < len)
 		    ris =
 		      _asn1_extract_tag_der (p->down, der + counter,
-					     len - counter, &len2);
+					     len - counter, &len2,
+					     max_indefinite);
 		  else
 		    ris = ASN1_DER_ERROR;
 		  if (ris == ASN1_SUCCESS)
@@ -940,10 +1476,11 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 			}
 		      break;
 		    }
-		  else if (ris == ASN1_ERROR_TYPE_ANY)
+		  else if ((ris == ASN1_ERROR_TYPE_ANY)
+			   || (ris == ASN1_LIMIT_EXCEEDED))
 		    {
-		      asn1_delete_structure (element);
-		      return ASN1_ERROR_TYPE_ANY;
+		      result = ris;
+		      goto cleanup;
 		    }
 		  else
 		    {
@@ -956,12 +1493,15 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		{
 		  if (!(p->type & CONST_OPTION))
 		    {
-		      asn1_delete_structure (element);
-		      return ASN1_DER_ERROR;
+		      result = ASN1_DER_ERROR;
+		      goto cleanup;
 		    }
 		}
 	      else
-		p = p->down;
+		{
+		  p = p->down;
+		  depth++;
+		}
 	    }
 
 	  if ((p->type & CONST_OPTION) || (p->type & CONST_DEFAULT))
@@ -974,7 +1514,13 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 
 	  if (ris == ASN1_SUCCESS)
 	    ris =
-	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2);
+	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2,
+				     max_indefinite);
+	  if (ris == ASN1_LIMIT_EXCEEDED)
+	    {
+	      result = ris;
+	      goto cleanup;
+	    }
 	  if (ris != ASN1_SUCCESS)
 	    {
 	      if (p->type & CONST_OPTION)
@@ -989,26 +1535,28 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		}
 	      else
 		{
-		  if (errorDescription != NULL)
-		    _asn1_error_description_tag_error (p, errorDescription);
-
-		  asn1_delete_structure (element);
-		  return ASN1_TAG_ERROR;
+		  result = ASN1_TAG_ERROR;
+		  goto cleanup;
 		}
 	    }
 	  else
-	    counter += len2;
+	    {
+	      if (flags & ASN1_DECODE_KEEP_OFFSETS)
+		p->offset_start = counter;
+	      counter += len2;
+	    }
 	}
 
       if (ris == ASN1_SUCCESS)
 	{
+	  last = p;
 	  switch (type_field (p->type))
 	    {
 	    case TYPE_NULL:
 	      if (der[counter])
 		{
-		  asn1_delete_structure (element);
-		  return ASN1_DER_ERROR;
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
 		}
 	      counter++;
 	      move = RIGHT;
@@ -1016,8 +1564,8 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	    case TYPE_BOOLEAN:
 	      if (der[counter++] != 1)
 		{
-		  asn1_delete_structure (element);
-		  return ASN1_DER_ERROR;
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
 		}
 	      if (der[counter++] == 0)
 		_asn1_set_value (p, "F", 1);
@@ -1030,26 +1578,26 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      len2 =
 		asn1_get_length_der (der + counter, len - counter, &len3);
 	      if (len2 < 0)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (len2 + len3 > len - counter)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      _asn1_set_value (p, der + counter, len3 + len2);
 	      counter += len3 + len2;
 	      move = RIGHT;
 	      break;
 	    case TYPE_OBJECT_ID:
 	      result =
-		_asn1_get_objectid_der (der + counter, len - counter, &len2,
-					temp, sizeof (temp));
+		_asn1_decode_objectid (p, der + counter, len - counter, &len2);
 	      if (result != ASN1_SUCCESS)
-		{
-		  asn1_delete_structure (element);
-		  return result;
-		}
-
-	      tlen = strlen (temp);
-	      if (tlen > 0)
-		_asn1_set_value (p, temp, tlen + 1);
+		{
+		  goto cleanup;
+		}
 	      counter += len2;
 	      move = RIGHT;
 	      break;
@@ -1059,8 +1607,7 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 				    sizeof (temp) - 1);
 	      if (result != ASN1_SUCCESS)
 		{
-		  asn1_delete_structure (element);
-		  return result;
+		  goto cleanup;
 		}
 	      tlen = strlen (temp);
 	      if (tlen > 0)
@@ -1072,7 +1619,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      len3 = len - counter;
 	      ris = _asn1_get_octet_string (der + counter, p, &len3);
 	      if (ris != ASN1_SUCCESS)
-		return ris;
+		{
+		  result = ris;
+		  goto cleanup;
+		}
 	      counter += len3;
 	      move = RIGHT;
 	      break;
@@ -1080,9 +1630,15 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      len2 =
 		asn1_get_length_der (der + counter, len - counter, &len3);
 	      if (len2 < 0)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (len3 + len2 > len - counter)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      _asn1_set_value (p, der + counter, len3 + len2);
 	      counter += len3 + len2;
 	      move = RIGHT;
@@ -1091,9 +1647,15 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      len2 =
 		asn1_get_length_der (der + counter, len - counter, &len3);
 	      if (len2 < 0)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (len3 + len2 > len - counter)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      _asn1_set_value (p, der + counter, len3 + len2);
 	      counter += len3 + len2;
 	      move = RIGHT;
@@ -1106,24 +1668,20 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  _asn1_set_value (p, NULL, 0);
 		  if (len2 == -1)
 		    {		/* indefinite length method */
-		      if (len - counter + 1 > 0)
+		      nested_indefinite--;
+		      if (!_asn1_is_eoc (der + counter, len - counter))
 			{
-			  if ((der[counter]) || der[counter + 1])
-			    {
-			      asn1_delete_structure (element);
-			      return ASN1_DER_ERROR;
-			    }
+			  result = ASN1_DER_ERROR;
+			  goto cleanup;
 			}
-		      else
-			return ASN1_DER_ERROR;
 		      counter += 2;
 		    }
 		  else
 		    {		/* definite length method */
 		      if (len2 != counter)
 			{
-			  asn1_delete_structure (element);
-			  return ASN1_DER_ERROR;
+			  result = ASN1_DER_ERROR;
+			  goto cleanup;
 			}
 		    }
 		  move = RIGHT;
@@ -1133,7 +1691,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  len3 =
 		    asn1_get_length_der (der + counter, len - counter, &len2);
 		  if (len3 < -1)
-		    return ASN1_DER_ERROR;
+		    {
+		      result = ASN1_DER_ERROR;
+		      goto cleanup;
+		    }
 		  counter += len2;
 		  if (len3 > 0)
 		    {
@@ -1162,8 +1723,16 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  else
 		    {		/* indefinite length method */
 		      _asn1_set_value (p, "-1", 3);
+		      nested_indefinite++;
 		      move = DOWN;
 		    }
+		  if (move == DOWN)
+		    {
+		      result =
+			_asn1_check_nesting (depth, nested_indefinite, options);
+		      if (result != ASN1_SUCCESS)
+			goto cleanup;
+		    }
 		}
 	      break;
 	    case TYPE_SEQUENCE_OF:
@@ -1174,35 +1743,53 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  if (len2 == -1)
 		    {		/* indefinite length method */
 		      if ((counter + 2) > len)
-			return ASN1_DER_ERROR;
-		      if ((der[counter]) || der[counter + 1])
 			{
-			  _asn1_append_sequence_set (p);
-			  p = p->down;
-			  while (p->right)
-			    p = p->right;
+			  result = ASN1_DER_ERROR;
+			  goto cleanup;
+			}
+		      if (!_asn1_is_eoc (der + counter, len - counter))
+			{
+			  p2 = _asn1_append_sequence_item (p, from);
+			  if (p2 == NULL)
+			    {
+			      result = ASN1_MEM_ALLOC_ERROR;
+			      goto cleanup;
+			    }
+			  result = _asn1_count_item (p2, options, &nodes);
+			  if (result != ASN1_SUCCESS)
+			    goto cleanup;
+			  p = p2;
+			  depth++;
 			  move = RIGHT;
 			  continue;
 			}
 		      _asn1_set_value (p, NULL, 0);
+		      nested_indefinite--;
 		      counter += 2;
 		    }
 		  else
 		    {		/* definite length method */
 		      if (len2 > counter)
 			{
-			  _asn1_append_sequence_set (p);
-			  p = p->down;
-			  while (p->right)
-			    p = p->right;
+			  p2 = _asn1_append_sequence_item (p, from);
+			  if (p2 == NULL)
+			    {
+			      result = ASN1_MEM_ALLOC_ERROR;
+			      goto cleanup;
+			    }
+			  result = _asn1_count_item (p2, options, &nodes);
+			  if (result != ASN1_SUCCESS)
+			    goto cleanup;
+			  p = p2;
+			  depth++;
 			  move = RIGHT;
 			  continue;
 			}
 		      _asn1_set_value (p, NULL, 0);
 		      if (len2 != counter)
 			{
-			  asn1_delete_structure (element);
-			  return ASN1_DER_ERROR;
+			  result = ASN1_DER_ERROR;
+			  goto cleanup;
 			}
 		    }
 		}
@@ -1211,7 +1798,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  len3 =
 		    asn1_get_length_der (der + counter, len - counter, &len2);
 		  if (len3 < -1)
-		    return ASN1_DER_ERROR;
+		    {
+		      result = ASN1_DER_ERROR;
+		      goto cleanup;
+		    }
 		  counter += len2;
 		  if (len3)
 		    {
@@ -1226,14 +1816,30 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		      else
 			{	/* indefinite length method */
 			  _asn1_set_value (p, "-1", 3);
+			  nested_indefinite++;
 			}
+		      result =
+			_asn1_check_nesting (depth, nested_indefinite, options);
+		      if (result != ASN1_SUCCESS)
+			goto cleanup;
 		      p2 = p->down;
 		      while ((type_field (p2->type) == TYPE_TAG)
 			     || (type_field (p2->type) == TYPE_SIZE))
 			p2 = p2->right;
 		      if (p2->right == NULL)
-			_asn1_append_sequence_set (p);
+			{
+			  p3 = _asn1_append_sequence_item (p, p2);
+			  if (p3 == NULL)
+			    {
+			      result = ASN1_MEM_ALLOC_ERROR;
+			      goto cleanup;
+			    }
+			  result = _asn1_count_item (p3, options, &nodes);
+			  if (result != ASN1_SUCCESS)
+			    goto cleanup;
+			}
 		      p = p2;
+		      depth++;
 		    }
 		}
 	      move = RIGHT;
@@ -1242,16 +1848,28 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      if (asn1_get_tag_der
 		  (der + counter, len - counter, &class, &len2,
 		   &tag) != ASN1_SUCCESS)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (counter + len2 > len)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      len4 =
 		asn1_get_length_der (der + counter + len2,
 				     len - counter - len2, &len3);
 	      if (len4 < -1)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (len4 > len - counter + len2 + len3)
-		return ASN1_DER_ERROR;
+		{
+		  result = ASN1_DER_ERROR;
+		  goto cleanup;
+		}
 	      if (len4 != -1)
 		{
 		  len2 += len4;
@@ -1266,13 +1884,28 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		  else
 		    indefinite = 0;
 
+		  /* the indefinite lengths within the ANY add to those it
+		     is in */
+		  max_indefinite = 0;
+		  if (options->max_indefinite > 0)
+		    {
+		      max_indefinite = options->max_indefinite
+			- nested_indefinite - indefinite;
+		      if (max_indefinite <= 0)
+			{
+			  result = ASN1_LIMIT_EXCEEDED;
+			  goto cleanup;
+			}
+		    }
+
 		  len2 = len - counter;
 		  ris =
-		    _asn1_get_indefinite_length_string (der + counter, &len2);
+		    _asn1_get_indefinite_length_string (der + counter, &len2,
+							max_indefinite);
 		  if (ris != ASN1_SUCCESS)
 		    {
-		      asn1_delete_structure (element);
-		      return ris;
+		      result = ris;
+		      goto cleanup;
 		    }
 
 		  _asn1_set_value_octet (p, der + counter, len2);
@@ -1282,14 +1915,14 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 		     an indefinite length method. */
 		  if (indefinite)
 		    {
-		      if (!der[counter] && !der[counter + 1])
+		      if (_asn1_is_eoc (der + counter, len - counter))
 			{
 			  counter += 2;
 			}
 		      else
 			{
-			  asn1_delete_structure (element);
-			  return ASN1_DER_ERROR;
+			  result = ASN1_DER_ERROR;
+			  goto cleanup;
 			}
 		    }
 		}
@@ -1299,6 +1932,23 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	      move = (move == UP) ? RIGHT : DOWN;
 	      break;
 	    }
+
+	  /* P is done, unless it went to the items of a SEQUENCE OF */
+	  if ((move == RIGHT) && (p == last))
+	    {
+	      if (flags & ASN1_DECODE_KEEP_OFFSETS)
+		{
+		  p->offset_len = counter - p->offset_start;
+		  p->type |= CONST_OFFSETS;
+		}
+	      value_bytes += p->value_len;
+	      if (options->max_value_bytes > 0
+		  && value_bytes > options->max_value_bytes)
+		{
+		  result = ASN1_LIMIT_EXCEEDED;
+		  goto cleanup;
+		}
+	    }
 	}
 
       if (p == node && move != DOWN)
@@ -1307,7 +1957,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
       if (move == DOWN)
 	{
 	  if (p->down)
-	    p = p->down;
+	    {
+	      p = p->down;
+	      depth++;
+	    }
 	  else
 	    move = RIGHT;
 	}
@@ -1319,18 +1972,35 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 	    move = UP;
 	}
       if (move == UP)
-	p = _asn1_find_up (p);
+	{
+	  /* the last child, when P is a SEQUENCE OF */
+	  from = p;
+	  p = _asn1_find_up (p);
+	  depth--;
+	}
     }
 
   _asn1_delete_not_used (*element);
 
   if (counter != len)
     {
-      asn1_delete_structure (element);
-      return ASN1_DER_ERROR;
+      result = ASN1_DER_ERROR;
+      goto cleanup;
     }
 
+  /* keep the input for asn1_der_coding where it is DER */
+  if (options->flags & ASN1_DECODE_KEEP_DER)
+    _asn1_cache_der (*element, der, len, 1);
+
   return ASN1_SUCCESS;
+
+cleanup:
+  /* the element of the error is deleted by the caller */
+  if (error != NULL)
+    _asn1_set_error (error, result, p, der, len, counter);
+  else
+    asn1_delete_structure (element);
+  return result;
 }
 
 #define FOUND        1
@@ -1338,6 +2008,10 @@ asn1_der_decoding (ASN1_TYPE * element, const void *ider, int len,
 #define OTHER_BRANCH 3
 #define EXIT         4
 
+static asn1_retCode
+_asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
+			    const void *ider, int len, char *errorDescription);
+
 /**
  * asn1_der_decoding_element:
  * @structure: pointer to an ASN1 structure
@@ -1363,7 +2037,24 @@ asn1_retCode
 asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 			   const void *ider, int len, char *errorDescription)
 {
-  ASN1_TYPE node, p, p2, p3, nodeFound = ASN1_TYPE_EMPTY;
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller =
+    _asn1_trace_begin ("asn1_der_decoding_element", *structure);
+  asn1_retCode result;
+
+  result = _asn1_der_decoding_element (structure, elementName, ider, len,
+				       errorDescription);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
+			    const void *ider, int len, char *errorDescription)
+{
+  ASN1_TYPE node, p, p2, p3, nodeFound = ASN1_TYPE_EMPTY, from = NULL;
   char temp[128], currentName[ASN1_MAX_NAME_SIZE * 10], *dot_p, *char_p;
   int nameLen = ASN1_MAX_NAME_SIZE * 10 - 1, state;
   int counter, len2, len3, len4, move, ris, tlen;
@@ -1389,6 +2080,10 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
       return ASN1_GENERIC_ERROR;
     }
 
+  /* the values change in place */
+  _asn1_set_modified (node);
+  _asn1_clear_der_cache (node);
+
   if ((*structure)->name)
     {				/* Has *structure got a name? */
       nameLen -= strlen ((*structure)->name);
@@ -1453,18 +2148,21 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 		{
 		  if ((p2->type & CONST_SET) && (p2->type & CONST_NOT_USED))
 		    {
+		      _asn1_trace (ASN1_TRACE_SET, set, p2, counter);
 		      if (type_field (p2->type) != TYPE_CHOICE)
 			ris =
 			  _asn1_extract_tag_der (p2, der + counter,
-						 len - counter, &len2);
+						 len - counter, &len2, -1);
 		      else
 			{
 			  p3 = p2->down;
 			  while (p3)
 			    {
+			      _asn1_trace (ASN1_TRACE_CHOICE, choice, p3,
+					   counter);
 			      ris =
 				_asn1_extract_tag_der (p3, der + counter,
-						       len - counter, &len2);
+						       len - counter, &len2, -1);
 			      if (ris == ASN1_SUCCESS)
 				break;
 			      p3 = p3->right;
@@ -1512,10 +2210,11 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 	    {
 	      while (p->down)
 		{
+		  _asn1_trace (ASN1_TRACE_CHOICE, choice, p->down, counter);
 		  if (counter < len)
 		    ris =
 		      _asn1_extract_tag_der (p->down, der + counter,
-					     len - counter, &len2);
+					     len - counter, &len2, -1);
 		  else
 		    ris = ASN1_DER_ERROR;
 		  if (ris == ASN1_SUCCESS)
@@ -1561,7 +2260,8 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 
 	  if (ris == ASN1_SUCCESS)
 	    ris =
-	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2);
+	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2,
+				     -1);
 	  if (ris != ASN1_SUCCESS)
 	    {
 	      if (p->type & CONST_OPTION)
@@ -1649,18 +2349,13 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 	      if (state == FOUND)
 		{
 		  result =
-		    _asn1_get_objectid_der (der + counter, len - counter,
-					    &len2, temp, sizeof (temp));
+		    _asn1_decode_objectid (p, der + counter, len - counter,
+					   &len2);
 		  if (result != ASN1_SUCCESS)
 		    {
 		      return result;
 		    }
 
-		  tlen = strlen (temp);
-
-		  if (tlen > 0)
-		    _asn1_set_value (p, temp, tlen + 1);
-
 		  if (p == nodeFound)
 		    state = EXIT;
 		}
@@ -1765,7 +2460,7 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 		  _asn1_set_value (p, NULL, 0);
 		  if (len2 == -1)
 		    {		/* indefinite length method */
-		      if ((der[counter]) || der[counter + 1])
+		      if (!_asn1_is_eoc (der + counter, len - counter))
 			{
 			  asn1_delete_structure (structure);
 			  return ASN1_DER_ERROR;
@@ -1844,10 +2539,13 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 		  len2 = strtol (p->value, NULL, 10);
 		  if (len2 > counter)
 		    {
-		      _asn1_append_sequence_set (p);
-		      p = p->down;
-		      while (p->right)
-			p = p->right;
+		      p2 = _asn1_append_sequence_item (p, from);
+		      if (p2 == NULL)
+			{
+			  asn1_delete_structure (structure);
+			  return ASN1_MEM_ALLOC_ERROR;
+			}
+		      p = p2;
 		      move = RIGHT;
 		      continue;
 		    }
@@ -1938,7 +2636,8 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 
 		  len2 = len - counter;
 		  ris =
-		    _asn1_get_indefinite_length_string (der + counter, &len2);
+		    _asn1_get_indefinite_length_string (der + counter, &len2,
+							0);
 		  if (ris != ASN1_SUCCESS)
 		    {
 		      asn1_delete_structure (structure);
@@ -1959,7 +2658,7 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 		     an indefinite length method. */
 		  if (indefinite)
 		    {
-		      if (!der[counter] && !der[counter + 1])
+		      if (_asn1_is_eoc (der + counter, len - counter))
 			{
 			  counter += 2;
 			}
@@ -2065,6 +2764,8 @@ asn1_der_decoding_element (ASN1_TYPE * structure, const char *elementName,
 
       if (move == UP)
 	{
+	  /* the last child, when P is a SEQUENCE OF */
+	  from = p;
 	  p = _asn1_find_up (p);
 
 	  if (state != FOUND)
@@ -2175,7 +2876,7 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 	      len2 = strtol (p2->value, NULL, 10);
 	      if (len2 == -1)
 		{
-		  if (!der[counter] && !der[counter + 1])
+		  if (_asn1_is_eoc (der + counter, len - counter))
 		    {
 		      p = p2;
 		      move = UP;
@@ -2199,13 +2900,13 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 		      if (type_field (p2->type) != TYPE_CHOICE)
 			ris =
 			  _asn1_extract_tag_der (p2, der + counter,
-						 len - counter, &len2);
+						 len - counter, &len2, -1);
 		      else
 			{
 			  p3 = p2->down;
 			  ris =
 			    _asn1_extract_tag_der (p3, der + counter,
-						   len - counter, &len2);
+						   len - counter, &len2, -1);
 			}
 		      if (ris == ASN1_SUCCESS)
 			{
@@ -2228,14 +2929,15 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 	      p = p->down;
 	      ris =
 		_asn1_extract_tag_der (p, der + counter, len - counter,
-				       &len2);
+				       &len2, -1);
 	      if (p == node_to_find)
 		*start = counter;
 	    }
 
 	  if (ris == ASN1_SUCCESS)
 	    ris =
-	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2);
+	      _asn1_extract_tag_der (p, der + counter, len - counter, &len2,
+				     -1);
 	  if (ris != ASN1_SUCCESS)
 	    {
 	      if (p->type & CONST_OPTION)
@@ -2337,7 +3039,7 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 		}
 	      else
 		{
-		  if (!der[counter] && !der[counter + 1])	/* indefinite length method */
+		  if (_asn1_is_eoc (der + counter, len - counter))	/* indefinite length method */
 		    counter += 2;
 		  move = RIGHT;
 		}
@@ -2351,7 +3053,7 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 		  if (len3 < -1)
 		    return ASN1_DER_ERROR;
 		  counter += len2;
-		  if ((len3 == -1) && !der[counter] && !der[counter + 1])
+		  if ((len3 == -1) && _asn1_is_eoc (der + counter, len - counter))
 		    counter += 2;
 		  else if (len3)
 		    {
@@ -2364,7 +3066,7 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 		}
 	      else
 		{
-		  if (!der[counter] && !der[counter + 1])	/* indefinite length method */
+		  if (_asn1_is_eoc (der + counter, len - counter))	/* indefinite length method */
 		    counter += 2;
 		}
 	      move = RIGHT;
@@ -2397,7 +3099,8 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 
 		  len2 = len - counter;
 		  ris =
-		    _asn1_get_indefinite_length_string (der + counter, &len2);
+		    _asn1_get_indefinite_length_string (der + counter, &len2,
+							0);
 		  if (ris != ASN1_SUCCESS)
 		    return ris;
 		  counter += len2;
@@ -2406,7 +3109,7 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 		     an indefinite length method. */
 		  if (indefinite)
 		    {
-		      if (!der[counter] && !der[counter + 1])
+		      if (_asn1_is_eoc (der + counter, len - counter))
 			counter += 2;
 		      else
 			return ASN1_DER_ERROR;
@@ -2450,6 +3153,49 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
   return ASN1_ELEMENT_NOT_FOUND;
 }
 
+/**
+ * asn1_read_der_offsets:
+ * @element: pointer to an ASN1 element
+ * @name: name of an element of @element, as for asn1_read_value().
+ * @start: the position of the first byte of the encoding of @name.
+ * @end: the position of the last byte of the encoding of @name.
+ *
+ * Return the position of the encoding of an element in the DER
+ * string @element was decoded from, as asn1_der_decoding_startEnd()
+ * does, when it was decoded with asn1_der_decoding2() and the flag
+ * %ASN1_DECODE_KEEP_OFFSETS.  The DER string is not needed: the
+ * positions were recorded while decoding, and they stay those of the
+ * decoded string when @element is changed afterwards.
+ *
+ * One example is the sequence "tbsCertificate" inside an X509
+ * certificate, whose encoding is signed.
+ *
+ * Returns: %ASN1_SUCCESS if the position is known,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element, and
+ *   %ASN1_VALUE_NOT_FOUND if the position of @name was not recorded.
+ **/
+asn1_retCode
+asn1_read_der_offsets (ASN1_TYPE element, const char *name,
+		       int *start, int *end)
+{
+  ASN1_TYPE node;
+
+  node = asn1_find_node (element, name);
+  if (node == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  if (!(node->type & CONST_OFFSETS) || node->offset_len == 0)
+    return ASN1_VALUE_NOT_FOUND;
+
+  *start = node->offset_start;
+  *end = node->offset_start + node->offset_len - 1;
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode
+_asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element);
+
 /**
  * asn1_expand_any_defined_by:
  * @definitions: ASN1 definitions
@@ -2469,12 +3215,25 @@ asn1_der_decoding_startEnd (ASN1_TYPE element, const void *ider, int len,
 asn1_retCode
 asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element)
 {
-  char definitionsName[ASN1_MAX_NAME_SIZE], name[2 * ASN1_MAX_NAME_SIZE + 1],
-    value[ASN1_MAX_NAME_SIZE];
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller =
+    _asn1_trace_begin ("asn1_expand_any_defined_by", *element);
+  asn1_retCode result;
+
+  result = _asn1_expand_any_defined_by (definitions, element);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element)
+{
+  char definitionsName[ASN1_MAX_NAME_SIZE], name[2 * ASN1_MAX_NAME_SIZE + 1];
   asn1_retCode retCode = ASN1_SUCCESS, result;
-  int len, len2, len3;
+  int len2, len3;
   ASN1_TYPE p, p2, p3, aux = ASN1_TYPE_EMPTY;
-  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
 
   if ((definitions == ASN1_TYPE_EMPTY) || (*element == ASN1_TYPE_EMPTY))
     return ASN1_ELEMENT_NOT_FOUND;
@@ -2549,95 +3308,72 @@ asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element)
 		}
 
 	      /* search the OBJECT_ID into definitions */
-	      p2 = definitions->down;
-	      while (p2)
+	      p2 = _asn1_find_oid_assignment (definitions, p3->value);
+	      if (!p2)
+		{
+		  retCode = ASN1_ERROR_TYPE_ANY;
+		  break;
+		}
+
+	      p2 = p2->right;	/* pointer to the structure to
+				   use for expansion */
+	      while ((p2) && (p2->type & CONST_ASSIGN))
+		p2 = p2->right;
+
+	      if (p2)
 		{
-		  if ((type_field (p2->type) == TYPE_OBJECT_ID) &&
-		      (p2->type & CONST_ASSIGN))
+		  _asn1_trace (ASN1_TRACE_ANY, any, p, -1);
+		  strcpy (name, definitionsName);
+		  strcat (name, p2->name);
+
+		  result = asn1_create_element (definitions, name, &aux);
+		  if (result == ASN1_SUCCESS)
 		    {
-		      strcpy (name, definitionsName);
-		      strcat (name, p2->name);
+		      _asn1_set_name (aux, p->name);
+		      len2 =
+			asn1_get_length_der (p->value, p->value_len, &len3);
+		      if (len2 < 0)
+			return ASN1_DER_ERROR;
 
-		      len = ASN1_MAX_NAME_SIZE;
 		      result =
-			asn1_read_value (definitions, name, value, &len);
-
-		      if ((result == ASN1_SUCCESS)
-			  && (!strcmp (p3->value, value)))
+			asn1_der_decoding (&aux, p->value + len3, len2, NULL);
+		      if (result == ASN1_SUCCESS)
 			{
-			  p2 = p2->right;	/* pointer to the structure to
-						   use for expansion */
-			  while ((p2) && (p2->type & CONST_ASSIGN))
-			    p2 = p2->right;
 
-			  if (p2)
-			    {
-			      strcpy (name, definitionsName);
-			      strcat (name, p2->name);
+			  _asn1_set_right (aux, p->right);
+			  _asn1_set_right (p, aux);
 
-			      result =
-				asn1_create_element (definitions, name, &aux);
-			      if (result == ASN1_SUCCESS)
-				{
-				  _asn1_set_name (aux, p->name);
-				  len2 =
-				    asn1_get_length_der (p->value,
-							 p->value_len, &len3);
-				  if (len2 < 0)
-				    return ASN1_DER_ERROR;
-
-				  result =
-				    asn1_der_decoding (&aux, p->value + len3,
-						       len2,
-						       errorDescription);
-				  if (result == ASN1_SUCCESS)
-				    {
-
-				      _asn1_set_right (aux, p->right);
-				      _asn1_set_right (p, aux);
-
-				      result = asn1_delete_structure (&p);
-				      if (result == ASN1_SUCCESS)
-					{
-					  p = aux;
-					  aux = ASN1_TYPE_EMPTY;
-					  break;
-					}
-				      else
-					{	/* error with asn1_delete_structure */
-					  asn1_delete_structure (&aux);
-					  retCode = result;
-					  break;
-					}
-				    }
-				  else
-				    {	/* error with asn1_der_decoding */
-				      retCode = result;
-				      break;
-				    }
-				}
-			      else
-				{	/* error with asn1_create_element */
-				  retCode = result;
-				  break;
-				}
+			  result = asn1_delete_structure (&p);
+			  if (result == ASN1_SUCCESS)
+			    {
+			      p = aux;
+			      aux = ASN1_TYPE_EMPTY;
+			      break;
 			    }
 			  else
-			    {	/* error with the pointer to the structure to exapand */
-			      retCode = ASN1_ERROR_TYPE_ANY;
+			    {	/* error with asn1_delete_structure */
+			      asn1_delete_structure (&aux);
+			      retCode = result;
 			      break;
 			    }
 			}
+		      else
+			{	/* error with asn1_der_decoding */
+			  retCode = result;
+			  break;
+			}
 		    }
-		  p2 = p2->right;
-		}		/* end while */
-
-	      if (!p2)
-		{
+		  else
+		    {		/* error with asn1_create_element */
+		      retCode = result;
+		      break;
+		    }
+		}
+	      else
+		{		/* error with the pointer to the structure to exapand */
 		  retCode = ASN1_ERROR_TYPE_ANY;
 		  break;
 		}
-
 	    }
 	  break;
 	default:
@@ -2678,6 +3414,10 @@ asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element)
   return retCode;
 }
 
+static asn1_retCode
+_asn1_expand_octet_string (ASN1_TYPE definitions, ASN1_TYPE * element,
+			   const char *octetName, const char *objectName);
+
 /**
  * asn1_expand_octet_string:
  * @definitions: ASN1 definitions
@@ -2700,12 +3440,28 @@ asn1_retCode
 asn1_expand_octet_string (ASN1_TYPE definitions, ASN1_TYPE * element,
 			  const char *octetName, const char *objectName)
 {
-  char name[2 * ASN1_MAX_NAME_SIZE + 1], value[ASN1_MAX_NAME_SIZE];
+  int site = _asn1_enter_site (ASN1_ALLOC_DECODE);
+  const char *caller =
+    _asn1_trace_begin ("asn1_expand_octet_string", *element);
+  asn1_retCode result;
+
+  result = _asn1_expand_octet_string (definitions, element, octetName,
+				      objectName);
+  _asn1_trace_end (caller, result);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_expand_octet_string (ASN1_TYPE definitions, ASN1_TYPE * element,
+			   const char *octetName, const char *objectName)
+{
+  char name[2 * ASN1_MAX_NAME_SIZE + 1];
   asn1_retCode retCode = ASN1_SUCCESS, result;
-  int len, len2, len3;
+  int len2, len3;
   ASN1_TYPE p2, aux = ASN1_TYPE_EMPTY;
   ASN1_TYPE octetNode = ASN1_TYPE_EMPTY, objectNode = ASN1_TYPE_EMPTY;
-  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
 
   if ((definitions == ASN1_TYPE_EMPTY) || (*element == ASN1_TYPE_EMPTY))
     return ASN1_ELEMENT_NOT_FOUND;
@@ -2730,92 +3486,61 @@ asn1_expand_octet_string (ASN1_TYPE definitions, ASN1_TYPE * element,
 
 
   /* search the OBJECT_ID into definitions */
-  p2 = definitions->down;
-  while (p2)
-    {
-      if ((type_field (p2->type) == TYPE_OBJECT_ID) &&
-	  (p2->type & CONST_ASSIGN))
-	{
-	  strcpy (name, definitions->name);
-	  strcat (name, ".");
-	  strcat (name, p2->name);
-
-	  len = sizeof (value);
-	  result = asn1_read_value (definitions, name, value, &len);
+  p2 = _asn1_find_oid_assignment (definitions, objectNode->value);
+  if (p2 == NULL)
+    return ASN1_VALUE_NOT_VALID;
 
-	  if ((result == ASN1_SUCCESS)
-	      && (!strcmp (objectNode->value, value)))
-	    {
-
-	      p2 = p2->right;	/* pointer to the structure to
+  p2 = p2->right;		/* pointer to the structure to
 				   use for expansion */
-	      while ((p2) && (p2->type & CONST_ASSIGN))
-		p2 = p2->right;
+  while ((p2) && (p2->type & CONST_ASSIGN))
+    p2 = p2->right;
 
-	      if (p2)
-		{
-		  strcpy (name, definitions->name);
-		  strcat (name, ".");
-		  strcat (name, p2->name);
+  if (p2)
+    {
+      _asn1_trace (ASN1_TRACE_ANY, any, octetNode, -1);
+      strcpy (name, definitions->name);
+      strcat (name, ".");
+      strcat (name, p2->name);
 
-		  result = asn1_create_element (definitions, name, &aux);
-		  if (result == ASN1_SUCCESS)
-		    {
-		      _asn1_set_name (aux, octetNode->name);
-		      len2 =
-			asn1_get_length_der (octetNode->value,
-					     octetNode->value_len, &len3);
-		      if (len2 < 0)
-			return ASN1_DER_ERROR;
+      result = asn1_create_element (definitions, name, &aux);
+      if (result == ASN1_SUCCESS)
+	{
+	  _asn1_set_name (aux, octetNode->name);
+	  len2 =
+	    asn1_get_length_der (octetNode->value, octetNode->value_len,
+				 &len3);
+	  if (len2 < 0)
+	    return ASN1_DER_ERROR;
 
-		      result =
-			asn1_der_decoding (&aux, octetNode->value + len3,
-					   len2, errorDescription);
-		      if (result == ASN1_SUCCESS)
-			{
+	  result =
+	    asn1_der_decoding (&aux, octetNode->value + len3, len2, NULL);
+	  if (result == ASN1_SUCCESS)
+	    {
 
-			  _asn1_set_right (aux, octetNode->right);
-			  _asn1_set_right (octetNode, aux);
+	      _asn1_set_right (aux, octetNode->right);
+	      _asn1_set_right (octetNode, aux);
 
-			  result = asn1_delete_structure (&octetNode);
-			  if (result == ASN1_SUCCESS)
-			    {
-			      aux = ASN1_TYPE_EMPTY;
-			      break;
-			    }
-			  else
-			    {	/* error with asn1_delete_structure */
-			      asn1_delete_structure (&aux);
-			      retCode = result;
-			      break;
-			    }
-			}
-		      else
-			{	/* error with asn1_der_decoding */
-			  retCode = result;
-			  break;
-			}
-		    }
-		  else
-		    {		/* error with asn1_create_element */
-		      retCode = result;
-		      break;
-		    }
-		}
-	      else
-		{		/* error with the pointer to the structure to exapand */
-		  retCode = ASN1_VALUE_NOT_VALID;
-		  break;
+	      result = asn1_delete_structure (&octetNode);
+	      if (result != ASN1_SUCCESS)
+		{		/* error with asn1_delete_structure */
+		  asn1_delete_structure (&aux);
+		  retCode = result;
 		}
 	    }
+	  else
+	    {			/* error with asn1_der_decoding */
+	      retCode = result;
+	    }
+	}
+      else
+	{			/* error with asn1_create_element */
+	  retCode = result;
 	}
-
-      p2 = p2->right;
-
     }
-
-  if (!p2)
-    retCode = ASN1_VALUE_NOT_VALID;
+  else
+    {				/* error with the pointer to the structure to exapand */
+      retCode = ASN1_VALUE_NOT_VALID;
+    }
 
   return retCode;
 }
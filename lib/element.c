@@ -34,30 +34,44 @@
 
 #include "element.h"
 
+/* Write the name of NODE as for asn1_find_node(), truncated to
+   NAME_SIZE - 1 bytes.  The names are copied from the end of the
+   path, in place, so that every level is visited twice at most.  */
 void
 _asn1_hierarchical_name (ASN1_TYPE node, char *name, int name_size)
 {
   ASN1_TYPE p;
-  char tmp_name[64];
+  int len, total, n;
 
-  p = node;
+  if (name_size <= 0)
+    return;
 
-  name[0] = 0;
+  total = 0;
+  for (p = node; p != NULL; p = _asn1_find_up (p))
+    if (p->name != NULL)
+      total += strlen (p->name) + 1;
 
-  while (p != NULL)
+  if (total == 0)
     {
-      if (p->name != NULL)
-	{
-	  _asn1_str_cpy (tmp_name, sizeof (tmp_name), name),
-	    _asn1_str_cpy (name, name_size, p->name);
-	  _asn1_str_cat (name, name_size, ".");
-	  _asn1_str_cat (name, name_size, tmp_name);
-	}
-      p = _asn1_find_up (p);
+      _asn1_str_cpy (name, name_size, "ROOT");
+      return;
     }
 
-  if (name[0] == 0)
-    _asn1_str_cpy (name, name_size, "ROOT");
+  /* no dot after the last name */
+  len = --total;
+  for (p = node; p != NULL; p = _asn1_find_up (p))
+    if (p->name != NULL)
+      {
+	n = strlen (p->name);
+	len -= n;
+	if (len < name_size - 1)
+	  memcpy (name + len, p->name,
+		  (len + n < name_size - 1) ? n : name_size - 1 - len);
+	if (len > 0 && --len < name_size - 1)
+	  name[len] = '.';
+      }
+
+  name[(total < name_size - 1) ? total : name_size - 1] = 0;
 }
 
 
@@ -127,161 +141,181 @@ _asn1_convert_integer (const char *value, unsigned char *value_out,
 }
 
 
-int
-_asn1_append_sequence_set (ASN1_TYPE node)
+/* Appends a copy of TYPE, the type of the elements of a SEQUENCE OF
+   or SET OF, after LAST, its last child, and returns it.  */
+static ASN1_TYPE
+_asn1_append_element (ASN1_TYPE type, ASN1_TYPE last)
 {
-  ASN1_TYPE p, p2;
+  ASN1_TYPE p2;
   char temp[10];
   long n;
 
+  if (last->name == NULL)
+    _asn1_str_cpy (temp, sizeof (temp), "?1");
+  else
+    {
+      n = strtol (last->name + 1, NULL, 0);
+      n++;
+      temp[0] = '?';
+      _asn1_ltostr (n, temp + 1);
+    }
+
+  p2 = _asn1_copy_structure3 (type);
+  if (p2 == NULL || _asn1_set_name (p2, temp) == NULL)
+    {
+      asn1_delete_structure (&p2);
+      return NULL;
+    }
+  _asn1_set_modified (_asn1_find_up (type));
+  _asn1_set_right (last, p2);
+  _asn1_trace (ASN1_TRACE_NODE, node, p2, -1);
+  /*  p2->type |= CONST_OPTION; */
+
+  return p2;
+}
+
+int
+_asn1_append_sequence_set (ASN1_TYPE node)
+{
   if (!node || !(node->down))
     return ASN1_GENERIC_ERROR;
 
+  if (_asn1_append_sequence_item (node, NULL) == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
+
+  return ASN1_SUCCESS;
+}
+
+/* Appends an element to NODE, a SEQUENCE OF or SET OF, after LAST,
+   its last child, and returns it.  Without LAST the children are
+   walked to find it.  */
+ASN1_TYPE
+_asn1_append_sequence_item (ASN1_TYPE node, ASN1_TYPE last)
+{
+  ASN1_TYPE p;
+
   p = node->down;
   while ((type_field (p->type) == TYPE_TAG)
 	 || (type_field (p->type) == TYPE_SIZE))
     p = p->right;
-  p2 = _asn1_copy_structure3 (p);
-  while (p->right)
+
+  if (last == NULL)
+    last = _asn1_get_last_right (p);
+
+  return _asn1_append_element (p, last);
+}
+
+
+/* Returns in DEFAULT_VALUE and LEN the two's complement encoding of
+   the DEFAULT of the INTEGER or ENUMERATED NODE, or a LEN of zero if
+   it has none.  DEFAULT_INT holds the value when it was not
+   precomputed.  */
+static asn1_retCode
+_asn1_default_integer (ASN1_TYPE node, unsigned char *default_int,
+		       const unsigned char **default_value, int *len)
+{
+  ASN1_TYPE p, p2;
+  const char *text;
+
+  *len = 0;
+  if (!(node->type & CONST_DEFAULT))
+    return ASN1_SUCCESS;
+
+  p = node->down;
+  while (type_field (p->type) != TYPE_DEFAULT)
     p = p->right;
-  _asn1_set_right (p, p2);
+  *default_value = _asn1_value_der (p, len);
+  if (*default_value != NULL)
+    return ASN1_SUCCESS;
+
+  /* not precomputed, convert the DEFAULT now */
+  text = (char *) p->value;
+  if (!(isdigit (p->value[0])) && (p->value[0] != '-'))
+    {				/* is an identifier like v1 */
+      if (!(node->type & CONST_LIST))
+	return ASN1_VALUE_NOT_VALID;
+      p2 = node->down;
+      while (p2)
+	{
+	  if ((type_field (p2->type) == TYPE_CONSTANT) && (p2->name)
+	      && (!strcmp (p2->name, p->value)))
+	    break;
+	  p2 = p2->right;
+	}
+      if (p2 == NULL)
+	return ASN1_VALUE_NOT_VALID;
+      text = (char *) p2->value;
+    }
+  if (_asn1_convert_integer (text, default_int, SIZEOF_UNSIGNED_LONG_INT,
+			     len) != ASN1_SUCCESS)
+    *len = 0;
+  *default_value = default_int;
 
-  if (p->name == NULL)
-    _asn1_str_cpy (temp, sizeof (temp), "?1");
+  return ASN1_SUCCESS;
+}
+
+/* Sets the INTEGER or ENUMERATED NODE to the two's complement VALUE
+   of LEN bytes.  The value is left empty if it is the DEFAULT one.  */
+static asn1_retCode
+_asn1_write_integer (ASN1_TYPE node, const unsigned char *value, int len)
+{
+  unsigned char default_int[SIZEOF_UNSIGNED_LONG_INT];
+  const unsigned char *default_value;
+  int len2, k, negative;
+  asn1_retCode result;
+
+  if (len <= 0)
+    return ASN1_VALUE_NOT_VALID;
+
+  if (value[0] & 0x80)
+    negative = 1;
   else
+    negative = 0;
+
+  if (negative && (type_field (node->type) == TYPE_ENUMERATED))
+    return ASN1_VALUE_NOT_VALID;
+
+  for (k = 0; k < len - 1; k++)
+    if (negative && (value[k] != 0xFF))
+      break;
+    else if (!negative && value[k])
+      break;
+
+  if ((negative && !(value[k] & 0x80)) || (!negative && (value[k] & 0x80)))
+    k--;
+
+  result = _asn1_default_integer (node, default_int, &default_value, &len2);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  if (len2 && ((len - k) == len2) && !memcmp (value + k, default_value, len2))
     {
-      n = strtol (p->name + 1, NULL, 0);
-      n++;
-      temp[0] = '?';
-      _asn1_ltostr (n, temp + 1);
+      _asn1_set_value (node, NULL, 0);
+      return ASN1_SUCCESS;
     }
-  _asn1_set_name (p2, temp);
-  /*  p2->type |= CONST_OPTION; */
+
+  if (_asn1_set_value_octet (node, value + k, len - k) == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
 
   return ASN1_SUCCESS;
 }
 
-
-/**
- * asn1_write_value:
- * @node_root: pointer to a structure
- * @name: the name of the element inside the structure that you want to set.
- * @ivalue: vector used to specify the value to set. If len is >0,
- *   VALUE must be a two's complement form integer.  if len=0 *VALUE
- *   must be a null terminated string with an integer value.
- * @len: number of bytes of *value to use to set the value:
- *   value[0]..value[len-1] or 0 if value is a null terminated string
- *
- * Set the value of one element inside a structure.
- *
- * If an element is OPTIONAL and you want to delete it, you must use
- * the value=NULL and len=0.  Using "pkix.asn":
- *
- * result=asn1_write_value(cert, "tbsCertificate.issuerUniqueID",
- * NULL, 0);
- *
- * Description for each type:
- *
- * INTEGER: VALUE must contain a two's complement form integer.
- *
- *            value[0]=0xFF ,               len=1 -> integer=-1.
- *            value[0]=0xFF value[1]=0xFF , len=2 -> integer=-1.
- *            value[0]=0x01 ,               len=1 -> integer= 1.
- *            value[0]=0x00 value[1]=0x01 , len=2 -> integer= 1.
- *            value="123"                 , len=0 -> integer= 123.
- *
- * ENUMERATED: As INTEGER (but only with not negative numbers).
- *
- * BOOLEAN: VALUE must be the null terminated string "TRUE" or
- *   "FALSE" and LEN != 0.
- *
- *            value="TRUE" , len=1 -> boolean=TRUE.
- *            value="FALSE" , len=1 -> boolean=FALSE.
- *
- * OBJECT IDENTIFIER: VALUE must be a null terminated string with
- *   each number separated by a dot (e.g. "1.2.3.543.1").  LEN != 0.
- *
- *            value="1 2 840 10040 4 3" , len=1 -> OID=dsa-with-sha.
- *
- * UTCTime: VALUE must be a null terminated string in one of these
- *   formats: "YYMMDDhhmmssZ", "YYMMDDhhmmssZ",
- *   "YYMMDDhhmmss+hh'mm'", "YYMMDDhhmmss-hh'mm'",
- *   "YYMMDDhhmm+hh'mm'", or "YYMMDDhhmm-hh'mm'".  LEN != 0.
- *
- *            value="9801011200Z" , len=1 -> time=Jannuary 1st, 1998
- *            at 12h 00m Greenwich Mean Time
- *
- * GeneralizedTime: VALUE must be in one of this format:
- *   "YYYYMMDDhhmmss.sZ", "YYYYMMDDhhmmss.sZ",
- *   "YYYYMMDDhhmmss.s+hh'mm'", "YYYYMMDDhhmmss.s-hh'mm'",
- *   "YYYYMMDDhhmm+hh'mm'", or "YYYYMMDDhhmm-hh'mm'" where ss.s
- *   indicates the seconds with any precision like "10.1" or "01.02".
- *   LEN != 0
- *
- *            value="2001010112001.12-0700" , len=1 -> time=Jannuary
- *            1st, 2001 at 12h 00m 01.12s Pacific Daylight Time
- *
- * OCTET STRING: VALUE contains the octet string and LEN is the
- *   number of octets.
- *
- *            value="$\backslash$x01$\backslash$x02$\backslash$x03" ,
- *            len=3 -> three bytes octet string
- *
- * GeneralString: VALUE contains the generalstring and LEN is the
- *   number of octets.
- *
- *            value="$\backslash$x01$\backslash$x02$\backslash$x03" ,
- *            len=3 -> three bytes generalstring
- *
- * BIT STRING: VALUE contains the bit string organized by bytes and
- *   LEN is the number of bits.
- *
- *   value="$\backslash$xCF" , len=6 -> bit string="110011" (six
- *   bits)
- *
- * CHOICE: if NAME indicates a choice type, VALUE must specify one of
- *   the alternatives with a null terminated string. LEN != 0. Using
- *   "pkix.asn"\:
- *
- *           result=asn1_write_value(cert,
- *           "certificate1.tbsCertificate.subject", "rdnSequence",
- *           1);
- *
- * ANY: VALUE indicates the der encoding of a structure.  LEN != 0.
- *
- * SEQUENCE OF: VALUE must be the null terminated string "NEW" and
- *   LEN != 0. With this instruction another element is appended in
- *   the sequence. The name of this element will be "?1" if it's the
- *   first one, "?2" for the second and so on.
- *
- *   Using "pkix.asn"\:
- *
- *   result=asn1_write_value(cert,
- *   "certificate1.tbsCertificate.subject.rdnSequence", "NEW", 1);
- *
- * SET OF: the same as SEQUENCE OF.  Using "pkix.asn":
- *
- *           result=asn1_write_value(cert,
- *           "tbsCertificate.subject.rdnSequence.?LAST", "NEW", 1);
- *
- * Returns: %ASN1_SUCCESS if the value was set,
- *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element, and
- *   %ASN1_VALUE_NOT_VALID if @ivalue has a wrong format.
- **/
-asn1_retCode
-asn1_write_value (ASN1_TYPE node_root, const char *name,
-		  const void *ivalue, int len)
+/* Sets the value of NODE, as described for asn1_write_value.  */
+static asn1_retCode
+_asn1_write_value (ASN1_TYPE node, const void *ivalue, int len)
 {
-  ASN1_TYPE node, p, p2;
-  unsigned char *temp, *value_temp = NULL, *default_temp = NULL;
-  int len2, k, k2, negative;
+  ASN1_TYPE p, p2;
+  unsigned char *temp, value_int[SIZEOF_UNSIGNED_LONG_INT];
+  int len2, k;
   size_t i;
   const unsigned char *value = ivalue;
+  asn1_retCode result;
 
-  node = asn1_find_node (node_root, name);
   if (node == NULL)
     return ASN1_ELEMENT_NOT_FOUND;
 
+  _asn1_set_modified (node);
+
   if ((node->type & CONST_OPTION) && (value == NULL) && (len == 0))
     {
       asn1_delete_structure (&node);
@@ -343,15 +377,8 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
       if (len == 0)
 	{
 	  if ((isdigit (value[0])) || (value[0] == '-'))
-	    {
-	      value_temp =
-		(unsigned char *) _asn1_malloc (SIZEOF_UNSIGNED_LONG_INT);
-	      if (value_temp == NULL)
-		return ASN1_MEM_ALLOC_ERROR;
-
-	      _asn1_convert_integer (value, value_temp,
-				     SIZEOF_UNSIGNED_LONG_INT, &len);
-	    }
+	    _asn1_convert_integer (value, value_int, sizeof (value_int),
+				   &len);
 	  else
 	    {			/* is an identifier like v1 */
 	      if (!(node->type & CONST_LIST))
@@ -363,16 +390,8 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
 		    {
 		      if ((p->name) && (!strcmp (p->name, value)))
 			{
-			  value_temp =
-			    (unsigned char *)
-			    _asn1_malloc (SIZEOF_UNSIGNED_LONG_INT);
-			  if (value_temp == NULL)
-			    return ASN1_MEM_ALLOC_ERROR;
-
-			  _asn1_convert_integer (p->value,
-						 value_temp,
-						 SIZEOF_UNSIGNED_LONG_INT,
-						 &len);
+			  _asn1_convert_integer (p->value, value_int,
+						 sizeof (value_int), &len);
 			  break;
 			}
 		    }
@@ -381,110 +400,12 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
 	      if (p == NULL)
 		return ASN1_VALUE_NOT_VALID;
 	    }
+	  value = value_int;
 	}
-      else
-	{			/* len != 0 */
-	  value_temp = (unsigned char *) _asn1_malloc (len);
-	  if (value_temp == NULL)
-	    return ASN1_MEM_ALLOC_ERROR;
-	  memcpy (value_temp, value, len);
-	}
-
-
-      if (value_temp[0] & 0x80)
-	negative = 1;
-      else
-	negative = 0;
-
-      if (negative && (type_field (node->type) == TYPE_ENUMERATED))
-	{
-	  _asn1_free (value_temp);
-	  return ASN1_VALUE_NOT_VALID;
-	}
-
-      for (k = 0; k < len - 1; k++)
-	if (negative && (value_temp[k] != 0xFF))
-	  break;
-	else if (!negative && value_temp[k])
-	  break;
-
-      if ((negative && !(value_temp[k] & 0x80)) ||
-	  (!negative && (value_temp[k] & 0x80)))
-	k--;
-
-      _asn1_set_value_octet (node, value_temp + k, len - k);
-
-      if (node->type & CONST_DEFAULT)
-	{
-	  p = node->down;
-	  while (type_field (p->type) != TYPE_DEFAULT)
-	    p = p->right;
-	  if ((isdigit (p->value[0])) || (p->value[0] == '-'))
-	    {
-	      default_temp =
-		(unsigned char *) _asn1_malloc (SIZEOF_UNSIGNED_LONG_INT);
-	      if (default_temp == NULL)
-		{
-		  _asn1_free (value_temp);
-		  return ASN1_MEM_ALLOC_ERROR;
-		}
-
-	      _asn1_convert_integer (p->value, default_temp,
-				     SIZEOF_UNSIGNED_LONG_INT, &len2);
-	    }
-	  else
-	    {			/* is an identifier like v1 */
-	      if (!(node->type & CONST_LIST))
-		{
-		  _asn1_free (value_temp);
-		  return ASN1_VALUE_NOT_VALID;
-		}
-	      p2 = node->down;
-	      while (p2)
-		{
-		  if (type_field (p2->type) == TYPE_CONSTANT)
-		    {
-		      if ((p2->name) && (!strcmp (p2->name, p->value)))
-			{
-			  default_temp =
-			    (unsigned char *)
-			    _asn1_malloc (SIZEOF_UNSIGNED_LONG_INT);
-			  if (default_temp == NULL)
-			    {
-			      _asn1_free (value_temp);
-			      return ASN1_MEM_ALLOC_ERROR;
-			    }
-
-			  _asn1_convert_integer (p2->value,
-						 default_temp,
-						 SIZEOF_UNSIGNED_LONG_INT,
-						 &len2);
-			  break;
-			}
-		    }
-		  p2 = p2->right;
-		}
-	      if (p2 == NULL)
-		{
-		  _asn1_free (value_temp);
-		  return ASN1_VALUE_NOT_VALID;
-		}
-	    }
-
 
-	  if ((len - k) == len2)
-	    {
-	      for (k2 = 0; k2 < len2; k2++)
-		if (value_temp[k + k2] != default_temp[k2])
-		  {
-		    break;
-		  }
-	      if (k2 == len2)
-		_asn1_set_value (node, NULL, 0);
-	    }
-	  _asn1_free (default_temp);
-	}
-      _asn1_free (value_temp);
+      result = _asn1_write_integer (node, value, len);
+      if (result != ASN1_SUCCESS)
+	return result;
       break;
     case TYPE_OBJECT_ID:
       for (i = 0; i < strlen (value); i++)
@@ -563,7 +484,7 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
       if (len == 0)
 	len = strlen (value);
       asn1_length_der ((len >> 3) + 2, NULL, &len2);
-      temp = (unsigned char *) _asn1_malloc ((len >> 3) + 2 + len2);
+      temp = (unsigned char *) _asn1_pool_malloc ((len >> 3) + 2 + len2);
       if (temp == NULL)
 	return ASN1_MEM_ALLOC_ERROR;
 
@@ -602,8 +523,7 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
     case TYPE_SET_OF:
       if (strcmp (value, "NEW"))
 	return ASN1_VALUE_NOT_VALID;
-      _asn1_append_sequence_set (node);
-      break;
+      return _asn1_append_sequence_set (node);
     default:
       return ASN1_ELEMENT_NOT_FOUND;
       break;
@@ -612,103 +532,156 @@ asn1_write_value (ASN1_TYPE node_root, const char *name,
   return ASN1_SUCCESS;
 }
 
-
-#define PUT_VALUE( ptr, ptr_size, data, data_size) \
-	*len = data_size; \
-	if (ptr_size < data_size) { \
-		return ASN1_MEM_ERROR; \
-	} else { \
-		memcpy( ptr, data, data_size); \
-	}
-
-#define PUT_STR_VALUE( ptr, ptr_size, data) \
-	*len = strlen(data) + 1; \
-	if (ptr_size < *len) { \
-		return ASN1_MEM_ERROR; \
-	} else { \
-		/* this strcpy is checked */ \
-		strcpy(ptr, data); \
-	}
-
-#define ADD_STR_VALUE( ptr, ptr_size, data) \
-	*len = (int) strlen(data) + 1; \
-	if (ptr_size < (int) strlen(ptr)+(*len)) { \
-		return ASN1_MEM_ERROR; \
-	} else { \
-		/* this strcat is checked */ \
-		strcat(ptr, data); \
-	}
-
 /**
- * asn1_read_value:
- * @root: pointer to a structure.
- * @name: the name of the element inside a structure that you want to read.
- * @ivalue: vector that will contain the element's content, must be a
- *   pointer to memory cells already allocated.
- * @len: number of bytes of *value: value[0]..value[len-1]. Initialy
- *   holds the sizeof value.
+ * asn1_write_value:
+ * @node_root: pointer to a structure
+ * @name: the name of the element inside the structure that you want to set.
+ * @ivalue: vector used to specify the value to set. If len is >0,
+ *   VALUE must be a two's complement form integer.  if len=0 *VALUE
+ *   must be a null terminated string with an integer value.
+ * @len: number of bytes of *value to use to set the value:
+ *   value[0]..value[len-1] or 0 if value is a null terminated string
  *
- * Returns the value of one element inside a structure.
+ * Set the value of one element inside a structure.
  *
- * If an element is OPTIONAL and the function "read_value" returns
- * %ASN1_ELEMENT_NOT_FOUND, it means that this element wasn't present
- * in the der encoding that created the structure.  The first element
- * of a SEQUENCE_OF or SET_OF is named "?1". The second one "?2" and
- * so on.
+ * If an element is OPTIONAL and you want to delete it, you must use
+ * the value=NULL and len=0.  Using "pkix.asn":
  *
- * INTEGER: VALUE will contain a two's complement form integer.
+ * result=asn1_write_value(cert, "tbsCertificate.issuerUniqueID",
+ * NULL, 0);
  *
- *            integer=-1  -> value[0]=0xFF , len=1.
- *            integer=1   -> value[0]=0x01 , len=1.
+ * Description for each type:
+ *
+ * INTEGER: VALUE must contain a two's complement form integer.
+ *
+ *            value[0]=0xFF ,               len=1 -> integer=-1.
+ *            value[0]=0xFF value[1]=0xFF , len=2 -> integer=-1.
+ *            value[0]=0x01 ,               len=1 -> integer= 1.
+ *            value[0]=0x00 value[1]=0x01 , len=2 -> integer= 1.
+ *            value="123"                 , len=0 -> integer= 123.
  *
  * ENUMERATED: As INTEGER (but only with not negative numbers).
  *
- * BOOLEAN: VALUE will be the null terminated string "TRUE" or
- *   "FALSE" and LEN=5 or LEN=6.
+ * BOOLEAN: VALUE must be the null terminated string "TRUE" or
+ *   "FALSE" and LEN != 0.
  *
- * OBJECT IDENTIFIER: VALUE will be a null terminated string with
- *   each number separated by a dot (i.e. "1.2.3.543.1").
+ *            value="TRUE" , len=1 -> boolean=TRUE.
+ *            value="FALSE" , len=1 -> boolean=FALSE.
  *
- *                      LEN = strlen(VALUE)+1
+ * OBJECT IDENTIFIER: VALUE must be a null terminated string with
+ *   each number separated by a dot (e.g. "1.2.3.543.1").  LEN != 0.
  *
- * UTCTime: VALUE will be a null terminated string in one of these
- *   formats: "YYMMDDhhmmss+hh'mm'" or "YYMMDDhhmmss-hh'mm'".
- *   LEN=strlen(VALUE)+1.
+ *            value="1 2 840 10040 4 3" , len=1 -> OID=dsa-with-sha.
  *
- * GeneralizedTime: VALUE will be a null terminated string in the
- *   same format used to set the value.
+ * UTCTime: VALUE must be a null terminated string in one of these
+ *   formats: "YYMMDDhhmmssZ", "YYMMDDhhmmssZ",
+ *   "YYMMDDhhmmss+hh'mm'", "YYMMDDhhmmss-hh'mm'",
+ *   "YYMMDDhhmm+hh'mm'", or "YYMMDDhhmm-hh'mm'".  LEN != 0.
  *
- * OCTET STRING: VALUE will contain the octet string and LEN will be
- *   the number of octets.
+ *            value="9801011200Z" , len=1 -> time=Jannuary 1st, 1998
+ *            at 12h 00m Greenwich Mean Time
  *
- * GeneralString: VALUE will contain the generalstring and LEN will
- *   be the number of octets.
+ * GeneralizedTime: VALUE must be in one of this format:
+ *   "YYYYMMDDhhmmss.sZ", "YYYYMMDDhhmmss.sZ",
+ *   "YYYYMMDDhhmmss.s+hh'mm'", "YYYYMMDDhhmmss.s-hh'mm'",
+ *   "YYYYMMDDhhmm+hh'mm'", or "YYYYMMDDhhmm-hh'mm'" where ss.s
+ *   indicates the seconds with any precision like "10.1" or "01.02".
+ *   LEN != 0
  *
- * BIT STRING: VALUE will contain the bit string organized by bytes
- *   and LEN will be the number of bits.
+ *            value="2001010112001.12-0700" , len=1 -> time=Jannuary
+ *            1st, 2001 at 12h 00m 01.12s Pacific Daylight Time
  *
- * CHOICE: If NAME indicates a choice type, VALUE will specify the
- *   alternative selected.
+ * OCTET STRING: VALUE contains the octet string and LEN is the
+ *   number of octets.
  *
- * ANY: If NAME indicates an any type, VALUE will indicate the DER
- *   encoding of the structure actually used.
+ *            value="$\backslash$x01$\backslash$x02$\backslash$x03" ,
+ *            len=3 -> three bytes octet string
  *
- * Returns: %ASN1_SUCCESS if value is returned,
- *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element,
- *   %ASN1_VALUE_NOT_FOUND if there isn't any value for the element
- *   selected, and %ASN1_MEM_ERROR if The value vector isn't big enough
- *   to store the result, and in this case @len will contain the number of
- *   bytes needed.
+ * GeneralString: VALUE contains the generalstring and LEN is the
+ *   number of octets.
+ *
+ *            value="$\backslash$x01$\backslash$x02$\backslash$x03" ,
+ *            len=3 -> three bytes generalstring
+ *
+ * BIT STRING: VALUE contains the bit string organized by bytes and
+ *   LEN is the number of bits.
+ *
+ *   value="$\backslash$xCF" , len=6 -> bit string="110011" (six
+ *   bits)
+ *
+ * CHOICE: if NAME indicates a choice type, VALUE must specify one of
+ *   the alternatives with a null terminated string. LEN != 0. Using
+ *   "pkix.asn"\:
+ *
+ *           result=asn1_write_value(cert,
+ *           "certificate1.tbsCertificate.subject", "rdnSequence",
+ *           1);
+ *
+ * ANY: VALUE indicates the der encoding of a structure.  LEN != 0.
+ *
+ * SEQUENCE OF: VALUE must be the null terminated string "NEW" and
+ *   LEN != 0. With this instruction another element is appended in
+ *   the sequence. The name of this element will be "?1" if it's the
+ *   first one, "?2" for the second and so on.
+ *
+ *   Using "pkix.asn"\:
+ *
+ *   result=asn1_write_value(cert,
+ *   "certificate1.tbsCertificate.subject.rdnSequence", "NEW", 1);
+ *
+ * SET OF: the same as SEQUENCE OF.  Using "pkix.asn":
+ *
+ *           result=asn1_write_value(cert,
+ *           "tbsCertificate.subject.rdnSequence.?LAST", "NEW", 1);
+ *
+ * Returns: %ASN1_SUCCESS if the value was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element, and
+ *   %ASN1_VALUE_NOT_VALID if @ivalue has a wrong format.
  **/
 asn1_retCode
-asn1_read_value (ASN1_TYPE root, const char *name, void *ivalue, int *len)
+asn1_write_value (ASN1_TYPE node_root, const char *name,
+		  const void *ivalue, int len)
+{
+  return _asn1_write_value (asn1_find_node (node_root, name), ivalue, len);
+}
+
+
+#define PUT_VALUE( ptr, ptr_size, data, data_size) \
+	*len = data_size; \
+	if (ptr_size < data_size) { \
+		return ASN1_MEM_ERROR; \
+	} else { \
+		memcpy( ptr, data, data_size); \
+	}
+
+#define PUT_STR_VALUE( ptr, ptr_size, data) \
+	*len = strlen(data) + 1; \
+	if (ptr_size < *len) { \
+		return ASN1_MEM_ERROR; \
+	} else { \
+		/* this strcpy is checked */ \
+		strcpy(ptr, data); \
+	}
+
+#define ADD_STR_VALUE( ptr, ptr_size, data) \
+	*len = (int) strlen(data) + 1; \
+	if (ptr_size < (int) strlen(ptr)+(*len)) { \
+		return ASN1_MEM_ERROR; \
+	} else { \
+		/* this strcat is checked */ \
+		strcat(ptr, data); \
+	}
+
+/* Returns the value of NODE, as described for asn1_read_value.  */
+static asn1_retCode
+_asn1_read_value (ASN1_TYPE node, void *ivalue, int *len)
 {
-  ASN1_TYPE node, p, p2;
+  ASN1_TYPE p, p2;
   int len2, len3;
   int value_size = *len;
   unsigned char *value = ivalue;
+  const unsigned char *default_value;
 
-  node = asn1_find_node (root, name);
   if (node == NULL)
     return ASN1_ELEMENT_NOT_FOUND;
 
@@ -754,7 +727,12 @@ asn1_read_value (ASN1_TYPE root, const char *name, void *ivalue, int *len)
 	  p = node->down;
 	  while (type_field (p->type) != TYPE_DEFAULT)
 	    p = p->right;
-	  if ((isdigit (p->value[0])) || (p->value[0] == '-')
+	  default_value = _asn1_value_der (p, &len2);
+	  if (default_value)
+	    {
+	      PUT_VALUE (value, value_size, default_value, len2);
+	    }
+	  else if ((isdigit (p->value[0])) || (p->value[0] == '-')
 	      || (p->value[0] == '+'))
 	    {
 	      if (_asn1_convert_integer
@@ -862,37 +840,1524 @@ asn1_read_value (ASN1_TYPE root, const char *name, void *ivalue, int *len)
   return ASN1_SUCCESS;
 }
 
-
 /**
- * asn1_read_tag:
- * @root: pointer to a structure
- * @name: the name of the element inside a structure.
- * @tagValue:  variable that will contain the TAG value.
- * @classValue: variable that will specify the TAG type.
+ * asn1_read_value:
+ * @root: pointer to a structure.
+ * @name: the name of the element inside a structure that you want to read.
+ * @ivalue: vector that will contain the element's content, must be a
+ *   pointer to memory cells already allocated.
+ * @len: number of bytes of *value: value[0]..value[len-1]. Initialy
+ *   holds the sizeof value.
  *
- * Returns the TAG and the CLASS of one element inside a structure.
- * CLASS can have one of these constants: %ASN1_CLASS_APPLICATION,
- * %ASN1_CLASS_UNIVERSAL, %ASN1_CLASS_PRIVATE or
- * %ASN1_CLASS_CONTEXT_SPECIFIC.
+ * Returns the value of one element inside a structure.
  *
- * Returns: %ASN1_SUCCESS if successful, %ASN1_ELEMENT_NOT_FOUND if
- *   @name is not a valid element.
+ * If an element is OPTIONAL and the function "read_value" returns
+ * %ASN1_ELEMENT_NOT_FOUND, it means that this element wasn't present
+ * in the der encoding that created the structure.  The first element
+ * of a SEQUENCE_OF or SET_OF is named "?1". The second one "?2" and
+ * so on.
+ *
+ * INTEGER: VALUE will contain a two's complement form integer.
+ *
+ *            integer=-1  -> value[0]=0xFF , len=1.
+ *            integer=1   -> value[0]=0x01 , len=1.
+ *
+ * ENUMERATED: As INTEGER (but only with not negative numbers).
+ *
+ * BOOLEAN: VALUE will be the null terminated string "TRUE" or
+ *   "FALSE" and LEN=5 or LEN=6.
+ *
+ * OBJECT IDENTIFIER: VALUE will be a null terminated string with
+ *   each number separated by a dot (i.e. "1.2.3.543.1").
+ *
+ *                      LEN = strlen(VALUE)+1
+ *
+ * UTCTime: VALUE will be a null terminated string in one of these
+ *   formats: "YYMMDDhhmmss+hh'mm'" or "YYMMDDhhmmss-hh'mm'".
+ *   LEN=strlen(VALUE)+1.
+ *
+ * GeneralizedTime: VALUE will be a null terminated string in the
+ *   same format used to set the value.
+ *
+ * OCTET STRING: VALUE will contain the octet string and LEN will be
+ *   the number of octets.
+ *
+ * GeneralString: VALUE will contain the generalstring and LEN will
+ *   be the number of octets.
+ *
+ * BIT STRING: VALUE will contain the bit string organized by bytes
+ *   and LEN will be the number of bits.
+ *
+ * CHOICE: If NAME indicates a choice type, VALUE will specify the
+ *   alternative selected.
+ *
+ * ANY: If NAME indicates an any type, VALUE will indicate the DER
+ *   encoding of the structure actually used.
+ *
+ * Returns: %ASN1_SUCCESS if value is returned,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element,
+ *   %ASN1_VALUE_NOT_FOUND if there isn't any value for the element
+ *   selected, and %ASN1_MEM_ERROR if The value vector isn't big enough
+ *   to store the result, and in this case @len will contain the number of
+ *   bytes needed.
  **/
 asn1_retCode
-asn1_read_tag (ASN1_TYPE root, const char *name, int *tagValue,
-	       int *classValue)
+asn1_read_value (ASN1_TYPE root, const char *name, void *ivalue, int *len)
 {
-  ASN1_TYPE node, p, pTag;
-
-  node = asn1_find_node (root, name);
-  if (node == NULL)
-    return ASN1_ELEMENT_NOT_FOUND;
-
-  p = node->down;
+  return _asn1_read_value (asn1_find_node (root, name), ivalue, len);
+}
 
-  /* pTag will points to the IMPLICIT TAG */
-  pTag = NULL;
-  if (node->type & CONST_TAG)
+/**
+ * asn1_read_element_value:
+ * @element: pointer to an element of a structure, as returned by
+ *   asn1_first_element() or asn1_next_element().
+ * @name: the name of the element inside @element that you want to
+ *   read, or "" for @element itself.
+ * @ivalue: vector that will contain the element's content, must be a
+ *   pointer to memory cells already allocated.
+ * @len: number of bytes of *value: value[0]..value[len-1]. Initialy
+ *   holds the sizeof value.
+ *
+ * Like asn1_read_value(), but @name is relative to @element instead
+ * of starting with its name, so the elements of a SEQUENCE OF or
+ * SET OF can be read while iterating over them, without building
+ * names like "?1.serialNumber" and searching for them from the root.
+ *
+ * Returns: as asn1_read_value().
+ **/
+asn1_retCode
+asn1_read_element_value (ASN1_TYPE element, const char *name,
+			 void *ivalue, int *len)
+{
+  return _asn1_read_value (_asn1_find_child (element, name), ivalue, len);
+}
+
+
+/* Sets the INTEGER or ENUMERATED NODE to the 64 bit two's complement
+   number VALUE, sign extended by NEGATIVE.  */
+static asn1_retCode
+_asn1_write_uint64 (ASN1_TYPE node, uint64_t value, int negative)
+{
+  unsigned char value_int[9];
+  int k;
+
+  if (node == NULL || (type_field (node->type) != TYPE_INTEGER
+		       && type_field (node->type) != TYPE_ENUMERATED))
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  value_int[0] = negative ? 0xFF : 0x00;
+  for (k = 8; k > 0; k--, value >>= 8)
+    value_int[k] = value & 0xFF;
+
+  _asn1_set_modified (node);
+  return _asn1_write_integer (node, value_int, sizeof (value_int));
+}
+
+/* Reads the INTEGER or ENUMERATED NODE as a 64 bit two's complement
+   number, setting NEGATIVE for values below zero.  */
+static asn1_retCode
+_asn1_read_integer64 (ASN1_TYPE node, uint64_t * value, int *negative)
+{
+  unsigned char value_int[9];
+  int len, len2, k;
+  asn1_retCode result;
+
+  if (node == NULL || (type_field (node->type) != TYPE_INTEGER
+		       && type_field (node->type) != TYPE_ENUMERATED))
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  len = sizeof (value_int);
+  if (node->value)
+    result = asn1_get_octet_der (node->value, node->value_len, &len2,
+				 value_int, sizeof (value_int), &len);
+  else
+    result = _asn1_read_value (node, value_int, &len);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (len <= 0)
+    return ASN1_VALUE_NOT_VALID;
+
+  *negative = (value_int[0] & 0x80) ? 1 : 0;
+
+  /* skip the octets that only repeat the sign */
+  for (k = 0; k < len - 1; k++)
+    if (value_int[k] != (*negative ? 0xFF : 0x00)
+	|| (value_int[k + 1] & 0x80) != (*negative ? 0x80 : 0x00))
+      break;
+  /* the zero in front of an unsigned value with the top bit set */
+  if (!*negative && len - k == 9 && value_int[k] == 0)
+    k++;
+  if (len - k > 8)
+    return ASN1_MEM_ERROR;
+
+  *value = *negative ? ~(uint64_t) 0 : 0;
+  for (; k < len; k++)
+    *value = (*value << 8) | value_int[k];
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode
+_asn1_read_int64 (ASN1_TYPE node, int64_t * value)
+{
+  uint64_t val;
+  int negative;
+  asn1_retCode result;
+
+  result = _asn1_read_integer64 (node, &val, &negative);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  /* the sign must survive the conversion */
+  if (negative != ((val >> 63) ? 1 : 0))
+    return ASN1_MEM_ERROR;
+
+  *value = (int64_t) val;
+
+  return ASN1_SUCCESS;
+}
+
+static asn1_retCode
+_asn1_read_uint64 (ASN1_TYPE node, uint64_t * value)
+{
+  uint64_t val;
+  int negative;
+  asn1_retCode result;
+
+  result = _asn1_read_integer64 (node, &val, &negative);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  if (negative)
+    return ASN1_VALUE_NOT_VALID;
+
+  *value = val;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_write_int64:
+ * @node_root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside the
+ *   structure that you want to set.
+ * @value: the value to set.
+ *
+ * Sets the value of an INTEGER or ENUMERATED element from a native
+ * integer.  Unlike asn1_write_value() with a decimal string this
+ * needs no conversion and, as the encoding of a 64 bit number fits
+ * in the element itself, no allocation.  A value equal to the
+ * DEFAULT of the element is not stored, so it is not encoded.
+ *
+ * Returns: %ASN1_SUCCESS if the value was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, and %ASN1_VALUE_NOT_VALID if @value is negative for an
+ *   ENUMERATED.
+ **/
+asn1_retCode
+asn1_write_int64 (ASN1_TYPE node_root, const char *name, int64_t value)
+{
+  return _asn1_write_uint64 (asn1_find_node (node_root, name), value,
+			     value < 0);
+}
+
+/**
+ * asn1_write_uint64:
+ * @node_root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside the
+ *   structure that you want to set.
+ * @value: the value to set.
+ *
+ * Like asn1_write_int64() for unsigned values, so the full range of
+ * a 64 bit serial number can be written.
+ *
+ * Returns: %ASN1_SUCCESS if the value was set, and
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element.
+ **/
+asn1_retCode
+asn1_write_uint64 (ASN1_TYPE node_root, const char *name, uint64_t value)
+{
+  return _asn1_write_uint64 (asn1_find_node (node_root, name), value, 0);
+}
+
+/**
+ * asn1_read_int64:
+ * @root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside a
+ *   structure that you want to read.
+ * @value: variable that will contain the value.
+ *
+ * Returns the value of an INTEGER or ENUMERATED element as a native
+ * integer, so callers do not need to reassemble the two's complement
+ * octets returned by asn1_read_value().  Like asn1_read_value() this
+ * returns the DEFAULT value of an element without one.
+ *
+ * Returns: %ASN1_SUCCESS if the value was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, %ASN1_VALUE_NOT_FOUND if there is no value, or
+ *   %ASN1_MEM_ERROR if the value does not fit in an int64_t.
+ **/
+asn1_retCode
+asn1_read_int64 (ASN1_TYPE root, const char *name, int64_t * value)
+{
+  return _asn1_read_int64 (asn1_find_node (root, name), value);
+}
+
+/**
+ * asn1_read_uint64:
+ * @root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside a
+ *   structure that you want to read.
+ * @value: variable that will contain the value.
+ *
+ * Like asn1_read_int64() for values that are not negative.
+ *
+ * Returns: %ASN1_SUCCESS if the value was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, %ASN1_VALUE_NOT_FOUND if there is no value,
+ *   %ASN1_VALUE_NOT_VALID if the value is negative, or
+ *   %ASN1_MEM_ERROR if it does not fit in an uint64_t.
+ **/
+asn1_retCode
+asn1_read_uint64 (ASN1_TYPE root, const char *name, uint64_t * value)
+{
+  return _asn1_read_uint64 (asn1_find_node (root, name), value);
+}
+
+/* Returns in CONTENT and LEN the two's complement octets of the
+   INTEGER or ENUMERATED element NAME, pointing into the element
+   itself.  An element without a value has its DEFAULT one.  */
+static asn1_retCode
+_asn1_integer_content (ASN1_TYPE root, const char *name,
+		       const unsigned char **content, int *len)
+{
+  ASN1_TYPE node, p;
+  int len2;
+
+  node = asn1_find_node (root, name);
+  if (node == NULL || (type_field (node->type) != TYPE_INTEGER
+		       && type_field (node->type) != TYPE_ENUMERATED))
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  if (node->value)
+    {
+      *len = asn1_get_length_der (node->value, node->value_len, &len2);
+      if (*len <= 0)
+	return ASN1_DER_ERROR;
+      *content = node->value + len2;
+      return ASN1_SUCCESS;
+    }
+
+  if (!(node->type & CONST_DEFAULT))
+    return ASN1_VALUE_NOT_FOUND;
+
+  p = node->down;
+  while (type_field (p->type) != TYPE_DEFAULT)
+    p = p->right;
+  *content = _asn1_value_der (p, len);
+  if (*content == NULL)
+    return ASN1_VALUE_NOT_FOUND;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_write_integer_magnitude:
+ * @node_root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside the
+ *   structure that you want to set.
+ * @magnitude: the absolute value, as unsigned big endian octets.
+ * @len: number of octets in @magnitude.
+ * @negative: nonzero if the value is below zero.
+ *
+ * Sets the value of an INTEGER or ENUMERATED element of any size from
+ * its magnitude and sign, as kept by big number libraries.  The two's
+ * complement encoding is built directly in the element, so no copy
+ * with a leading zero octet or negated digits has to be made first.
+ * Leading zero octets of @magnitude are ignored and a zero @len sets
+ * the value 0.  A value equal to the DEFAULT of the element is not
+ * stored, so it is not encoded.
+ *
+ * Returns: %ASN1_SUCCESS if the value was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, %ASN1_VALUE_NOT_VALID if the value is negative for an
+ *   ENUMERATED, and %ASN1_MEM_ALLOC_ERROR if the value cannot be
+ *   stored.
+ **/
+asn1_retCode
+asn1_write_integer_magnitude (ASN1_TYPE node_root, const char *name,
+			      const unsigned char *magnitude, int len,
+			      int negative)
+{
+  ASN1_TYPE node;
+  unsigned char small_value[sizeof (node->small_value)];
+  unsigned char default_int[SIZEOF_UNSIGNED_LONG_INT];
+  const unsigned char *default_value;
+  unsigned char *value, *content;
+  int len2, len3, size, k, carry;
+  asn1_retCode result;
+
+  node = asn1_find_node (node_root, name);
+  if (node == NULL || (type_field (node->type) != TYPE_INTEGER
+		       && type_field (node->type) != TYPE_ENUMERATED))
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  if (len < 0)
+    return ASN1_VALUE_NOT_VALID;
+
+  while (len > 0 && magnitude[0] == 0)
+    {
+      magnitude++;
+      len--;
+    }
+  if (len == 0)
+    negative = 0;
+
+  if (negative && (type_field (node->type) == TYPE_ENUMERATED))
+    return ASN1_VALUE_NOT_VALID;
+
+  _asn1_set_modified (node);
+
+  /* The encoding needs an octet more for the sign bit, unless it is
+     already clear, or for a negative value, unless the magnitude is a
+     power of two that fills the top octet.  */
+  size = len;
+  if (len == 0 || (!negative && (magnitude[0] & 0x80)))
+    size++;
+  else if (negative && magnitude[0] >= 0x80)
+    {
+      if (magnitude[0] != 0x80)
+	size++;
+      else
+	for (k = 1; k < len; k++)
+	  if (magnitude[k])
+	    {
+	      size++;
+	      break;
+	    }
+    }
+
+  asn1_length_der (size, NULL, &len2);
+  if (size + len2 < sizeof (small_value))
+    value = small_value;
+  else
+    {
+      value = _asn1_pool_malloc (size + len2);
+      if (value == NULL)
+	return ASN1_MEM_ALLOC_ERROR;
+    }
+  asn1_length_der (size, value, &len2);
+  content = value + len2;
+
+  /* the two's complement of a negative value is ~magnitude + 1 */
+  carry = 1;
+  for (k = 1; k <= len; k++)
+    {
+      if (negative)
+	{
+	  carry += (unsigned char) ~magnitude[len - k];
+	  content[size - k] = carry & 0xFF;
+	  carry >>= 8;
+	}
+      else
+	content[size - k] = magnitude[len - k];
+    }
+  if (size > len)
+    content[0] = negative ? 0xFF : 0x00;
+
+  result = _asn1_default_integer (node, default_int, &default_value, &len3);
+  if (result != ASN1_SUCCESS
+      || (len3 == size && !memcmp (content, default_value, len3)))
+    {
+      if (value != small_value)
+	_asn1_free (value);
+      if (result == ASN1_SUCCESS)
+	_asn1_set_value (node, NULL, 0);
+      return result;
+    }
+
+  if (value == small_value)
+    _asn1_set_value (node, value, size + len2);
+  else
+    _asn1_set_value_m (node, value, size + len2);
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_read_integer_magnitude:
+ * @root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside a
+ *   structure that you want to read.
+ * @magnitude: buffer that will contain the absolute value, as
+ *   unsigned big endian octets.
+ * @len: number of bytes of @magnitude buffer; on return the number
+ *   of octets of the magnitude.
+ * @negative: variable that will be set to 1 for values below zero and
+ *   to 0 otherwise, or %NULL if only values that are not negative are
+ *   accepted.
+ *
+ * Returns the value of an INTEGER or ENUMERATED element of any size
+ * as magnitude and sign, the form kept by big number libraries, so
+ * callers do not need to strip the sign octet or negate the two's
+ * complement octets returned by asn1_read_value().  The magnitude has
+ * no leading zero octets, so the value 0 has a length of zero.  Like
+ * asn1_read_value() this returns the DEFAULT value of an element
+ * without one.
+ *
+ * Returns: %ASN1_SUCCESS if the value was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, %ASN1_VALUE_NOT_FOUND if there is no value,
+ *   %ASN1_VALUE_NOT_VALID if the value is negative and @negative is
+ *   %NULL, and %ASN1_MEM_ERROR if @magnitude is too small; then @len
+ *   is set to the number of bytes needed.
+ **/
+asn1_retCode
+asn1_read_integer_magnitude (ASN1_TYPE root, const char *name,
+			     unsigned char *magnitude, int *len,
+			     int *negative)
+{
+  const unsigned char *content;
+  int content_len, k, skip, carry;
+  asn1_retCode result;
+
+  result = _asn1_integer_content (root, name, &content, &content_len);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  if (!(content[0] & 0x80))
+    {
+      for (k = 0; k < content_len && content[k] == 0; k++);
+      content += k;
+      content_len -= k;
+      if (*len < content_len)
+	{
+	  *len = content_len;
+	  return ASN1_MEM_ERROR;
+	}
+      if (content_len)
+	memcpy (magnitude, content, content_len);
+      *len = content_len;
+      if (negative)
+	*negative = 0;
+      return ASN1_SUCCESS;
+    }
+
+  if (negative == NULL)
+    return ASN1_VALUE_NOT_VALID;
+
+  /* skip the octets that only repeat the sign */
+  for (k = 0; k < content_len - 1; k++)
+    if (content[k] != 0xFF || !(content[k + 1] & 0x80))
+      break;
+  content += k;
+  content_len -= k;
+
+  /* The magnitude is ~content + 1.  Its top octet is only zero when
+     the first octet is 0xFF and the increment does not carry into
+     it.  */
+  skip = 0;
+  if (content[0] == 0xFF)
+    for (k = 1; k < content_len; k++)
+      if (content[k])
+	{
+	  skip = 1;
+	  break;
+	}
+  if (*len < content_len - skip)
+    {
+      *len = content_len - skip;
+      return ASN1_MEM_ERROR;
+    }
+
+  carry = 1;
+  for (k = content_len - 1; k >= skip; k--)
+    {
+      carry += (unsigned char) ~content[k];
+      magnitude[k - skip] = carry & 0xFF;
+      carry >>= 8;
+    }
+  *len = content_len - skip;
+  *negative = 1;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_read_integer_magnitude_ref:
+ * @root: pointer to a structure.
+ * @name: the name of the INTEGER or ENUMERATED element inside a
+ *   structure that you want to read.
+ * @magnitude: variable that will point to the value, as unsigned big
+ *   endian octets.
+ * @len: variable that will contain the number of octets of the value.
+ *
+ * Like asn1_read_integer_magnitude() for values that are not
+ * negative, as the moduli and exponents of keys, but without copying
+ * them: @magnitude points into the storage of the element, so it is
+ * only valid until the element is changed or deleted.
+ *
+ * Returns: %ASN1_SUCCESS if the value was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an INTEGER or ENUMERATED
+ *   element, %ASN1_VALUE_NOT_FOUND if there is no value, and
+ *   %ASN1_VALUE_NOT_VALID if the value is negative.
+ **/
+asn1_retCode
+asn1_read_integer_magnitude_ref (ASN1_TYPE root, const char *name,
+				 const unsigned char **magnitude, int *len)
+{
+  const unsigned char *content;
+  int content_len, k;
+  asn1_retCode result;
+
+  result = _asn1_integer_content (root, name, &content, &content_len);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  if (content[0] & 0x80)
+    return ASN1_VALUE_NOT_VALID;
+
+  for (k = 0; k < content_len && content[k] == 0; k++);
+  *magnitude = content + k;
+  *len = content_len - k;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_write_oid_der:
+ * @node_root: pointer to a structure
+ * @name: the name of the OBJECT IDENTIFIER element inside the
+ *   structure that you want to set.
+ * @oid: content octets of the DER encoding of the value.
+ * @len: number of octets in @oid.
+ *
+ * Sets the value of an OBJECT IDENTIFIER element from the content
+ * octets of its DER encoding, i.e. without tag and length, as
+ * returned by asn1_oid_der() or asn1_read_oid_der().  Otherwise it
+ * behaves like asn1_write_value().
+ *
+ * Returns: %ASN1_SUCCESS if the value was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an OBJECT IDENTIFIER
+ *   element, and %ASN1_VALUE_NOT_VALID if @oid is not a valid
+ *   encoding.
+ **/
+asn1_retCode
+asn1_write_oid_der (ASN1_TYPE node_root, const char *name,
+		    const unsigned char *oid, int len)
+{
+  ASN1_TYPE node;
+  char value[ASN1_MAX_NAME_SIZE], *str;
+  int value_len;
+  asn1_retCode result;
+
+  node = asn1_find_node (node_root, name);
+  if (node == NULL || type_field (node->type) != TYPE_OBJECT_ID)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  str = value;
+  value_len = sizeof (value);
+  result = asn1_get_oid_der (oid, len, str, &value_len);
+  if (result == ASN1_MEM_ERROR)
+    {
+      str = _asn1_malloc (value_len);
+      if (str == NULL)
+	return ASN1_MEM_ALLOC_ERROR;
+      result = asn1_get_oid_der (oid, len, str, &value_len);
+    }
+
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (node_root, name, str, 0);
+  else
+    result = ASN1_VALUE_NOT_VALID;
+
+  /* keep the octets for asn1_read_oid_der, unless the value is the
+     DEFAULT one and was not stored */
+  if (result == ASN1_SUCCESS && node->value != NULL
+      && !strcmp ((char *) node->value, str)
+      && _asn1_set_value_oid (node, str, oid, len) == NULL)
+    result = ASN1_MEM_ALLOC_ERROR;
+
+  if (str != value)
+    _asn1_free (str);
+
+  return result;
+}
+
+/**
+ * asn1_read_oid_der:
+ * @root: pointer to a structure.
+ * @name: the name of the OBJECT IDENTIFIER element inside a
+ *   structure that you want to read.
+ * @oid: buffer to hold the content octets.
+ * @len: initially the size of @oid, on return the number of content
+ *   octets.
+ *
+ * Returns the value of an OBJECT IDENTIFIER element as the content
+ * octets of its DER encoding, i.e. without tag and length.  The
+ * result can be compared with memcmp() or asn1_oid_der_cmp() against
+ * constant encodings, without formatting and comparing dotted decimal
+ * strings.  Like asn1_read_value() this returns the DEFAULT value of
+ * an element without one, and reads OBJECT IDENTIFIER assignments of
+ * the definitions.  The content octets of a value that was decoded or
+ * written with asn1_write_oid_der() are kept and returned as they
+ * are, the others are converted from the dotted decimal form.
+ *
+ * Returns: %ASN1_SUCCESS if the value was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not an OBJECT IDENTIFIER
+ *   element, %ASN1_VALUE_NOT_FOUND if there is no value, or
+ *   %ASN1_MEM_ERROR if @oid is too small; in that case @len holds the
+ *   needed size.
+ **/
+asn1_retCode
+asn1_read_oid_der (ASN1_TYPE root, const char *name, unsigned char *oid,
+		   int *len)
+{
+  ASN1_TYPE node;
+  char value[ASN1_MAX_NAME_SIZE];
+  const unsigned char *der;
+  const char *str;
+  int value_len, der_len;
+  asn1_retCode result;
+
+  node = asn1_find_node (root, name);
+  if (node == NULL || type_field (node->type) != TYPE_OBJECT_ID)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  der = _asn1_value_der (node, &der_len);
+  if (der != NULL)
+    {
+      result = (*len < der_len) ? ASN1_MEM_ERROR : ASN1_SUCCESS;
+      if (result == ASN1_SUCCESS)
+	memcpy (oid, der, der_len);
+      *len = der_len;
+      return result;
+    }
+
+  if (node->value)
+    str = (char *) node->value;
+  else
+    {
+      /* DEFAULT values and assignments */
+      value_len = sizeof (value);
+      result = asn1_read_value (root, name, value, &value_len);
+      if (result != ASN1_SUCCESS)
+	return result;
+      str = value;
+    }
+
+  return asn1_oid_der (str, oid, len);
+}
+
+/* Days between 1970-01-01 and the proleptic Gregorian date
+   YEAR-MONTH-DAY, MONTH counting from 1.  */
+static int64_t
+_asn1_days_from_civil (int64_t year, int month, int day)
+{
+  int64_t era, yoe, doy;
+
+  year -= (month <= 2);
+  era = (year >= 0 ? year : year - 399) / 400;
+  yoe = year - era * 400;
+  doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+
+  return era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+}
+
+/* Splits SECS, seconds since the epoch, into the UTC broken-down
+   time TM.  */
+static void
+_asn1_time_to_tm (int64_t secs, struct tm *tm)
+{
+  int64_t days, era, doe, yoe, doy, mp, year;
+  int sec;
+
+  days = secs / 86400;
+  sec = secs % 86400;
+  if (sec < 0)
+    {
+      sec += 86400;
+      days--;
+    }
+
+  memset (tm, 0, sizeof (*tm));
+  tm->tm_hour = sec / 3600;
+  tm->tm_min = (sec / 60) % 60;
+  tm->tm_sec = sec % 60;
+  /* 1970-01-01 was a Thursday */
+  tm->tm_wday = ((days % 7) + 11) % 7;
+
+  era = (days >= -719468 ? days + 719468 : days + 719468 - 146096) / 146097;
+  doe = days + 719468 - era * 146097;
+  yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  mp = (5 * doy + 2) / 153;
+  tm->tm_mday = doy - (153 * mp + 2) / 5 + 1;
+  tm->tm_mon = (mp < 10) ? mp + 2 : mp - 10;
+  year = yoe + era * 400 + (tm->tm_mon <= 1);
+  tm->tm_year = year - 1900;
+  tm->tm_yday = days - _asn1_days_from_civil (year, 1, 1);
+}
+
+/* Reads COUNT digits from *P into *VAL.  Returns 0 if there are not
+   enough digits.  */
+static int
+_asn1_time_digits (const char **p, int count, int *val)
+{
+  int k;
+
+  *val = 0;
+  for (k = 0; k < count; k++, (*p)++)
+    {
+      if (!isdigit ((unsigned char) **p))
+	return 0;
+      *val = *val * 10 + (**p - '0');
+    }
+
+  return 1;
+}
+
+/* Writes VAL as COUNT digits to P and returns the end.  */
+static char *
+_asn1_time_put_digits (char *p, int val, int count)
+{
+  int k;
+
+  for (k = count - 1; k >= 0; k--, val /= 10)
+    p[k] = '0' + (val % 10);
+
+  return p + count;
+}
+
+/* Converts the UTCTime (if UTC is set) or GeneralizedTime STR, as
+   accepted by asn1_write_value(), to seconds since the epoch.  Two
+   digit years are mapped to 1950-2049 as in RFC 5280, fractions of a
+   second are dropped and a GeneralizedTime without time zone is taken
+   as UTC.  */
+static asn1_retCode
+_asn1_parse_time (const char *str, int utc, int64_t * secs)
+{
+  static const char month_days[] =
+    { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  const char *p = str;
+  int year, month, day, hour, min = 0, sec = 0, zone_hour, zone_min;
+  int64_t offset = 0;
+
+  if (utc)
+    {
+      if (!_asn1_time_digits (&p, 2, &year))
+	return ASN1_VALUE_NOT_VALID;
+      year += (year < 50) ? 2000 : 1900;
+    }
+  else if (!_asn1_time_digits (&p, 4, &year))
+    return ASN1_VALUE_NOT_VALID;
+
+  if (!_asn1_time_digits (&p, 2, &month)
+      || !_asn1_time_digits (&p, 2, &day)
+      || !_asn1_time_digits (&p, 2, &hour))
+    return ASN1_VALUE_NOT_VALID;
+
+  /* minutes are optional in GeneralizedTime only */
+  if ((utc || isdigit ((unsigned char) *p))
+      && !_asn1_time_digits (&p, 2, &min))
+    return ASN1_VALUE_NOT_VALID;
+  if (isdigit ((unsigned char) *p) && !_asn1_time_digits (&p, 2, &sec))
+    return ASN1_VALUE_NOT_VALID;
+
+  if (!utc && (*p == '.' || *p == ','))
+    {
+      p++;
+      if (!isdigit ((unsigned char) *p))
+	return ASN1_VALUE_NOT_VALID;
+      while (isdigit ((unsigned char) *p))
+	p++;
+    }
+
+  if (*p == 'Z')
+    p++;
+  else if (*p == '+' || *p == '-')
+    {
+      p++;
+      if (!_asn1_time_digits (&p, 2, &zone_hour)
+	  || !_asn1_time_digits (&p, 2, &zone_min)
+	  || zone_hour > 23 || zone_min > 59)
+	return ASN1_VALUE_NOT_VALID;
+      offset = zone_hour * 3600 + zone_min * 60;
+      if (p[-5] == '-')
+	offset = -offset;
+    }
+  else if (utc)
+    return ASN1_VALUE_NOT_VALID;
+
+  if (*p != 0)
+    return ASN1_VALUE_NOT_VALID;
+
+  if (month < 1 || month > 12 || day < 1 || day > month_days[month - 1]
+      || (month == 2 && day == 29 && (year % 4 != 0
+				      || (year % 100 == 0
+					  && year % 400 != 0)))
+      || hour > 23 || min > 59 || sec > 60)
+    return ASN1_VALUE_NOT_VALID;
+
+  *secs = _asn1_days_from_civil (year, month, day) * 86400
+    + hour * 3600 + min * 60 + sec - offset;
+
+  return ASN1_SUCCESS;
+}
+
+/* Reads the TIME NODE, or the chosen alternative if NODE is a CHOICE
+   of times, as seconds since the epoch.  */
+static asn1_retCode
+_asn1_read_time (ASN1_TYPE node, int64_t * secs)
+{
+  if (node == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  if (type_field (node->type) == TYPE_CHOICE)
+    {
+      node = node->down;
+      while (node && type_field (node->type) == TYPE_TAG)
+	node = node->right;
+      /* no alternative has been chosen yet */
+      if (node == NULL || node->right != NULL)
+	return ASN1_VALUE_NOT_FOUND;
+    }
+
+  if (type_field (node->type) != TYPE_TIME)
+    return ASN1_ELEMENT_NOT_FOUND;
+  if (node->value == NULL)
+    return ASN1_VALUE_NOT_FOUND;
+
+  return _asn1_parse_time ((char *) node->value, node->type & CONST_UTC,
+			   secs);
+}
+
+static asn1_retCode
+_asn1_read_time_t (ASN1_TYPE node, time_t * t)
+{
+  int64_t secs;
+  asn1_retCode result;
+
+  result = _asn1_read_time (node, &secs);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  *t = (time_t) secs;
+  if ((int64_t) * t != secs)
+    return ASN1_VALUE_NOT_VALID;
+
+  return ASN1_SUCCESS;
+}
+
+/* Stores SECS in DER form in the TIME NODE.  For a CHOICE of
+   times the UTCTime alternative is chosen for the years 1950 to 2049
+   and the GeneralizedTime one otherwise, as RFC 5280 requires.  */
+static asn1_retCode
+_asn1_write_time (ASN1_TYPE node, int64_t secs)
+{
+  ASN1_TYPE p;
+  struct tm tm;
+  char value[16], *p_value;
+  int year, utc;
+  asn1_retCode result;
+
+  if (node == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  _asn1_time_to_tm (secs, &tm);
+  year = tm.tm_year + 1900;
+  if (year < 0 || year > 9999)
+    return ASN1_VALUE_NOT_VALID;
+  utc = (year >= 1950 && year < 2050);
+
+  if (type_field (node->type) == TYPE_CHOICE)
+    {
+      for (p = node->down; p; p = p->right)
+	if (type_field (p->type) == TYPE_TIME
+	    && (p->type & CONST_UTC) == (utc ? CONST_UTC : 0))
+	  break;
+      /* a GeneralizedTime can hold any year */
+      if (p == NULL)
+	for (p = node->down; p; p = p->right)
+	  if (type_field (p->type) == TYPE_TIME && !(p->type & CONST_UTC))
+	    break;
+      if (p == NULL)
+	return ASN1_VALUE_NOT_VALID;
+
+      result = _asn1_write_value (node, p->name, 1);
+      if (result != ASN1_SUCCESS)
+	return result;
+      node = p;
+    }
+
+  if (type_field (node->type) != TYPE_TIME)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  if (node->type & CONST_UTC)
+    {
+      if (!utc)
+	return ASN1_VALUE_NOT_VALID;
+      p_value = _asn1_time_put_digits (value, year % 100, 2);
+    }
+  else
+    p_value = _asn1_time_put_digits (value, year, 4);
+
+  p_value = _asn1_time_put_digits (p_value, tm.tm_mon + 1, 2);
+  p_value = _asn1_time_put_digits (p_value, tm.tm_mday, 2);
+  p_value = _asn1_time_put_digits (p_value, tm.tm_hour, 2);
+  p_value = _asn1_time_put_digits (p_value, tm.tm_min, 2);
+  p_value = _asn1_time_put_digits (p_value, tm.tm_sec, 2);
+  *p_value++ = 'Z';
+  *p_value = 0;
+
+  _asn1_set_modified (node);
+  if (_asn1_set_value (node, value, strlen (value) + 1) == NULL)
+    return ASN1_MEM_ALLOC_ERROR;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_read_time:
+ * @root: pointer to a structure.
+ * @name: the name of the UTCTime or GeneralizedTime element inside a
+ *   structure, or of a CHOICE between them.
+ * @t: variable that will contain the time.
+ *
+ * Returns the value of a time element as seconds since the epoch.
+ * The value is parsed directly, so certificate validity checks need
+ * not read it with asn1_read_value() and parse the string again.
+ * Time zone offsets are applied, fractions of a second are dropped
+ * and the two digit years of UTCTime are mapped to 1950-2049.
+ *
+ * Returns: %ASN1_SUCCESS if the time was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a time element,
+ *   %ASN1_VALUE_NOT_FOUND if it has no value, or
+ *   %ASN1_VALUE_NOT_VALID if the value is not a valid time or does
+ *   not fit in a time_t.
+ **/
+asn1_retCode
+asn1_read_time (ASN1_TYPE root, const char *name, time_t * t)
+{
+  return _asn1_read_time_t (asn1_find_node (root, name), t);
+}
+
+/**
+ * asn1_read_time_tm:
+ * @root: pointer to a structure.
+ * @name: the name of the UTCTime or GeneralizedTime element inside a
+ *   structure, or of a CHOICE between them.
+ * @tm: variable that will contain the time in UTC.
+ *
+ * Like asn1_read_time() but returns the broken-down UTC time, which
+ * also holds years that do not fit in a time_t.
+ *
+ * Returns: %ASN1_SUCCESS if the time was read,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a time element,
+ *   %ASN1_VALUE_NOT_FOUND if it has no value, or
+ *   %ASN1_VALUE_NOT_VALID if the value is not a valid time.
+ **/
+asn1_retCode
+asn1_read_time_tm (ASN1_TYPE root, const char *name, struct tm *tm)
+{
+  int64_t secs;
+  asn1_retCode result;
+
+  result = _asn1_read_time (asn1_find_node (root, name), &secs);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  _asn1_time_to_tm (secs, tm);
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_write_time:
+ * @node_root: pointer to a structure.
+ * @name: the name of the UTCTime or GeneralizedTime element inside a
+ *   structure, or of a CHOICE between them.
+ * @t: the time to set.
+ *
+ * Sets a time element from seconds since the epoch.  The value is
+ * stored in the form DER requires, "YYMMDDHHMMSSZ" for UTCTime and
+ * "YYYYMMDDHHMMSSZ" for GeneralizedTime.  For a CHOICE between the
+ * two the UTCTime alternative is chosen for the years 1950 to 2049
+ * and the GeneralizedTime one otherwise, as RFC 5280 requires.
+ *
+ * Returns: %ASN1_SUCCESS if the time was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a time element, or
+ *   %ASN1_VALUE_NOT_VALID if the element cannot hold the time.
+ **/
+asn1_retCode
+asn1_write_time (ASN1_TYPE node_root, const char *name, time_t t)
+{
+  return _asn1_write_time (asn1_find_node (node_root, name), t);
+}
+
+/**
+ * asn1_write_time_tm:
+ * @node_root: pointer to a structure.
+ * @name: the name of the UTCTime or GeneralizedTime element inside a
+ *   structure, or of a CHOICE between them.
+ * @tm: the time to set, in UTC.
+ *
+ * Like asn1_write_time() but takes a broken-down UTC time.  Fields
+ * outside their usual ranges are normalized, the tm_wday, tm_yday
+ * and tm_isdst fields are ignored.
+ *
+ * Returns: %ASN1_SUCCESS if the time was set,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a time element, or
+ *   %ASN1_VALUE_NOT_VALID if the element cannot hold the time.
+ **/
+asn1_retCode
+asn1_write_time_tm (ASN1_TYPE node_root, const char *name,
+		    const struct tm *tm)
+{
+  int64_t year, month, secs;
+
+  year = tm->tm_year + (int64_t) 1900 + tm->tm_mon / 12;
+  month = tm->tm_mon % 12;
+  if (month < 0)
+    {
+      month += 12;
+      year--;
+    }
+
+  secs = (_asn1_days_from_civil (year, month + 1, 1) + tm->tm_mday - 1)
+    * 86400 + tm->tm_hour * (int64_t) 3600 + tm->tm_min * 60 + tm->tm_sec;
+
+  return _asn1_write_time (asn1_find_node (node_root, name), secs);
+}
+
+/* Number of identifiers of an element name remembered by
+   _asn1_find_field; longer names are searched from the root.  */
+#define FIELD_DEPTH 16
+
+/* The elements found for the identifiers of the last name searched by
+   _asn1_find_field.  */
+typedef struct
+{
+  int relative;			/* names start below the root */
+  const char *name;
+  int depth;
+  ASN1_TYPE node[FIELD_DEPTH];
+} field_cache;
+
+/* Returns the element after HINT called N in the chain starting with
+   FIRST, wrapping around to FIRST, or the first one called N if HINT
+   is NULL.  The names of a structure are usually asked for in the
+   order of its definition, so each search starts where the last one
+   stopped.  */
+static ASN1_TYPE
+_asn1_find_sibling (ASN1_TYPE first, ASN1_TYPE hint, const char *n)
+{
+  ASN1_TYPE p;
+
+  if (!strcmp (n, "?LAST"))
+    {
+      p = first;
+      while (p && p->right)
+	p = p->right;
+      return p;
+    }
+
+  for (p = hint ? hint->right : first; p; p = p->right)
+    if ((p->name) && (!strcmp (p->name, n)))
+      return p;
+
+  if (hint)
+    for (p = first; p != hint->right; p = p->right)
+      if ((p->name) && (!strcmp (p->name, n)))
+	return p;
+
+  return NULL;
+}
+
+/* Like asn1_find_node, or _asn1_find_child for a relative CACHE, but
+   the identifiers NAME shares with the last name searched with CACHE
+   are not searched again, and the others are searched from the
+   elements found for that name.  */
+static ASN1_TYPE
+_asn1_find_field (ASN1_TYPE root, const char *name, field_cache * cache)
+{
+  ASN1_TYPE p = NULL, hint = NULL;
+  const char *n_start = name, *last = cache->name;
+  char n[ASN1_MAX_NAME_SIZE + 1];
+  int depth = 0, k;
+
+  if (name[0] == 0)
+    return (cache->relative || root->name == NULL) ? root : NULL;
+
+  /* skip the identifiers in common with the last name */
+  while (last && depth < cache->depth)
+    {
+      for (k = 0; n_start[k] == last[k] && n_start[k] && n_start[k] != '.';
+	   k++);
+      if ((n_start[k] && n_start[k] != '.') || (last[k] && last[k] != '.'))
+	{
+	  hint = cache->node[depth];
+	  break;
+	}
+      p = cache->node[depth++];
+      if (n_start[k] == 0)
+	{
+	  cache->name = name;
+	  cache->depth = depth;
+	  return p;
+	}
+      n_start += k + 1;
+      last += k + 1;
+    }
+
+  while (1)
+    {
+      for (k = 0; n_start[k] && n_start[k] != '.'; k++);
+      if (k > ASN1_MAX_NAME_SIZE || depth == FIELD_DEPTH)
+	{
+	  cache->name = NULL;
+	  cache->depth = 0;
+	  if (cache->relative)
+	    return _asn1_find_child (root, name);
+	  return asn1_find_node (root, name);
+	}
+      memcpy (n, n_start, k);
+      n[k] = 0;
+
+      if (depth > 0)
+	p = _asn1_find_sibling (p->down, hint, n);
+      else if (root->name && !cache->relative)
+	p = _asn1_find_sibling (root, hint, n);
+      else
+	p = _asn1_find_sibling (root->down, hint, n);
+      if (p == NULL)
+	break;
+
+      cache->node[depth++] = p;
+      hint = NULL;
+      if (n_start[k] == 0)
+	break;
+      n_start += k + 1;
+    }
+
+  /* the identifiers found so far are still valid */
+  cache->name = name;
+  cache->depth = depth;
+  return p;
+}
+
+/**
+ * asn1_read_fields:
+ * @root: pointer to a structure.
+ * @fields: the elements to read and where their values go.
+ * @count: number of entries of @fields.
+ * @data: the C structure @fields describes.
+ * @errorDescription: return the name of the field that could not be
+ *   read, or %NULL.
+ *
+ * Reads several elements of a structure at once into a C structure,
+ * as described by a static table.  For each entry the element
+ * @name is read according to @type:
+ *
+ * %ASN1_FIELD_VALUE: as with asn1_read_value() into the @size bytes
+ *   at @offset, with the length stored as an int at @len_offset.  If
+ *   %ASN1_FIELD_POINTER is added to @type, @offset holds a pointer to
+ *   the buffer instead of the buffer itself.
+ *
+ * %ASN1_FIELD_INT64, %ASN1_FIELD_UINT64: as with asn1_read_int64() or
+ *   asn1_read_uint64() into an int64_t or uint64_t at @offset.
+ *
+ * %ASN1_FIELD_TIME: as with asn1_read_time() into a time_t at
+ *   @offset.
+ *
+ * %ASN1_FIELD_SEQUENCE_OF is only supported by asn1_write_fields().
+ *
+ * If %ASN1_FIELD_OPTIONAL is added to @type, an element without a
+ * value is skipped instead of stopping the read; the structure is not
+ * changed for it, except that the length of an %ASN1_FIELD_VALUE is
+ * set to -1.
+ *
+ * The elements are found with a single walk of the structure: each
+ * name is only searched from where it differs from the name of the
+ * previous entry, continuing with the elements that follow the last
+ * one found.  Listing the fields in the order of the definitions
+ * makes reading them all take linear time.
+ *
+ * Returns: %ASN1_SUCCESS if all the fields were read, otherwise the
+ *   error of the first field that could not be read, as returned by
+ *   the corresponding asn1_read_*() function.
+ **/
+asn1_retCode
+asn1_read_fields (ASN1_TYPE root, const asn1_field * fields, int count,
+		  void *data, char *errorDescription)
+{
+  field_cache cache;
+  ASN1_TYPE node;
+  unsigned char *field;
+  int *len, k;
+  asn1_retCode result;
+
+  if (root == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  cache.relative = 0;
+  cache.name = NULL;
+  cache.depth = 0;
+
+  for (k = 0; k < count; k++)
+    {
+      node = _asn1_find_field (root, fields[k].name, &cache);
+      field = (unsigned char *) data + fields[k].offset;
+      if (fields[k].type & ASN1_FIELD_POINTER)
+	field = *(unsigned char **) field;
+      len = NULL;
+
+      switch (fields[k].type & ~(ASN1_FIELD_OPTIONAL | ASN1_FIELD_POINTER))
+	{
+	case ASN1_FIELD_VALUE:
+	  len = (int *) ((unsigned char *) data + fields[k].len_offset);
+	  *len = fields[k].size;
+	  result = _asn1_read_value (node, field, len);
+	  break;
+	case ASN1_FIELD_INT64:
+	  result = _asn1_read_int64 (node, (int64_t *) field);
+	  break;
+	case ASN1_FIELD_UINT64:
+	  result = _asn1_read_uint64 (node, (uint64_t *) field);
+	  break;
+	case ASN1_FIELD_TIME:
+	  result = _asn1_read_time_t (node, (time_t *) field);
+	  break;
+	default:
+	  result = ASN1_GENERIC_ERROR;
+	  break;
+	}
+
+      if ((fields[k].type & ASN1_FIELD_OPTIONAL)
+	  && (result == ASN1_ELEMENT_NOT_FOUND
+	      || result == ASN1_VALUE_NOT_FOUND))
+	{
+	  if (len)
+	    *len = -1;
+	  continue;
+	}
+
+      if (result != ASN1_SUCCESS)
+	{
+	  if (errorDescription)
+	    Estrcpy (errorDescription, fields[k].name);
+	  return result;
+	}
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/* Returns 1 if writing VALUE of LEN bytes into NODE, as
+   _asn1_write_value does, may delete elements: an OPTIONAL element or
+   the items of a SEQUENCE OF given no value, or the alternatives of a
+   CHOICE not chosen.  */
+static int
+_asn1_write_deletes (ASN1_TYPE node, const void *value, int len)
+{
+  if (node == NULL)
+    return 0;
+  if (value == NULL && len == 0)
+    return 1;
+  return type_field (node->type) == TYPE_CHOICE;
+}
+
+/* Writes the COUNT FIELDS of DATA into ROOT, with names relative to
+   ROOT if RELATIVE is set.  */
+static asn1_retCode
+_asn1_write_fields (ASN1_TYPE root, const asn1_field * fields, int count,
+		    const unsigned char *data, int relative,
+		    char *errorDescription)
+{
+  field_cache cache;
+  ASN1_TYPE node, p, last;
+  const unsigned char *field, *item;
+  int len, k, i, missing, deletes;
+  asn1_retCode result;
+
+  cache.relative = relative;
+  cache.name = NULL;
+  cache.depth = 0;
+
+  for (k = 0; k < count; k++)
+    {
+      node = _asn1_find_field (root, fields[k].name, &cache);
+      field = data + fields[k].offset;
+      if (fields[k].type & ASN1_FIELD_POINTER)
+	field = *(const unsigned char **) field;
+      missing = deletes = 0;
+
+      switch (fields[k].type & ~(ASN1_FIELD_OPTIONAL | ASN1_FIELD_POINTER))
+	{
+	case ASN1_FIELD_VALUE:
+	  len = *(const int *) (data + fields[k].len_offset);
+	  if (len >= 0)
+	    {
+	      deletes = _asn1_write_deletes (node, field, len);
+	      result = _asn1_write_value (node, field, len);
+	    }
+	  else
+	    {
+	      missing = 1;
+	      result = ASN1_VALUE_NOT_FOUND;
+	    }
+	  break;
+	case ASN1_FIELD_INT64:
+	  result = _asn1_write_uint64 (node, *(const int64_t *) field,
+				       *(const int64_t *) field < 0);
+	  break;
+	case ASN1_FIELD_UINT64:
+	  result = _asn1_write_uint64 (node, *(const uint64_t *) field, 0);
+	  break;
+	case ASN1_FIELD_TIME:
+	  deletes = _asn1_write_deletes (node, field, 1);
+	  result = _asn1_write_time (node, *(const time_t *) field);
+	  break;
+	case ASN1_FIELD_SEQUENCE_OF:
+	  item = *(const unsigned char **) (data + fields[k].offset);
+	  len = *(const int *) (data + fields[k].len_offset);
+	  if (node == NULL || (type_field (node->type) != TYPE_SEQUENCE_OF
+			       && type_field (node->type) != TYPE_SET_OF))
+	    {
+	      result = ASN1_ELEMENT_NOT_FOUND;
+	      break;
+	    }
+	  if (len < 0)
+	    {
+	      missing = 1;
+	      result = ASN1_VALUE_NOT_FOUND;
+	      break;
+	    }
+
+	  /* the type of the items, and the last one already there */
+	  p = node->down;
+	  while ((type_field (p->type) == TYPE_TAG)
+		 || (type_field (p->type) == TYPE_SIZE))
+	    p = p->right;
+	  last = _asn1_get_last_right (p);
+
+	  result = ASN1_SUCCESS;
+	  for (i = 0; i < len && result == ASN1_SUCCESS;
+	       i++, item += fields[k].size)
+	    {
+	      last = _asn1_append_element (p, last);
+	      if (last == NULL)
+		result = ASN1_MEM_ALLOC_ERROR;
+	      else
+		result = _asn1_write_fields (last, fields[k].fields,
+					     fields[k].count, item, 1, NULL);
+	    }
+	  break;
+	default:
+	  result = ASN1_GENERIC_ERROR;
+	  break;
+	}
+
+      /* the elements the cache holds may be gone */
+      if (deletes)
+	{
+	  cache.name = NULL;
+	  cache.depth = 0;
+	}
+
+      /* a missing value removes an OPTIONAL element */
+      if ((fields[k].type & ASN1_FIELD_OPTIONAL) && missing)
+	{
+	  if (node && (node->type & CONST_OPTION))
+	    {
+	      asn1_delete_structure (&node);
+	      cache.name = NULL;
+	      cache.depth = 0;
+	    }
+	  continue;
+	}
+
+      if (result != ASN1_SUCCESS)
+	{
+	  if (errorDescription)
+	    Estrcpy (errorDescription, fields[k].name);
+	  return result;
+	}
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_write_fields:
+ * @node_root: pointer to a structure.
+ * @fields: the elements to set and where their values are.
+ * @count: number of entries of @fields.
+ * @data: the C structure @fields describes.
+ * @errorDescription: return the name of the field that could not be
+ *   written, or %NULL.
+ *
+ * Sets several elements of a structure at once from a C structure,
+ * described by a static table as for asn1_read_fields(), so a
+ * structure read by that function can be written back with the same
+ * table.  For each entry the element @name is set according to
+ * @type:
+ *
+ * %ASN1_FIELD_VALUE: as with asn1_write_value() from the value at
+ *   @offset, or pointed to from there with %ASN1_FIELD_POINTER, whose
+ *   length is the int at @len_offset.
+ *
+ * %ASN1_FIELD_INT64, %ASN1_FIELD_UINT64: as with asn1_write_int64()
+ *   or asn1_write_uint64() from an int64_t or uint64_t at @offset.
+ *
+ * %ASN1_FIELD_TIME: as with asn1_write_time() from a time_t at
+ *   @offset.
+ *
+ * %ASN1_FIELD_SEQUENCE_OF: @offset holds a pointer to an array of
+ *   items of @size bytes, and @len_offset the number of items as an
+ *   int.  An element is added to the SEQUENCE OF or SET OF @name for
+ *   each item, and set from it with the @count entries of @fields,
+ *   whose names are relative to the new element ("" for the element
+ *   itself).
+ *
+ * A negative length or number of items means the value is missing.
+ * That is an error, unless %ASN1_FIELD_OPTIONAL is added to @type;
+ * then an OPTIONAL element is removed, so it is not encoded.
+ *
+ * As in asn1_read_fields() the elements are found in a single walk
+ * when the table follows the order of the definitions.  The items of
+ * a SEQUENCE OF are appended directly after the last one, without
+ * searching for it each time.
+ *
+ * Returns: %ASN1_SUCCESS if all the fields were set, otherwise the
+ *   error of the first field that could not be set, as returned by
+ *   the corresponding asn1_write_*() function.  The fields before it
+ *   have been set.
+ **/
+asn1_retCode
+asn1_write_fields (ASN1_TYPE node_root, const asn1_field * fields,
+		   int count, const void *data, char *errorDescription)
+{
+  if (node_root == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  return _asn1_write_fields (node_root, fields, count, data, 0,
+			     errorDescription);
+}
+
+/* Tag of NODE as asn1_read_tag() returns it.  *TAGVALUE is not set
+   for the types without a tag of their own.  */
+void
+_asn1_read_tag (ASN1_TYPE node, int *tagValue, int *classValue)
+{
+  ASN1_TYPE p, pTag;
+
+  p = node->down;
+
+  /* pTag will points to the IMPLICIT TAG */
+  pTag = NULL;
+  if (node->type & CONST_TAG)
     {
       while (p)
 	{
@@ -974,6 +2439,34 @@ asn1_read_tag (ASN1_TYPE root, const char *name, int *tagValue,
 	  break;
 	}
     }
+}
+
+/**
+ * asn1_read_tag:
+ * @root: pointer to a structure
+ * @name: the name of the element inside a structure.
+ * @tagValue:  variable that will contain the TAG value.
+ * @classValue: variable that will specify the TAG type.
+ *
+ * Returns the TAG and the CLASS of one element inside a structure.
+ * CLASS can have one of these constants: %ASN1_CLASS_APPLICATION,
+ * %ASN1_CLASS_UNIVERSAL, %ASN1_CLASS_PRIVATE or
+ * %ASN1_CLASS_CONTEXT_SPECIFIC.
+ *
+ * Returns: %ASN1_SUCCESS if successful, %ASN1_ELEMENT_NOT_FOUND if
+ *   @name is not a valid element.
+ **/
+asn1_retCode
+asn1_read_tag (ASN1_TYPE root, const char *name, int *tagValue,
+	       int *classValue)
+{
+  ASN1_TYPE node;
+
+  node = asn1_find_node (root, name);
+  if (node == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  _asn1_read_tag (node, tagValue, classValue);
 
   return ASN1_SUCCESS;
 }
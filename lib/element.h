@@ -26,10 +26,14 @@
 
 asn1_retCode _asn1_append_sequence_set (ASN1_TYPE node);
 
+ASN1_TYPE _asn1_append_sequence_item (ASN1_TYPE node, ASN1_TYPE last);
+
 asn1_retCode _asn1_convert_integer (const char *value,
 				    unsigned char *value_out,
 				    int value_out_size, int *len);
 
 void _asn1_hierarchical_name (ASN1_TYPE node, char *name, int name_size);
 
+void _asn1_read_tag (ASN1_TYPE node, int *tagValue, int *classValue);
+
 #endif
@@ -21,6 +21,8 @@
  */
 
 #include <int.h>
+#include "gstr.h"
+#include "element.h"
 #ifdef STDC_HEADERS
 # include <stdarg.h>
 #endif
@@ -53,6 +55,7 @@ static const libtasn1_error_entry error_algorithms[] = {
   LIBTASN1_ERROR_ENTRY (ASN1_NAME_TOO_LONG),
   LIBTASN1_ERROR_ENTRY (ASN1_ARRAY_ERROR),
   LIBTASN1_ERROR_ENTRY (ASN1_ELEMENT_NOT_EMPTY),
+  LIBTASN1_ERROR_ENTRY (ASN1_LIMIT_EXCEEDED),
   {0, 0}
 };
 
@@ -102,6 +105,32 @@ asn1_strerror (asn1_retCode error)
   return NULL;
 }
 
+/**
+ * asn1_error_description:
+ * @error: the error filled by asn1_der_decoding2().
+ * @errorDescription: return the description of @error, of at most
+ *   %ASN1_MAX_ERROR_DESCRIPTION_SIZE bytes.
+ *
+ * Write the description asn1_der_decoding() gives of the same error.
+ * The decoding only records where it failed, the text is built when
+ * it is asked for, from the element: it must not have been deleted
+ * since the decoding.
+ **/
+void
+asn1_error_description (const asn1_error * error, char *errorDescription)
+{
+  errorDescription[0] = 0;
+
+  if (error->code == ASN1_TAG_ERROR && error->node != NULL)
+    {
+      Estrcpy (errorDescription, ":: tag error near element '");
+      _asn1_hierarchical_name (error->node,
+			       errorDescription + strlen (errorDescription),
+			       ASN1_MAX_ERROR_DESCRIPTION_SIZE - 40);
+      Estrcat (errorDescription, "'");
+    }
+}
+
 #ifndef ASN1_DISABLE_DEPRECATED
 
 /* Compatibility mappings to preserve ABI. */
@@ -32,6 +32,8 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
 
 #ifdef HAVE_SYS_TYPES_H
 # include <sys/types.h>
@@ -41,6 +43,30 @@
 
 #define ASN1_SMALL_VALUE_SIZE 16
 
+/* A copy of an encoding shared by the nodes whose DER it holds, see
+   _asn1_set_der_cache.  */
+struct der_cache_st
+{
+  unsigned int refs;
+  int len;
+  unsigned char data[1];
+};
+
+/* Storage of node names.  The names of a copied structure share one
+   block, see _asn1_set_block_name; each one is preceded by a pointer
+   to its block, which is freed with the last name.  */
+struct name_block_st
+{
+  unsigned int refs;
+  unsigned int size;		/* Bytes allocated */
+};
+
+struct name_entry_st
+{
+  struct name_block_st *block;
+  char name[1];
+};
+
 /* This structure is also in libtasn1.h, but then contains less
    fields.  You cannot make any modifications to these first fields
    without breaking ABI.  */
@@ -56,13 +82,23 @@ struct node_asn_struct
   ASN1_TYPE left;		/* Pointer to the next list element */
   /* private fields: */
   unsigned char small_value[ASN1_SMALL_VALUE_SIZE];	/* For small values */
+  ASN1_TYPE up;			/* Father node, or NULL for a root */
+  struct der_cache_st *der;	/* DER of the node, while unchanged */
+  int der_start;		/* Span of the node in der */
+  int der_len;
+  int offset_start;		/* Span of the node in the decoded */
+  int offset_len;		/* encoding, with CONST_OFFSETS */
 };
 
-#define _asn1_malloc malloc
-#define _asn1_free free
-#define _asn1_calloc calloc
-#define _asn1_realloc realloc
-#define _asn1_strdup strdup
+/* For the state the library keeps for each thread */
+#ifdef HAVE_TLS
+# define THREAD_LOCAL __thread
+#else
+# define THREAD_LOCAL
+#endif
+
+#include "memory.h"
+#include "trace.h"
 
 #define MAX_LOG_SIZE 1024	/* maximum number of characters of a log message */
 
@@ -131,6 +167,7 @@ struct node_asn_struct
 #define CONST_UTC         (1<<24)
 
 /* #define CONST_IMPORTS     (1<<25) */
+#define CONST_OFFSETS     (1<<25)	/*  offset_start and offset_len are kept from decoding  */
 
 #define CONST_NOT_USED    (1<<26)
 #define CONST_SET         (1<<27)
@@ -0,0 +1,565 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+
+/*****************************************************/
+/* File: json.c                                      */
+/* Description: Functions to write the elements of   */
+/*  a structure as JSON.                             */
+/*****************************************************/
+
+#include <int.h>
+#include "parser_aux.h"
+
+/* Output of asn1_print_json, written to OUT when DATA is full.  */
+typedef struct
+{
+  FILE *out;
+  int flags;
+  int indent;
+  asn1_retCode error;		/* ASN1_GENERIC_ERROR once OUT could
+				   not be written */
+  int len;
+  char data[4096];
+} json_writer;
+
+static void
+_json_flush (json_writer * w)
+{
+  if ((w->len > 0) && (w->error == ASN1_SUCCESS)
+      && (fwrite (w->data, 1, w->len, w->out) != (size_t) w->len))
+    w->error = ASN1_GENERIC_ERROR;
+  w->len = 0;
+}
+
+static void
+_json_write (json_writer * w, const char *data, int len)
+{
+  int n;
+
+  while (len > 0)
+    {
+      if (w->len == sizeof (w->data))
+	_json_flush (w);
+      n = sizeof (w->data) - w->len;
+      if (n > len)
+	n = len;
+      memcpy (w->data + w->len, data, n);
+      w->len += n;
+      data += n;
+      len -= n;
+    }
+}
+
+static void
+_json_putc (json_writer * w, char c)
+{
+  if (w->len == sizeof (w->data))
+    _json_flush (w);
+  w->data[w->len++] = c;
+}
+
+static void
+_json_puts (json_writer * w, const char *s)
+{
+  _json_write (w, s, strlen (s));
+}
+
+/* Starts a new line at the current depth, when indenting.  */
+static void
+_json_newline (json_writer * w)
+{
+  int k;
+
+  if (!(w->flags & ASN1_JSON_INDENT))
+    return;
+
+  _json_putc (w, '\n');
+  for (k = 0; k < w->indent; k++)
+    _json_puts (w, "  ");
+}
+
+/* The length of the UTF-8 sequence at S, of at most LEN bytes, or 0
+   if it is not valid: overlong, a surrogate, beyond U+10FFFF or
+   truncated.  */
+static int
+_json_utf8_len (const unsigned char *s, int len)
+{
+  unsigned long c;
+  int n, k;
+
+  if (s[0] < 0x80)
+    return 1;
+  else if ((s[0] & 0xE0) == 0xC0)
+    {
+      n = 2;
+      c = s[0] & 0x1F;
+    }
+  else if ((s[0] & 0xF0) == 0xE0)
+    {
+      n = 3;
+      c = s[0] & 0x0F;
+    }
+  else if ((s[0] & 0xF8) == 0xF0)
+    {
+      n = 4;
+      c = s[0] & 0x07;
+    }
+  else
+    return 0;
+
+  if (n > len)
+    return 0;
+  for (k = 1; k < n; k++)
+    {
+      if ((s[k] & 0xC0) != 0x80)
+	return 0;
+      c = (c << 6) | (s[k] & 0x3F);
+    }
+
+  if ((c < 0x80) || ((n > 2) && (c < 0x800)) || ((n > 3) && (c < 0x10000))
+      || ((c >= 0xD800) && (c <= 0xDFFF)) || (c > 0x10FFFF))
+    return 0;
+
+  return n;
+}
+
+/* Writes S as a string.  The bytes that are not valid UTF-8 are
+   written as the characters of the same code, as if S were in
+   ISO-8859-1, so that the output is always valid JSON.  */
+static void
+_json_string (json_writer * w, const unsigned char *s, int len)
+{
+  static const char hex[] = "0123456789abcdef";
+  int k, n;
+
+  _json_putc (w, '"');
+  for (k = 0; k < len; k += n)
+    {
+      n = _json_utf8_len (s + k, len - k);
+      if ((s[k] == '"') || (s[k] == '\\'))
+	{
+	  _json_putc (w, '\\');
+	  _json_putc (w, s[k]);
+	}
+      else if ((s[k] < 0x20) || (n == 0))
+	{
+	  _json_puts (w, "\\u00");
+	  _json_putc (w, hex[s[k] >> 4]);
+	  _json_putc (w, hex[s[k] & 0x0F]);
+	  n = 1;
+	}
+      else
+	_json_write (w, (const char *) s + k, n);
+    }
+  _json_putc (w, '"');
+}
+
+/* Writes DATA as a string, in hexadecimal or in base64.  */
+static void
+_json_binary (json_writer * w, const unsigned char *data, int len)
+{
+  static const char hex[] = "0123456789abcdef";
+  static const char b64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  unsigned long bits;
+  int k;
+
+  _json_putc (w, '"');
+  if (!(w->flags & ASN1_JSON_BASE64))
+    for (k = 0; k < len; k++)
+      {
+	_json_putc (w, hex[data[k] >> 4]);
+	_json_putc (w, hex[data[k] & 0x0F]);
+      }
+  else
+    for (k = 0; k < len; k += 3)
+      {
+	bits = (unsigned long) data[k] << 16;
+	if (k + 1 < len)
+	  bits |= data[k + 1] << 8;
+	if (k + 2 < len)
+	  bits |= data[k + 2];
+	_json_putc (w, b64[(bits >> 18) & 0x3F]);
+	_json_putc (w, b64[(bits >> 12) & 0x3F]);
+	_json_putc (w, (k + 1 < len) ? b64[(bits >> 6) & 0x3F] : '=');
+	_json_putc (w, (k + 2 < len) ? b64[bits & 0x3F] : '=');
+      }
+  _json_putc (w, '"');
+}
+
+/* Writes the two's complement number DATA in decimal, as a string
+   when its magnitude is 2^53 or more, which most readers cannot hold
+   in a number exactly.  */
+static asn1_retCode
+_json_integer (json_writer * w, const unsigned char *data, int len)
+{
+  unsigned char small[4 * 8 + 1], *buffer = small, *n;
+  char *digits;
+  int k, count = 0, negative, carry, rest, quoted;
+
+  if (len <= 0)
+    {
+      _json_putc (w, '0');
+      return ASN1_SUCCESS;
+    }
+
+  /* less than 3 digits a byte */
+  if (len > 8)
+    {
+      buffer = _asn1_malloc (4 * len + 1);
+      if (buffer == NULL)
+	return ASN1_MEM_ALLOC_ERROR;
+    }
+  n = buffer;
+  digits = (char *) buffer + len;
+
+  /* the magnitude, in N */
+  negative = data[0] & 0x80;
+  carry = 1;
+  for (k = len - 1; k >= 0; k--)
+    {
+      n[k] = negative ? (unsigned char) (~data[k] + carry) : data[k];
+      carry = negative && carry && (n[k] == 0);
+    }
+
+  for (k = 0; (k < len) && (n[k] == 0); k++)
+    ;
+  quoted = (len - k > 7) || ((len - k == 7) && (n[k] >= 0x20));
+
+  /* the digits, from the last one, by dividing N by 10 */
+  do
+    {
+      rest = 0;
+      for (k = 0; k < len; k++)
+	{
+	  rest = rest * 256 + n[k];
+	  n[k] = rest / 10;
+	  rest %= 10;
+	}
+      digits[count++] = '0' + rest;
+      while ((len > 0) && (n[0] == 0))
+	{
+	  n++;
+	  len--;
+	}
+    }
+  while (len > 0);
+
+  if (quoted)
+    _json_putc (w, '"');
+  if (negative)
+    _json_putc (w, '-');
+  while (count > 0)
+    _json_putc (w, digits[--count]);
+  if (quoted)
+    _json_putc (w, '"');
+
+  if (buffer != small)
+    _asn1_free (buffer);
+
+  return ASN1_SUCCESS;
+}
+
+/* Whether NODE describes its parent rather than being an element.  */
+static int
+_json_is_element (ASN1_TYPE node)
+{
+  switch (type_field (node->type))
+    {
+    case TYPE_CONSTANT:
+    case TYPE_TAG:
+    case TYPE_SIZE:
+    case TYPE_DEFAULT:
+      return 0;
+    default:
+      return !(node->type & CONST_NOT_USED);
+    }
+}
+
+/* Whether the element NODE has a value to write, or elements.  */
+static int
+_json_is_present (ASN1_TYPE node)
+{
+  switch (type_field (node->type))
+    {
+    case TYPE_SEQUENCE:
+    case TYPE_SET:
+    case TYPE_SEQUENCE_OF:
+    case TYPE_SET_OF:
+    case TYPE_CHOICE:
+    case TYPE_NULL:
+      return 1;
+    default:
+      return (node->value != NULL) || (node->type & CONST_DEFAULT);
+    }
+}
+
+static asn1_retCode _json_element (json_writer * w, ASN1_TYPE node);
+
+/* Writes the elements under NODE as the members of an object, or as
+   the items of an array.  */
+static asn1_retCode
+_json_elements (json_writer * w, ASN1_TYPE node, int array)
+{
+  asn1_retCode result;
+  ASN1_TYPE p;
+  int first = 1;
+
+  _json_putc (w, array ? '[' : '{');
+  w->indent++;
+
+  for (p = node->down; p; p = p->right)
+    {
+      if (!_json_is_element (p) || !_json_is_present (p))
+	continue;
+      /* the first element of a SEQUENCE OF is its template */
+      if (array && ((p->name == NULL) || (p->name[0] != '?')))
+	continue;
+
+      if (!first)
+	_json_putc (w, ',');
+      first = 0;
+      _json_newline (w);
+
+      if (!array)
+	{
+	  _json_string (w, (unsigned char *) p->name,
+			p->name ? strlen (p->name) : 0);
+	  _json_puts (w, (w->flags & ASN1_JSON_INDENT) ? ": " : ":");
+	}
+
+      result = _json_element (w, p);
+      if (result != ASN1_SUCCESS)
+	return result;
+    }
+
+  w->indent--;
+  if (!first)
+    _json_newline (w);
+  _json_putc (w, array ? ']' : '}');
+
+  return ASN1_SUCCESS;
+}
+
+/* Writes the value of the element NODE.  */
+static asn1_retCode
+_json_element (json_writer * w, ASN1_TYPE node)
+{
+  unsigned char value[ASN1_MAX_NAME_SIZE];
+  const unsigned char *data = node->value;
+  ASN1_TYPE p, chosen = NULL;
+  asn1_retCode result = ASN1_SUCCESS;
+  int len = node->value_len, len2, k;
+
+  switch (type_field (node->type))
+    {
+    case TYPE_SEQUENCE:
+    case TYPE_SET:
+      return _json_elements (w, node, 0);
+    case TYPE_SEQUENCE_OF:
+    case TYPE_SET_OF:
+      return _json_elements (w, node, 1);
+    case TYPE_CHOICE:
+      /* an object with the alternative chosen, null until then */
+      for (p = node->down, k = 0; p; p = p->right)
+	if (_json_is_element (p))
+	  {
+	    chosen = p;
+	    k++;
+	  }
+      if (k != 1)
+	break;
+      _json_putc (w, '{');
+      w->indent++;
+      _json_newline (w);
+      _json_string (w, (unsigned char *) chosen->name, strlen (chosen->name));
+      _json_puts (w, (w->flags & ASN1_JSON_INDENT) ? ": " : ":");
+      if (_json_is_present (chosen))
+	result = _json_element (w, chosen);
+      else
+	_json_puts (w, "null");
+      w->indent--;
+      _json_newline (w);
+      _json_putc (w, '}');
+      return result;
+    default:
+      break;
+    }
+
+  /* a DEFAULT value is read as asn1_read_value does */
+  if ((data == NULL) && (node->type & CONST_DEFAULT))
+    {
+      len = sizeof (value);
+      if (asn1_read_element_value (node, "", value, &len) == ASN1_SUCCESS)
+	switch (type_field (node->type))
+	  {
+	  case TYPE_INTEGER:
+	  case TYPE_ENUMERATED:
+	    return _json_integer (w, value, len);
+	  case TYPE_BOOLEAN:
+	    _json_puts (w, (value[0] == 'T') ? "true" : "false");
+	    return ASN1_SUCCESS;
+	  case TYPE_OBJECT_ID:
+	    _json_string (w, value, strlen ((char *) value));
+	    return ASN1_SUCCESS;
+	  default:
+	    break;
+	  }
+    }
+
+  if (data == NULL)
+    {
+      _json_puts (w, "null");
+      return ASN1_SUCCESS;
+    }
+
+  switch (type_field (node->type))
+    {
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+    case TYPE_OCTET_STRING:
+    case TYPE_GENERALSTRING:
+    case TYPE_BIT_STRING:
+    case TYPE_ANY:
+      /* the content octets, after their length */
+      len = asn1_get_length_der (node->value, node->value_len, &len2);
+      if ((len < 0) || (len2 + len > node->value_len))
+	return ASN1_DER_ERROR;
+      data = node->value + len2;
+      break;
+    default:
+      break;
+    }
+
+  switch (type_field (node->type))
+    {
+    case TYPE_INTEGER:
+    case TYPE_ENUMERATED:
+      return _json_integer (w, data, len);
+    case TYPE_BOOLEAN:
+      _json_puts (w, (data[0] == 'T') ? "true" : "false");
+      break;
+    case TYPE_OBJECT_ID:
+    case TYPE_TIME:
+      /* strings kept with their terminating zero */
+      for (k = 0; (k < len) && data[k]; k++)
+	;
+      _json_string (w, data, k);
+      break;
+    case TYPE_BIT_STRING:
+      /* the number of bits and the bytes holding them */
+      _json_puts (w, "{\"bits\":");
+      sprintf ((char *) value, "%d", (len > 0) ? (len - 1) * 8 - data[0] : 0);
+      _json_puts (w, (char *) value);
+      _json_puts (w, ",\"data\":");
+      _json_binary (w, data + 1, (len > 0) ? len - 1 : 0);
+      _json_putc (w, '}');
+      break;
+    case TYPE_OCTET_STRING:
+    case TYPE_GENERALSTRING:
+    case TYPE_ANY:
+      _json_binary (w, data, len);
+      break;
+    default:
+      _json_puts (w, "null");
+      break;
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_print_json:
+ * @out: pointer to the output file (e.g. stdout).
+ * @structure: pointer to the structure that you want to write.
+ * @name: an element of the structure.
+ * @flags: %ASN1_JSON_INDENT to write one member per line, and
+ *   %ASN1_JSON_BASE64 to write binary values in base64 rather than
+ *   in hexadecimal.
+ *
+ * Writes the @name element of @structure to @out as a JSON value.
+ * The value is written as it is built, through a buffer of 4 KiB,
+ * so when an error is returned @out may hold the beginning of the
+ * value, which is then not valid JSON and should be discarded.
+ *
+ * SEQUENCE and SET elements are objects with a member for each
+ * element present, SEQUENCE OF and SET OF elements are arrays, and a
+ * CHOICE is an object whose only member is the alternative chosen.
+ * INTEGER and ENUMERATED values are numbers, or strings of their
+ * decimal digits from 2^53 in magnitude, which most JSON readers
+ * cannot hold exactly as numbers.  BOOLEAN values are true or false,
+ * NULL is null, OBJECT IDENTIFIER values are strings in dotted form,
+ * and times are strings as read by asn1_read_value(), with the bytes
+ * that are not valid UTF-8 read as ISO-8859-1.  OCTET STRING,
+ * GeneralString and ANY values are strings with the octets in
+ * hexadecimal or base64, and a BIT STRING is an object with the
+ * number of bits, "bits", and the octets holding them, "data".
+ *
+ * Without %ASN1_JSON_INDENT the value takes a single line, and no
+ * newline is written after it, so that one line with a newline per
+ * structure gives NDJSON.
+ *
+ * Returns: %ASN1_SUCCESS if the element was written,
+ *   %ASN1_ELEMENT_NOT_FOUND if @name is not a valid element,
+ *   %ASN1_DER_ERROR if a value is not valid, %ASN1_MEM_ALLOC_ERROR
+ *   when out of memory, and %ASN1_GENERIC_ERROR if @out could not be
+ *   written.
+ *
+ * Since: 2.10
+ **/
+asn1_retCode
+asn1_print_json (FILE * out, ASN1_TYPE structure, const char *name,
+		 int flags)
+{
+  json_writer w;
+  ASN1_TYPE root;
+  asn1_retCode result;
+
+  if (out == NULL)
+    return ASN1_GENERIC_ERROR;
+
+  root = asn1_find_node (structure, name);
+  if (root == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  w.out = out;
+  w.flags = flags;
+  w.indent = 0;
+  w.error = ASN1_SUCCESS;
+  w.len = 0;
+
+  if (_json_is_present (root))
+    result = _json_element (&w, root);
+  else
+    {
+      _json_puts (&w, "null");
+      result = ASN1_SUCCESS;
+    }
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  _json_flush (&w);
+  if ((w.error != ASN1_SUCCESS) || ferror (out))
+    return ASN1_GENERIC_ERROR;
+
+  return ASN1_SUCCESS;
+}
@@ -39,6 +39,7 @@
 #include <stdio.h>		/* for FILE* */
 #include <sys/types.h>
 #include <time.h>
+#include <stdint.h>		/* for int64_t */
 
 #ifdef __cplusplus
 extern "C"
@@ -70,6 +71,7 @@ extern "C"
 #define ASN1_NAME_TOO_LONG		15
 #define ASN1_ARRAY_ERROR		16
 #define ASN1_ELEMENT_NOT_EMPTY		17
+#define ASN1_LIMIT_EXCEEDED		18
 
   /*************************************/
   /* Constants used in asn1_visit_tree */
@@ -142,6 +144,118 @@ extern "C"
   };
   typedef struct static_struct_asn ASN1_ARRAY_TYPE;
 
+  /*************************************************/
+  /* Fields of asn1_read_fields and asn1_write_fields */
+  /*************************************************/
+#define ASN1_FIELD_VALUE		0	/* as asn1_read_value */
+#define ASN1_FIELD_INT64		1	/* int64_t */
+#define ASN1_FIELD_UINT64		2	/* uint64_t */
+#define ASN1_FIELD_TIME			3	/* time_t */
+#define ASN1_FIELD_SEQUENCE_OF		4	/* array of structures */
+#define ASN1_FIELD_OPTIONAL		0x100	/* may be missing */
+#define ASN1_FIELD_POINTER		0x200	/* pointer to the value */
+
+  struct asn1_field_st
+  {
+    const char *name;		/* Element name, as for asn1_read_value */
+    int type;			/* ASN1_FIELD_* */
+    size_t offset;		/* Where the value goes */
+    int size;			/* Room for a value, or size of an item */
+    size_t len_offset;		/* Where the length goes, as an int */
+    const struct asn1_field_st *fields;	/* Fields of the items */
+    int count;			/* Number of fields of the items */
+  };
+  typedef struct asn1_field_st asn1_field;
+
+  /*****************************************/
+  /* Flags of asn1_der_decoding2           */
+  /*****************************************/
+#define ASN1_DECODE_KEEP_OFFSETS	1	/* for asn1_read_der_offsets */
+#define ASN1_DECODE_KEEP_DER		2	/* for asn1_der_coding */
+
+  /* Options of asn1_der_decoding_options(), a limit of 0 being none */
+  struct asn1_decode_options_st
+  {
+    size_t size;		/* sizeof (asn1_decode_options) */
+    unsigned int flags;		/* ASN1_DECODE_* */
+    int max_depth;		/* Levels of elements nested */
+    long max_nodes;		/* Elements of the type and of the items */
+    long max_value_bytes;	/* Bytes of the values stored */
+    int max_indefinite;		/* Indefinite lengths nested */
+    size_t max_pool_bytes;	/* Memory a decoder keeps, 0: default */
+  };
+  typedef struct asn1_decode_options_st asn1_decode_options;
+
+  /* Decoder of asn1_decoder_init(), opaque */
+  typedef struct asn1_decoder_st asn1_decoder;
+
+  /*****************************************/
+  /* Flags of asn1_print_json              */
+  /*****************************************/
+#define ASN1_JSON_INDENT		1	/* one member per line */
+#define ASN1_JSON_BASE64		2	/* binary values in base64 */
+
+  /*****************************************/
+  /* Allocators of asn1_set_allocator      */
+  /*****************************************/
+  typedef void *(*asn1_malloc_function) (size_t size, void *ctx);
+  typedef void *(*asn1_realloc_function) (void *ptr, size_t size,
+					  void *ctx);
+  typedef void (*asn1_free_function) (void *ptr, void *ctx);
+
+  /*****************************************/
+  /* Operations of asn1_alloc_stats        */
+  /*****************************************/
+#define ASN1_ALLOC_OTHER		0	/* asn1_write_value... */
+#define ASN1_ALLOC_PARSE		1	/* asn1_parser2tree... */
+#define ASN1_ALLOC_CREATE		2	/* asn1_create_element */
+#define ASN1_ALLOC_DECODE		3	/* asn1_der_decoding... */
+#define ASN1_ALLOC_ENCODE		4	/* asn1_der_coding */
+#define ASN1_ALLOC_SITES		5
+
+  /* Counts of asn1_get_alloc_stats() */
+  struct asn1_alloc_stats_st
+  {
+    unsigned long allocations;	/* Blocks allocated or resized */
+    unsigned long frees;	/* Blocks freed */
+    size_t bytes;		/* Bytes allocated or resized to */
+    long in_use;		/* Bytes allocated less bytes freed */
+    long peak;			/* Highest in_use */
+    struct
+    {
+      unsigned long allocations;
+      size_t bytes;
+    } site[ASN1_ALLOC_SITES];	/* The same, by ASN1_ALLOC_* */
+  };
+  typedef struct asn1_alloc_stats_st asn1_alloc_stats;
+
+  /*****************************************/
+  /* Events of asn1_set_trace_function     */
+  /*****************************************/
+#define ASN1_TRACE_BEGIN		0	/* a function starts */
+#define ASN1_TRACE_END			1	/* it returns */
+#define ASN1_TRACE_NODE			2	/* an element is instantiated */
+#define ASN1_TRACE_CHOICE		3	/* a CHOICE alternative is tried */
+#define ASN1_TRACE_SET			4	/* a SET component is tried */
+#define ASN1_TRACE_ANY			5	/* an ANY is expanded */
+#define ASN1_TRACE_EVENTS		6
+
+  /* Passed to the function of asn1_set_trace_function() */
+  struct asn1_trace_event_st
+  {
+    int event;			/* ASN1_TRACE_* */
+    const char *function;	/* Function of the library running */
+    int depth;			/* 0 if called by the application */
+    ASN1_TYPE node;		/* Element concerned, or NULL */
+    long offset;		/* Position in the DER, or -1 */
+    asn1_retCode result;	/* Returned, for ASN1_TRACE_END */
+    unsigned long count[ASN1_TRACE_EVENTS];	/* Events of the call */
+  };
+  typedef struct asn1_trace_event_st asn1_trace_event;
+
+  typedef void (*asn1_trace_function) (const asn1_trace_event * event,
+				       void *ctx);
+
   /***********************************/
   /*  Fixed constants                */
   /***********************************/
@@ -155,6 +269,17 @@ extern "C"
   /* (null character included)    */
 #define ASN1_MAX_ERROR_DESCRIPTION_SIZE 128
 
+  /* Where asn1_der_decoding2() failed, see asn1_error_tags() */
+  struct asn1_error_st
+  {
+    asn1_retCode code;		/* Error returned */
+    int offset;			/* Position in the DER, or -1 */
+    ASN1_TYPE node;		/* Element decoded there, or NULL */
+    const unsigned char *der;	/* The DER decoded */
+    int der_len;
+  };
+  typedef struct asn1_error_st asn1_error;
+
   /***********************************/
   /*  Functions definitions          */
   /***********************************/
@@ -168,6 +293,11 @@ extern "C"
 		       const char *outputFileName,
 		       const char *vectorName, char *errorDescription);
 
+  extern ASN1_API asn1_retCode
+    asn1_parser2code (const char *inputFileName,
+		      const char *outputFileName,
+		      const char *prefix, char *errorDescription);
+
   extern ASN1_API asn1_retCode
     asn1_array2tree (const ASN1_ARRAY_TYPE * array,
 		     ASN1_TYPE * definitions, char *errorDescription);
@@ -176,6 +306,10 @@ extern "C"
     asn1_print_structure (FILE * out, ASN1_TYPE structure,
 			  const char *name, int mode);
 
+  extern ASN1_API asn1_retCode
+    asn1_print_json (FILE * out, ASN1_TYPE structure, const char *name,
+		     int flags);
+
   extern ASN1_API asn1_retCode
     asn1_create_element (ASN1_TYPE definitions,
 			 const char *source_name, ASN1_TYPE * element);
@@ -193,9 +327,26 @@ extern "C"
     asn1_read_value (ASN1_TYPE root, const char *name,
 		     void *ivalue, int *len);
 
+  extern ASN1_API asn1_retCode
+    asn1_read_fields (ASN1_TYPE root, const asn1_field * fields,
+		      int count, void *data, char *errorDescription);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_fields (ASN1_TYPE node_root, const asn1_field * fields,
+		       int count, const void *data, char *errorDescription);
+
   extern ASN1_API asn1_retCode
     asn1_number_of_elements (ASN1_TYPE element, const char *name, int *num);
 
+  extern ASN1_API ASN1_TYPE
+    asn1_first_element (ASN1_TYPE root, const char *name);
+
+  extern ASN1_API ASN1_TYPE asn1_next_element (ASN1_TYPE element);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_element_value (ASN1_TYPE element, const char *name,
+			     void *ivalue, int *len);
+
   extern ASN1_API asn1_retCode
     asn1_der_coding (ASN1_TYPE element, const char *name,
 		     void *ider, int *len, char *ErrorDescription);
@@ -204,6 +355,26 @@ extern "C"
     asn1_der_decoding (ASN1_TYPE * element, const void *ider,
 		       int len, char *errorDescription);
 
+  extern ASN1_API asn1_retCode
+    asn1_der_decoding2 (ASN1_TYPE * element, const void *ider,
+			int len, unsigned int flags, asn1_error * error);
+
+  extern ASN1_API asn1_retCode
+    asn1_der_decoding_options (ASN1_TYPE * element, const void *ider,
+			       int len, const asn1_decode_options * options,
+			       asn1_error * error);
+
+  extern ASN1_API asn1_retCode
+    asn1_decoder_init (ASN1_TYPE definitions, const char *source_name,
+		       const asn1_decode_options * options,
+		       asn1_decoder ** decoder);
+
+  extern ASN1_API asn1_retCode
+    asn1_decoder_decode (asn1_decoder * decoder, const void *ider,
+			 int len, ASN1_TYPE * element, asn1_error * error);
+
+  extern ASN1_API void asn1_decoder_deinit (asn1_decoder ** decoder);
+
   extern ASN1_API asn1_retCode
     asn1_der_decoding_element (ASN1_TYPE * structure,
 			       const char *elementName,
@@ -216,6 +387,10 @@ extern "C"
 				const char *name_element,
 				int *start, int *end);
 
+  extern ASN1_API asn1_retCode
+    asn1_read_der_offsets (ASN1_TYPE element, const char *name,
+			   int *start, int *end);
+
   extern ASN1_API asn1_retCode
     asn1_expand_any_defined_by (ASN1_TYPE definitions, ASN1_TYPE * element);
 
@@ -224,6 +399,55 @@ extern "C"
 			      ASN1_TYPE * element,
 			      const char *octetName, const char *objectName);
 
+  extern ASN1_API asn1_retCode
+    asn1_write_int64 (ASN1_TYPE node_root, const char *name, int64_t value);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_uint64 (ASN1_TYPE node_root, const char *name,
+		       uint64_t value);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_int64 (ASN1_TYPE root, const char *name, int64_t * value);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_uint64 (ASN1_TYPE root, const char *name, uint64_t * value);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_integer_magnitude (ASN1_TYPE node_root, const char *name,
+				  const unsigned char *magnitude, int len,
+				  int negative);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_integer_magnitude (ASN1_TYPE root, const char *name,
+				 unsigned char *magnitude, int *len,
+				 int *negative);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_integer_magnitude_ref (ASN1_TYPE root, const char *name,
+				     const unsigned char **magnitude,
+				     int *len);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_oid_der (ASN1_TYPE node_root, const char *name,
+			const unsigned char *oid, int len);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_oid_der (ASN1_TYPE root, const char *name,
+		       unsigned char *oid, int *len);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_time (ASN1_TYPE node_root, const char *name, time_t t);
+
+  extern ASN1_API asn1_retCode
+    asn1_write_time_tm (ASN1_TYPE node_root, const char *name,
+			const struct tm *tm);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_time (ASN1_TYPE root, const char *name, time_t * t);
+
+  extern ASN1_API asn1_retCode
+    asn1_read_time_tm (ASN1_TYPE root, const char *name, struct tm *tm);
+
   extern ASN1_API asn1_retCode
     asn1_read_tag (ASN1_TYPE root, const char *name,
 		   int *tagValue, int *classValue);
@@ -239,6 +463,31 @@ extern "C"
 
   extern ASN1_API void asn1_perror (asn1_retCode error);
 
+  extern ASN1_API void
+    asn1_error_description (const asn1_error * error,
+			    char *errorDescription);
+
+  extern ASN1_API void
+    asn1_error_tags (const asn1_error * error, int *expected_class,
+		     unsigned long *expected_tag, int *found_class,
+		     unsigned long *found_tag);
+
+  extern ASN1_API asn1_retCode
+    asn1_set_allocator (asn1_malloc_function malloc_func,
+			asn1_realloc_function realloc_func,
+			asn1_free_function free_func, void *ctx);
+
+  extern ASN1_API asn1_retCode asn1_set_recycling (size_t max_bytes);
+
+  extern ASN1_API void asn1_enable_alloc_stats (int enable);
+
+  extern ASN1_API void asn1_get_alloc_stats (asn1_alloc_stats * out);
+
+  extern ASN1_API void asn1_reset_alloc_stats (void);
+
+  extern ASN1_API asn1_retCode asn1_set_trace_function (asn1_trace_function
+							 func, void *ctx);
+
   /* DER utility functions. */
 
   extern ASN1_API int
@@ -262,6 +511,17 @@ extern "C"
 		      int *ret_len, unsigned char *str,
 		      int str_size, int *bit_len);
 
+  extern ASN1_API asn1_retCode
+    asn1_oid_der (const char *oid, unsigned char *der, int *der_len);
+
+  extern ASN1_API asn1_retCode
+    asn1_get_oid_der (const unsigned char *der, int der_len,
+		      char *oid, int *oid_len);
+
+  extern ASN1_API int
+    asn1_oid_der_cmp (const unsigned char *oid1, int oid1_len,
+		      const unsigned char *oid2, int oid2_len);
+
   extern ASN1_API signed long
     asn1_get_length_der (const unsigned char *der, int der_len, int *len);
 
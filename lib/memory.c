@@ -0,0 +1,551 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+
+/*****************************************************/
+/* File: memory.c                                    */
+/* Description: Allocation of the memory used by the */
+/*  library, through the functions set with          */
+/*  asn1_set_allocator, its statistics, and the      */
+/*  pools recycling the blocks of the elements.      */
+/*****************************************************/
+
+#include <int.h>
+
+static struct
+{
+  asn1_malloc_function malloc_func;	/* NULL for the C library */
+  asn1_realloc_function realloc_func;
+  asn1_free_function free_func;
+  void *ctx;
+  int stats;			/* blocks start with a header */
+} allocator;
+
+/* Counted while allocator.stats is set, by each thread when the
+   compiler supports thread-local variables.  */
+static THREAD_LOCAL asn1_alloc_stats stats;
+static THREAD_LOCAL int site;
+
+/* The pool used by the calls of the thread, or NULL: the one of a
+   decoder while it decodes, else the one of asn1_set_recycling.  */
+static THREAD_LOCAL struct asn1_pool_st *pool;
+static THREAD_LOCAL struct asn1_pool_st *thread_pool;
+
+/* Precedes the blocks while allocator.stats is set, keeping the
+   alignment of malloc.  */
+union header_u
+{
+  size_t size;			/* bytes asked for */
+  void *align_pointer;
+  int64_t align_integer;
+  long double align_double;
+};
+
+static void *
+_asn1_raw_malloc (size_t size)
+{
+  if (allocator.malloc_func == NULL)
+    return malloc (size);
+  return allocator.malloc_func (size, allocator.ctx);
+}
+
+static void *
+_asn1_raw_realloc (void *ptr, size_t size)
+{
+  if (allocator.realloc_func == NULL)
+    return realloc (ptr, size);
+  return allocator.realloc_func (ptr, size, allocator.ctx);
+}
+
+static void
+_asn1_raw_free (void *ptr)
+{
+  if (allocator.free_func == NULL)
+    free (ptr);
+  else
+    allocator.free_func (ptr, allocator.ctx);
+}
+
+static void
+_asn1_count_allocation (size_t size, long change)
+{
+  stats.allocations++;
+  stats.bytes += size;
+  stats.site[site].allocations++;
+  stats.site[site].bytes += size;
+  stats.in_use += change;
+  if (stats.in_use > stats.peak)
+    stats.peak = stats.in_use;
+}
+
+void *
+_asn1_malloc (size_t size)
+{
+  union header_u *header;
+
+  if (!allocator.stats)
+    return _asn1_raw_malloc (size);
+
+  if (size > SIZE_MAX - sizeof (*header))
+    return NULL;
+  header = _asn1_raw_malloc (sizeof (*header) + size);
+  if (header == NULL)
+    return NULL;
+
+  header->size = size;
+  _asn1_count_allocation (size, size);
+
+  return header + 1;
+}
+
+void *
+_asn1_calloc (size_t nmemb, size_t size)
+{
+  void *ptr;
+
+  if (!allocator.stats && allocator.malloc_func == NULL)
+    return calloc (nmemb, size);
+
+  if (size && nmemb > SIZE_MAX / size)
+    return NULL;
+  ptr = _asn1_malloc (nmemb * size);
+  if (ptr != NULL)
+    memset (ptr, 0, nmemb * size);
+
+  return ptr;
+}
+
+void *
+_asn1_realloc (void *ptr, size_t size)
+{
+  union header_u *header;
+  size_t old_size;
+
+  if (!allocator.stats)
+    return _asn1_raw_realloc (ptr, size);
+
+  if (ptr == NULL)
+    return _asn1_malloc (size);
+  if (size > SIZE_MAX - sizeof (*header))
+    return NULL;
+
+  header = (union header_u *) ptr - 1;
+  old_size = header->size;
+  header = _asn1_raw_realloc (header, sizeof (*header) + size);
+  if (header == NULL)
+    return NULL;
+
+  header->size = size;
+  _asn1_count_allocation (size, (long) size - (long) old_size);
+
+  return header + 1;
+}
+
+void
+_asn1_free (void *ptr)
+{
+  union header_u *header;
+
+  if (ptr == NULL)
+    return;
+
+  if (!allocator.stats)
+    {
+      _asn1_raw_free (ptr);
+      return;
+    }
+
+  header = (union header_u *) ptr - 1;
+  stats.frees++;
+  stats.in_use -= header->size;
+  _asn1_raw_free (header);
+}
+
+/* Sizes of the blocks kept by the pools: multiples of POOL_STEP
+   bytes up to POOL_SPLIT, then of POOL_LARGE_STEP up to POOL_MAX.  */
+#define POOL_STEP 16
+#define POOL_SPLIT 1024
+#define POOL_LARGE_STEP 256
+#define POOL_MAX (16 * 1024)
+#define POOL_CLASSES \
+  (POOL_SPLIT / POOL_STEP + (POOL_MAX - POOL_SPLIT) / POOL_LARGE_STEP)
+
+/* The free blocks are linked through their first bytes.  */
+struct asn1_pool_st
+{
+  void *blocks[POOL_CLASSES];	/* free blocks of each size class */
+  size_t bytes;			/* their total size */
+  size_t max_bytes;		/* limit of bytes, or 0 for none */
+};
+
+static struct asn1_pool_st *
+_asn1_current_pool (void)
+{
+  return pool != NULL ? pool : thread_pool;
+}
+
+/* The size class of blocks of SIZE bytes, from 1 to POOL_MAX.  */
+static int
+_asn1_pool_class (size_t size)
+{
+  if (size <= POOL_SPLIT)
+    return (size - 1) / POOL_STEP;
+  return POOL_SPLIT / POOL_STEP + (size - POOL_SPLIT - 1) / POOL_LARGE_STEP;
+}
+
+/* The size of the blocks of size class CLASS.  */
+static size_t
+_asn1_pool_class_size (int class)
+{
+  if (class < POOL_SPLIT / POOL_STEP)
+    return (class + 1) * POOL_STEP;
+  return POOL_SPLIT + (class - POOL_SPLIT / POOL_STEP + 1) * POOL_LARGE_STEP;
+}
+
+/******************************************************************/
+/* Function : _asn1_pool_malloc                                   */
+/* Description: allocates a block of the elements, taken from the */
+/*   pool of the thread when it has one of the size class.  The   */
+/*   blocks are rounded up to their class so that                 */
+/*   _asn1_pool_free can keep them.                               */
+/* Parameters:                                                    */
+/*   size: bytes needed.                                          */
+/* Return: the block, or NULL if out of memory.                   */
+/******************************************************************/
+void *
+_asn1_pool_malloc (size_t size)
+{
+  struct asn1_pool_st *current = _asn1_current_pool ();
+  void *ptr;
+  int class;
+
+  if (size == 0 || size > POOL_MAX)
+    return _asn1_malloc (size);
+
+  class = _asn1_pool_class (size);
+  if (current != NULL && current->blocks[class] != NULL)
+    {
+      ptr = current->blocks[class];
+      current->blocks[class] = *(void **) ptr;
+      current->bytes -= _asn1_pool_class_size (class);
+      return ptr;
+    }
+
+  return _asn1_malloc (_asn1_pool_class_size (class));
+}
+
+/******************************************************************/
+/* Function : _asn1_pool_free                                     */
+/* Description: frees PTR, allocated with _asn1_pool_malloc, or   */
+/*   keeps it in the pool of the thread if there is one and it    */
+/*   is not full.                                                 */
+/* Parameters:                                                    */
+/*   ptr: the block, or NULL.                                     */
+/*   size: the size it was allocated with, or less.               */
+/******************************************************************/
+void
+_asn1_pool_free (void *ptr, size_t size)
+{
+  struct asn1_pool_st *current = _asn1_current_pool ();
+  int class;
+
+  if (ptr == NULL)
+    return;
+
+  if (current == NULL || size < sizeof (void *) || size > POOL_MAX)
+    {
+      _asn1_free (ptr);
+      return;
+    }
+
+  class = _asn1_pool_class (size);
+  if (current->max_bytes != 0
+      && current->bytes + _asn1_pool_class_size (class) > current->max_bytes)
+    {
+      _asn1_free (ptr);
+      return;
+    }
+
+  *(void **) ptr = current->blocks[class];
+  current->blocks[class] = ptr;
+  current->bytes += _asn1_pool_class_size (class);
+}
+
+/* A new pool keeping up to MAX_BYTES, or without limit for 0.  */
+struct asn1_pool_st *
+_asn1_new_pool (size_t max_bytes)
+{
+  struct asn1_pool_st *new_pool;
+
+  new_pool = _asn1_calloc (1, sizeof (struct asn1_pool_st));
+  if (new_pool != NULL)
+    new_pool->max_bytes = max_bytes;
+
+  return new_pool;
+}
+
+/* Frees the blocks kept by P, the largest first, until it keeps
+   MAX_BYTES or less.  */
+static void
+_asn1_trim_pool (struct asn1_pool_st *p, size_t max_bytes)
+{
+  void *ptr;
+  int k;
+
+  for (k = POOL_CLASSES - 1; k >= 0 && p->bytes > max_bytes; k--)
+    while (p->blocks[k] != NULL && p->bytes > max_bytes)
+      {
+	ptr = p->blocks[k];
+	p->blocks[k] = *(void **) ptr;
+	p->bytes -= _asn1_pool_class_size (k);
+	_asn1_free (ptr);
+      }
+}
+
+/* Frees OLD_POOL and the blocks it keeps.  */
+void
+_asn1_delete_pool (struct asn1_pool_st *old_pool)
+{
+  if (old_pool == NULL)
+    return;
+
+  _asn1_trim_pool (old_pool, 0);
+  _asn1_free (old_pool);
+}
+
+/******************************************************************/
+/* Function : _asn1_enter_pool                                    */
+/* Description: makes the blocks of the elements freed by the     */
+/*   thread go to NEW_POOL, and those it allocates come from it.  */
+/*   Without thread-local variables the pools are not used, since */
+/*   the threads would share them.                                */
+/* Parameters:                                                    */
+/*   new_pool: the pool, or NULL for none.                        */
+/* Return: the value for _asn1_leave_pool.                        */
+/******************************************************************/
+struct asn1_pool_st *
+_asn1_enter_pool (struct asn1_pool_st *new_pool)
+{
+  struct asn1_pool_st *previous = pool;
+
+#ifdef HAVE_TLS
+  pool = new_pool;
+#endif
+
+  return previous;
+}
+
+void
+_asn1_leave_pool (struct asn1_pool_st *previous)
+{
+#ifdef HAVE_TLS
+  pool = previous;
+#endif
+}
+
+char *
+_asn1_strdup (const char *s)
+{
+  size_t size = strlen (s) + 1;
+  char *copy;
+
+  copy = _asn1_malloc (size);
+  if (copy != NULL)
+    memcpy (copy, s, size);
+
+  return copy;
+}
+
+/******************************************************************/
+/* Function : _asn1_enter_site                                    */
+/* Description: counts the next allocations of the thread as      */
+/*   those of NEW_SITE, unless an outer function already set one. */
+/*   Nothing is written while the allocations are not counted.    */
+/* Parameters:                                                    */
+/*   new_site: one of ASN1_ALLOC_*.                               */
+/* Return: the value for _asn1_leave_site, -1 if not counted.     */
+/******************************************************************/
+int
+_asn1_enter_site (int new_site)
+{
+  int previous;
+
+  if (!allocator.stats)
+    return -1;
+
+  previous = site;
+  if (previous == ASN1_ALLOC_OTHER)
+    site = new_site;
+
+  return previous;
+}
+
+void
+_asn1_leave_site (int previous)
+{
+  if (previous >= 0)
+    site = previous;
+}
+
+/**
+ * asn1_set_allocator:
+ * @malloc_func: allocates a block, as malloc(), or %NULL.
+ * @realloc_func: changes the size of a block, as realloc(), or %NULL.
+ * @free_func: frees a block, as free(), or %NULL.
+ * @ctx: passed to the three functions.
+ *
+ * Makes the library allocate all its memory with the given
+ * functions, for example to use a slab allocator or to limit the
+ * memory of a request.  With %NULL functions the library uses the C
+ * library again.
+ *
+ * The functions are used by all the threads, and must be thread safe
+ * when the library is used by several threads.  This function must
+ * be called before the library allocates memory, or when all the
+ * definitions and elements have been deleted.
+ *
+ * Returns: %ASN1_SUCCESS, or %ASN1_GENERIC_ERROR if only some of the
+ *   functions are %NULL.
+ **/
+asn1_retCode
+asn1_set_allocator (asn1_malloc_function malloc_func,
+		    asn1_realloc_function realloc_func,
+		    asn1_free_function free_func, void *ctx)
+{
+  if ((malloc_func == NULL) != (free_func == NULL)
+      || (malloc_func == NULL) != (realloc_func == NULL))
+    return ASN1_GENERIC_ERROR;
+
+  allocator.malloc_func = malloc_func;
+  allocator.realloc_func = realloc_func;
+  allocator.free_func = free_func;
+  allocator.ctx = ctx;
+
+  return ASN1_SUCCESS;
+}
+
+/**
+ * asn1_set_recycling:
+ * @max_bytes: the most bytes kept for reuse, or 0 to stop recycling.
+ *
+ * Makes the calling thread keep the memory of the elements it
+ * deletes, up to @max_bytes, and reuse it for the elements it
+ * creates or decodes next, so that a thread creating and deleting
+ * similar elements for each request no longer allocates memory for
+ * them.  The blocks are kept by size, and those beyond @max_bytes are
+ * freed.  The decoders of asn1_decoder_init() keep the memory of
+ * their own elements, and do not use that of the thread.
+ *
+ * With a @max_bytes of 0 the memory kept is freed, which a thread
+ * must do before exiting.  The memory kept still counts as in use in
+ * asn1_get_alloc_stats(), and must be freed before calling
+ * asn1_set_allocator().
+ *
+ * Returns: %ASN1_SUCCESS, %ASN1_MEM_ALLOC_ERROR if out of memory, or
+ *   %ASN1_GENERIC_ERROR if the compiler does not support thread-local
+ *   variables, without which the memory is not recycled.
+ **/
+asn1_retCode
+asn1_set_recycling (size_t max_bytes)
+{
+#ifdef HAVE_TLS
+  if (max_bytes == 0)
+    {
+      _asn1_delete_pool (thread_pool);
+      thread_pool = NULL;
+      return ASN1_SUCCESS;
+    }
+
+  if (thread_pool == NULL)
+    {
+      thread_pool = _asn1_new_pool (max_bytes);
+      if (thread_pool == NULL)
+	return ASN1_MEM_ALLOC_ERROR;
+    }
+
+  thread_pool->max_bytes = max_bytes;
+  _asn1_trim_pool (thread_pool, max_bytes);
+
+  return ASN1_SUCCESS;
+#else
+  return max_bytes == 0 ? ASN1_SUCCESS : ASN1_GENERIC_ERROR;
+#endif
+}
+
+/**
+ * asn1_enable_alloc_stats:
+ * @enable: non zero to count the allocations, zero to stop.
+ *
+ * Counts the allocations of the library, their size and the memory
+ * in use, in total and for each kind of operation: parsing
+ * definitions (%ASN1_ALLOC_PARSE), creating (%ASN1_ALLOC_CREATE),
+ * decoding (%ASN1_ALLOC_DECODE) and encoding (%ASN1_ALLOC_ENCODE)
+ * elements, and the others such as writing values
+ * (%ASN1_ALLOC_OTHER).  The allocations made by a function for
+ * another one, such as the elements created while decoding, are
+ * counted for the function called by the application.
+ * asn1_get_alloc_stats() returns the counts.
+ *
+ * Each block then starts with its size, which the library needs to
+ * count the memory freed, so as with asn1_set_allocator() this
+ * function must be called before the library allocates memory, or
+ * when all the definitions and elements have been deleted.
+ *
+ * When the compiler does not support thread-local variables the
+ * counts are shared by the threads, so they must only be enabled
+ * while a single thread uses the library.
+ **/
+void
+asn1_enable_alloc_stats (int enable)
+{
+  allocator.stats = enable != 0;
+}
+
+/**
+ * asn1_get_alloc_stats:
+ * @out: filled with the counts.
+ *
+ * Returns the allocations counted since asn1_enable_alloc_stats() or
+ * asn1_reset_alloc_stats().  When the compiler supports thread-local
+ * variables the counts are those of the calling thread, so the
+ * memory used to handle a request can be measured while other
+ * threads handle others: a block freed by another thread than the
+ * one that allocated it is counted by the thread that freed it.
+ **/
+void
+asn1_get_alloc_stats (asn1_alloc_stats * out)
+{
+  *out = stats;
+}
+
+/**
+ * asn1_reset_alloc_stats:
+ *
+ * Sets the counts returned by asn1_get_alloc_stats() to zero, so
+ * that they count the following allocations only.  The memory in use
+ * then counts the bytes allocated less the bytes freed since the
+ * reset, and can be negative.
+ **/
+void
+asn1_reset_alloc_stats (void)
+{
+  memset (&stats, 0, sizeof (stats));
+}
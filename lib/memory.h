@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+#ifndef _MEMORY_H
+#define _MEMORY_H
+
+
+void *_asn1_malloc (size_t size);
+
+void *_asn1_calloc (size_t nmemb, size_t size);
+
+void *_asn1_realloc (void *ptr, size_t size);
+
+void _asn1_free (void *ptr);
+
+char *_asn1_strdup (const char *s);
+
+void *_asn1_pool_malloc (size_t size);
+
+void _asn1_pool_free (void *ptr, size_t size);
+
+struct asn1_pool_st *_asn1_new_pool (size_t max_bytes);
+
+void _asn1_delete_pool (struct asn1_pool_st *old_pool);
+
+struct asn1_pool_st *_asn1_enter_pool (struct asn1_pool_st *new_pool);
+
+void _asn1_leave_pool (struct asn1_pool_st *previous);
+
+int _asn1_enter_site (int site);
+
+void _asn1_leave_site (int previous);
+
+#endif
@@ -58,14 +58,15 @@ _asn1_add_node (unsigned int type)
   list_type *listElement;
   ASN1_TYPE punt;
 
-  punt = (ASN1_TYPE) _asn1_calloc (1, sizeof (struct node_asn_struct));
+  punt = (ASN1_TYPE) _asn1_pool_malloc (sizeof (struct node_asn_struct));
   if (punt == NULL)
     return NULL;
+  memset (punt, 0, sizeof (struct node_asn_struct));
 
   listElement = (list_type *) _asn1_malloc (sizeof (list_type));
   if (listElement == NULL)
     {
-      _asn1_free (punt);
+      _asn1_pool_free (punt, sizeof (struct node_asn_struct));
       return NULL;
     }
 
@@ -78,6 +79,70 @@ _asn1_add_node (unsigned int type)
   return punt;
 }
 
+/* Follows the identifiers of N_START, separated by dots, down from P.
+   Each one is the name of a child of the element found for the
+   previous one.  */
+static ASN1_TYPE
+_asn1_find_down (ASN1_TYPE p, const char *n_start)
+{
+  char *n_end, n[ASN1_MAX_NAME_SIZE + 1];
+
+  while (n_start)
+    {				/* Has the end of NAME been reached? */
+      n_end = strchr (n_start, '.');	/* search the next dot */
+      if (n_end)
+	{
+	  memcpy (n, n_start, n_end - n_start);
+	  n[n_end - n_start] = 0;
+	  n_start = n_end;
+	  n_start++;
+	}
+      else
+	{
+	  _asn1_str_cpy (n, sizeof (n), n_start);
+	  n_start = NULL;
+	}
+
+      if (p->down == NULL)
+	return NULL;
+
+      /* the assignments of a module are indexed */
+      if ((type_field (p->type) == TYPE_DEFINITIONS) && strcmp (n, "?LAST"))
+	{
+	  p = _asn1_find_definition (p, n);
+	  if (p == NULL)
+	    return NULL;
+	  continue;
+	}
+
+      p = p->down;
+
+      /* The identifier "?LAST" indicates the last element
+         in the right chain. */
+      if (!strcmp (n, "?LAST"))
+	{
+	  if (p == NULL)
+	    return NULL;
+	  while (p->right)
+	    p = p->right;
+	}
+      else
+	{			/* no "?LAST" */
+	  while (p)
+	    {
+	      if ((p->name) && (!strcmp (p->name, n)))
+		break;
+	      else
+		p = p->right;
+	    }
+	  if (p == NULL)
+	    return NULL;
+	}
+    }				/* while */
+
+  return p;
+}
+
 /**
  * asn1_find_node:
  * @pointer: NODE_ASN element pointer.
@@ -139,51 +204,26 @@ asn1_find_node (ASN1_TYPE pointer, const char *name)
 	return p;
     }
 
-  while (n_start)
-    {				/* Has the end of NAME been reached? */
-      n_end = strchr (n_start, '.');	/* search the next dot */
-      if (n_end)
-	{
-	  memcpy (n, n_start, n_end - n_start);
-	  n[n_end - n_start] = 0;
-	  n_start = n_end;
-	  n_start++;
-	}
-      else
-	{
-	  _asn1_str_cpy (n, sizeof (n), n_start);
-	  n_start = NULL;
-	}
-
-      if (p->down == NULL)
-	return NULL;
-
-      p = p->down;
+  return _asn1_find_down (p, n_start);
+}
 
-      /* The identifier "?LAST" indicates the last element
-         in the right chain. */
-      if (!strcmp (n, "?LAST"))
-	{
-	  if (p == NULL)
-	    return NULL;
-	  while (p->right)
-	    p = p->right;
-	}
-      else
-	{			/* no "?LAST" */
-	  while (p)
-	    {
-	      if ((p->name) && (!strcmp (p->name, n)))
-		break;
-	      else
-		p = p->right;
-	    }
-	  if (p == NULL)
-	    return NULL;
-	}
-    }				/* while */
+/******************************************************************/
+/* Function : _asn1_find_child                                    */
+/* Description: searches for an element below NODE.  Unlike      */
+/*   asn1_find_node the first identifier of NAME is the name of a */
+/*   child of NODE, whatever the name of NODE itself.             */
+/* Parameters:                                                    */
+/*   node: element pointer.                                       */
+/*   name: identifiers separated by dots, or "" for NODE itself.  */
+/* Return: the element found, or NULL.                            */
+/******************************************************************/
+ASN1_TYPE
+_asn1_find_child (ASN1_TYPE node, const char *name)
+{
+  if (node == NULL || name == NULL)
+    return NULL;
 
-  return p;
+  return _asn1_find_down (node, (name[0] != 0) ? name : NULL);
 }
 
 
@@ -205,7 +245,7 @@ _asn1_set_value (ASN1_TYPE node, const void *value, unsigned int len)
   if (node->value)
     {
       if (node->value != node->small_value)
-	_asn1_free (node->value);
+	_asn1_pool_free (node->value, node->value_len);
       node->value = NULL;
       node->value_len = 0;
     }
@@ -219,7 +259,7 @@ _asn1_set_value (ASN1_TYPE node, const void *value, unsigned int len)
     }
   else
     {
-      node->value = _asn1_malloc (len);
+      node->value = _asn1_pool_malloc (len);
       if (node->value == NULL)
 	return NULL;
     }
@@ -245,12 +285,21 @@ _asn1_set_value_octet (ASN1_TYPE node, const void *value, unsigned int len)
 {
   int len2;
   void *temp;
+  unsigned char small_value[sizeof (node->small_value)];
 
   if (node == NULL)
     return node;
 
   asn1_length_der (len, NULL, &len2);
-  temp = (unsigned char *) _asn1_malloc (len + len2);
+
+  /* short values go to the node's own storage without a malloc */
+  if (len + len2 < sizeof (small_value))
+    {
+      asn1_octet_der (value, len, small_value, &len2);
+      return _asn1_set_value (node, small_value, len2);
+    }
+
+  temp = (unsigned char *) _asn1_pool_malloc (len + len2);
   if (temp == NULL)
     return NULL;
 
@@ -258,8 +307,47 @@ _asn1_set_value_octet (ASN1_TYPE node, const void *value, unsigned int len)
   return _asn1_set_value_m (node, temp, len2);
 }
 
+/******************************************************************/
+/* Function : _asn1_set_value_oid                                 */
+/* Description: sets the VALUE of an OBJECT IDENTIFIER element to */
+/*   the dotted decimal OID followed by the content octets DER it */
+/*   was decoded from, that _asn1_value_der returns.              */
+/* Parameters:                                                    */
+/*   node: element pointer.                                       */
+/*   oid: the value as a string.                                  */
+/*   der: the content octets of its encoding.                     */
+/*   der_len: number of octets in der.                            */
+/* Return: pointer to the NODE_ASN element.                       */
+/******************************************************************/
+ASN1_TYPE
+_asn1_set_value_oid (ASN1_TYPE node, const char *oid,
+		     const unsigned char *der, int der_len)
+{
+  unsigned char small_value[sizeof (node->small_value)], *temp;
+  int len = strlen (oid) + 1;
+
+  if (node == NULL)
+    return node;
+
+  if (len + der_len < sizeof (small_value))
+    temp = small_value;
+  else
+    {
+      temp = _asn1_pool_malloc (len + der_len);
+      if (temp == NULL)
+	return NULL;
+    }
+
+  memcpy (temp, oid, len);
+  memcpy (temp + len, der, der_len);
+
+  if (temp == small_value)
+    return _asn1_set_value (node, small_value, len + der_len);
+  return _asn1_set_value_m (node, temp, len + der_len);
+}
+
 /* the same as _asn1_set_value except that it sets an already malloc'ed
- * value.
+ * value, allocated with _asn1_pool_malloc of LEN bytes or more.
  */
 ASN1_TYPE
 _asn1_set_value_m (ASN1_TYPE node, void *value, unsigned int len)
@@ -270,7 +358,7 @@ _asn1_set_value_m (ASN1_TYPE node, void *value, unsigned int len)
   if (node->value)
     {
       if (node->value != node->small_value)
-	_asn1_free (node->value);
+	_asn1_pool_free (node->value, node->value_len);
       node->value = NULL;
       node->value_len = 0;
     }
@@ -299,34 +387,22 @@ _asn1_append_value (ASN1_TYPE node, const void *value, unsigned int len)
 {
   if (node == NULL)
     return node;
-  if (node->value != NULL && node->value != node->small_value)
+  if (node->value != NULL)
     {
-      /* value is allocated */
+      /* the value moves to a block of the new size, as the pools
+	 keep the blocks by size */
       int prev_len = node->value_len;
-      node->value_len += len;
-      node->value = _asn1_realloc (node->value, node->value_len);
-      if (node->value == NULL)
-	{
-	  node->value_len = 0;
-	  return NULL;
-	}
-      memcpy (&node->value[prev_len], value, len);
+      unsigned char *new_value;
 
-      return node;
-    }
-  else if (node->value == node->small_value)
-    {
-      /* value is in node */
-      int prev_len = node->value_len;
-      node->value_len += len;
-      node->value = _asn1_malloc (node->value_len);
-      if (node->value == NULL)
-	{
-	  node->value_len = 0;
-	  return NULL;
-	}
-      memcpy (node->value, node->small_value, prev_len);
-      memcpy (&node->value[prev_len], value, len);
+      new_value = _asn1_pool_malloc (prev_len + len);
+      if (new_value == NULL)
+	return NULL;
+      memcpy (new_value, node->value, prev_len);
+      memcpy (new_value + prev_len, value, len);
+      if (node->value != node->small_value)
+	_asn1_pool_free (node->value, prev_len);
+      node->value = new_value;
+      node->value_len = prev_len + len;
 
       return node;
     }
@@ -334,6 +410,20 @@ _asn1_append_value (ASN1_TYPE node, const void *value, unsigned int len)
     return _asn1_set_value (node, value, len);
 }
 
+/* Names are aligned in their blocks for the pointer before them.  */
+#define NAME_ALIGN(size) \
+  (((size) + sizeof (void *) - 1) / sizeof (void *) * sizeof (void *))
+#define NAME_BLOCK_HEADER NAME_ALIGN (sizeof (struct name_block_st))
+
+static void
+_asn1_free_name (char *name)
+{
+  if (name != NULL)
+    _asn1_put_name_block (((struct name_entry_st *)
+			   (name - offsetof (struct name_entry_st,
+					     name)))->block);
+}
+
 /******************************************************************/
 /* Function : _asn1_set_name                                      */
 /* Description: sets the field NAME in a NODE_ASN element. The    */
@@ -347,32 +437,95 @@ _asn1_append_value (ASN1_TYPE node, const void *value, unsigned int len)
 ASN1_TYPE
 _asn1_set_name (ASN1_TYPE node, const char *name)
 {
+  struct name_block_st *block;
+  unsigned int used = 0;
+
   if (node == NULL)
     return node;
 
-  if (node->name)
+  if ((name == NULL) || (name[0] == 0))
     {
-      _asn1_free (node->name);
+      _asn1_free_name (node->name);
       node->name = NULL;
+      return node;
     }
 
-  if (name == NULL)
-    return node;
+  block = _asn1_new_name_block (_asn1_name_size (name));
+  if (block == NULL)
+    return NULL;
+
+  _asn1_set_block_name (node, name, block, &used);
+  _asn1_put_name_block (block);
 
-  if (strlen (name))
-    {
-      node->name = (char *) _asn1_strdup (name);
-      if (node->name == NULL)
-	return NULL;
-    }
-  else
-    node->name = NULL;
   return node;
 }
 
+/******************************************************************/
+/* Function : _asn1_name_size                                     */
+/* Description: room taken by NAME in a name block.               */
+/******************************************************************/
+unsigned int
+_asn1_name_size (const char *name)
+{
+  return NAME_ALIGN (offsetof (struct name_entry_st, name) +
+		     strlen (name) + 1);
+}
+
+/******************************************************************/
+/* Function : _asn1_new_name_block                                */
+/* Description: allocates a block for names taking SIZE bytes, as */
+/*   summed with _asn1_name_size.  The caller owns one reference. */
+/* Return: NULL if out of memory.                                 */
+/******************************************************************/
+struct name_block_st *
+_asn1_new_name_block (unsigned int size)
+{
+  struct name_block_st *block;
+
+  block = _asn1_pool_malloc (NAME_BLOCK_HEADER + size);
+  if (block == NULL)
+    return NULL;
+
+  block->refs = 1;
+  block->size = NAME_BLOCK_HEADER + size;
+
+  return block;
+}
+
+void
+_asn1_put_name_block (struct name_block_st *block)
+{
+  if (--block->refs == 0)
+    _asn1_pool_free (block, block->size);
+}
+
+/******************************************************************/
+/* Function : _asn1_set_block_name                                */
+/* Description: sets the field NAME of NODE to a copy of NAME     */
+/*   stored in BLOCK, *USED bytes after its start.  *USED is      */
+/*   updated.  NAME must not be empty.                            */
+/******************************************************************/
+void
+_asn1_set_block_name (ASN1_TYPE node, const char *name,
+		      struct name_block_st *block, unsigned int *used)
+{
+  struct name_entry_st *entry;
+
+  entry = (struct name_entry_st *) ((char *) block + NAME_BLOCK_HEADER +
+				    *used);
+  entry->block = block;
+  strcpy (entry->name, name);
+  block->refs++;
+  *used += _asn1_name_size (name);
+
+  _asn1_free_name (node->name);
+  node->name = entry->name;
+}
+
 /******************************************************************/
 /* Function : _asn1_set_right                                     */
-/* Description: sets the field RIGHT in a NODE_ASN element.       */
+/* Description: sets the field RIGHT in a NODE_ASN element, and  */
+/*   gives RIGHT and the elements after it the father of NODE.    */
 /* Parameters:                                                    */
 /*   node: element pointer.                                       */
 /*   right: pointer to a NODE_ASN element that you want be pointed*/
@@ -387,6 +540,8 @@ _asn1_set_right (ASN1_TYPE node, ASN1_TYPE right)
   node->right = right;
   if (right)
     right->left = node;
+  for (; right && right->up != node->up; right = right->right)
+    right->up = node->up;
   return node;
 }
 
@@ -428,7 +583,8 @@ _asn1_get_last_right (ASN1_TYPE node)
 
 /******************************************************************/
 /* Function : _asn1_set_down                                      */
-/* Description: sets the field DOWN in a NODE_ASN element.        */
+/* Description: sets the field DOWN in a NODE_ASN element, and   */
+/*   makes NODE the father of DOWN and the elements after it.     */
 /* Parameters:                                                    */
 /*   node: element pointer.                                       */
 /*   down: pointer to a NODE_ASN element that you want be pointed */
@@ -443,6 +599,8 @@ _asn1_set_down (ASN1_TYPE node, ASN1_TYPE down)
   node->down = down;
   if (down)
     down->left = node;
+  for (; down && down->up != node; down = down->right)
+    down->up = node;
   return node;
 }
 
@@ -511,11 +669,12 @@ _asn1_remove_node (ASN1_TYPE node)
   if (node == NULL)
     return;
 
-  if (node->name != NULL)
-    _asn1_free (node->name);
+  _asn1_free_name (node->name);
   if (node->value != NULL && node->value != node->small_value)
-    _asn1_free (node->value);
-  _asn1_free (node);
+    _asn1_pool_free (node->value, node->value_len);
+  if (node->der != NULL)
+    _asn1_put_der_cache (node->der);
+  _asn1_pool_free (node, sizeof (struct node_asn_struct));
 }
 
 /******************************************************************/
@@ -528,17 +687,105 @@ _asn1_remove_node (ASN1_TYPE node)
 ASN1_TYPE
 _asn1_find_up (ASN1_TYPE node)
 {
-  ASN1_TYPE p;
-
   if (node == NULL)
     return NULL;
 
+  return node->up;
+}
+
+/******************************************************************/
+/* Function : _asn1_new_der_cache                                 */
+/* Description: copies an encoding to share it between the nodes  */
+/*   it holds.  The caller owns one reference.                    */
+/* Return: NULL if out of memory.                                 */
+/******************************************************************/
+struct der_cache_st *
+_asn1_new_der_cache (const unsigned char *der, int der_len)
+{
+  struct der_cache_st *cache;
+
+  cache = _asn1_pool_malloc (sizeof (*cache) + der_len);
+  if (cache == NULL)
+    return NULL;
+
+  cache->refs = 1;
+  cache->len = der_len;
+  memcpy (cache->data, der, der_len);
+
+  return cache;
+}
+
+void
+_asn1_put_der_cache (struct der_cache_st *cache)
+{
+  if (--cache->refs == 0)
+    _asn1_pool_free (cache, sizeof (*cache) + cache->len);
+}
+
+/******************************************************************/
+/* Function : _asn1_set_der_cache                                 */
+/* Description: records that CACHE->data[START..START+LEN-1] is   */
+/*   the encoding of NODE, tags included.  A NULL CACHE drops the */
+/*   previous one.                                                */
+/******************************************************************/
+void
+_asn1_set_der_cache (ASN1_TYPE node, struct der_cache_st *cache,
+		     int start, int len)
+{
+  if (cache != NULL)
+    cache->refs++;
+  if (node->der != NULL)
+    _asn1_put_der_cache (node->der);
+
+  node->der = cache;
+  node->der_start = start;
+  node->der_len = len;
+}
+
+/******************************************************************/
+/* Function : _asn1_clear_der_cache                               */
+/* Description: drops the cached encodings of NODE and of all the */
+/*   elements under it.                                           */
+/******************************************************************/
+void
+_asn1_clear_der_cache (ASN1_TYPE node)
+{
+  ASN1_TYPE p;
+
   p = node;
+  while (p)
+    {
+      if (p->der != NULL)
+	_asn1_set_der_cache (p, NULL, 0, 0);
 
-  while ((p->left != NULL) && (p->left->right == p))
-    p = p->left;
+      if (p->down)
+	p = p->down;
+      else
+	{
+	  while (p != node && p->right == NULL)
+	    p = _asn1_find_up (p);
+	  if (p == node)
+	    break;
+	  p = p->right;
+	}
+    }
+}
 
-  return p->left;
+/******************************************************************/
+/* Function : _asn1_set_modified                                  */
+/* Description: drops the cached encodings that contain NODE      */
+/*   before its value or its elements change: those of NODE and   */
+/*   of every element above it, up to the root, whether or not    */
+/*   the elements between them have one.                          */
+/******************************************************************/
+void
+_asn1_set_modified (ASN1_TYPE node)
+{
+  ASN1_TYPE p;
+
+  for (p = node; p; p = _asn1_find_up (p))
+    if (p->der != NULL)
+      _asn1_set_der_cache (p, NULL, 0, 0);
 }
 
 /******************************************************************/
@@ -578,6 +825,32 @@ _asn1_delete_list_and_nodes (void)
     }
 }
 
+/******************************************************************/
+/* Function : _asn1_delete_list_and_unused_nodes                  */
+/* Description: deletes the list elements and the elements        */
+/*  pointed by them that are not in the tree of ROOT, such as the */
+/*  ones a grammar rule replaced by a new element.                */
+/******************************************************************/
+void
+_asn1_delete_list_and_unused_nodes (ASN1_TYPE root)
+{
+  list_type *listElement;
+  ASN1_TYPE p, up;
+
+  /* nothing is freed before all the elements are checked */
+  for (listElement = firstElement; listElement;
+       listElement = listElement->next)
+    {
+      p = listElement->node;
+      while ((up = _asn1_find_up (p)) != NULL)
+	p = up;
+      if (p == root)
+	listElement->node = NULL;
+    }
+
+  _asn1_delete_list_and_nodes ();
+}
+
 
 char *
 _asn1_ltostr (long v, char *str)
@@ -681,6 +954,127 @@ _asn1_change_integer_value (ASN1_TYPE node)
 }
 
 
+/******************************************************************/
+/* Function : _asn1_expand_default_value                          */
+/* Description: appends to the DEFAULT value of every INTEGER and */
+/*   ENUMERATED element its two's complement encoding, after the  */
+/*   terminating zero of the text.  Writing, reading and encoding */
+/*   such an element then compare against these bytes instead of  */
+/*   converting the DEFAULT again.                                */
+/* Parameters:                                                    */
+/*   node: root of an ASN1element.                                */
+/* Return:                                                        */
+/*   ASN1_ELEMENT_NOT_FOUND if NODE is NULL,                      */
+/*   otherwise ASN1_SUCCESS                                       */
+/******************************************************************/
+asn1_retCode
+_asn1_expand_default_value (ASN1_TYPE node)
+{
+  ASN1_TYPE p, p2, p3;
+  unsigned char val[ASN1_MAX_NAME_SIZE + SIZEOF_UNSIGNED_LONG_INT + 1];
+  const char *value;
+  int text_len, len;
+
+  if (node == NULL)
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  p = node;
+  while (p)
+    {
+      if (((type_field (p->type) == TYPE_INTEGER)
+	   || (type_field (p->type) == TYPE_ENUMERATED))
+	  && (p->type & CONST_DEFAULT))
+	{
+	  p2 = p->down;
+	  while (p2 && (type_field (p2->type) != TYPE_DEFAULT))
+	    p2 = p2->right;
+
+	  value = NULL;
+	  if (p2 && p2->value)
+	    {
+	      value = (char *) p2->value;
+	      if (!isdigit (value[0]) && (value[0] != '-'))
+		{		/* is an identifier like v1 */
+		  for (p3 = p->down; p3; p3 = p3->right)
+		    if ((type_field (p3->type) == TYPE_CONSTANT) && p3->name
+			&& !strcmp (p3->name, value))
+		      break;
+		  value = p3 ? (char *) p3->value : NULL;
+		}
+	    }
+
+	  text_len = p2 && p2->value ? strlen ((char *) p2->value) + 1 : 0;
+	  if (value && (text_len <= ASN1_MAX_NAME_SIZE)
+	      && (text_len == p2->value_len)
+	      && (_asn1_convert_integer (value, val + text_len,
+					 SIZEOF_UNSIGNED_LONG_INT,
+					 &len) == ASN1_SUCCESS))
+	    {
+	      memcpy (val, p2->value, text_len);
+	      _asn1_set_value (p2, val, text_len + len);
+	    }
+	}
+
+      if (p->down)
+	{
+	  p = p->down;
+	}
+      else
+	{
+	  if (p == node)
+	    p = NULL;
+	  else if (p->right)
+	    p = p->right;
+	  else
+	    {
+	      while (1)
+		{
+		  p = _asn1_find_up (p);
+		  if (p == node)
+		    {
+		      p = NULL;
+		      break;
+		    }
+		  if (p->right)
+		    {
+		      p = p->right;
+		      break;
+		    }
+		}
+	    }
+	}
+    }
+
+  return ASN1_SUCCESS;
+}
+
+/******************************************************************/
+/* Function : _asn1_value_der                                     */
+/* Description: returns the encoding stored after the string      */
+/*   value of NODE: the two's complement one stored by            */
+/*   _asn1_expand_default_value in a DEFAULT node, or the content */
+/*   octets stored by _asn1_set_value_oid.                        */
+/* Parameters:                                                    */
+/*   node: the TYPE_DEFAULT or TYPE_OBJECT_ID node.               */
+/*   len: number of bytes returned.                               */
+/* Return: the encoding or NULL if there is none.                 */
+/******************************************************************/
+const unsigned char *
+_asn1_value_der (ASN1_TYPE node, int *len)
+{
+  int text_len;
+
+  if (node == NULL || node->value == NULL)
+    return NULL;
+
+  text_len = strlen ((char *) node->value) + 1;
+  if (node->value_len <= text_len)
+    return NULL;
+
+  *len = node->value_len - text_len;
+  return node->value + text_len;
+}
+
 /******************************************************************/
 /* Function : _asn1_expand_object_id                              */
 /* Description: expand the IDs of an OBJECT IDENTIFIER constant.  */
@@ -30,6 +30,8 @@
 /***************************************/
 ASN1_TYPE _asn1_add_node (unsigned int type);
 
+ASN1_TYPE _asn1_find_child (ASN1_TYPE node, const char *name);
+
 ASN1_TYPE
 _asn1_set_value (ASN1_TYPE node, const void *value, unsigned int len);
 
@@ -38,11 +40,24 @@ ASN1_TYPE _asn1_set_value_m (ASN1_TYPE node, void *value, unsigned int len);
 ASN1_TYPE
 _asn1_set_value_octet (ASN1_TYPE node, const void *value, unsigned int len);
 
+ASN1_TYPE
+_asn1_set_value_oid (ASN1_TYPE node, const char *oid,
+		     const unsigned char *der, int der_len);
+
 ASN1_TYPE
 _asn1_append_value (ASN1_TYPE node, const void *value, unsigned int len);
 
 ASN1_TYPE _asn1_set_name (ASN1_TYPE node, const char *name);
 
+unsigned int _asn1_name_size (const char *name);
+
+struct name_block_st *_asn1_new_name_block (unsigned int size);
+
+void _asn1_put_name_block (struct name_block_st *block);
+
+void _asn1_set_block_name (ASN1_TYPE node, const char *name,
+			   struct name_block_st *block, unsigned int *used);
+
 ASN1_TYPE _asn1_set_right (ASN1_TYPE node, ASN1_TYPE right);
 
 ASN1_TYPE _asn1_get_right (ASN1_TYPE node);
@@ -63,14 +78,32 @@ void _asn1_delete_list (void);
 
 void _asn1_delete_list_and_nodes (void);
 
+void _asn1_delete_list_and_unused_nodes (ASN1_TYPE root);
+
 char *_asn1_ltostr (long v, char *str);
 
 ASN1_TYPE _asn1_find_up (ASN1_TYPE node);
 
+struct der_cache_st *_asn1_new_der_cache (const unsigned char *der,
+					  int der_len);
+
+void _asn1_put_der_cache (struct der_cache_st *cache);
+
+void _asn1_set_der_cache (ASN1_TYPE node, struct der_cache_st *cache,
+			  int start, int len);
+
+void _asn1_clear_der_cache (ASN1_TYPE node);
+
+void _asn1_set_modified (ASN1_TYPE node);
+
 asn1_retCode _asn1_change_integer_value (ASN1_TYPE node);
 
 asn1_retCode _asn1_expand_object_id (ASN1_TYPE node);
 
+asn1_retCode _asn1_expand_default_value (ASN1_TYPE node);
+
+const unsigned char *_asn1_value_der (ASN1_TYPE node, int *len);
+
 asn1_retCode _asn1_type_set_config (ASN1_TYPE node);
 
 asn1_retCode _asn1_check_identifier (ASN1_TYPE node);
@@ -50,9 +50,10 @@ _asn1_add_node_only (unsigned int type)
 {
   ASN1_TYPE punt;
 
-  punt = (ASN1_TYPE) _asn1_calloc (1, sizeof (struct node_asn_struct));
+  punt = (ASN1_TYPE) _asn1_pool_malloc (sizeof (struct node_asn_struct));
   if (punt == NULL)
     return NULL;
+  memset (punt, 0, sizeof (struct node_asn_struct));
 
   punt->type = type;
 
@@ -158,6 +159,10 @@ _asn1_create_static_structure (ASN1_TYPE pointer, char *output_file_name,
 }
 
 
+static asn1_retCode
+_asn1_array2tree (const ASN1_ARRAY_TYPE * array, ASN1_TYPE * definitions,
+		  char *errorDescription);
+
 /**
  * asn1_array2tree:
  * @array: specify the array that contains ASN.1 declarations
@@ -177,6 +182,19 @@ _asn1_create_static_structure (ASN1_TYPE pointer, char *output_file_name,
 asn1_retCode
 asn1_array2tree (const ASN1_ARRAY_TYPE * array, ASN1_TYPE * definitions,
 		 char *errorDescription)
+{
+  int site = _asn1_enter_site (ASN1_ALLOC_PARSE);
+  asn1_retCode result;
+
+  result = _asn1_array2tree (array, definitions, errorDescription);
+  _asn1_leave_site (site);
+
+  return result;
+}
+
+static asn1_retCode
+_asn1_array2tree (const ASN1_ARRAY_TYPE * array, ASN1_TYPE * definitions,
+		  char *errorDescription)
 {
   ASN1_TYPE p, p_last = NULL;
   unsigned long k;
@@ -242,6 +260,8 @@ asn1_array2tree (const ASN1_ARRAY_TYPE * array, ASN1_TYPE * definitions,
 	{
 	  _asn1_change_integer_value (*definitions);
 	  _asn1_expand_object_id (*definitions);
+	  _asn1_expand_default_value (*definitions);
+	  _asn1_create_oid_index (*definitions);
 	}
     }
   else
@@ -309,6 +329,7 @@ asn1_delete_structure (ASN1_TYPE * structure)
 	    }
 	  else
 	    {			/* p==root */
+	      _asn1_set_modified (_asn1_find_up (p));
 	      p3 = _asn1_find_left (p);
 	      if (!p3)
 		{
@@ -356,6 +377,8 @@ asn1_delete_element (ASN1_TYPE structure, const char *element_name)
   if (source_node == ASN1_TYPE_EMPTY)
     return ASN1_ELEMENT_NOT_FOUND;
 
+  _asn1_set_modified (_asn1_find_up (source_node));
+
   p2 = source_node->right;
   p3 = _asn1_find_left (source_node);
   if (!p3)
@@ -369,19 +392,59 @@ asn1_delete_element (ASN1_TYPE structure, const char *element_name)
   else
     _asn1_set_right (p3, p2);
 
+  /* deleted as a structure of its own */
+  source_node->left = source_node->right = source_node->up = NULL;
+
   return asn1_delete_structure (&source_node);
 }
 
+/* Room taken by the names that _asn1_copy_structure3 copies.  */
+static unsigned int
+_asn1_copy_names_size (ASN1_TYPE source_node)
+{
+  ASN1_TYPE p;
+  unsigned int size = 0;
+
+  p = source_node;
+  for (;;)
+    {
+      if (p->name)
+	size += _asn1_name_size (p->name);
+
+      if (p->down && !p->der)
+	p = p->down;
+      else
+	{
+	  while ((p != source_node) && (p->right == NULL))
+	    p = _asn1_find_up (p);
+	  if (p == source_node)
+	    break;
+	  p = p->right;
+	}
+    }
+
+  return size;
+}
+
 ASN1_TYPE
 _asn1_copy_structure3 (ASN1_TYPE source_node)
 {
   ASN1_TYPE dest_node, p_s, p_d, p_d_prev;
+  struct name_block_st *names;
+  unsigned int names_used = 0;
   int move;
 
   if (source_node == NULL)
     return NULL;
 
+  /* all the names of the copy take one allocation */
+  names = _asn1_new_name_block (_asn1_copy_names_size (source_node));
+  if (names == NULL)
+    return NULL;
+
   dest_node = _asn1_add_node_only (source_node->type);
+  if (dest_node == NULL)
+    goto error;
 
   p_s = source_node;
   p_d = dest_node;
@@ -393,9 +456,18 @@ _asn1_copy_structure3 (ASN1_TYPE source_node)
       if (move != UP)
 	{
 	  if (p_s->name)
-	    _asn1_set_name (p_d, p_s->name);
-	  if (p_s->value)
-	    _asn1_set_value (p_d, p_s->value, p_s->value_len);
+	    _asn1_set_block_name (p_d, p_s->name, names, &names_used);
+	  if (p_s->value
+	      && _asn1_set_value (p_d, p_s->value, p_s->value_len) == NULL)
+	    goto error;
+	  if (p_s->type & CONST_OFFSETS)
+	    {
+	      p_d->offset_start = p_s->offset_start;
+	      p_d->offset_len = p_s->offset_len;
+	    }
+	  if (p_s->der)
+	    _asn1_set_der_cache (p_d, p_s->der, p_s->der_start,
+				 p_s->der_len);
 	  move = DOWN;
 	}
       else
@@ -403,11 +475,14 @@ _asn1_copy_structure3 (ASN1_TYPE source_node)
 
       if (move == DOWN)
 	{
-	  if (p_s->down)
+	  /* the cached encoding stands for the elements */
+	  if (p_s->down && !p_s->der)
 	    {
 	      p_s = p_s->down;
 	      p_d_prev = p_d;
 	      p_d = _asn1_add_node_only (p_s->type);
+	      if (p_d == NULL)
+		goto error;
 	      _asn1_set_down (p_d_prev, p_d);
 	    }
 	  else
@@ -424,6 +499,8 @@ _asn1_copy_structure3 (ASN1_TYPE source_node)
 	      p_s = p_s->right;
 	      p_d_prev = p_d;
 	      p_d = _asn1_add_node_only (p_s->type);
+	      if (p_d == NULL)
+		goto error;
 	      _asn1_set_right (p_d_prev, p_d);
 	    }
 	  else
@@ -437,19 +514,14 @@ _asn1_copy_structure3 (ASN1_TYPE source_node)
     }
   while (p_s != source_node);
 
-  return dest_node;
-}
-
-
-static ASN1_TYPE
-_asn1_copy_structure2 (ASN1_TYPE root, const char *source_name)
-{
-  ASN1_TYPE source_node;
+  _asn1_put_name_block (names);
 
-  source_node = asn1_find_node (root, source_name);
-
-  return _asn1_copy_structure3 (source_node);
+  return dest_node;
 
+error:
+  _asn1_put_name_block (names);
+  asn1_delete_structure (&dest_node);
+  return NULL;
 }
 
 
@@ -560,12 +632,18 @@ _asn1_expand_identifier (ASN1_TYPE * node, ASN1_TYPE root)
 	      _asn1_str_cpy (name2, sizeof (name2), root->name);
 	      _asn1_str_cat (name2, sizeof (name2), ".");
 	      _asn1_str_cat (name2, sizeof (name2), p->value);
-	      p2 = _asn1_copy_structure2 (root, name2);
+	      p2 = asn1_find_node (root, name2);
 	      if (p2 == NULL)
 		{
 		  return ASN1_IDENTIFIER_NOT_FOUND;
 		}
-	      _asn1_set_name (p2, p->name);
+	      _asn1_trace (ASN1_TRACE_NODE, node, p2, -1);
+	      p2 = _asn1_copy_structure3 (p2);
+	      if (p2 == NULL || _asn1_set_name (p2, p->name) == NULL)
+		{
+		  asn1_delete_structure (&p2);
+		  return ASN1_MEM_ALLOC_ERROR;
+		}
 	      p2->right = p->right;
 	      p2->left = p->left;
 	      if (p->right)
@@ -659,6 +737,10 @@ _asn1_expand_identifier (ASN1_TYPE * node, ASN1_TYPE root)
  *
  * rc = asn1_create_element(cert_def, "PKIX1.Certificate", certptr);
  *
+ * @definitions is only read, so several threads can create elements
+ * from the same definitions at the same time.  Each element must be
+ * used by one thread at a time.
+ *
  * Returns: %ASN1_SUCCESS if creation OK, %ASN1_ELEMENT_NOT_FOUND if
  *   @source_name is not known.
  **/
@@ -666,20 +748,35 @@ asn1_retCode
 asn1_create_element (ASN1_TYPE definitions, const char *source_name,
 		     ASN1_TYPE * element)
 {
-  ASN1_TYPE dest_node;
-  int res;
+  ASN1_TYPE source, dest_node = ASN1_TYPE_EMPTY;
+  const char *caller;
+  int res, site;
 
-  dest_node = _asn1_copy_structure2 (definitions, source_name);
+  site = _asn1_enter_site (ASN1_ALLOC_CREATE);
+  caller = _asn1_trace_begin ("asn1_create_element", definitions);
 
-  if (dest_node == NULL)
-    return ASN1_ELEMENT_NOT_FOUND;
-
-  _asn1_set_name (dest_node, "");
-
-  res = _asn1_expand_identifier (&dest_node, definitions);
-  _asn1_type_choice_config (dest_node);
+  source = asn1_find_node (definitions, source_name);
+  if (source == NULL)
+    res = ASN1_ELEMENT_NOT_FOUND;
+  else
+    {
+      _asn1_trace (ASN1_TRACE_NODE, node, source, -1);
+      dest_node = _asn1_copy_structure3 (source);
+      if (dest_node == NULL || _asn1_set_name (dest_node, "") == NULL)
+	res = ASN1_MEM_ALLOC_ERROR;
+      else
+	res = _asn1_expand_identifier (&dest_node, definitions);
+    }
 
-  *element = dest_node;
+  if (res == ASN1_SUCCESS)
+    {
+      _asn1_type_choice_config (dest_node);
+      *element = dest_node;
+    }
+  else
+    asn1_delete_structure (&dest_node);
+  _asn1_trace_end (caller, res);
+  _asn1_leave_site (site);
 
   return res;
 }
@@ -1087,6 +1184,320 @@ asn1_number_of_elements (ASN1_TYPE element, const char *name, int *num)
   return ASN1_SUCCESS;
 }
 
+/**
+ * asn1_first_element:
+ * @root: pointer to the root of an ASN1 structure.
+ * @name: the name of a SEQUENCE OF or SET OF inside @root.
+ *
+ * Starts an iteration over the elements of the SEQUENCE OF or SET OF
+ * called @name, the ones named "?1", "?2", ... in the order they
+ * were decoded or written.  The next ones are returned by
+ * asn1_next_element(), and their values can be read with
+ * asn1_read_element_value().  Unlike reading "?1", "?2", ... by name,
+ * where each name is searched again from the first element, walking
+ * all the elements this way takes linear time.
+ *
+ * The elements stay valid as long as the structure is not changed.
+ *
+ * Returns: the first element, or %ASN1_TYPE_EMPTY if @name is not a
+ *   SEQUENCE OF or SET OF or it has no elements.
+ **/
+ASN1_TYPE
+asn1_first_element (ASN1_TYPE root, const char *name)
+{
+  ASN1_TYPE node, p;
+
+  node = asn1_find_node (root, name);
+  if (node == NULL || (type_field (node->type) != TYPE_SEQUENCE_OF
+		       && type_field (node->type) != TYPE_SET_OF))
+    return ASN1_TYPE_EMPTY;
+
+  for (p = node->down; p; p = p->right)
+    if ((p->name) && (p->name[0] == '?'))
+      return p;
+
+  return ASN1_TYPE_EMPTY;
+}
+
+/**
+ * asn1_next_element:
+ * @element: an element returned by asn1_first_element() or
+ *   asn1_next_element().
+ *
+ * Continues the iteration started by asn1_first_element().
+ *
+ * Returns: the element that follows @element, or %ASN1_TYPE_EMPTY
+ *   after the last one.
+ **/
+ASN1_TYPE
+asn1_next_element (ASN1_TYPE element)
+{
+  ASN1_TYPE p;
+
+  if (element == NULL)
+    return ASN1_TYPE_EMPTY;
+
+  for (p = element->right; p; p = p->right)
+    if ((p->name) && (p->name[0] == '?'))
+      return p;
+
+  return ASN1_TYPE_EMPTY;
+}
+
+
+/* Index of the OBJECT IDENTIFIER assignments and of the type names
+   of a definitions tree.  It is kept as the value of the DEFINITIONS
+   node, in one allocation with the header, the two hash tables and
+   the dotted OID strings.  */
+typedef struct
+{
+  ASN1_TYPE definitions;	/* tree the index was built for */
+  unsigned int size;		/* number of OID slots, a power of 2 */
+  unsigned int names;		/* number of name slots, a power of 2 */
+} oid_index_type;
+
+typedef struct
+{
+  ASN1_TYPE node;		/* OBJECT IDENTIFIER assignment, or NULL */
+  unsigned int hash;
+  unsigned int oid;		/* offset of the dotted OID */
+} oid_slot_type;
+
+typedef struct
+{
+  ASN1_TYPE node;		/* child of DEFINITIONS, or NULL */
+  unsigned int hash;		/* of its name */
+} name_slot_type;
+
+#define OID_SLOTS(index) ((oid_slot_type *) ((index) + 1))
+#define NAME_SLOTS(index) \
+  ((name_slot_type *) (OID_SLOTS (index) + (index)->size))
+#define OID_STRINGS(index) ((char *) (NAME_SLOTS (index) + (index)->names))
+
+static unsigned int
+_asn1_oid_hash (const char *oid)
+{
+  unsigned int hash = 0;
+
+  while (*oid)
+    hash = hash * 31 + (unsigned char) *oid++;
+
+  return hash;
+}
+
+/* Read the dotted value of the OBJECT IDENTIFIER assignment NODE.  */
+static asn1_retCode
+_asn1_read_oid_assignment (ASN1_TYPE definitions, ASN1_TYPE node,
+			   char *value, int *len)
+{
+  char name[2 * ASN1_MAX_NAME_SIZE + 1];
+
+  if ((type_field (node->type) != TYPE_OBJECT_ID) ||
+      !(node->type & CONST_ASSIGN))
+    return ASN1_ELEMENT_NOT_FOUND;
+
+  strcpy (name, definitions->name);
+  strcat (name, ".");
+  strcat (name, node->name);
+
+  return asn1_read_value (definitions, name, value, len);
+}
+
+/******************************************************************/
+/* Function : _asn1_create_oid_index                              */
+/* Description: builds the index used by                          */
+/*   _asn1_find_oid_assignment and _asn1_find_definition.  It     */
+/*   must be called once, when the definitions are created, so    */
+/*   that they are not modified while they are shared.  Without   */
+/*   memory the index is not built and the searches are           */
+/*   sequential.                                                  */
+/* Parameters:                                                    */
+/*   definitions: pointer to a DEFINITIONS element.               */
+/******************************************************************/
+void
+_asn1_create_oid_index (ASN1_TYPE definitions)
+{
+  char value[ASN1_MAX_NAME_SIZE];
+  oid_index_type *index;
+  oid_slot_type *slot;
+  name_slot_type *name_slot;
+  ASN1_TYPE p;
+  unsigned int count = 0, size, names, types = 0, strings = 0, hash, k;
+  size_t index_size;
+  int len;
+
+  if ((definitions == NULL) ||
+      (type_field (definitions->type) != TYPE_DEFINITIONS) ||
+      (definitions->value != NULL))
+    return;
+
+  for (p = definitions->down; p; p = p->right)
+    {
+      if (p->name)
+	types++;
+      len = sizeof (value);
+      if (_asn1_read_oid_assignment (definitions, p, value, &len) ==
+	  ASN1_SUCCESS)
+	{
+	  count++;
+	  strings += strlen (value) + 1;
+	}
+    }
+
+  for (size = 8; size < 2 * count; size *= 2)
+    ;
+  for (names = 8; names < 2 * types; names *= 2)
+    ;
+
+  /* freed as the value of DEFINITIONS */
+  index_size = sizeof (oid_index_type) + size * sizeof (oid_slot_type) +
+    names * sizeof (name_slot_type) + strings;
+  index = _asn1_pool_malloc (index_size);
+  if (index == NULL)
+    return;
+  memset (index, 0, index_size);
+
+  index->definitions = definitions;
+  index->size = size;
+  index->names = names;
+
+  strings = 0;
+  for (p = definitions->down; p; p = p->right)
+    {
+      if (p->name)
+	{
+	  /* the first type of a name is found first */
+	  hash = _asn1_oid_hash (p->name);
+	  for (k = hash & (names - 1); NAME_SLOTS (index)[k].node;
+	       k = (k + 1) & (names - 1))
+	    ;
+	  name_slot = &NAME_SLOTS (index)[k];
+	  name_slot->node = p;
+	  name_slot->hash = hash;
+	}
+
+      len = sizeof (value);
+      if (_asn1_read_oid_assignment (definitions, p, value, &len) !=
+	  ASN1_SUCCESS)
+	continue;
+
+      /* the first assignment of an OID is found first */
+      hash = _asn1_oid_hash (value);
+      for (k = hash & (size - 1); OID_SLOTS (index)[k].node;
+	   k = (k + 1) & (size - 1))
+	;
+      slot = &OID_SLOTS (index)[k];
+      slot->node = p;
+      slot->hash = hash;
+      slot->oid = strings;
+      strcpy (OID_STRINGS (index) + strings, value);
+      strings += strlen (value) + 1;
+    }
+
+  definitions->value = (unsigned char *) index;
+  definitions->value_len = index_size;
+}
+
+/* The index of DEFINITIONS, or NULL if it has none.  */
+static oid_index_type *
+_asn1_get_oid_index (ASN1_TYPE definitions)
+{
+  oid_index_type *index;
+
+  index = (oid_index_type *) definitions->value;
+  if ((type_field (definitions->type) == TYPE_DEFINITIONS) &&
+      (index != NULL) && (definitions->value_len >= sizeof (*index)) &&
+      (index->definitions == definitions))
+    return index;
+
+  return NULL;
+}
+
+/******************************************************************/
+/* Function : _asn1_find_definition                               */
+/* Description: searches the first child of DEFINITIONS called    */
+/*   NAME, the type or value assignment named NAME.               */
+/* Parameters:                                                    */
+/*   definitions: pointer to a DEFINITIONS element.               */
+/*   name: name of the assignment, without the module name.       */
+/* Return: the assignment node, or NULL if not found.             */
+/******************************************************************/
+ASN1_TYPE
+_asn1_find_definition (ASN1_TYPE definitions, const char *name)
+{
+  oid_index_type *index;
+  name_slot_type *slot;
+  ASN1_TYPE p;
+  unsigned int hash, k;
+
+  index = _asn1_get_oid_index (definitions);
+  if (index != NULL)
+    {
+      hash = _asn1_oid_hash (name);
+      for (k = hash & (index->names - 1); NAME_SLOTS (index)[k].node;
+	   k = (k + 1) & (index->names - 1))
+	{
+	  slot = &NAME_SLOTS (index)[k];
+	  if ((slot->hash == hash) && !strcmp (slot->node->name, name))
+	    return slot->node;
+	}
+      return NULL;
+    }
+
+  for (p = definitions->down; p; p = p->right)
+    if ((p->name) && !strcmp (p->name, name))
+      return p;
+
+  return NULL;
+}
+
+/******************************************************************/
+/* Function : _asn1_find_oid_assignment                           */
+/* Description: searches the first OBJECT IDENTIFIER assignment   */
+/*   of DEFINITIONS whose value is OID.                           */
+/* Parameters:                                                    */
+/*   definitions: pointer to a DEFINITIONS element.               */
+/*   oid: dotted value of the OBJECT IDENTIFIER (e.g. "1.2.3.4"). */
+/* Return: the assignment node, or NULL if not found.             */
+/******************************************************************/
+ASN1_TYPE
+_asn1_find_oid_assignment (ASN1_TYPE definitions, const char *oid)
+{
+  char value[ASN1_MAX_NAME_SIZE];
+  oid_index_type *index;
+  oid_slot_type *slot;
+  ASN1_TYPE p;
+  unsigned int hash, k;
+  int len;
+
+  if ((definitions == NULL) || (oid == NULL))
+    return NULL;
+
+  index = _asn1_get_oid_index (definitions);
+  if (index != NULL)
+    {
+      hash = _asn1_oid_hash (oid);
+      for (k = hash & (index->size - 1); OID_SLOTS (index)[k].node;
+	   k = (k + 1) & (index->size - 1))
+	{
+	  slot = &OID_SLOTS (index)[k];
+	  if ((slot->hash == hash) &&
+	      !strcmp (OID_STRINGS (index) + slot->oid, oid))
+	    return slot->node;
+	}
+      return NULL;
+    }
+
+  for (p = definitions->down; p; p = p->right)
+    {
+      len = sizeof (value);
+      if ((_asn1_read_oid_assignment (definitions, p, value, &len) ==
+	   ASN1_SUCCESS) && !strcmp (oid, value))
+	return p;
+    }
+
+  return NULL;
+}
 
 /**
  * asn1_find_structure_from_oid:
@@ -1102,45 +1513,17 @@ asn1_number_of_elements (ASN1_TYPE element, const char *name, int *num)
 const char *
 asn1_find_structure_from_oid (ASN1_TYPE definitions, const char *oidValue)
 {
-  char definitionsName[ASN1_MAX_NAME_SIZE], name[2 * ASN1_MAX_NAME_SIZE + 1];
-  char value[ASN1_MAX_NAME_SIZE];
   ASN1_TYPE p;
-  int len;
-  asn1_retCode result;
 
   if ((definitions == ASN1_TYPE_EMPTY) || (oidValue == NULL))
     return NULL;		/* ASN1_ELEMENT_NOT_FOUND; */
 
-
-  strcpy (definitionsName, definitions->name);
-  strcat (definitionsName, ".");
-
   /* search the OBJECT_ID into definitions */
-  p = definitions->down;
-  while (p)
-    {
-      if ((type_field (p->type) == TYPE_OBJECT_ID) &&
-	  (p->type & CONST_ASSIGN))
-	{
-	  strcpy (name, definitionsName);
-	  strcat (name, p->name);
-
-	  len = ASN1_MAX_NAME_SIZE;
-	  result = asn1_read_value (definitions, name, value, &len);
-
-	  if ((result == ASN1_SUCCESS) && (!strcmp (oidValue, value)))
-	    {
-	      p = p->right;
-	      if (p == NULL)	/* reach the end of ASN1 definitions */
-		return NULL;	/* ASN1_ELEMENT_NOT_FOUND; */
-
-	      return p->name;
-	    }
-	}
-      p = p->right;
-    }
+  p = _asn1_find_oid_assignment (definitions, oidValue);
+  if ((p == NULL) || (p->right == NULL))
+    return NULL;		/* ASN1_ELEMENT_NOT_FOUND; */
 
-  return NULL;			/* ASN1_ELEMENT_NOT_FOUND; */
+  return p->right->name;
 }
 
 /**
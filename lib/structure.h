@@ -39,4 +39,11 @@ ASN1_TYPE _asn1_add_node_only (unsigned int type);
 
 ASN1_TYPE _asn1_find_left (ASN1_TYPE node);
 
+void _asn1_create_oid_index (ASN1_TYPE definitions);
+
+ASN1_TYPE _asn1_find_oid_assignment (ASN1_TYPE definitions,
+				     const char *oid);
+
+ASN1_TYPE _asn1_find_definition (ASN1_TYPE definitions, const char *name);
+
 #endif
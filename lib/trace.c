@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+
+/*****************************************************/
+/* File: trace.c                                     */
+/* Description: Reports the functions of the library */
+/*  and their steps to the function set with         */
+/*  asn1_set_trace_function, and to the static       */
+/*  probes when built with --enable-sdt.             */
+/*****************************************************/
+
+#include <int.h>
+
+asn1_trace_function _asn1_trace_func;
+static void *trace_ctx;
+
+/* The begin and end probes, which cannot tell whether they are
+   enabled, need the function running at each call.  They are left out
+   when it could not be kept by each thread.  */
+#if defined ENABLE_SDT && defined HAVE_TLS
+# define TRACE_PROBES 1
+#else
+# define TRACE_PROBES 0
+#endif
+
+/* The function running in the thread, and the events since the
+   application called it, kept while tracing.  */
+static THREAD_LOCAL struct
+{
+  const char *function;		/* NULL outside the library */
+  int depth;
+  unsigned long count[ASN1_TRACE_EVENTS];
+} call;
+
+static void
+_asn1_trace_report (int event, ASN1_TYPE node, long offset,
+		    asn1_retCode result)
+{
+  asn1_trace_event trace;
+
+  call.count[event]++;
+
+  trace.event = event;
+  trace.function = call.function;
+  trace.depth = call.depth;
+  trace.node = node;
+  trace.offset = offset;
+  trace.result = result;
+  memcpy (trace.count, call.count, sizeof (trace.count));
+
+  _asn1_trace_func (&trace, trace_ctx);
+}
+
+void
+_asn1_trace_event (int event, ASN1_TYPE node, long offset)
+{
+  _asn1_trace_report (event, node, offset, ASN1_SUCCESS);
+}
+
+/******************************************************************/
+/* Function : _asn1_trace_begin                                   */
+/* Description: reports that FUNCTION, a public function, starts  */
+/*   on NODE.  Nothing is written when nothing traces the calls.  */
+/* Return: the value for _asn1_trace_end.                         */
+/******************************************************************/
+const char *
+_asn1_trace_begin (const char *function, ASN1_TYPE node)
+{
+  const char *previous;
+
+  if (!TRACE_PROBES && _asn1_trace_func == NULL)
+    return NULL;
+
+  previous = call.function;
+  if (previous == NULL)
+    {
+      call.depth = 0;
+      memset (call.count, 0, sizeof (call.count));
+    }
+  else
+    call.depth++;
+  call.function = function;
+
+#if TRACE_PROBES
+  STAP_PROBE2 (libtasn1, begin, function, call.depth);
+#endif
+  if (_asn1_trace_func != NULL)
+    _asn1_trace_report (ASN1_TRACE_BEGIN, node, -1, ASN1_SUCCESS);
+
+  return previous;
+}
+
+void
+_asn1_trace_end (const char *previous, asn1_retCode result)
+{
+  /* Also true when the tracing started during the call */
+  if (call.function == NULL)
+    return;
+
+#if TRACE_PROBES
+  STAP_PROBE3 (libtasn1, end, call.function, call.depth, result);
+#endif
+  if (_asn1_trace_func != NULL)
+    _asn1_trace_report (ASN1_TRACE_END, NULL, -1, result);
+
+  if (previous != NULL)
+    call.depth--;
+  call.function = previous;
+}
+
+/**
+ * asn1_set_trace_function:
+ * @func: called for each event, or %NULL.
+ * @ctx: passed to @func.
+ *
+ * Makes the library call @func at the start (%ASN1_TRACE_BEGIN) and
+ * the end (%ASN1_TRACE_END) of asn1_create_element(),
+ * asn1_der_decoding2(), asn1_der_decoding_options(),
+ * asn1_der_decoding_element(), asn1_der_coding(),
+ * asn1_expand_any_defined_by() and asn1_expand_octet_string(), and
+ * for their steps: each element instantiated, the type of
+ * asn1_create_element() or of an identifier it expands, and each
+ * element added to a SEQUENCE OF or SET OF (%ASN1_TRACE_NODE); each
+ * CHOICE alternative (%ASN1_TRACE_CHOICE) and SET component
+ * (%ASN1_TRACE_SET) whose tag is compared while decoding; and each ANY
+ * or OCTET STRING expanded (%ASN1_TRACE_ANY).
+ *
+ * The event names the function running and the element concerned,
+ * gives the position in the DER when decoding, and counts the events
+ * of each kind since the application called the library, so that the
+ * time of a call can be attributed to the elements of the schema.
+ * asn1_der_decoding() is reported as asn1_der_decoding2(), and the
+ * functions the library calls for itself, such as asn1_der_decoding2()
+ * in asn1_expand_any_defined_by(), are reported with a higher depth.
+ *
+ * @func runs in the thread calling the library, and must be thread
+ * safe when the library is used by several threads.  This function
+ * must not be called while other threads use the library.  The
+ * events are counted by each thread, so tracing needs a compiler
+ * supporting thread-local variables.
+ *
+ * When the library is built with --enable-sdt the same events are
+ * static probes named begin, end, node, choice, set and any, for
+ * SystemTap or DTrace, that cost nothing until they are enabled.
+ *
+ * Returns: %ASN1_SUCCESS, or %ASN1_GENERIC_ERROR if @func is not
+ *   %NULL and the compiler does not support thread-local variables.
+ **/
+asn1_retCode
+asn1_set_trace_function (asn1_trace_function func, void *ctx)
+{
+#ifdef HAVE_TLS
+  trace_ctx = ctx;
+  _asn1_trace_func = func;
+
+  return ASN1_SUCCESS;
+#else
+  return func == NULL ? ASN1_SUCCESS : ASN1_GENERIC_ERROR;
+#endif
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * The LIBTASN1 library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA
+ */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#ifdef ENABLE_SDT
+# include <sys/sdt.h>
+# define _ASN1_PROBE(probe, node, offset) \
+  STAP_PROBE2 (libtasn1, probe, (node)->name, (long) (offset))
+#else
+# define _ASN1_PROBE(probe, node, offset)
+#endif
+
+/* Set by asn1_set_trace_function, read without a call when NULL */
+extern asn1_trace_function _asn1_trace_func;
+
+/* Reports EVENT, one of the ASN1_TRACE_* after ASN1_TRACE_END, for
+   NODE at OFFSET in the DER, or -1.  PROBE is the name of the static
+   probe.  */
+#define _asn1_trace(event, probe, node, offset)			\
+  do								\
+    {								\
+      _ASN1_PROBE (probe, node, offset);			\
+      if (_asn1_trace_func != NULL)				\
+	_asn1_trace_event (event, node, offset);		\
+    }								\
+  while (0)
+
+void _asn1_trace_event (int event, ASN1_TYPE node, long offset);
+
+const char *_asn1_trace_begin (const char *function, ASN1_TYPE node);
+
+void _asn1_trace_end (const char *previous, asn1_retCode result);
+
+#endif
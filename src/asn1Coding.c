@@ -55,6 +55,10 @@ and ASSIGNMENTS file with value assignments.\n\
       printf ("\
 Mandatory arguments to long options are mandatory for short options too.\n\
   -c, --check           checks the syntax only\n\
+  -s, --stream          ASSIGNMENTS holds several records, blocks of\n\
+                        assignments ended by a `--' line or JSON objects\n\
+                        one per line, encoded one after the other\n\
+  -d, --directory=DIR   with -s, writes each record to its own file\n\
   -o, --output=FILE     output file\n\
   -h, --help            display this help and exit\n\
   -v, --version         output version information and exit\n");
@@ -73,13 +77,13 @@ readAssignment (FILE * file, char *varName, char *value)
 
   int ret;
 
-  ret = fscanf (file, "%s", varName);
+  ret = fscanf (file, "%1023s", varName);
   if (ret == EOF)
     return ASSIGNMENT_EOF;
   if (!strcmp (varName, "''"))
     varName[0] = 0;
 
-  ret = fscanf (file, "%s", value);
+  ret = fscanf (file, "%1023s", value);
   if (ret == EOF)
     return ASSIGNMENT_ERROR;
 
@@ -118,6 +122,368 @@ createFileName (char *inputFileName, char **outputFileName)
   return;
 }
 
+/* A record of an assignment stream: a block of NAME VALUE pairs
+   ended by a "--" line or by the end of the file, or a JSON object on
+   one line whose members are the pairs.  */
+typedef struct
+{
+  FILE *file;
+  int json;			/* the record is a JSON object */
+  int members;			/* members of the object read so far */
+  int last;			/* last character read from the object */
+} record_type;
+
+/* Starts the next record of RECORD->file.  */
+static int
+startRecord (record_type * record)
+{
+  int c;
+
+  do
+    c = getc (record->file);
+  while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+
+  if (c == EOF)
+    return ASSIGNMENT_EOF;
+
+  record->json = (c == '{');
+  record->members = 0;
+  record->last = c;
+  if (!record->json)
+    ungetc (c, record->file);
+
+  return ASSIGNMENT_SUCCESS;
+}
+
+static int
+jsonSkipSpace (record_type * record)
+{
+  do
+    record->last = getc (record->file);
+  while (record->last == ' ' || record->last == '\t'
+	 || record->last == '\r');
+
+  return record->last;
+}
+
+/* Reads a JSON string, after its opening quote, into STRING.  */
+static int
+readJsonString (record_type * record, char *string)
+{
+  unsigned int u;
+  int c, k, n = 0;
+  char hex[5];
+
+  while ((c = getc (record->file)) != '"')
+    {
+      record->last = c;
+      if (c == EOF || c == '\n')
+	return ASSIGNMENT_ERROR;
+
+      if (c == '\\')
+	{
+	  c = record->last = getc (record->file);
+	  switch (c)
+	    {
+	    case '"':
+	    case '\\':
+	    case '/':
+	      break;
+	    case 'b':
+	      c = '\b';
+	      break;
+	    case 'f':
+	      c = '\f';
+	      break;
+	    case 'n':
+	      c = '\n';
+	      break;
+	    case 'r':
+	      c = '\r';
+	      break;
+	    case 't':
+	      c = '\t';
+	      break;
+	    case 'u':
+	      for (k = 0; k < 4; k++)
+		{
+		  hex[k] = record->last = getc (record->file);
+		  if (!strchr ("0123456789abcdefABCDEF", hex[k]) || !hex[k])
+		    return ASSIGNMENT_ERROR;
+		}
+	      hex[4] = 0;
+	      u = strtoul (hex, NULL, 16);
+	      /* values are C strings, and surrogate pairs are not joined */
+	      if (u == 0 || (u >= 0xd800 && u < 0xe000) || n + 3 > 1023)
+		return ASSIGNMENT_ERROR;
+	      if (u < 0x80)
+		c = u;
+	      else if (u < 0x800)
+		{
+		  string[n++] = 0xc0 | (u >> 6);
+		  c = 0x80 | (u & 0x3f);
+		}
+	      else
+		{
+		  string[n++] = 0xe0 | (u >> 12);
+		  string[n++] = 0x80 | ((u >> 6) & 0x3f);
+		  c = 0x80 | (u & 0x3f);
+		}
+	      break;
+	    default:
+	      return ASSIGNMENT_ERROR;
+	    }
+	}
+
+      if (n == 1023)
+	return ASSIGNMENT_ERROR;
+      string[n++] = c;
+    }
+  record->last = c;
+  string[n] = 0;
+
+  return ASSIGNMENT_SUCCESS;
+}
+
+/* Reads a JSON number, true or false into VALUE.  */
+static int
+readJsonToken (record_type * record, char *value)
+{
+  int c, n = 0;
+
+  for (c = record->last; c != EOF && !strchr (",} \t\r\n", c);
+       c = getc (record->file))
+    {
+      if (n == 1023)
+	return ASSIGNMENT_ERROR;
+      value[n++] = c;
+    }
+  if (c != EOF)
+    ungetc (c, record->file);
+  value[n] = 0;
+
+  if (n == 0)
+    return ASSIGNMENT_ERROR;
+  if (!strcmp (value, "true"))
+    strcpy (value, "TRUE");
+  else if (!strcmp (value, "false"))
+    strcpy (value, "FALSE");
+
+  return ASSIGNMENT_SUCCESS;
+}
+
+/* Reads the next assignment of RECORD.  ASSIGNMENT_EOF ends the
+   record.  */
+static int
+readRecordAssignment (record_type * record, char *varName, char *value)
+{
+  int c;
+
+  if (!record->json)
+    {
+      if (fscanf (record->file, "%1023s", varName) == EOF
+	  || !strcmp (varName, "--"))
+	return ASSIGNMENT_EOF;
+      if (!strcmp (varName, "''"))
+	varName[0] = 0;
+      if (fscanf (record->file, "%1023s", value) == EOF)
+	return ASSIGNMENT_ERROR;
+      return ASSIGNMENT_SUCCESS;
+    }
+
+  c = jsonSkipSpace (record);
+  if (c == '}')
+    return ASSIGNMENT_EOF;
+  if (record->members && c == ',')
+    c = jsonSkipSpace (record);
+  else if (record->members)
+    return ASSIGNMENT_ERROR;
+  record->members++;
+
+  if (c != '"' || readJsonString (record, varName) != ASSIGNMENT_SUCCESS)
+    return ASSIGNMENT_ERROR;
+  if (jsonSkipSpace (record) != ':')
+    return ASSIGNMENT_ERROR;
+
+  c = jsonSkipSpace (record);
+  if (c == '"')
+    return readJsonString (record, value);
+
+  return readJsonToken (record, value);
+}
+
+/* Skips the rest of a record after a syntax error.  */
+static void
+skipRecord (record_type * record)
+{
+  int c;
+
+  if (!record->json)
+    return;
+
+  for (c = record->last; c != '\n' && c != EOF; c = getc (record->file))
+    ;
+}
+
+/* Encodes STRUCTURE into DER, growing DER as needed.  */
+static int
+encodeRecord (ASN1_TYPE structure, unsigned char **der, int *der_size,
+	      int *der_len, char *errorDescription)
+{
+  unsigned char *p;
+  int asn1_result;
+
+  *der_len = *der_size;
+  asn1_result = asn1_der_coding (structure, "", *der, der_len,
+				 errorDescription);
+  if (asn1_result == ASN1_MEM_ERROR)
+    {
+      p = realloc (*der, *der_len);
+      if (p == NULL)
+	{
+	  fprintf (stderr, "asn1Coding: memory exhausted\n");
+	  exit (1);
+	}
+      *der = p;
+      *der_size = *der_len;
+      asn1_result = asn1_der_coding (structure, "", *der, der_len,
+				     errorDescription);
+    }
+
+  return asn1_result;
+}
+
+/* Encodes each record of INPUTFILE with DEFINITIONS, one after the
+   other into OUTPUTFILENAME, or into a file for each record in
+   DIRECTORY.  Returns the number of records that failed.  */
+static unsigned long
+encodeStream (ASN1_TYPE definitions, FILE * inputFile,
+	      const char *outputFileName, const char *directory)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  ASN1_TYPE structure;
+  record_type record;
+  char varName[1024];
+  char value[1024];
+  unsigned char *der = NULL;
+  int der_size = 0, der_len;
+  unsigned long records = 0, errors = 0;
+  FILE *outputFile = NULL;
+  char *fileName = NULL;
+  int asn1_result, ret;
+
+  if (directory)
+    {
+      fileName = malloc (strlen (directory) + sizeof ("/00000000.der") + 16);
+      if (fileName == NULL)
+	{
+	  fprintf (stderr, "asn1Coding: memory exhausted\n");
+	  exit (1);
+	}
+    }
+  else
+    {
+      outputFile = fopen (outputFileName, "wb");
+      if (outputFile == NULL)
+	{
+	  printf ("asn1Coding: output file '%s' not available\n",
+		  outputFileName);
+	  exit (1);
+	}
+    }
+
+  record.file = inputFile;
+  while (startRecord (&record) == ASSIGNMENT_SUCCESS)
+    {
+      records++;
+      structure = ASN1_TYPE_EMPTY;
+      asn1_result = ASN1_SUCCESS;
+      errorDescription[0] = 0;
+
+      while ((ret = readRecordAssignment (&record, varName, value))
+	     == ASSIGNMENT_SUCCESS)
+	{
+	  if (asn1_result != ASN1_SUCCESS)
+	    continue;
+	  if (structure == ASN1_TYPE_EMPTY)
+	    asn1_result = asn1_create_element (definitions, value, &structure);
+	  else
+	    asn1_result = asn1_write_value (structure, varName, value, 0);
+	  if (asn1_result != ASN1_SUCCESS)
+	    {
+	      strncpy (errorDescription,
+		       structure == ASN1_TYPE_EMPTY ? value : varName,
+		       sizeof (errorDescription) - 1);
+	      errorDescription[sizeof (errorDescription) - 1] = 0;
+	    }
+	}
+
+      if (ret == ASSIGNMENT_ERROR)
+	{
+	  skipRecord (&record);
+	  printf ("asn1Coding: record %lu: syntax error\n", records);
+	  errors++;
+	}
+      else if (structure == ASN1_TYPE_EMPTY && asn1_result == ASN1_SUCCESS)
+	{
+	  printf ("asn1Coding: record %lu: no assignments\n", records);
+	  errors++;
+	}
+      else
+	{
+	  if (asn1_result == ASN1_SUCCESS)
+	    asn1_result = encodeRecord (structure, &der, &der_size, &der_len,
+					errorDescription);
+	  if (asn1_result != ASN1_SUCCESS)
+	    {
+	      printf ("asn1Coding: record %lu: %s %s\n", records,
+		      asn1_strerror (asn1_result), errorDescription);
+	      errors++;
+	    }
+	  else if (directory)
+	    {
+	      sprintf (fileName, "%s/%08lu.der", directory, records);
+	      outputFile = fopen (fileName, "wb");
+	      if (outputFile == NULL
+		  || fwrite (der, 1, der_len, outputFile) != (size_t) der_len
+		  || fclose (outputFile) != 0)
+		{
+		  printf ("asn1Coding: output file '%s' not available\n",
+			  fileName);
+		  exit (1);
+		}
+	    }
+	  else if (fwrite (der, 1, der_len, outputFile) != (size_t) der_len)
+	    {
+	      printf ("asn1Coding: output file '%s' not available\n",
+		      outputFileName);
+	      exit (1);
+	    }
+	}
+
+      asn1_delete_structure (&structure);
+    }
+
+  if (!directory && fclose (outputFile) != 0)
+    {
+      printf ("asn1Coding: output file '%s' not available\n",
+	      outputFileName);
+      exit (1);
+    }
+
+  printf ("\nCoding: %lu records, %lu errors\n", records, errors);
+  if (directory)
+    printf ("\nOutputDirectory=%s\n", directory);
+  else
+    printf ("\nOutputFile=%s\n", outputFileName);
+  printf ("\nWriting: done.\n");
+
+  free (der);
+  free (fileName);
+
+  return errors;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -125,6 +491,8 @@ main (int argc, char *argv[])
     {"help", no_argument, 0, 'h'},
     {"version", no_argument, 0, 'v'},
     {"check", no_argument, 0, 'c'},
+    {"stream", no_argument, 0, 's'},
+    {"directory", required_argument, 0, 'd'},
     {"output", required_argument, 0, 'o'},
     {0, 0, 0, 0}
   };
@@ -134,6 +502,8 @@ main (int argc, char *argv[])
   char *inputFileAsnName = NULL;
   char *inputFileAssignmentName = NULL;
   int checkSyntaxOnly = 0;
+  int stream = 0;
+  char *directory = NULL;
   ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
   ASN1_TYPE structure = ASN1_TYPE_EMPTY;
   char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
@@ -154,7 +524,7 @@ main (int argc, char *argv[])
     {
 
       option_result =
-	getopt_long (argc, argv, "hvco:", long_options, &option_index);
+	getopt_long (argc, argv, "hvcsd:o:", long_options, &option_index);
 
       if (option_result == -1)
 	break;
@@ -174,6 +544,12 @@ main (int argc, char *argv[])
 	case 'c':		/* CHECK SYNTAX */
 	  checkSyntaxOnly = 1;
 	  break;
+	case 's':		/* STREAM */
+	  stream = 1;
+	  break;
+	case 'd':		/* DIRECTORY */
+	  directory = optarg;
+	  break;
 	case 'o':		/* OUTPUT */
 	  outputFileName = (char *) malloc (strlen (optarg) + 1);
 	  strcpy (outputFileName, optarg);
@@ -244,6 +620,24 @@ main (int argc, char *argv[])
     }
 
 
+  if (stream)
+    {
+      if (directory == NULL && outputFileName == NULL)
+	createFileName (inputFileAssignmentName, &outputFileName);
+
+      asn1_result = encodeStream (definitions, inputFile, outputFileName,
+				  directory) ? 1 : 0;
+
+      fclose (inputFile);
+      asn1_delete_structure (&definitions);
+
+      free (inputFileAsnName);
+      free (inputFileAssignmentName);
+      free (outputFileName);
+
+      exit (asn1_result);
+    }
+
   printf ("\n");
 
   while (readAssignment (inputFile, varName, value) == ASSIGNMENT_SUCCESS)
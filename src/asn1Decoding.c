@@ -26,9 +26,15 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <getopt.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
 #include <libtasn1.h>
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
 #include <progname.h>
 #include <version-etc.h>
 #include <read-file.h>
@@ -52,9 +58,16 @@ Usage: %s [OPTION] DEFINITIONS ENCODED ASN1TYPE\n", program_name);
       printf ("\
 Decodes DER data in ENCODED file, for the ASN1TYPE element\n\
 described in ASN.1 DEFINITIONS file, and print decoded structures.\n\
+When ENCODED is a directory, every file in it is decoded.\n\
 \n");
       printf ("\
   -c, --check           checks the syntax only\n\
+  -s, --stream          ENCODED holds several DER objects, one after\n\
+                        the other\n\
+  -l, --list            ENCODED lists the files to decode, one per line\n\
+  -j, --jobs=N          decode N objects at a time\n\
+  -J, --json            print the result of each object as a line of\n\
+                        JSON\n\
   -h, --help            display this help and exit\n\
   -v, --version         output version information and exit\n");
       emit_bug_reporting_address ();
@@ -62,6 +75,378 @@ described in ASN.1 DEFINITIONS file, and print decoded structures.\n\
   exit (status);
 }
 
+/* One DER object of a batch.  */
+typedef struct
+{
+  const char *file;		/* file holding the object, or NULL */
+  const unsigned char *der;	/* the object, when FILE is NULL */
+  int der_len;
+  long offset;			/* of DER in the stream */
+  FILE *out;			/* decoding result, when decoded by a job */
+  int result;
+} object_type;
+
+/* Objects decoded by the jobs before their results are printed.  */
+#define BATCH_SIZE 256
+
+typedef struct
+{
+  ASN1_TYPE definitions;
+  const char *typeName;
+  int json;
+  object_type *objects;
+  size_t count;
+  size_t next;			/* first object not taken by a job */
+#ifdef HAVE_PTHREAD_H
+  pthread_mutex_t lock;
+#endif
+} batch_type;
+
+static object_type *
+add_object (object_type ** objects, size_t * count, size_t * size)
+{
+  if (*count == *size)
+    {
+      *size = *size ? 2 * *size : 64;
+      *objects = realloc (*objects, *size * sizeof (**objects));
+      if (*objects == NULL)
+	{
+	  fprintf (stderr, "asn1Decoding: memory exhausted\n");
+	  exit (1);
+	}
+    }
+
+  memset (&(*objects)[*count], 0, sizeof (**objects));
+  return &(*objects)[(*count)++];
+}
+
+/* Splits DER on the boundaries of its outer TLVs.  What cannot be
+   split is left as a last object, whose decoding reports the error.  */
+static object_type *
+split_stream (const unsigned char *der, size_t der_len, size_t * count)
+{
+  object_type *objects = NULL, *object;
+  size_t size = 0, offset = 0;
+  unsigned long tag;
+  unsigned char class;
+  int tag_len, len_len, remaining;
+  long len;
+
+  *count = 0;
+  while (offset < der_len)
+    {
+      remaining = der_len - offset;
+      object = add_object (&objects, count, &size);
+      object->der = der + offset;
+      object->der_len = remaining;
+      object->offset = offset;
+
+      if (asn1_get_tag_der (der + offset, remaining, &class, &tag_len,
+			    &tag) != ASN1_SUCCESS)
+	break;
+      len = asn1_get_length_ber (der + offset + tag_len,
+				 remaining - tag_len, &len_len);
+      if ((len < 0) || (len > remaining - tag_len - len_len))
+	break;
+
+      object->der_len = tag_len + len_len + len;
+      offset += object->der_len;
+    }
+
+  return objects;
+}
+
+/* The files listed in LIST, one per line.  */
+static object_type *
+read_list (char *list, size_t list_len, size_t * count)
+{
+  object_type *objects = NULL;
+  size_t size = 0;
+  char *line, *end;
+
+  *count = 0;
+  for (line = list; line < list + list_len; line = end + 1)
+    {
+      end = memchr (line, '\n', list + list_len - line);
+      if (end == NULL)
+	end = list + list_len;
+      *end = 0;
+      if ((end > line) && (end[-1] == '\r'))
+	end[-1] = 0;
+      if (line[0])
+	add_object (&objects, count, &size)->file = line;
+    }
+
+  return objects;
+}
+
+static int
+compare_objects (const void *a, const void *b)
+{
+  return strcmp (((const object_type *) a)->file,
+		 ((const object_type *) b)->file);
+}
+
+/* The regular files of DIRECTORY, sorted by name.  */
+static object_type *
+read_directory (const char *directory, size_t * count)
+{
+  object_type *objects = NULL;
+  size_t size = 0;
+  struct dirent *entry;
+  struct stat st;
+  DIR *dir;
+  char *file;
+
+  *count = 0;
+  dir = opendir (directory);
+  if (dir == NULL)
+    {
+      printf ("asn1Decoding: could not read '%s'\n", directory);
+      exit (1);
+    }
+
+  while ((entry = readdir (dir)) != NULL)
+    {
+      if (entry->d_name[0] == '.')
+	continue;
+
+      file = malloc (strlen (directory) + strlen (entry->d_name) + 2);
+      if (file == NULL)
+	{
+	  fprintf (stderr, "asn1Decoding: memory exhausted\n");
+	  exit (1);
+	}
+      sprintf (file, "%s/%s", directory, entry->d_name);
+
+      if ((stat (file, &st) == 0) && S_ISREG (st.st_mode))
+	add_object (&objects, count, &size)->file = file;
+      else
+	free (file);
+    }
+  closedir (dir);
+
+  if (*count)
+    qsort (objects, *count, sizeof (*objects), compare_objects);
+
+  return objects;
+}
+
+/* Prints S to OUT as a JSON string.  */
+static void
+print_json_string (FILE * out, const char *s)
+{
+  putc ('"', out);
+  for (; *s; s++)
+    if ((*s == '"') || (*s == '\\'))
+      fprintf (out, "\\%c", *s);
+    else if ((unsigned char) *s < 0x20)
+      fprintf (out, "\\u%04x", (unsigned char) *s);
+    else
+      putc (*s, out);
+  putc ('"', out);
+}
+
+/* Decodes OBJECT as a TYPENAME element and prints the result to OUT,
+   as text or as a line of JSON.  */
+static int
+decode_object (ASN1_TYPE definitions, const char *typeName, int json,
+	       object_type * object, FILE * out)
+{
+  ASN1_TYPE structure = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  const unsigned char *der = object->der;
+  unsigned char *data = NULL;
+  int der_len = object->der_len;
+  int result;
+
+  if (json && object->file)
+    {
+      fprintf (out, "{\"file\":");
+      print_json_string (out, object->file);
+    }
+  else if (json)
+    fprintf (out, "{\"offset\":%ld", object->offset);
+  else if (object->file)
+    fprintf (out, "\n%s:\n", object->file);
+  else
+    fprintf (out, "\nObject at offset %ld:\n", object->offset);
+
+  errorDescription[0] = 0;
+  result = ASN1_SUCCESS;
+  if (object->file)
+    {
+      size_t tmplen;
+
+      data = (unsigned char *) read_binary_file (object->file, &tmplen);
+      if (data == NULL)
+	{
+	  result = ASN1_FILE_NOT_FOUND;
+	  if (!json)
+	    fprintf (out, "asn1Decoding: could not read '%s'\n",
+		     object->file);
+	}
+      der = data;
+      der_len = tmplen;
+    }
+
+  if (result == ASN1_SUCCESS)
+    {
+      result = asn1_create_element (definitions, typeName, &structure);
+      if ((result != ASN1_SUCCESS) && !json)
+	fprintf (out, "Structure creation: %s\n", asn1_strerror (result));
+      else if (result == ASN1_SUCCESS)
+	{
+	  result = asn1_der_decoding (&structure, der, der_len,
+				      errorDescription);
+	  if (!json)
+	    {
+	      fprintf (out, "\nDecoding: %s\n", asn1_strerror (result));
+	      if (result != ASN1_SUCCESS)
+		fprintf (out, "asn1Decoding: %s\n", errorDescription);
+
+	      fprintf (out, "\nDECODING RESULT:\n");
+	      asn1_print_structure (out, structure, "",
+				    ASN1_PRINT_NAME_TYPE_VALUE);
+	    }
+	}
+    }
+
+  if (json)
+    {
+      fprintf (out, ",\"result\":");
+      print_json_string (out, asn1_strerror (result));
+      if (errorDescription[0])
+	{
+	  fprintf (out, ",\"error\":");
+	  print_json_string (out, errorDescription);
+	}
+      if (result == ASN1_SUCCESS)
+	{
+	  fprintf (out, ",\"value\":");
+	  asn1_print_json (out, structure, "", 0);
+	}
+      fprintf (out, "}\n");
+    }
+
+  asn1_delete_structure (&structure);
+  free (data);
+
+  return result;
+}
+
+#ifdef HAVE_PTHREAD_H
+/* Decodes the objects of the batch ARG not taken by other jobs, each
+   one into a temporary file.  */
+static void *
+decode_job (void *arg)
+{
+  batch_type *batch = arg;
+  object_type *object;
+
+  while (1)
+    {
+      pthread_mutex_lock (&batch->lock);
+      object = NULL;
+      if (batch->next < batch->count)
+	object = &batch->objects[batch->next++];
+      pthread_mutex_unlock (&batch->lock);
+
+      if (object == NULL)
+	break;
+
+      object->out = tmpfile ();
+      if (object->out == NULL)
+	object->result = ASN1_MEM_ERROR;
+      else
+	object->result = decode_object (batch->definitions, batch->typeName,
+					batch->json, object, object->out);
+    }
+
+  return NULL;
+}
+#endif
+
+/* Decodes COUNT objects with JOBS jobs and prints the results in
+   their order.  Returns the number of objects not decoded.  */
+static size_t
+decode_objects (ASN1_TYPE definitions, const char *typeName, int json,
+		object_type * objects, size_t count, int jobs)
+{
+  size_t errors = 0, i;
+#ifdef HAVE_PTHREAD_H
+  batch_type batch;
+  pthread_t *thread;
+  char buffer[4096];
+  size_t first, n;
+  int k, threads;
+#endif
+
+  if (jobs <= 1)
+    {
+      for (i = 0; i < count; i++)
+	if (decode_object (definitions, typeName, json, &objects[i],
+			   stdout) != ASN1_SUCCESS)
+	  errors++;
+      return errors;
+    }
+
+#ifdef HAVE_PTHREAD_H
+  thread = malloc ((jobs - 1) * sizeof (*thread));
+  if (thread == NULL)
+    {
+      fprintf (stderr, "asn1Decoding: memory exhausted\n");
+      exit (1);
+    }
+
+  batch.definitions = definitions;
+  batch.typeName = typeName;
+  batch.json = json;
+  pthread_mutex_init (&batch.lock, NULL);
+
+  for (first = 0; first < count; first += batch.count)
+    {
+      batch.objects = objects + first;
+      batch.count = count - first;
+      if (batch.count > BATCH_SIZE)
+	batch.count = BATCH_SIZE;
+      batch.next = 0;
+
+      /* this thread is the last job */
+      for (threads = 0; threads < jobs - 1; threads++)
+	if (pthread_create (&thread[threads], NULL, decode_job, &batch))
+	  break;
+      decode_job (&batch);
+      for (k = 0; k < threads; k++)
+	pthread_join (thread[k], NULL);
+
+      for (i = 0; i < batch.count; i++)
+	{
+	  if (batch.objects[i].out == NULL)
+	    {
+	      printf ("\nasn1Decoding: cannot create a temporary file\n");
+	      errors++;
+	      continue;
+	    }
+
+	  rewind (batch.objects[i].out);
+	  while ((n = fread (buffer, 1, sizeof (buffer),
+			     batch.objects[i].out)) > 0)
+	    fwrite (buffer, 1, n, stdout);
+	  fclose (batch.objects[i].out);
+
+	  if (batch.objects[i].result != ASN1_SUCCESS)
+	    errors++;
+	}
+    }
+
+  pthread_mutex_destroy (&batch.lock);
+  free (thread);
+#endif
+
+  return errors;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -69,6 +454,10 @@ main (int argc, char *argv[])
     {"help", no_argument, 0, 'h'},
     {"version", no_argument, 0, 'v'},
     {"check", no_argument, 0, 'c'},
+    {"stream", no_argument, 0, 's'},
+    {"list", no_argument, 0, 'l'},
+    {"jobs", required_argument, 0, 'j'},
+    {"json", no_argument, 0, 'J'},
     {0, 0, 0, 0}
   };
   int option_index = 0;
@@ -77,6 +466,10 @@ main (int argc, char *argv[])
   char *inputFileDerName = NULL;
   char *typeName = NULL;
   int checkSyntaxOnly = 0;
+  int stream = 0, list = 0, jobs = 1, json = 0, directory;
+  object_type *objects;
+  size_t count, errors;
+  struct stat st;
   ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
   ASN1_TYPE structure = ASN1_TYPE_EMPTY;
   char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
@@ -93,7 +486,7 @@ main (int argc, char *argv[])
     {
 
       option_result =
-	getopt_long (argc, argv, "hvc", long_options, &option_index);
+	getopt_long (argc, argv, "hvcslj:J", long_options, &option_index);
 
       if (option_result == -1)
 	break;
@@ -111,6 +504,27 @@ main (int argc, char *argv[])
 	case 'c':		/* CHECK SYNTAX */
 	  checkSyntaxOnly = 1;
 	  break;
+	case 's':		/* DER OBJECTS ONE AFTER THE OTHER */
+	  stream = 1;
+	  break;
+	case 'l':		/* LIST OF FILES */
+	  list = 1;
+	  break;
+	case 'j':		/* JOBS */
+	  jobs = atoi (optarg);
+	  if (jobs < 1)
+	    {
+	      fprintf (stderr, "asn1Decoding: invalid number of jobs '%s'\n",
+		       optarg);
+	      usage (EXIT_FAILURE);
+	    }
+#ifndef HAVE_PTHREAD_H
+	  jobs = 1;
+#endif
+	  break;
+	case 'J':		/* JSON */
+	  json = 1;
+	  break;
 	case '?':		/* UNKNOW OPTION */
 	  fprintf (stderr,
 		   "asn1Decoding: option '%s' not recognized or without argument.\n\n",
@@ -146,7 +560,8 @@ main (int argc, char *argv[])
   switch (asn1_result)
     {
     case ASN1_SUCCESS:
-      printf ("Parse: done.\n");
+      if (!json)
+	printf ("Parse: done.\n");
       break;
     case ASN1_FILE_NOT_FOUND:
       printf ("asn1Decoding: FILE %s NOT FOUND\n", inputFileAsnName);
@@ -169,6 +584,57 @@ main (int argc, char *argv[])
     }
 
 
+  directory = (stat (inputFileDerName, &st) == 0) && S_ISDIR (st.st_mode);
+  if (stream || list || directory || json)
+    {
+      size_t tmplen = 0;
+
+      /* the definitions are parsed once for all the objects */
+      der = NULL;
+      if (stream)
+	{
+	  der = (unsigned char *) read_binary_file (inputFileDerName,
+						    &tmplen);
+	  objects = split_stream (der, tmplen, &count);
+	}
+      else if (list)
+	{
+	  der = (unsigned char *) read_file (inputFileDerName, &tmplen);
+	  objects = read_list ((char *) der, tmplen, &count);
+	}
+      else if (directory)
+	objects = read_directory (inputFileDerName, &count);
+      else
+	{
+	  objects = NULL;
+	  count = tmplen = 0;
+	  add_object (&objects, &count, &tmplen)->file = inputFileDerName;
+	}
+
+      if ((der == NULL) && (stream || list))
+	{
+	  printf ("asn1Decoding: could not read '%s'\n", inputFileDerName);
+	  errors = 1;
+	}
+      else
+	errors = decode_objects (definitions, typeName, json, objects, count,
+				 jobs);
+
+      if (directory)
+	while (count > 0)
+	  free ((char *) objects[--count].file);
+      free (objects);
+      free (der);
+
+      asn1_delete_structure (&definitions);
+
+      free (inputFileAsnName);
+      free (inputFileDerName);
+      free (typeName);
+
+      exit (errors ? 1 : 0);
+    }
+
   {
     size_t tmplen;
     der = (unsigned char *) read_binary_file (inputFileDerName, &tmplen);
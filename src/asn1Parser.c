@@ -56,7 +56,9 @@ a C array that is used with libtasn1 functions.\n\
 Mandatory arguments to long options are mandatory for short options too.\n\
   -c, --check           checks the syntax only\n\
   -o, --output=FILE     output file\n\
-  -n, --name=NAME       array name\n\
+  -n, --name=NAME       array name, or prefix of the C identifiers\n\
+  -s, --structures      generate C structures and DER coding functions\n\
+                        instead of the array\n\
   -h, --help            display this help and exit\n\
   -v, --version         output version information and exit\n");
       emit_bug_reporting_address ();
@@ -73,6 +75,7 @@ main (int argc, char *argv[])
     {"check", no_argument, 0, 'c'},
     {"output", required_argument, 0, 'o'},
     {"name", required_argument, 0, 'n'},
+    {"structures", no_argument, 0, 's'},
     {0, 0, 0, 0}
   };
   int option_index = 0;
@@ -81,6 +84,7 @@ main (int argc, char *argv[])
   char *inputFileName = NULL;
   char *vectorName = NULL;
   int checkSyntaxOnly = 0;
+  int structures = 0;
   ASN1_TYPE pointer = ASN1_TYPE_EMPTY;
   char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
   int parse_result = ASN1_SUCCESS;
@@ -93,7 +97,7 @@ main (int argc, char *argv[])
     {
 
       option_result =
-	getopt_long (argc, argv, "hvco:n:", long_options, &option_index);
+	getopt_long (argc, argv, "hvcso:n:", long_options, &option_index);
 
       if (option_result == -1)
 	break;
@@ -121,6 +125,9 @@ main (int argc, char *argv[])
 	case 'c':		/* CHECK SYNTAX */
 	  checkSyntaxOnly = 1;
 	  break;
+	case 's':		/* C STRUCTURES */
+	  structures = 1;
+	  break;
 	case 'o':		/* OUTPUT */
 	  outputFileName = (char *) malloc (strlen (optarg) + 1);
 	  strcpy (outputFileName, optarg);
@@ -163,6 +170,10 @@ main (int argc, char *argv[])
 	asn1_parser2tree (inputFileName, &pointer, errorDescription);
       asn1_delete_structure (&pointer);
     }
+  else if (structures == 1)	/* C STRUCTURES CREATION */
+    parse_result = asn1_parser2code (inputFileName,
+				     outputFileName, vectorName,
+				     errorDescription);
   else				/* C VECTOR CREATION */
     parse_result = asn1_parser2array (inputFileName,
 				      outputFileName, vectorName,
@@ -179,6 +190,7 @@ main (int argc, char *argv[])
     case ASN1_SYNTAX_ERROR:
     case ASN1_IDENTIFIER_NOT_FOUND:
     case ASN1_NAME_TOO_LONG:
+    case ASN1_VALUE_NOT_VALID:
       printf ("asn1Parser: %s\n", errorDescription);
       break;
     default:
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_alloc.c                                */
+/* Description: Test the allocator set with          */
+/*   asn1_set_allocator, the counts of               */
+/*   asn1_get_alloc_stats, the handling of           */
+/*   allocation failures, and the memory recycled    */
+/*   with asn1_set_recycling.                        */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+typedef struct
+{
+  unsigned long calls;		/* malloc and realloc calls */
+  unsigned long fail_at;	/* call that fails, or 0 */
+  long blocks;			/* blocks not freed */
+} allocator_type;
+
+static void *
+test_malloc (size_t size, void *ctx)
+{
+  allocator_type *allocator = ctx;
+  void *ptr;
+
+  if (++allocator->calls == allocator->fail_at)
+    return NULL;
+  ptr = malloc (size);
+  if (ptr != NULL)
+    allocator->blocks++;
+  return ptr;
+}
+
+static void *
+test_realloc (void *ptr, size_t size, void *ctx)
+{
+  allocator_type *allocator = ctx;
+  void *new_ptr;
+
+  if (ptr == NULL)
+    return test_malloc (size, ctx);
+  if (++allocator->calls == allocator->fail_at)
+    return NULL;
+  new_ptr = realloc (ptr, size);
+  return new_ptr;
+}
+
+static void
+test_free (void *ptr, void *ctx)
+{
+  allocator_type *allocator = ctx;
+
+  if (ptr != NULL)
+    allocator->blocks--;
+  free (ptr);
+}
+
+/* Decodes DER as TYPE and encodes it again.  */
+static asn1_retCode
+process (ASN1_TYPE definitions, const char *type, const unsigned char *der,
+	 int der_len)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  unsigned char coding[4 * 1024];
+  int coding_len = sizeof (coding);
+  asn1_retCode result;
+
+  result = asn1_create_element (definitions, type, &element);
+  if (result == ASN1_SUCCESS)
+    result = asn1_der_decoding (&element, der, der_len, NULL);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (element, "tbsCertificate.serialNumber",
+			       "1", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_der_coding (element, "", coding, &coding_len, NULL);
+  asn1_delete_structure (&element);
+
+  return result;
+}
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result;
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  allocator_type allocator = { 0, 0, 0 };
+  asn1_alloc_stats stats;
+  unsigned char der[4 * 1024];
+  int der_len, errorCounter = 0, testCounter = 0;
+  unsigned long calls, k, failures = 0;
+  long kept;
+  size_t bytes;
+  FILE *fd;
+  ASN1_TYPE element;
+  struct tm tm;
+  const char *treefile = getenv ("ASN1PKIX");
+  const char *certfile = getenv ("ASN1CRLF");
+
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_alloc       */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+  fd = fopen (certfile, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", certfile);
+      exit (1);
+    }
+  der_len = fread (der, 1, sizeof (der), fd);
+  fclose (fd);
+
+  testCounter++;
+  if (asn1_set_allocator (test_malloc, NULL, test_free, &allocator)
+      != ASN1_GENERIC_ERROR)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  missing realloc accepted\n\n", errorCounter);
+    }
+
+  /* Both must be set before the library allocates memory */
+  asn1_set_allocator (test_malloc, test_realloc, test_free, &allocator);
+  asn1_enable_alloc_stats (1);
+
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  testCounter++;
+  asn1_get_alloc_stats (&stats);
+  if (allocator.calls == 0 || allocator.blocks <= 0
+      || stats.site[ASN1_ALLOC_PARSE].allocations != stats.allocations
+      || stats.in_use <= 0 || stats.peak < stats.in_use)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  parsing: %lu calls, %ld blocks, "
+	      "%lu allocations, %ld bytes in use\n\n", errorCounter,
+	      allocator.calls, allocator.blocks, stats.allocations,
+	      stats.in_use);
+    }
+
+  /* The memory of an element is counted apart from the definitions */
+  testCounter++;
+  asn1_reset_alloc_stats ();
+  result = process (definitions, "PKIX1.Certificate", der, der_len);
+  asn1_get_alloc_stats (&stats);
+  for (k = bytes = 0; k < ASN1_ALLOC_SITES; k++)
+    bytes += stats.site[k].bytes;
+  if (result != ASN1_SUCCESS || stats.in_use != 0 || stats.peak <= 0
+      || stats.site[ASN1_ALLOC_PARSE].allocations != 0
+      || stats.site[ASN1_ALLOC_CREATE].allocations == 0
+      || stats.site[ASN1_ALLOC_DECODE].allocations == 0
+      || stats.site[ASN1_ALLOC_ENCODE].allocations == 0
+      || bytes != stats.bytes)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  process: %s, %ld bytes in use, "
+	      "peak %ld\n\n", errorCounter, asn1_strerror (result),
+	      stats.in_use, stats.peak);
+    }
+
+  /* Each allocation of the processing fails in turn */
+  allocator.calls = 0;
+  process (definitions, "PKIX1.Certificate", der, der_len);
+  calls = allocator.calls;
+  for (k = 1; k <= calls; k++)
+    {
+      testCounter++;
+      asn1_reset_alloc_stats ();
+      allocator.calls = 0;
+      allocator.fail_at = k;
+      result = process (definitions, "PKIX1.Certificate", der, der_len);
+      allocator.fail_at = 0;
+      asn1_get_alloc_stats (&stats);
+      if (result != ASN1_SUCCESS)
+	failures++;
+      if (stats.in_use != 0)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  allocation %lu failed: %s, "
+		  "%ld bytes not freed\n\n", errorCounter, k,
+		  asn1_strerror (result), stats.in_use);
+	}
+    }
+
+  testCounter++;
+  if (failures == 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  no failure reported for %lu "
+	      "allocations\n\n", errorCounter, calls);
+    }
+
+  /* A GeneralizedTime does not fit in the node, so each allocation of
+     its writing is needed and its failure must be reported */
+  memset (&tm, 0, sizeof (tm));
+  tm.tm_year = 151;
+  tm.tm_mday = 1;
+  element = ASN1_TYPE_EMPTY;
+  result = asn1_create_element (definitions, "PKIX1.Certificate", &element);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      exit (1);
+    }
+  allocator.calls = 0;
+  asn1_write_time_tm (element, "tbsCertificate.validity.notAfter", &tm);
+  calls = allocator.calls;
+  for (k = 1; k <= calls; k++)
+    {
+      testCounter++;
+      allocator.calls = 0;
+      allocator.fail_at = k;
+      result = asn1_write_time_tm (element,
+				   "tbsCertificate.validity.notAfter", &tm);
+      allocator.fail_at = 0;
+      if (result != ASN1_MEM_ALLOC_ERROR)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  asn1_write_time_tm, allocation %lu "
+		  "failed: %s\n\n", errorCounter, k, asn1_strerror (result));
+	}
+    }
+  asn1_delete_structure (&element);
+
+  /* Once recycling, the elements are made of the memory of the
+     elements deleted before */
+  testCounter++;
+  result = asn1_set_recycling (64 * 1024);
+  if (result == ASN1_SUCCESS)
+    {
+      process (definitions, "PKIX1.Certificate", der, der_len);
+      asn1_reset_alloc_stats ();
+      result = process (definitions, "PKIX1.Certificate", der, der_len);
+      asn1_get_alloc_stats (&stats);
+      if (result != ASN1_SUCCESS
+	  || stats.site[ASN1_ALLOC_CREATE].allocations != 0
+	  || stats.site[ASN1_ALLOC_DECODE].allocations != 0)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  recycling: %s, %lu allocations\n\n",
+		  errorCounter, asn1_strerror (result),
+		  stats.site[ASN1_ALLOC_CREATE].allocations
+		  + stats.site[ASN1_ALLOC_DECODE].allocations);
+	}
+
+      /* With a lower limit the thread keeps no more, which a limit
+	 below the smallest block frees */
+      testCounter++;
+      asn1_set_recycling (256);
+      process (definitions, "PKIX1.Certificate", der, der_len);
+      asn1_get_alloc_stats (&stats);
+      kept = stats.in_use;
+      asn1_set_recycling (1);
+      asn1_get_alloc_stats (&stats);
+      kept -= stats.in_use;
+      asn1_set_recycling (0);
+      if (kept <= 0 || kept > 256)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  recycling limit: %ld bytes kept\n\n",
+		  errorCounter, kept);
+	}
+    }
+  else if (result != ASN1_GENERIC_ERROR)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_set_recycling: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  testCounter++;
+  asn1_delete_structure (&definitions);
+  if (allocator.blocks != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %ld blocks not freed\n\n", errorCounter,
+	      allocator.blocks);
+    }
+
+  asn1_enable_alloc_stats (0);
+  asn1_set_allocator (NULL, NULL, NULL, NULL);
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
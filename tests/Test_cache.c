@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_cache.c                                */
+/* Description: Test the encodings asn1_der_coding   */
+/*   keeps: after each change of an element encoded  */
+/*   before, its encoding must be the one of an      */
+/*   element decoded again, changed the same way and */
+/*   encoded once, for BER and DER inputs.           */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#define OP_WRITE	0
+#define OP_DELETE	1
+#define OP_EXPAND	2
+
+typedef struct
+{
+  int op;
+  const char *name;
+  const char *value;
+  int len;
+} change;
+
+typedef struct
+{
+  const char *file;		/* the input, or NULL for DER */
+  const char *der;
+  int der_len;
+  int tree;			/* decoded with the definitions of Test_tree */
+  const char *type;
+  const change *changes;
+  int n_changes;
+} cache_test;
+
+/* BER: indefinite lengths */
+static const change pfx_changes[] = {
+  {OP_EXPAND},
+  {OP_WRITE, "macData.iterations", "2048", 0},
+  {OP_WRITE, "macData.mac.digest", "\x01\x02", 2},
+  {OP_WRITE, "authSafe.contentType", "1.2.840.113549.1.7.2", 0},
+  {OP_WRITE, "macData", NULL, 0}
+};
+
+static const change cert_changes[] = {
+  {OP_WRITE, "tbsCertificate.serialNumber", "7", 0},
+  {OP_DELETE, "tbsCertificate.issuer.rdnSequence.?1"},
+  {OP_WRITE, "tbsCertificate.subject.rdnSequence.?1", "NEW", 0},
+  {OP_WRITE, "tbsCertificate.subject.rdnSequence.?1.?LAST.type", "2.5.4.3",
+   0},
+  {OP_WRITE, "tbsCertificate.subject.rdnSequence.?1.?LAST.value",
+   "\x0c\x01\x61", 3},
+  {OP_EXPAND}
+};
+
+/* Not DER: a SET OF out of order */
+static const change set_of_changes[] = {
+  {OP_WRITE, "issuer.rdnSequence.?1.value", "\x13\x01\x63", 3},
+  {OP_WRITE, "version", "2", 0},
+  {OP_DELETE, "issuer.rdnSequence.?2"}
+};
+
+/* BER: indefinite lengths in a definite one */
+static const change indefinite_changes[] = {
+  {OP_WRITE, "seq1.int", "3", 0},
+  {OP_WRITE, "set1", "NEW", 0},
+  {OP_WRITE, "set1.?LAST", "1.2.7", 0},
+  {OP_DELETE, "set1.?1"}
+};
+
+#define CHANGES(c) c, sizeof (c) / sizeof (c[0])
+
+static cache_test tests[] = {
+  {NULL, NULL, 0, 0, "PKIX1.pkcs-12-PFX", CHANGES (pfx_changes)},
+  {NULL, NULL, 0, 0, "PKIX1.Certificate", CHANGES (cert_changes)},
+  {NULL, "\x30\x16\xa3\x14\x30\x08\x06\x03\x55\x04\x06\x13\x01\x62\x30\x08"
+   "\x06\x03\x55\x04\x03\x0c\x01\x61", 24, 1, "TEST_TREE.CertTemplate",
+   CHANGES (set_of_changes)},
+  {NULL, "\x30\x18\xa1\x80\x02\x01\x02\x00\x00\x31\x80\x06\x03\x2a\x03\x04"
+   "\x06\x03\x2a\x05\x06\x00\x00\x02\x01\x01", 26, 1,
+   "TEST_TREE.IndefiniteLengthTest", CHANGES (indefinite_changes)}
+};
+
+#define TESTS (sizeof (tests) / sizeof (tests[0]))
+
+static ASN1_TYPE pkix = ASN1_TYPE_EMPTY, tree = ASN1_TYPE_EMPTY;
+
+/* Applies CHANGE to *ELEMENT.  */
+static asn1_retCode
+apply (const cache_test * test, const change * c, ASN1_TYPE * element)
+{
+  switch (c->op)
+    {
+    case OP_WRITE:
+      return asn1_write_value (*element, c->name, c->value, c->len);
+    case OP_DELETE:
+      return asn1_delete_element (*element, c->name);
+    default:
+      return asn1_expand_any_defined_by (test->tree ? tree : pkix,
+					 element);
+    }
+}
+
+/* Decodes TEST with FLAGS, makes its first N changes and encodes it
+   in DER, of *DER_LEN bytes, encoding it before each change too when
+   CACHED is set, whether or not it can be.  Returns the result of
+   the decoding or of the last encoding; those of the changes go in
+   RESULTS.  */
+static asn1_retCode
+encode (const cache_test * test, unsigned int flags, int n, int cached,
+	unsigned char *der, int *der_len, asn1_retCode * results)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  asn1_retCode result;
+  int size = *der_len, k;
+
+  result = asn1_create_element (test->tree ? tree : pkix, test->type,
+				&element);
+  if (result == ASN1_SUCCESS)
+    result = asn1_der_decoding2 (&element, test->der, test->der_len, flags,
+				 NULL);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_delete_structure (&element);
+      return result;
+    }
+
+  for (k = 0; k <= n; k++)
+    {
+      if (k > 0)
+	results[k - 1] = apply (test, &test->changes[k - 1], &element);
+      if (cached || k == n)
+	{
+	  *der_len = size;
+	  result = asn1_der_coding (element, "", der, der_len, NULL);
+	}
+    }
+
+  asn1_delete_structure (&element);
+
+  return result;
+}
+
+/* Reads FILE into DER, of SIZE bytes.  Returns its length.  */
+static int
+read_file (const char *file, unsigned char *der, int size)
+{
+  FILE *fd;
+  int der_len;
+
+  fd = fopen (file, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", file);
+      exit (1);
+    }
+  der_len = fread (der, 1, size, fd);
+  fclose (fd);
+
+  return der_len;
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const unsigned int flags[] = {
+    0, ASN1_DECODE_KEEP_DER, ASN1_DECODE_KEEP_OFFSETS,
+    ASN1_DECODE_KEEP_DER | ASN1_DECODE_KEEP_OFFSETS
+  };
+  static unsigned char pfx[16 * 1024], cert[16 * 1024];
+  static unsigned char cached[16 * 1024], fresh[16 * 1024];
+  asn1_retCode result, fresh_result;
+  asn1_retCode results[8], fresh_results[8];
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  int errorCounter = 0, testCounter = 0, cached_len, fresh_len, n, k;
+  size_t t, f;
+  const char *pkixfile = getenv ("ASN1PKIX");
+  const char *treefile = getenv ("ASN1TREE");
+  const char *indeffile = getenv ("ASN1INDEF");
+  const char *certfile = getenv ("ASN1CRLF");
+
+  if (!pkixfile)
+    pkixfile = "pkix.asn";
+  if (!treefile)
+    treefile = "Test_tree.asn";
+  if (!indeffile)
+    indeffile = "TestIndef.p12";
+  if (!certfile)
+    certfile = "crlf.cer";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_cache       */\n");
+  printf ("/****************************************/\n\n");
+
+  result = asn1_parser2tree (pkixfile, &pkix, errorDescription);
+  if (result == ASN1_SUCCESS)
+    result = asn1_parser2tree (treefile, &tree, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  tests[0].file = indeffile;
+  tests[0].der_len = read_file (indeffile, pfx, sizeof (pfx));
+  tests[0].der = (const char *) pfx;
+  tests[1].file = certfile;
+  tests[1].der_len = read_file (certfile, cert, sizeof (cert));
+  tests[1].der = (const char *) cert;
+
+  for (t = 0; t < TESTS; t++)
+    for (f = 0; f < sizeof (flags) / sizeof (flags[0]); f++)
+      for (n = 0; n <= tests[t].n_changes; n++)
+	{
+	  testCounter++;
+	  cached_len = sizeof (cached);
+	  result = encode (&tests[t], flags[f], n, 1, cached, &cached_len,
+			   results);
+	  fresh_len = sizeof (fresh);
+	  fresh_result = encode (&tests[t], 0, n, 0, fresh, &fresh_len,
+				 fresh_results);
+	  for (k = 0; k < n && result == fresh_result; k++)
+	    if (results[k] != fresh_results[k])
+	      result = ASN1_GENERIC_ERROR;
+	  if (result != fresh_result || (result == ASN1_SUCCESS
+					 && (cached_len != fresh_len
+					     || memcmp (cached, fresh,
+							fresh_len) != 0)))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n  %s, flags %u, %d changes: %s, "
+		      "%d bytes, expected %s, %d bytes\n\n", errorCounter,
+		      tests[t].file ? tests[t].file : tests[t].type,
+		      flags[f], n, asn1_strerror (result), cached_len,
+		      asn1_strerror (fresh_result), fresh_len);
+	    }
+	}
+
+  asn1_delete_structure (&tree);
+  asn1_delete_structure (&pkix);
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
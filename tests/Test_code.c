@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_code.c                                 */
+/* Description: Test the C structures and functions  */
+/*   generated by asn1_parser2code against           */
+/*   asn1_der_coding.                                */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#include "Test_tree_asn1_code.c"
+
+#define ROUNDTRIP(T)						\
+  static int							\
+  roundtrip_##T (const unsigned char *der, int der_len,	\
+		 unsigned char *out, int *out_len)		\
+  {								\
+    struct test_tree_##T s;					\
+    int result = test_tree_decode_##T (der, der_len, &s);	\
+    if (result != ASN1_SUCCESS)					\
+      return result;						\
+    return test_tree_encode_##T (&s, out, out_len);		\
+  }
+
+ROUNDTRIP (KrbError)
+ROUNDTRIP (CertTemplate)
+ROUNDTRIP (sequenceEmpty)
+ROUNDTRIP (OidTest)
+ROUNDTRIP (OidAndTimeTest)
+ROUNDTRIP (Sequence1)
+ROUNDTRIP (DHParameter)
+ROUNDTRIP (AnyTest2)
+ROUNDTRIP (Test3)
+ROUNDTRIP (X520LocalityName)
+ROUNDTRIP (Validity)
+
+typedef struct
+{
+  const char *name;
+  const char *value;
+  int len;
+} write_type;
+
+typedef struct
+{
+  const char *type;
+  int (*roundtrip) (const unsigned char *der, int der_len,
+		    unsigned char *out, int *out_len);
+  write_type write[16];
+} test_type;
+
+test_type test_array[] = {
+  {"TEST_TREE.KrbError", roundtrip_KrbError,
+   {{"pvno", "5", 0}}},
+  {"TEST_TREE.CertTemplate", roundtrip_CertTemplate,
+   {{"version", NULL, 0},
+    {"validity", "7", 0},
+    {"issuer", "rdnSequence", 0},
+    {"issuer.rdnSequence", "NEW", 0},
+    {"issuer.rdnSequence.?LAST.type", "2.5.4.3", 0},
+    {"issuer.rdnSequence.?LAST.value", "\x0c\x02\x49\x43", 4},
+    {"issuer.rdnSequence", "NEW", 0},
+    {"issuer.rdnSequence.?LAST.type", "2.5.4.6", 0},
+    {"issuer.rdnSequence.?LAST.value",
+     "\x13\x06\x42\x72\x61\x73\x69\x6c", 8}}},
+  {"TEST_TREE.sequenceEmpty", roundtrip_sequenceEmpty,
+   {{"int1", "1", 0},
+    {"seq1.int", NULL, 0}}},
+  {"TEST_TREE.OidTest", roundtrip_OidTest,
+   {{"oid", "1.2.3.4", 0},
+    {"oid2", "2.5.29.1", 0},
+    {"oid3", "1.2.29.3", 0}}},
+  {"TEST_TREE.OidAndTimeTest", roundtrip_OidAndTimeTest,
+   {{"oid", "1.2.3.4", 0},
+    {"time1", "9801011200Z", 1},
+    {"time2", "2001010112001.12-0700", 1},
+    {"oct", "ABCD", 4},
+    {"bol", "TRUE", 1},
+    {"bol2", "FALSE", 1},
+    {"enum", "2", 0},
+    {"bit", "1\xC0", 10},
+    {"any", "\x30\x01\x01", 3},
+    {"set", "NEW", 0},
+    {"set.?LAST", "10", 0},
+    {"set", "NEW", 0},
+    {"set.?LAST", "1", 0},
+    {"gen", "Prova", 5}}},
+  {"TEST_TREE.Sequence1", roundtrip_Sequence1,
+   {{"int1", "v3", 0},
+    {"int2", "-20000000000", 0},
+    {"seq", "NEW", 1},
+    {"seq.?LAST", "1", 0},
+    {"id", "2.5.29.2", 0},
+    {"oct", "\x02\x01\x0a", 3},
+    {"any1", "\x02\x01\x05", 3}}},
+  {"TEST_TREE.DHParameter", roundtrip_DHParameter,
+   {{"prime", "1", 0},
+    {"base", "2", 0},
+    {"privateValueLength", NULL, 0}}},
+  {"TEST_TREE.AnyTest2", roundtrip_AnyTest2,
+   {{"", "int", 0},
+    {"int", "2000000000", 0}}},
+  {"TEST_TREE.Test3", roundtrip_Test3,
+   {{"a", "1234", 0},
+    {"b", "prova", 5}}},
+  {"TEST_TREE.X520LocalityName", roundtrip_X520LocalityName,
+   {{"", "printableString", 0},
+    {"printableString", "PROVA", 5}}},
+  {"TEST_TREE.Validity", roundtrip_Validity,
+   {{"notBefore", "utcTime", 0},
+    {"notBefore.utcTime", "980101120000Z", 1},
+    {"notAfter", "generalTime", 0},
+    {"notAfter.generalTime", "20500101000000Z", 1}}},
+
+  /* end */
+  {NULL}
+};
+
+/* Definitions whose names collide in C */
+static const char names_asn[] =
+  "Names {1 2 3} DEFINITIONS IMPLICIT TAGS ::=\n"
+  "BEGIN\n"
+  "Pair ::= SEQUENCE {\n"
+  "    a-b INTEGER,\n"
+  "    a_b INTEGER\n"
+  "}\n"
+  "END\n";
+
+static const char valid_asn[] =
+  "Valid {1 2 3} DEFINITIONS IMPLICIT TAGS ::=\n"
+  "BEGIN\n"
+  "Pair ::= SEQUENCE {\n"
+  "    a INTEGER\n"
+  "}\n"
+  "END\n";
+
+static void
+write_file (const char *name, const char *text)
+{
+  FILE *f = fopen (name, "w");
+
+  if (f == NULL || fputs (text, f) == EOF || fclose (f) != 0)
+    {
+      printf ("Cannot write file %s\n", name);
+      exit (1);
+    }
+}
+
+static int
+compare_files (const char *name1, const char *name2)
+{
+  FILE *f1, *f2;
+  int c1, c2;
+
+  f1 = fopen (name1, "r");
+  f2 = fopen (name2, "r");
+  if (f1 == NULL || f2 == NULL)
+    c1 = 0, c2 = 1;
+  else
+    do
+      {
+	c1 = getc (f1);
+	c2 = getc (f2);
+      }
+    while (c1 == c2 && c1 != EOF);
+
+  if (f1)
+    fclose (f1);
+  if (f2)
+    fclose (f2);
+
+  return c1 == c2;
+}
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result;
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+  ASN1_TYPE asn1_element = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  unsigned char der[1024], out[1024];
+  int der_len, out_len, k;
+  int errorCounter = 0, testCounter = 0;
+  struct test_tree_KrbError krb;
+  struct test_tree_CertTemplate cert;
+  struct test_tree_Sequence1 seq;
+  test_tree_iter it;
+  int64_t value;
+  static const int64_t items[] = { 3, -300 };
+  test_type *test;
+  write_type *w;
+  const char *treefile = getenv ("ASN1TREE");
+  const char *codefile = getenv ("ASN1TREECODE");
+
+  if (!treefile)
+    treefile = "Test_tree.asn";
+  if (!codefile)
+    codefile = "Test_tree_asn1_code.c";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_code        */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+  /* The generated file must be up to date */
+  result = asn1_parser2code (treefile, "Test_tree_asn1_code.out",
+			     "test_tree", errorDescription);
+  testCounter++;
+  if (result != ASN1_SUCCESS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_parser2code: %s %s\n\n", errorCounter,
+	      asn1_strerror (result), errorDescription);
+    }
+  else if (!compare_files ("Test_tree_asn1_code.out", codefile))
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s differs from the generated code\n\n",
+	      errorCounter, codefile);
+    }
+
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  for (test = test_array; test->type; test++)
+    {
+      testCounter++;
+
+      result = asn1_create_element (definitions, test->type, &asn1_element);
+      for (w = test->write; w->name && result == ASN1_SUCCESS; w++)
+	result = asn1_write_value (asn1_element, w->name, w->value, w->len);
+      der_len = sizeof (der);
+      if (result == ASN1_SUCCESS)
+	result = asn1_der_coding (asn1_element, "", der, &der_len,
+				  errorDescription);
+      asn1_delete_structure (&asn1_element);
+      if (result != ASN1_SUCCESS)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s: asn1_der_coding: %s\n\n",
+		  errorCounter, test->type, asn1_strerror (result));
+	  continue;
+	}
+
+      /* a short buffer returns the needed length */
+      out_len = der_len - 1;
+      result = test->roundtrip (der, der_len, out, &out_len);
+      if (result != ASN1_MEM_ERROR || out_len != der_len)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s: short buffer: %s - %d\n\n",
+		  errorCounter, test->type, asn1_strerror (result), out_len);
+	}
+
+      out_len = sizeof (out);
+      result = test->roundtrip (der, der_len, out, &out_len);
+      if (result != ASN1_SUCCESS || out_len != der_len
+	  || memcmp (der, out, der_len))
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s: %s\n  expected: ", errorCounter,
+		  test->type, asn1_strerror (result));
+	  for (k = 0; k < der_len; k++)
+	    printf ("%02x", der[k]);
+	  printf ("\n  detected: ");
+	  for (k = 0; k < out_len && result == ASN1_SUCCESS; k++)
+	    printf ("%02x", out[k]);
+	  printf ("\n\n");
+	}
+
+      if (der_len > 1)
+	{
+	  result = test->roundtrip (der, der_len - 1, out, &out_len);
+	  if (result == ASN1_SUCCESS)
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n  %s: truncated input accepted\n\n",
+		      errorCounter, test->type);
+	    }
+	}
+    }
+
+  /* Decoded values */
+  testCounter++;
+  result = test_tree_decode_KrbError ((const unsigned char *)
+				      "\x7e\x03\x80\x01\x05", 5, &krb);
+  if (result != ASN1_SUCCESS || krb.pvno != 5)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  KrbError: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = test_tree_decode_KrbError ((const unsigned char *)
+				      "\x7e\x04\x80\x02\xfe\xd4", 6, &krb);
+  if (result != ASN1_SUCCESS || krb.pvno != -300)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  KrbError: negative: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  /* INTEGER values must fit in an int64_t */
+  testCounter++;
+  result = test_tree_decode_KrbError ((const unsigned char *)
+				      "\x7e\x0b\x80\x09\x00\x80\x00\x00"
+				      "\x00\x00\x00\x00\x00", 13, &krb);
+  if (result != ASN1_DER_OVERFLOW)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  KrbError: 2^63: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = test_tree_decode_CertTemplate ((const unsigned char *)
+					  "\x30\x06\x80\x01\x01\x84\x01\x00",
+					  8, &cert);
+  if (result != ASN1_SUCCESS || cert.version != 1 || !cert.version_present
+      || cert.issuer_present || !cert.validity_present || cert.validity != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  CertTemplate: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = test_tree_decode_CertTemplate ((const unsigned char *)
+					  "\x30\x05\x80\x01\x01\x84\x00", 7,
+					  &cert);
+  if (result != ASN1_DER_ERROR)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  CertTemplate: empty INTEGER: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = test_tree_decode_CertTemplate ((const unsigned char *)
+					  "\x30\x03\x81\x01\x01", 5, &cert);
+  if (result != ASN1_DER_ERROR)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  CertTemplate: unknown element: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  /* The elements of a SET OF, decoded one at a time and encoded from
+     an array */
+  testCounter++;
+  result = asn1_create_element (definitions, "TEST_TREE.Sequence1",
+				&asn1_element);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "int1", "v3", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "int2", "-20000000000", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "seq", "NEW", 1);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "seq.?LAST", "-300", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "seq", "NEW", 1);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "seq.?LAST", "3", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "id", "2.5.29.2", 0);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "oct", "ABCD", 4);
+  if (result == ASN1_SUCCESS)
+    result = asn1_write_value (asn1_element, "any1", NULL, 0);
+  der_len = sizeof (der);
+  if (result == ASN1_SUCCESS)
+    result = asn1_der_coding (asn1_element, "", der, &der_len, NULL);
+  asn1_delete_structure (&asn1_element);
+  if (result == ASN1_SUCCESS)
+    result = test_tree_decode_Sequence1 (der, der_len, &seq);
+  if (result != ASN1_SUCCESS || !seq.int1_present || seq.int1 != 2
+      || seq.int2 != -20000000000LL || seq.seq.count != 2)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  Sequence1: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+      memset (&seq, 0, sizeof (seq));
+    }
+
+  test_tree_iter_init (&it, seq.seq.data, seq.seq.len);
+  for (k = 0; k < 3; k++)
+    {
+      testCounter++;
+      result = test_tree_next_Sequence1_seq (&it, &value);
+      if ((k < 2 && (result != ASN1_SUCCESS || value != items[k]))
+	  || (k == 2 && result != ASN1_ELEMENT_NOT_FOUND))
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  Sequence1.seq element %d: %s\n\n",
+		  errorCounter, k, asn1_strerror (result));
+	}
+    }
+
+  testCounter++;
+  seq.seq.data = NULL;
+  seq.seq.len = 0;
+  seq.seq.count = 2;
+  seq.seq.items = items;
+  out_len = sizeof (out);
+  result = test_tree_encode_Sequence1 (&seq, out, &out_len);
+  if (result != ASN1_SUCCESS || out_len != der_len
+      || memcmp (der, out, der_len))
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  Sequence1 from items: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  /* Names that are the same in C, and prefixes that are not C
+     identifiers, are refused */
+  testCounter++;
+  write_file ("Test_code_names.asn", names_asn);
+  result = asn1_parser2code ("Test_code_names.asn", "Test_code_names.out",
+			     "names", errorDescription);
+  if (result != ASN1_VALUE_NOT_VALID
+      || strstr (errorDescription, "a_b in C") == NULL)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  a-b and a_b: %s %s\n\n", errorCounter,
+	      asn1_strerror (result), errorDescription);
+    }
+
+  testCounter++;
+  write_file ("Test_code_names.asn", valid_asn);
+  result = asn1_parser2code ("Test_code_names.asn", "Test_code_names.out",
+			     "3gpp", errorDescription);
+  if (result != ASN1_VALUE_NOT_VALID)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  prefix 3gpp: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  testCounter++;
+  write_file ("3code.asn", valid_asn);
+  result = asn1_parser2code ("3code.asn", "Test_code_names.out", NULL,
+			     errorDescription);
+  if (result != ASN1_VALUE_NOT_VALID)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  prefix from 3code.asn: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = asn1_parser2code ("Test_code_names.asn", "Test_code_names.out",
+			     "valid", errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  valid names: %s %s\n\n", errorCounter,
+	      asn1_strerror (result), errorDescription);
+    }
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  asn1_delete_structure (&definitions);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_decoder.c                              */
+/* Description: Test asn1_decoder_decode: the        */
+/*   elements decoded, and no allocations once the   */
+/*   decoder decoded the same encoding before.       */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#define ROUNDS 10
+
+static int errorCounter = 0, testCounter = 0;
+
+/* Decodes DER with DECODER ROUNDS times, checking that each element
+   encodes back to DER and that the decodings after the first
+   allocate nothing.  */
+static void
+test_rounds (asn1_decoder * decoder, const char *file,
+	     const unsigned char *der, int der_len)
+{
+  static unsigned char coding[16 * 1024];
+  ASN1_TYPE element;
+  asn1_alloc_stats stats;
+  unsigned long allocations = 0;
+  asn1_error error;
+  asn1_retCode result;
+  int coding_len, k;
+
+  for (k = 0; k < ROUNDS; k++)
+    {
+      if (k == 1)
+	{
+	  asn1_get_alloc_stats (&stats);
+	  allocations = stats.site[ASN1_ALLOC_DECODE].allocations;
+	}
+
+      testCounter++;
+      result = asn1_decoder_decode (decoder, der, der_len, &element, &error);
+      if (result != ASN1_SUCCESS)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s round %d: %s at %d\n\n",
+		  errorCounter, file, k, asn1_strerror (result),
+		  error.offset);
+	  return;
+	}
+
+      testCounter++;
+      coding_len = sizeof (coding);
+      result = asn1_der_coding (element, "", coding, &coding_len, NULL);
+      if (result != ASN1_SUCCESS || coding_len != der_len
+	  || memcmp (coding, der, der_len) != 0)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s round %d: encoded differently (%s)\n\n",
+		  errorCounter, file, k, asn1_strerror (result));
+	}
+    }
+
+  testCounter++;
+  asn1_get_alloc_stats (&stats);
+  allocations = stats.site[ASN1_ALLOC_DECODE].allocations - allocations;
+  printf ("%s: %lu allocations in %d rounds\n", file, allocations,
+	  ROUNDS - 1);
+  if (allocations != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s: %lu allocations\n\n", errorCounter,
+	      file, allocations);
+    }
+}
+
+/* Reads FILE into DER, of SIZE bytes.  Returns its length.  */
+static int
+read_file (const char *file, unsigned char *der, int size)
+{
+  FILE *fd;
+  int der_len;
+
+  fd = fopen (file, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", file);
+      exit (1);
+    }
+  der_len = fread (der, 1, size, fd);
+  fclose (fd);
+
+  return der_len;
+}
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  static unsigned char cert[16 * 1024], indef[16 * 1024];
+  int cert_len, indef_len, k;
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY, element;
+  asn1_decoder *cert_decoder, *indef_decoder, *limited_decoder;
+  asn1_decode_options options;
+  asn1_alloc_stats stats;
+  unsigned long allocations;
+  asn1_error error;
+  const char *treefile = getenv ("ASN1PKIX");
+  const char *certfile = getenv ("ASN1CRLF");
+  const char *indeffile = getenv ("ASN1INDEF");
+
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+  if (!indeffile)
+    indeffile = "TestIndef.p12";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_decoder     */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+  asn1_enable_alloc_stats (1);
+
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  cert_len = read_file (certfile, cert, sizeof (cert));
+  indef_len = read_file (indeffile, indef, sizeof (indef));
+
+  if (asn1_decoder_init (definitions, "PKIX1.Certificate", NULL,
+			 &cert_decoder) != ASN1_SUCCESS
+      || asn1_decoder_init (definitions, "PKIX1.pkcs-12-PFX", NULL,
+			    &indef_decoder) != ASN1_SUCCESS)
+    {
+      printf ("Cannot create the decoders\n");
+      exit (1);
+    }
+
+  testCounter++;
+  result = asn1_decoder_init (definitions, "PKIX1.NoSuchType", NULL,
+			      &limited_decoder);
+  if (result != ASN1_ELEMENT_NOT_FOUND || limited_decoder != NULL)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  unknown type: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+
+  test_rounds (cert_decoder, certfile, cert, cert_len);
+
+  /* The indefinite lengths are encoded again as definite ones, which
+     only asn1_der_coding tells */
+  testCounter++;
+  result = asn1_decoder_decode (indef_decoder, indef, indef_len, &element,
+				&error);
+  if (result != ASN1_SUCCESS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s: %s\n\n", errorCounter, indeffile,
+	      asn1_strerror (result));
+    }
+
+  /* A truncated encoding fails with an empty element, and the decoder
+     decodes the whole one again after it */
+  testCounter++;
+  result = asn1_decoder_decode (cert_decoder, cert, cert_len / 2, &element,
+				&error);
+  if (result == ASN1_SUCCESS || element != ASN1_TYPE_EMPTY
+      || error.code != result)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  truncated %s: %s\n\n", errorCounter,
+	      certfile, asn1_strerror (result));
+    }
+
+  asn1_get_alloc_stats (&stats);
+  allocations = stats.site[ASN1_ALLOC_DECODE].allocations;
+  testCounter++;
+  result = asn1_decoder_decode (cert_decoder, cert, cert_len, &element,
+				&error);
+  asn1_get_alloc_stats (&stats);
+  allocations = stats.site[ASN1_ALLOC_DECODE].allocations - allocations;
+  if (result != ASN1_SUCCESS || allocations != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s after an error: %s, %lu allocations\n\n",
+	      errorCounter, certfile, asn1_strerror (result), allocations);
+    }
+
+  /* The options must have their size */
+  memset (&options, 0, sizeof (options));
+  options.max_depth = 2;
+  testCounter++;
+  result = asn1_decoder_init (definitions, "PKIX1.Certificate", &options,
+			      &limited_decoder);
+  if (result != ASN1_GENERIC_ERROR || limited_decoder != NULL)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  options without a size: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  /* The options are those of the decoder */
+  options.size = sizeof (options);
+  testCounter++;
+  result = asn1_decoder_init (definitions, "PKIX1.Certificate", &options,
+			      &limited_decoder);
+  if (result == ASN1_SUCCESS)
+    result = asn1_decoder_decode (limited_decoder, cert, cert_len, &element,
+				  &error);
+  if (result != ASN1_LIMIT_EXCEEDED)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s with max_depth 2: %s\n\n", errorCounter,
+	      certfile, asn1_strerror (result));
+    }
+
+  asn1_decoder_deinit (&limited_decoder);
+
+  /* The memory kept is limited by the options: without room for a
+     block, each decoding allocates as the first one */
+  memset (&options, 0, sizeof (options));
+  options.size = sizeof (options);
+  options.max_pool_bytes = 1;
+  testCounter++;
+  result = asn1_decoder_init (definitions, "PKIX1.Certificate", &options,
+			      &limited_decoder);
+  allocations = 0;
+  for (k = 0; k < 2 && result == ASN1_SUCCESS; k++)
+    {
+      asn1_get_alloc_stats (&stats);
+      allocations = stats.site[ASN1_ALLOC_DECODE].allocations;
+      result = asn1_decoder_decode (limited_decoder, cert, cert_len,
+				    &element, &error);
+      asn1_get_alloc_stats (&stats);
+      allocations = stats.site[ASN1_ALLOC_DECODE].allocations - allocations;
+    }
+  if (result != ASN1_SUCCESS || allocations == 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %s with max_pool_bytes 1: %s, %lu "
+	      "allocations\n\n", errorCounter, certfile,
+	      asn1_strerror (result), allocations);
+    }
+
+  asn1_decoder_deinit (&limited_decoder);
+  asn1_decoder_deinit (&indef_decoder);
+  asn1_decoder_deinit (&cert_decoder);
+  asn1_decoder_deinit (&cert_decoder);
+  asn1_delete_structure (&definitions);
+
+  testCounter++;
+  asn1_get_alloc_stats (&stats);
+  if (cert_decoder != NULL || stats.in_use != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %ld bytes in use after the decoders\n\n",
+	      errorCounter, stats.in_use);
+    }
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
@@ -0,0 +1,514 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_fuzz.c                                 */
+/* Description: Replay inputs of the fuzzing targets */
+/*   of fuzz.c within a budget of allocations: the   */
+/*   test files, all their truncations, and inputs   */
+/*   built to be slow to decode.  Those are decoded  */
+/*   at two sizes, and the test fails when the       */
+/*   decoding grows faster than the input.  With     */
+/*   --timing, run by "make fuzz-timing", the time   */
+/*   is also measured, which "make check" does not   */
+/*   do since it depends on the machine.  With a     */
+/*   directory as argument, the inputs built are     */
+/*   written there, as a corpus for the fuzzers.     */
+/*****************************************************/
+
+#include <sys/time.h>
+
+#include "fuzz.c"
+
+/* Budget of one input, the time with --timing only, and the
+   allocations of a decoding, fuzz_der making FUZZ_PASSES */
+#define TIME_BUDGET 1.0		/* seconds */
+#define ALLOC_BUDGET(size) (4 * (size) + 512)
+
+/* The slow inputs are built with N and GROWTH * N elements.  The
+   ratio of their decoding times is GROWTH when it is linear, and
+   GROWTH * GROWTH when it is quadratic; the limit leaves room for
+   the caches and a loaded machine.  Their time is not compared with
+   TIME_BUDGET.  */
+#define SLOW_N 4000
+#define GROWTH 4
+#define TIME_GROWTH 10.0
+#define ALLOC_GROWTH (GROWTH + 1)
+
+typedef struct
+{
+  const char *name;
+  const char *type;		/* decoded as */
+  size_t (*build) (unsigned char *der, long n);	/* returns the size */
+} slow_type;
+
+/* Counts the allocations of the library, set with
+   asn1_set_allocator.  */
+static unsigned long allocations;
+
+/* Set by --timing */
+static int timing;
+
+static void *
+count_malloc (size_t size, void *ctx)
+{
+  allocations++;
+  return malloc (size);
+}
+
+static void *
+count_realloc (void *ptr, size_t size, void *ctx)
+{
+  allocations++;
+  return realloc (ptr, size);
+}
+
+static void
+count_free (void *ptr, void *ctx)
+{
+  free (ptr);
+}
+
+static double
+now (void)
+{
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* Writes the tag and the length of a value of LEN octets.  */
+static size_t
+put_header (unsigned char *der, unsigned char tag, long len)
+{
+  int len_len;
+
+  der[0] = tag;
+  asn1_length_der (len, der + 1, &len_len);
+  return 1 + len_len;
+}
+
+/* Writes a SEQUENCE, or a SET, holding the SIZE octets at DER.  */
+static size_t
+wrap (unsigned char *der, unsigned char tag, size_t size)
+{
+  unsigned char header[1 + 8];
+  size_t header_len;
+
+  header_len = put_header (header, tag, size);
+  memmove (der + header_len, der, size);
+  memcpy (der, header, header_len);
+
+  return header_len + size;
+}
+
+/* An AttributeTypeAndValue: commonName "a" */
+static const unsigned char attribute[] = {
+  0x30, 0x08, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x01, 'a'
+};
+
+/* A Name with one RelativeDistinguishedName, a SET OF N attributes */
+static size_t
+build_wide_set (unsigned char *der, long n)
+{
+  size_t size = 0;
+  long k;
+
+  for (k = 0; k < n; k++, size += sizeof (attribute))
+    memcpy (der + size, attribute, sizeof (attribute));
+  size = wrap (der, 0x31, size);
+
+  return wrap (der, 0x30, size);
+}
+
+/* A Name with N RelativeDistinguishedName, a SEQUENCE OF N SET */
+static size_t
+build_many_rdn (unsigned char *der, long n)
+{
+  size_t size = 0;
+  long k;
+
+  for (k = 0; k < n; k++)
+    {
+      size += put_header (der + size, 0x31, sizeof (attribute));
+      memcpy (der + size, attribute, sizeof (attribute));
+      size += sizeof (attribute);
+    }
+
+  return wrap (der, 0x30, size);
+}
+
+/* The OBJECT IDENTIFIER of pkcs-7-data */
+static const unsigned char data_oid[] = {
+  0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01
+};
+
+/* A ContentInfo whose content, an ANY, holds N nested SEQUENCE of
+   indefinite length */
+static size_t
+build_nested (unsigned char *der, long n)
+{
+  size_t size = 0;
+  long k;
+
+  der[size++] = 0x30;
+  der[size++] = 0x80;
+  memcpy (der + size, data_oid, sizeof (data_oid));
+  size += sizeof (data_oid);
+  der[size++] = 0xa0;
+  der[size++] = 0x80;
+  for (k = 0; k < n; k++)
+    {
+      der[size++] = 0x30;
+      der[size++] = 0x80;
+    }
+  memset (der + size, 0, 2 * n + 4);
+
+  return size + 2 * n + 4;
+}
+
+/* An AuthenticatedSafe, a SEQUENCE OF N ContentInfo, all of
+   indefinite length as in TestIndef.p12 */
+static size_t
+build_indefinite_chain (unsigned char *der, long n)
+{
+  size_t size = 0;
+  long k;
+
+  der[size++] = 0x30;
+  der[size++] = 0x80;
+  for (k = 0; k < n; k++)
+    {
+      der[size++] = 0x30;
+      der[size++] = 0x80;
+      memcpy (der + size, data_oid, sizeof (data_oid));
+      size += sizeof (data_oid);
+      der[size++] = 0xa0;
+      der[size++] = 0x80;
+      der[size++] = 0x24;
+      der[size++] = 0x80;
+      der[size++] = 0x04;
+      der[size++] = 0x01;
+      der[size++] = 'a';
+      memset (der + size, 0, 6);
+      size += 6;
+    }
+  der[size++] = 0;
+  der[size++] = 0;
+
+  return size;
+}
+
+/* A Data, an OCTET STRING of indefinite length made of N segments */
+static size_t
+build_segments (unsigned char *der, long n)
+{
+  size_t size = 0;
+  long k;
+
+  der[size++] = 0x24;
+  der[size++] = 0x80;
+  for (k = 0; k < n; k++)
+    {
+      der[size++] = 0x04;
+      der[size++] = 0x01;
+      der[size++] = 'a';
+    }
+  der[size++] = 0;
+  der[size++] = 0;
+
+  return size;
+}
+
+static const slow_type slow_inputs[] = {
+  {"wide-set", "PKIX1.Name", build_wide_set},
+  {"many-rdn", "PKIX1.Name", build_many_rdn},
+  {"nested", "PKIX1.pkcs-7-ContentInfo", build_nested},
+  {"indefinite-chain", "PKIX1.pkcs-12-AuthenticatedSafe",
+   build_indefinite_chain},
+  {"segments", "PKIX1.pkcs-7-Data", build_segments}
+};
+
+#define SLOW_INPUTS (sizeof (slow_inputs) / sizeof (slow_inputs[0]))
+
+/* Decodes DER as TYPE.  Returns the result, and the allocations in
+   *ALLOCS.  */
+static asn1_retCode
+decode (const char *type, const unsigned char *der, size_t size,
+	unsigned long *allocs)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  asn1_retCode result;
+
+  allocations = 0;
+  result = asn1_create_element (fuzz_definitions, type, &element);
+  if (result == ASN1_SUCCESS)
+    result = asn1_der_decoding (&element, der, size, NULL);
+  asn1_delete_structure (&element);
+  *allocs = allocations;
+
+  return result;
+}
+
+/* Returns the seconds taken to decode DER as TYPE, measured during
+   10 ms at least.  */
+static double
+decode_time (const char *type, const unsigned char *der, size_t size)
+{
+  unsigned long allocs;
+  double start, elapsed;
+  int count = 0;
+
+  start = now ();
+  do
+    {
+      decode (type, der, size, &allocs);
+      count++;
+      elapsed = now () - start;
+    }
+  while (elapsed < 0.01);
+
+  return elapsed / count;
+}
+
+/* Runs INPUT through the fuzzing target PARSER, or fuzz_der.  Returns
+   1 if it goes over the budget.  */
+static int
+replay (const char *name, const unsigned char *input, size_t size,
+	int parser)
+{
+  double start, elapsed;
+
+  allocations = 0;
+  start = now ();
+  if (parser)
+    fuzz_parser (input, size);
+  else
+    fuzz_der (input, size);
+  elapsed = now () - start;
+
+  if ((timing && elapsed > TIME_BUDGET)
+      || allocations > (parser ? 1 : FUZZ_PASSES) * ALLOC_BUDGET (size))
+    {
+      printf ("%s (%lu bytes): %.3f s, %lu allocations\n", name,
+	      (unsigned long) size, elapsed, allocations);
+      return 1;
+    }
+
+  return 0;
+}
+
+/* Reads FILE, which must exist.  Returns the size.  */
+static size_t
+read_file (const char *file, unsigned char *data, size_t data_size)
+{
+  FILE *fd;
+  size_t size;
+
+  fd = fopen (file, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", file);
+      exit (1);
+    }
+  size = fread (data, 1, data_size, fd);
+  fclose (fd);
+
+  return size;
+}
+
+int
+main (int argc, char *argv[])
+{
+  static unsigned char data[1024 * 1024];
+  unsigned char *der[2], *input;
+  const char *corpus;
+  const char *der_files[2], *asn_files[2];
+  char file_name[1024];
+  asn1_retCode result;
+  unsigned long allocs[2];
+  double times[2], elapsed;
+  size_t size, sizes[2], k, cut;
+  int errorCounter = 0, testCounter = 0, over, pass, i;
+  FILE *fd;
+
+  if (argc > 1 && strcmp (argv[1], "--timing") == 0)
+    {
+      timing = 1;
+      argc--;
+      argv++;
+    }
+  corpus = argc > 1 ? argv[1] : NULL;
+
+  der_files[0] = getenv ("ASN1CRLF");
+  der_files[1] = getenv ("ASN1INDEF");
+  asn_files[0] = getenv ("ASN1PKIX");
+  asn_files[1] = getenv ("ASN1TREE");
+  if (!der_files[0])
+    der_files[0] = "crlf.cer";
+  if (!der_files[1])
+    der_files[1] = "TestIndef.p12";
+  if (!asn_files[0])
+    asn_files[0] = "pkix.asn";
+  if (!asn_files[1])
+    asn_files[1] = "Test_tree.asn";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_fuzz        */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", asn_files[0]);
+
+  asn1_set_allocator (count_malloc, count_realloc, count_free, NULL);
+  fuzz_init ();
+
+  /* The test files, and each of their truncations */
+  for (i = 0; i < 2; i++)
+    {
+      testCounter++;
+      size = read_file (der_files[i], data, sizeof (data));
+      if (fuzz_der (data, size) == 0)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s not decoded\n\n", errorCounter,
+		  der_files[i]);
+	}
+
+      testCounter++;
+      for (cut = 0, over = 0; cut <= size; cut++)
+	{
+	  /* a copy of the exact size, for the memory checkers */
+	  input = malloc (cut + 1);
+	  memcpy (input, data, cut);
+	  over += replay (der_files[i], input, cut, 0);
+	  free (input);
+	}
+      if (over)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %d truncations of %s over the "
+		  "budget\n\n", errorCounter, over, der_files[i]);
+	}
+    }
+
+  for (i = 0; i < 2; i++)
+    {
+      testCounter++;
+      size = read_file (asn_files[i], data, sizeof (data));
+      if (fuzz_parser (data, size) != ASN1_SUCCESS
+	  || replay (asn_files[i], data, size, 1))
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s not parsed within the budget\n\n",
+		  errorCounter, asn_files[i]);
+	}
+    }
+
+  /* The inputs that would be slow to decode */
+  for (i = 0; i < 2; i++)
+    {
+      der[i] = malloc (64 * GROWTH * SLOW_N + 64);
+      if (der[i] == NULL)
+	exit (1);
+    }
+  for (k = 0; k < SLOW_INPUTS; k++)
+    {
+      testCounter++;
+      for (i = 0; i < 2; i++)
+	{
+	  sizes[i] = slow_inputs[k].build (der[i],
+					   i ? GROWTH * SLOW_N : SLOW_N);
+	  result = decode (slow_inputs[k].type, der[i], sizes[i],
+			   &allocs[i]);
+	  if (result != ASN1_SUCCESS)
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n  %s not decoded: %s\n\n",
+		      errorCounter, slow_inputs[k].name,
+		      asn1_strerror (result));
+	      break;
+	    }
+	}
+      if (i < 2)
+	continue;
+
+      /* The best of a few measures, of both sizes in turn so that
+	 another process slows down both or none */
+      for (pass = 0; timing && pass < 5; pass++)
+	{
+	  for (i = 0; i < 2; i++)
+	    {
+	      elapsed = decode_time (slow_inputs[k].type, der[i], sizes[i]);
+	      if (pass == 0 || elapsed < times[i])
+		times[i] = elapsed;
+	    }
+	  if (times[1] > TIME_BUDGET)
+	    break;
+	}
+
+      if (timing)
+	printf ("%-18s %8lu bytes  %8lu allocations  %8.0f us  x%.1f\n",
+		slow_inputs[k].name, (unsigned long) sizes[1], allocs[1],
+		times[1] * 1000000, times[1] / times[0]);
+      else
+	{
+	  printf ("%-18s %8lu bytes  %8lu allocations\n",
+		  slow_inputs[k].name, (unsigned long) sizes[1], allocs[1]);
+	  times[0] = times[1] = 0;
+	}
+
+      if (allocs[1] > ALLOC_BUDGET (sizes[1])
+	  || times[1] > TIME_GROWTH * times[0]
+	  || allocs[1] > ALLOC_GROWTH * allocs[0])
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s: %lu then %lu allocations, "
+		  "%.0f then %.0f us\n\n", errorCounter,
+		  slow_inputs[k].name, allocs[0], allocs[1],
+		  times[0] * 1000000, times[1] * 1000000);
+	}
+
+      if (corpus)
+	{
+	  sprintf (file_name, "%.1000s/%s.der", corpus, slow_inputs[k].name);
+	  fd = fopen (file_name, "wb");
+	  if (fd == NULL || fwrite (der[1], 1, sizes[1], fd) != sizes[1])
+	    {
+	      printf ("Cannot write file %s\n", file_name);
+	      exit (1);
+	    }
+	  fclose (fd);
+	}
+    }
+  free (der[0]);
+  free (der[1]);
+
+  fuzz_deinit ();
+  asn1_set_allocator (NULL, NULL, NULL, NULL);
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
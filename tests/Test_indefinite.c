@@ -47,6 +47,7 @@ main (int argc, char *argv[])
   char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
   FILE *out, *fd;
   ssize_t size;
+  int len_len;
   const char *treefile = getenv ("ASN1PKIX");
   const char *indeffile = getenv ("ASN1INDEF");
 
@@ -91,6 +92,14 @@ main (int argc, char *argv[])
 
   fclose (fd);
 
+  /* The whole file is one element of indefinite length */
+  if (asn1_get_length_ber ((unsigned char *) buffer + 1, size - 1, &len_len)
+      != size - 1 - len_len)
+    {
+      printf ("Wrong indefinite length of %s\n", indeffile);
+      exit (1);
+    }
+
   result =
     asn1_create_element (definitions, "PKIX1.pkcs-12-PFX", &asn1_element);
   if (result != ASN1_SUCCESS)
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_limits.c                               */
+/* Description: Test the limits of                   */
+/*   asn1_der_decoding_options: the smallest value   */
+/*   of each limit with which a file decodes, and    */
+/*   ASN1_LIMIT_EXCEEDED below it.                   */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#define LIMIT_DEPTH		0
+#define LIMIT_NODES		1
+#define LIMIT_VALUE_BYTES	2
+#define LIMIT_INDEFINITE	3
+#define LIMITS			4
+
+static const char *limit_names[LIMITS] = {
+  "max_depth", "max_nodes", "max_value_bytes", "max_indefinite"
+};
+
+static ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+
+/* The OBJECT IDENTIFIER of pkcs-7-data */
+static const unsigned char data_oid[] = {
+  0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01
+};
+
+/* Decodes DER as TYPE with the limit WHICH set to VALUE, and checks
+   that the element is kept for the error.  */
+static asn1_retCode
+decode (const char *type, const unsigned char *der, int der_len,
+	int which, long value)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  asn1_decode_options options;
+  asn1_error error;
+  asn1_retCode result;
+
+  memset (&options, 0, sizeof (options));
+  options.size = sizeof (options);
+  switch (which)
+    {
+    case LIMIT_DEPTH:
+      options.max_depth = value;
+      break;
+    case LIMIT_NODES:
+      options.max_nodes = value;
+      break;
+    case LIMIT_VALUE_BYTES:
+      options.max_value_bytes = value;
+      break;
+    case LIMIT_INDEFINITE:
+      options.max_indefinite = value;
+      break;
+    }
+
+  result = asn1_create_element (definitions, type, &element);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  result = asn1_der_decoding_options (&element, der, der_len, &options,
+				      &error);
+  if (result != ASN1_SUCCESS
+      && (element == ASN1_TYPE_EMPTY || error.code != result))
+    result = ASN1_GENERIC_ERROR;
+  asn1_delete_structure (&element);
+
+  return result;
+}
+
+/* Returns the smallest value of the limit WHICH with which DER
+   decodes as TYPE, or -1 if it does not decode.  */
+static long
+find_limit (const char *type, const unsigned char *der, int der_len,
+	    int which)
+{
+  long low = 0, high = 1, middle;
+
+  /* LOW fails, but for 0 which is no limit */
+  while (decode (type, der, der_len, which, high) != ASN1_SUCCESS)
+    {
+      if (high > 1024 * 1024)
+	return -1;
+      low = high;
+      high *= 2;
+    }
+
+  while (high - low > 1)
+    {
+      middle = low + (high - low) / 2;
+      if (decode (type, der, der_len, which, middle) == ASN1_SUCCESS)
+	high = middle;
+      else
+	low = middle;
+    }
+
+  return high;
+}
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  static unsigned char der[16 * 1024];
+  int der_len, errorCounter = 0, testCounter = 0, which, k;
+  long limit;
+  FILE *fd;
+  const char *treefile = getenv ("ASN1PKIX");
+  const char *certfile = getenv ("ASN1CRLF");
+  const char *indeffile = getenv ("ASN1INDEF");
+  /* the files decoded, and the least limits they need, the values
+     being about the size of the encoding */
+  struct
+  {
+    const char *file;
+    const char *type;
+    long least[LIMITS];
+  } tests[2];
+
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+  if (!indeffile)
+    indeffile = "TestIndef.p12";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_limits      */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  tests[0].file = certfile;
+  tests[0].type = "PKIX1.Certificate";
+  tests[0].least[LIMIT_DEPTH] = 4;
+  tests[0].least[LIMIT_NODES] = 100;
+  tests[0].least[LIMIT_INDEFINITE] = 1;
+  tests[1].file = indeffile;
+  tests[1].type = "PKIX1.pkcs-12-PFX";
+  tests[1].least[LIMIT_DEPTH] = 2;
+  tests[1].least[LIMIT_NODES] = 10;
+  tests[1].least[LIMIT_INDEFINITE] = 3;
+
+  for (k = 0; k < 2; k++)
+    {
+      fd = fopen (tests[k].file, "rb");
+      if (fd == NULL)
+	{
+	  printf ("Cannot read file %s\n", tests[k].file);
+	  exit (1);
+	}
+      der_len = fread (der, 1, sizeof (der), fd);
+      fclose (fd);
+      tests[k].least[LIMIT_VALUE_BYTES] = der_len / 2;
+
+      /* No limit */
+      testCounter++;
+      result = decode (tests[k].type, der, der_len, LIMIT_DEPTH, 0);
+      if (result != ASN1_SUCCESS)
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  %s without limits: %s\n\n", errorCounter,
+		  tests[k].file, asn1_strerror (result));
+	  continue;
+	}
+
+      for (which = 0; which < LIMITS; which++)
+	{
+	  testCounter++;
+	  limit = find_limit (tests[k].type, der, der_len, which);
+	  printf ("%s: %s %ld\n", tests[k].file, limit_names[which], limit);
+	  if (limit < tests[k].least[which]
+	      || (which == LIMIT_VALUE_BYTES && limit > 2 * der_len))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n  %s: %s %ld\n\n", errorCounter,
+		      tests[k].file, limit_names[which], limit);
+	      continue;
+	    }
+
+	  /* Just below, the decoding fails with the error of the limits */
+	  if (limit == 1)
+	    continue;
+	  testCounter++;
+	  result = decode (tests[k].type, der, der_len, which, limit - 1);
+	  if (result != ASN1_LIMIT_EXCEEDED)
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n  %s: %s %ld: %s\n\n", errorCounter,
+		      tests[k].file, limit_names[which], limit - 1,
+		      asn1_strerror (result));
+	    }
+	}
+    }
+
+  /* A ContentInfo whose content, of indefinite length, holds nested
+     SEQUENCE of indefinite length and is cut.  Without limits it is
+     taken as absent once its contents were walked to the end; with
+     one the walk stops there */
+  der_len = 0;
+  der[der_len++] = 0x30;
+  der[der_len++] = 0x80;
+  memcpy (der + der_len, data_oid, sizeof (data_oid));
+  der_len += sizeof (data_oid);
+  der[der_len++] = 0xa0;
+  der[der_len++] = 0x80;
+  for (k = 0; k < 64; k++)
+    {
+      der[der_len++] = 0x30;
+      der[der_len++] = 0x80;
+    }
+
+  testCounter++;
+  result = decode ("PKIX1.pkcs-7-ContentInfo", der, der_len,
+		   LIMIT_INDEFINITE, 0);
+  if (result != ASN1_TAG_ERROR)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  EXPLICIT tag cut, without limits: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  testCounter++;
+  result = decode ("PKIX1.pkcs-7-ContentInfo", der, der_len,
+		   LIMIT_INDEFINITE, 4);
+  if (result != ASN1_LIMIT_EXCEEDED)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  EXPLICIT tag cut, max_indefinite 4: %s\n\n",
+	      errorCounter, asn1_strerror (result));
+    }
+
+  asn1_delete_structure (&definitions);
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
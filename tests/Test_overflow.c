@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_overflow.c                             */
+/* Description: Test asn1_get_length_der and         */
+/*   asn1_get_tag_der on lengths and tags that do    */
+/*   not fit in the data or in an int.               */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+typedef struct
+{
+  const char *der;
+  int der_len;			/* of the data, length octets included */
+  long length;			/* returned */
+  int len;			/* octets of the length */
+} length_test;
+
+static const length_test length_tests[] = {
+  {"", 0, 0, 0},
+  {"\x05", 6, 5, 1},
+  {"\x05", 5, -4, 1},
+  {"\x81\x80", 130, 128, 2},
+  {"\x81\x80", 129, -4, 2},
+  {"\x82\x01\x00", 259, 256, 3},
+  {"\x82\x01\x00", 10, -4, 3},
+  {"\x80", 1, -1, 1},
+  /* INT_MAX fits, but not in the data */
+  {"\x84\x7f\xff\xff\xff", 5, -4, 5},
+  /* beyond INT_MAX */
+  {"\x84\x80\x00\x00\x00", 5, -2, 0},
+  {"\x85\x01\x00\x00\x00\x00", 6, -2, 0},
+  {"\x88\xff\xff\xff\xff\xff\xff\xff\xff", 9, -2, 0}
+};
+
+#define LENGTH_TESTS (sizeof (length_tests) / sizeof (length_tests[0]))
+
+typedef struct
+{
+  const char *der;
+  int der_len;
+  asn1_retCode result;
+  unsigned char cls;
+  int len;			/* octets of the tag */
+  unsigned long tag;
+} tag_test;
+
+static const tag_test tag_tests[] = {
+  {"\x02\x01", 2, ASN1_SUCCESS, 0, 1, 2},
+  {"\xa3\x00", 2, ASN1_SUCCESS, 0xa0, 1, 3},
+  {"\x1f\x81\x00\x00", 4, ASN1_SUCCESS, 0, 3, 128},
+  {"\x02", 1, ASN1_DER_ERROR},
+  /* the last octet of the tag is missing */
+  {"\x1f\x81", 2, ASN1_DER_ERROR},
+  {"\x1f\x81\x81", 3, ASN1_DER_ERROR},
+  /* beyond INT_MAX */
+  {"\x1f\x88\x80\x80\x80\x00\x00", 7, ASN1_DER_ERROR}
+};
+
+#define TAG_TESTS (sizeof (tag_tests) / sizeof (tag_tests[0]))
+
+int
+main (int argc, char *argv[])
+{
+  static unsigned char der[512];
+  int errorCounter = 0, testCounter = 0, len;
+  unsigned char cls;
+  unsigned long tag;
+  asn1_retCode result;
+  long length;
+  size_t k;
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_overflow    */\n");
+  printf ("/****************************************/\n\n");
+
+  /* The octets after the length are zero, and only those of der_len
+     may be read */
+  for (k = 0; k < LENGTH_TESTS; k++)
+    {
+      testCounter++;
+      memset (der, 0, sizeof (der));
+      memcpy (der, length_tests[k].der, strlen (length_tests[k].der));
+      length = asn1_get_length_der (der, length_tests[k].der_len, &len);
+      if (length != length_tests[k].length
+	  || (length != -2 && len != length_tests[k].len))
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  length %lu: %ld with %d octets, "
+		  "expected %ld with %d\n\n", errorCounter,
+		  (unsigned long) k, length, len, length_tests[k].length,
+		  length_tests[k].len);
+	}
+    }
+
+  for (k = 0; k < TAG_TESTS; k++)
+    {
+      testCounter++;
+      memset (der, 0, sizeof (der));
+      memcpy (der, tag_tests[k].der, tag_tests[k].der_len);
+      cls = 0;
+      len = 0;
+      tag = 0;
+      result = asn1_get_tag_der (der, tag_tests[k].der_len, &cls, &len,
+				 &tag);
+      if (result != tag_tests[k].result
+	  || (result == ASN1_SUCCESS
+	      && (cls != tag_tests[k].cls || len != tag_tests[k].len
+		  || tag != tag_tests[k].tag)))
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  tag %lu: %s, class %d, %d octets, "
+		  "tag %lu\n\n", errorCounter, (unsigned long) k,
+		  asn1_strerror (result), cls, len, tag);
+	}
+    }
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_threads.c                              */
+/* Description: Test that one definitions tree can   */
+/*   be shared by several threads calling            */
+/*     asn1_create_element,                          */
+/*     asn1_der_decoding,                            */
+/*     asn1_expand_any_defined_by,                   */
+/*     asn1_der_coding.                              */
+/*****************************************************/
+
+#include <config.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#define THREADS 8
+#define ITERATIONS 200
+
+typedef struct
+{
+  const char *type;
+  unsigned char der[10 * 1024];
+  int der_len;
+  /* results of a single threaded run */
+  asn1_retCode expand;
+  unsigned char coding[10 * 1024];
+  int coding_len;
+} sample_type;
+
+sample_type sample_array[] = {
+  {"PKIX1.Certificate"},
+  {"PKIX1.pkcs-12-PFX"}
+};
+
+#define SAMPLES (sizeof (sample_array) / sizeof (sample_array[0]))
+
+ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+
+static int
+read_sample (sample_type * sample, const char *file_name)
+{
+  FILE *fd;
+
+  fd = fopen (file_name, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", file_name);
+      return 1;
+    }
+  sample->der_len = fread (sample->der, 1, sizeof (sample->der), fd);
+  fclose (fd);
+
+  if (sample->der_len <= 0)
+    {
+      printf ("Cannot read from file %s\n", file_name);
+      return 1;
+    }
+
+  return 0;
+}
+
+/* Decode SAMPLE with the shared definitions, expand its ANY elements
+   and encode it again into CODING.  */
+static asn1_retCode
+process_sample (sample_type * sample, asn1_retCode * expand,
+		unsigned char *coding, int *coding_len)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  asn1_retCode result;
+
+  result = asn1_create_element (definitions, sample->type, &element);
+  if (result != ASN1_SUCCESS)
+    return result;
+
+  result = asn1_der_decoding (&element, sample->der, sample->der_len,
+			      errorDescription);
+  if (result == ASN1_SUCCESS)
+    {
+      *expand = asn1_expand_any_defined_by (definitions, &element);
+      result = asn1_der_coding (element, "", coding, coding_len,
+				errorDescription);
+    }
+
+  asn1_delete_structure (&element);
+
+  return result;
+}
+
+#ifdef HAVE_PTHREAD_H
+static void *
+worker (void *arg)
+{
+  unsigned char coding[10 * 1024];
+  int *errors = arg;
+  int coding_len, k;
+  unsigned int i;
+  asn1_retCode result, expand;
+
+  for (k = 0; k < ITERATIONS; k++)
+    for (i = 0; i < SAMPLES; i++)
+      {
+	coding_len = sizeof (coding);
+	expand = ASN1_SUCCESS;
+	result = process_sample (&sample_array[i], &expand, coding,
+				 &coding_len);
+	if (result != ASN1_SUCCESS || expand != sample_array[i].expand
+	    || coding_len != sample_array[i].coding_len
+	    || memcmp (coding, sample_array[i].coding, coding_len))
+	  (*errors)++;
+      }
+
+  return NULL;
+}
+#endif
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  int errorCounter = 0;
+  unsigned int i;
+  const char *treefile = getenv ("ASN1PKIX");
+  const char *certfile = getenv ("ASN1CRLF");
+  const char *indeffile = getenv ("ASN1INDEF");
+#ifdef HAVE_PTHREAD_H
+  pthread_t thread[THREADS];
+  int errors[THREADS];
+  int k;
+#endif
+
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+  if (!indeffile)
+    indeffile = "TestIndef.p12";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_threads     */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+#ifndef HAVE_PTHREAD_H
+  printf ("Threads are not supported, skipping.\n");
+  exit (77);
+#else
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  if (read_sample (&sample_array[0], certfile)
+      || read_sample (&sample_array[1], indeffile))
+    exit (1);
+
+  /* Reference results, computed by one thread */
+  for (i = 0; i < SAMPLES; i++)
+    {
+      sample_array[i].coding_len = sizeof (sample_array[i].coding);
+      result = process_sample (&sample_array[i], &sample_array[i].expand,
+			       sample_array[i].coding,
+			       &sample_array[i].coding_len);
+      if (result != ASN1_SUCCESS)
+	{
+	  printf ("Cannot process %s: %s\n", sample_array[i].type,
+		  asn1_strerror (result));
+	  exit (1);
+	}
+    }
+
+  for (k = 0; k < THREADS; k++)
+    {
+      errors[k] = 0;
+      if (pthread_create (&thread[k], NULL, worker, &errors[k]))
+	{
+	  printf ("Cannot create thread %d\n", k);
+	  exit (1);
+	}
+    }
+
+  for (k = 0; k < THREADS; k++)
+    {
+      pthread_join (thread[k], NULL);
+      if (errors[k])
+	{
+	  errorCounter++;
+	  printf ("ERROR N. %d:\n  thread %d: %d wrong results\n\n",
+		  errorCounter, k, errors[k]);
+	}
+    }
+
+  /* The definitions must still work after being shared */
+  errors[0] = 0;
+  worker (&errors[0]);
+  if (errors[0])
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  definitions changed: %d wrong results\n\n",
+	      errorCounter, errors[0]);
+    }
+
+  printf ("Total threads: %d\n", THREADS);
+  printf ("Total errors : %d\n", errorCounter);
+
+  asn1_delete_structure (&definitions);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+#endif
+}
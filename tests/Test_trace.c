@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: Test_trace.c                                */
+/* Description: Test the events reported to the     */
+/*   function set with asn1_set_trace_function.      */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "libtasn1.h"
+
+#define MAX_DEPTH 8
+
+typedef struct
+{
+  unsigned long count[ASN1_TRACE_EVENTS];	/* events received */
+  const char *running[MAX_DEPTH];	/* functions begun */
+  int depth;			/* number of them */
+  int max_depth;
+  int errors;			/* events out of order */
+  asn1_retCode result;		/* of the last ASN1_TRACE_END */
+  unsigned long end_count[ASN1_TRACE_EVENTS];	/* its counts */
+  int choice_named;		/* CHOICE alternatives with a name */
+} trace_type;
+
+static void
+trace_function (const asn1_trace_event * event, void *ctx)
+{
+  trace_type *trace = ctx;
+
+  trace->count[event->event]++;
+  if (event->depth != trace->depth - (event->event != ASN1_TRACE_BEGIN))
+    trace->errors++;
+
+  switch (event->event)
+    {
+    case ASN1_TRACE_BEGIN:
+      if (trace->depth == MAX_DEPTH)
+	{
+	  trace->errors++;
+	  break;
+	}
+      trace->running[trace->depth++] = event->function;
+      if (trace->depth > trace->max_depth)
+	trace->max_depth = trace->depth;
+      break;
+    case ASN1_TRACE_END:
+      if (trace->depth == 0
+	  || trace->running[--trace->depth] != event->function)
+	trace->errors++;
+      trace->result = event->result;
+      memcpy (trace->end_count, event->count, sizeof (trace->end_count));
+      break;
+    case ASN1_TRACE_CHOICE:
+      if (event->node != NULL && event->node->name != NULL)
+	trace->choice_named++;
+      /* fall through */
+    default:
+      if (trace->depth == 0 || event->node == NULL)
+	trace->errors++;
+      break;
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  asn1_retCode result, decoding;
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY, element = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  trace_type trace;
+  unsigned char der[4 * 1024], coding[4 * 1024];
+  int der_len, coding_len, errorCounter = 0, testCounter = 0, k;
+  FILE *fd;
+  const char *treefile = getenv ("ASN1PKIX");
+  const char *certfile = getenv ("ASN1CRLF");
+
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+
+  printf ("\n\n/****************************************/\n");
+  printf ("/*     Test sequence : Test_trace       */\n");
+  printf ("/****************************************/\n\n");
+  printf ("ASN1TREE: %s\n", treefile);
+
+  fd = fopen (certfile, "rb");
+  if (fd == NULL)
+    {
+      printf ("Cannot read file %s\n", certfile);
+      exit (1);
+    }
+  der_len = fread (der, 1, sizeof (der), fd);
+  fclose (fd);
+
+  result = asn1_parser2tree (treefile, &definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  memset (&trace, 0, sizeof (trace));
+  if (asn1_set_trace_function (trace_function, &trace) != ASN1_SUCCESS)
+    {
+      printf ("Tracing needs thread-local variables\n");
+      asn1_delete_structure (&definitions);
+      exit (77);
+    }
+
+  /* Creating reports the type instantiated */
+  testCounter++;
+  result = asn1_create_element (definitions, "PKIX1.Certificate", &element);
+  if (result != ASN1_SUCCESS || trace.count[ASN1_TRACE_BEGIN] != 1
+      || trace.count[ASN1_TRACE_END] != 1
+      || trace.count[ASN1_TRACE_NODE] == 0
+      || trace.end_count[ASN1_TRACE_NODE] != trace.count[ASN1_TRACE_NODE]
+      || trace.result != ASN1_SUCCESS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_create_element: %s, %lu nodes\n\n",
+	      errorCounter, asn1_strerror (result),
+	      trace.count[ASN1_TRACE_NODE]);
+    }
+
+  /* Decoding reports the CHOICE alternatives tried, counted from the
+     start of the call */
+  testCounter++;
+  memset (&trace.count, 0, sizeof (trace.count));
+  result = asn1_der_decoding (&element, der, der_len, errorDescription);
+  if (result != ASN1_SUCCESS || trace.count[ASN1_TRACE_CHOICE] == 0
+      || trace.choice_named != trace.count[ASN1_TRACE_CHOICE]
+      || trace.end_count[ASN1_TRACE_CHOICE] != trace.count[ASN1_TRACE_CHOICE]
+      || trace.end_count[ASN1_TRACE_BEGIN] != 1)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_der_decoding: %s, %lu alternatives\n\n",
+	      errorCounter, asn1_strerror (result),
+	      trace.count[ASN1_TRACE_CHOICE]);
+    }
+
+  /* The functions called by the library are nested */
+  testCounter++;
+  memset (&trace.count, 0, sizeof (trace.count));
+  trace.max_depth = 0;
+  asn1_expand_any_defined_by (definitions, &element);
+  if (trace.count[ASN1_TRACE_ANY] == 0 || trace.max_depth < 2
+      || trace.end_count[ASN1_TRACE_BEGIN] != trace.count[ASN1_TRACE_BEGIN])
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_expand_any_defined_by: %lu ANY, "
+	      "depth %d\n\n", errorCounter, trace.count[ASN1_TRACE_ANY],
+	      trace.max_depth);
+    }
+
+  testCounter++;
+  coding_len = sizeof (coding);
+  result = asn1_der_coding (element, "", coding, &coding_len,
+			    errorDescription);
+  if (result != ASN1_SUCCESS || trace.result != ASN1_SUCCESS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  asn1_der_coding: %s\n\n", errorCounter,
+	      asn1_strerror (result));
+    }
+  asn1_delete_structure (&element);
+
+  /* The end reports the error returned */
+  testCounter++;
+  asn1_create_element (definitions, "PKIX1.Certificate", &element);
+  decoding = asn1_der_decoding (&element, der, der_len / 2, NULL);
+  if (decoding == ASN1_SUCCESS || trace.result != decoding)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  truncated DER: %s reported as %s\n\n",
+	      errorCounter, asn1_strerror (decoding),
+	      asn1_strerror (trace.result));
+    }
+  asn1_delete_structure (&element);
+
+  testCounter++;
+  if (trace.errors != 0 || trace.depth != 0)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  %d events out of order\n\n", errorCounter,
+	      trace.errors);
+    }
+
+  /* No event once the function is removed */
+  testCounter++;
+  asn1_set_trace_function (NULL, NULL);
+  for (k = 0; k < ASN1_TRACE_EVENTS; k++)
+    trace.count[k] = 0;
+  asn1_create_element (definitions, "PKIX1.Certificate", &element);
+  asn1_delete_structure (&element);
+  for (k = 0; k < ASN1_TRACE_EVENTS; k++)
+    if (trace.count[k] != 0)
+      break;
+  if (k < ASN1_TRACE_EVENTS)
+    {
+      errorCounter++;
+      printf ("ERROR N. %d:\n  events without a function\n\n",
+	      errorCounter);
+    }
+
+  asn1_delete_structure (&definitions);
+
+  printf ("Total tests : %d\n", testCounter);
+  printf ("Total errors: %d\n", errorCounter);
+
+  if (errorCounter > 0)
+    return 1;
+
+  exit (0);
+}
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include "libtasn1.h"
 
 #include "Test_tree_asn1_tab.c"
@@ -59,7 +60,31 @@
 #define ACT_READ_BIT           19
 #define ACT_SET_DER            20
 #define ACT_DELETE_ELEMENT     21
+#define ACT_WRITE_OID_DER      22
+#define ACT_READ_OID_DER       23
+#define ACT_OID_DER            24
+#define ACT_OID_DER_CMP        25
+#define ACT_WRITE_TIME         26
+#define ACT_WRITE_TIME_TM      27
+#define ACT_READ_TIME          28
+#define ACT_WRITE_INT64        29
+#define ACT_READ_INT64         30
+#define ACT_WRITE_INT_MAG      31
+#define ACT_READ_INT_MAG       32
+#define ACT_ITERATE            33
+#define ACT_READ_FIELDS        34
+#define ACT_WRITE_FIELDS       35
+#define ACT_DECODING_OFFSETS   36
+#define ACT_READ_DER_OFFSETS   37
+#define ACT_DECODING_ERROR     38
+#define ACT_PRINT_JSON         39
+#define ACT_DECODING_KEEP_DER  40
+#define ACT_ENCODING_CMP       41
 
+/* Twenty arcs 999999, whose dotted form is longer than 128 bytes */
+#define ARCS_5 "\xbd\x84\x3f\xbd\x84\x3f\xbd\x84\x3f" \
+  "\xbd\x84\x3f\xbd\x84\x3f"
+#define ARCS_20 ARCS_5 ARCS_5 ARCS_5 ARCS_5
 
 typedef struct
 {
@@ -70,6 +95,130 @@ typedef struct
   int errorNumber;
 } test_type;
 
+/* Fields of TEST_TREE.Sequence1 read by ACT_READ_FIELDS */
+typedef struct
+{
+  int64_t int1, int2, seq1;
+  char id[32];
+  int id_len;
+  unsigned char oct[8];
+  int oct_len;
+  unsigned char any1[8];
+  int any1_len;
+  const int64_t *seq;
+  int seq_len;
+} fields_type;
+
+#define FIELD_BUFFER(f) offsetof (fields_type, f), \
+    sizeof (((fields_type *) 0)->f), offsetof (fields_type, f##_len)
+
+static const asn1_field fields_array[] = {
+  {"int1", ASN1_FIELD_INT64, offsetof (fields_type, int1)},
+  {"int2", ASN1_FIELD_INT64, offsetof (fields_type, int2)},
+  {"seq.?1", ASN1_FIELD_INT64 | ASN1_FIELD_OPTIONAL,
+   offsetof (fields_type, seq1)},
+  {"id", ASN1_FIELD_VALUE, FIELD_BUFFER (id)},
+  {"oct", ASN1_FIELD_VALUE, FIELD_BUFFER (oct)},
+  {"any1", ASN1_FIELD_VALUE | ASN1_FIELD_OPTIONAL, FIELD_BUFFER (any1)},
+  /* searched again after the following elements */
+  {"seq.?1", ASN1_FIELD_INT64, offsetof (fields_type, seq1)}
+};
+
+static const asn1_field seq_item_fields[] = {
+  {"", ASN1_FIELD_INT64, 0}
+};
+
+static const asn1_field write_fields_array[] = {
+  {"int1", ASN1_FIELD_INT64, offsetof (fields_type, int1)},
+  {"int2", ASN1_FIELD_INT64, offsetof (fields_type, int2)},
+  {"seq", ASN1_FIELD_SEQUENCE_OF, offsetof (fields_type, seq),
+   sizeof (int64_t), offsetof (fields_type, seq_len), seq_item_fields, 1},
+  {"id", ASN1_FIELD_VALUE, FIELD_BUFFER (id)},
+  {"oct", ASN1_FIELD_VALUE, FIELD_BUFFER (oct)},
+  {"any1", ASN1_FIELD_VALUE | ASN1_FIELD_OPTIONAL, FIELD_BUFFER (any1)},
+  /* not OPTIONAL, so the missing value is an error */
+  {"any1", ASN1_FIELD_VALUE, FIELD_BUFFER (any1)}
+};
+
+static const int64_t seq_values[] = { 3, 1, 2 };
+
+/* Writing no value deletes an OPTIONAL element, which must not be
+   the starting point of the search of the next field */
+typedef struct
+{
+  const unsigned char *issuer;
+  int issuer_len;
+  const unsigned char *subject;
+  int subject_len;
+} unique_ids_type;
+
+static const asn1_field unique_ids_fields[] = {
+  {"tbsCertificate.issuerUniqueID", ASN1_FIELD_VALUE | ASN1_FIELD_POINTER,
+   offsetof (unique_ids_type, issuer), 0,
+   offsetof (unique_ids_type, issuer_len)},
+  {"tbsCertificate.subjectUniqueID", ASN1_FIELD_VALUE | ASN1_FIELD_POINTER,
+   offsetof (unique_ids_type, subject), 0,
+   offsetof (unique_ids_type, subject_len)}
+};
+
+/* Writes unique_ids_fields into a PKIX1.Certificate of PKIXFILE.
+   Returns the number of errors.  */
+static int
+test_unique_ids (const char *pkixfile)
+{
+  ASN1_TYPE pkix = ASN1_TYPE_EMPTY, cert = ASN1_TYPE_EMPTY;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  unique_ids_type ids;
+  unsigned char value[8];
+  int len, errors = 0;
+  asn1_retCode result;
+
+  result = asn1_parser2tree (pkixfile, &pkix, errorDescription);
+  if (result == ASN1_SUCCESS)
+    result = asn1_create_element (pkix, "PKIX1.Certificate", &cert);
+  if (result != ASN1_SUCCESS)
+    {
+      printf ("ERROR:\n  %s: %s\n\n", pkixfile, asn1_strerror (result));
+      asn1_delete_structure (&pkix);
+      return 1;
+    }
+
+  ids.issuer = NULL;
+  ids.issuer_len = 0;
+  ids.subject = (const unsigned char *) "\xa5";
+  ids.subject_len = 8;
+  result = asn1_write_fields (cert, unique_ids_fields, 2, &ids,
+			      errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      errors++;
+      printf ("ERROR:\n  write fields: %s %s\n\n", asn1_strerror (result),
+	      errorDescription);
+    }
+
+  len = sizeof (value);
+  result = asn1_read_value (cert, "tbsCertificate.subjectUniqueID", value,
+			    &len);
+  if (result != ASN1_SUCCESS || len != 8 || value[0] != 0xa5)
+    {
+      errors++;
+      printf ("ERROR:\n  subjectUniqueID: %s\n\n", asn1_strerror (result));
+    }
+
+  len = sizeof (value);
+  result = asn1_read_value (cert, "tbsCertificate.issuerUniqueID", value,
+			    &len);
+  if (result != ASN1_ELEMENT_NOT_FOUND)
+    {
+      errors++;
+      printf ("ERROR:\n  issuerUniqueID: %s\n\n", asn1_strerror (result));
+    }
+
+  asn1_delete_structure (&cert);
+  asn1_delete_structure (&pkix);
+
+  return errors;
+}
 
 test_type test_array[] = {
 
@@ -125,6 +274,10 @@ test_type test_array[] = {
   {ACT_WRITE, "issuer.rdnSequence.?LAST.value",
    "\x16\x19\x65\x64\x75\x61\x72\x64\x6f\x40\x6c\x61\x73\x2e\x69\x63\x2e\x75\x6e\x69\x63\x61\x6d\x70\x2e\x62\x72",
    27, ASN1_SUCCESS},
+  {ACT_ITERATE, "issuer.rdnSequence.?.type", "2.5.4.3,2.5.4.7,2.5.4.6,"
+   "2.5.4.10,2.5.4.11,2.5.4.8,1.2.840.113549.1.9.1", 7, ASN1_SUCCESS},
+  {ACT_ITERATE, "issuer.rdnSequence.?.none", "", 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_ITERATE, "issuer.?", "", 0, ASN1_SUCCESS},
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
   {ACT_ENCODING_LENGTH, "", 0, 152, ASN1_MEM_ERROR},
   {ACT_ENCODING, "", 0, 151, ASN1_MEM_ERROR},
@@ -141,6 +294,25 @@ test_type test_array[] = {
   {ACT_DELETE_ELEMENT, "issuer.rdnSequence.?5", "", 0, ASN1_SUCCESS},
   {ACT_DELETE_ELEMENT, "issuer.rdnSequence.?7", "", 0, ASN1_SUCCESS},
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
+  /* the elements left keep their father, also once the first and the
+     last are deleted and another added */
+  {ACT_NUMBER_OF_ELEMENTS, "issuer.rdnSequence", "", 3, ASN1_SUCCESS},
+  {ACT_ITERATE, "issuer.rdnSequence.?.type", "2.5.4.7,2.5.4.10,2.5.4.8",
+   3, ASN1_SUCCESS},
+  {ACT_DELETE_ELEMENT, "issuer.rdnSequence.?LAST", "", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "issuer.rdnSequence", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "issuer.rdnSequence.?LAST.type", "2.5.4.3", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "issuer.rdnSequence.?LAST.value", "\x13\x01\x61", 3,
+   ASN1_SUCCESS},
+  {ACT_DELETE_ELEMENT, "issuer.rdnSequence.?2", "", 0, ASN1_SUCCESS},
+  {ACT_ITERATE, "issuer.rdnSequence.?.type", "2.5.4.10,2.5.4.3", 2,
+   ASN1_SUCCESS},
+  {ACT_ENCODING, "", 0, 1024, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.CertTemplate", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_ITERATE, "issuer.rdnSequence.?.type", "2.5.4.3,2.5.4.10", 2,
+   ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
   /* Test: Empty sequnces */
@@ -158,8 +330,27 @@ test_type test_array[] = {
   {ACT_DECODING_START_END, "seq1", "END", 6, ASN1_SUCCESS},
   {ACT_DECODING_START_END, "set1", "START", 7, ASN1_SUCCESS},
   {ACT_DECODING_START_END, "set1", "END", 10, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1", "", 0, ASN1_VALUE_NOT_FOUND},
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.sequenceEmpty", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_OFFSETS, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "", "START", 0, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "", "END", 10, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "int1", "START", 2, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "int1", "END", 4, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1", "START", 5, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1", "END", 6, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "START", 7, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "END", 10, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1.int", "", 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_WRITE, "int1", "2000", 0, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "int1", "END", 4, ASN1_SUCCESS},
+  /* encoding moves set1, not its decoded position */
+  {ACT_ENCODING, "", 0, 64, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "START", 7, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "END", 10, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
   /* Test: Indefinite Length */
   {ACT_CREATE, "TEST_TREE.IndefiniteLengthTest", 0, 0, ASN1_SUCCESS},
@@ -181,8 +372,56 @@ test_type test_array[] = {
   {ACT_DECODING_START_END, "seq1", "END", 8, ASN1_SUCCESS},
   {ACT_DECODING_START_END, "set1", "START", 9, ASN1_SUCCESS},
   {ACT_DECODING_START_END, "set1", "END", 22, ASN1_SUCCESS},
+  {ACT_ITERATE, "set1.?", "1.2.3.4,1.2.5.6", 2, ASN1_SUCCESS},
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.IndefiniteLengthTest", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_OFFSETS, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1", "START", 2, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "seq1", "END", 8, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "START", 9, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1", "END", 22, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1.?2", "START", 16, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "set1.?2", "END", 20, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "int1", "START", 23, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "", "END", 25, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* the encodings kept by asn1_der_coding go when an element under
+     them changes, though the decoded spans did not match them */
+  {ACT_CREATE, "TEST_TREE.IndefiniteLengthTest", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_OFFSETS, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x14\xa1\x03\x02\x01\x02\x31\x0a\x06\x03"
+   "\x2a\x03\x04\x06\x03\x2a\x05\x06\x02\x01\x01", 22, ASN1_SUCCESS},
+  {ACT_WRITE, "seq1.int", "3", 0, ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x14\xa1\x03\x02\x01\x03\x31\x0a\x06\x03"
+   "\x2a\x03\x04\x06\x03\x2a\x05\x06\x02\x01\x01", 22, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* a SET OF out of order: the items move, the SET OF keeps its span */
+  {ACT_SET_DER, "\x30\x16\xa3\x14\x30\x08\x06\x03\x55\x04\x06\x13\x01"
+   "\x62\x30\x08\x06\x03\x55\x04\x03\x0c\x01\x61", 0, 24, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.CertTemplate", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_OFFSETS, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x16\xa3\x14\x30\x08\x06\x03\x55\x04\x03"
+   "\x0c\x01\x61\x30\x08\x06\x03\x55\x04\x06\x13\x01\x62", 24,
+   ASN1_SUCCESS},
+  {ACT_WRITE, "issuer.rdnSequence.?1.value", "\x13\x01\x63", 3,
+   ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x16\xa3\x14\x30\x08\x06\x03\x55\x04\x03"
+   "\x0c\x01\x61\x30\x08\x06\x03\x55\x04\x06\x13\x01\x63", 24,
+   ASN1_SUCCESS},
+  {ACT_DELETE_ELEMENT, "issuer.rdnSequence.?2", "", 0, ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x0c\xa3\x0a\x30\x08\x06\x03\x55\x04\x06"
+   "\x13\x01\x63", 14, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* the same without the offsets, encoded once */
+  {ACT_CREATE, "TEST_TREE.CertTemplate", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE, "issuer.rdnSequence.?1.value", "\x13\x01\x63", 3,
+   ASN1_SUCCESS},
+  {ACT_ENCODING_CMP, "", "\x30\x16\xa3\x14\x30\x08\x06\x03\x55\x04\x03"
+   "\x0c\x01\x61\x30\x08\x06\x03\x55\x04\x06\x13\x01\x63", 24,
+   ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
   /* Test: OID */
   {ACT_CREATE, "TEST_TREE.OidTest", 0, 0, ASN1_SUCCESS},
@@ -208,6 +447,51 @@ test_type test_array[] = {
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
+  /* Test: OID as DER content octets */
+  {ACT_CREATE, "TEST_TREE.OidTest", 0, 0, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid", "\x55\x1d\x02", 3, ASN1_SUCCESS},
+  {ACT_WRITE_OID_DER, "oid", "\x2a\x03\x04", 3, ASN1_SUCCESS},
+  {ACT_READ, "oid", "1.2.3.4", 8, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid", "\x2a\x03\x04", 3, ASN1_SUCCESS},
+  {ACT_WRITE_OID_DER, "oid", "\x2a\x83", 2, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_OID_DER, "oid", "\x2a\x80\x01", 3, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_OID_DER, "oid2", "\x55\x1d\x01", 3, ASN1_SUCCESS},
+  {ACT_WRITE_OID_DER, "", "\x55\x1d\x01", 3, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_ENCODING, "", 0, 1024, ASN1_SUCCESS},
+  {ACT_PRINT_DER, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.OidTest", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid", "\x2a\x03\x04", 3, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid2", "\x55\x1d\x01", 3, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid3", "\x2a\x1d\x02", 3, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* the decoded octets are returned as they are, even when the dotted
+     form is too long to be decoded whole, until another value is
+     written */
+  {ACT_CREATE, "TEST_TREE.OidTest", 0, 0, ASN1_SUCCESS},
+  {ACT_SET_DER, "\x30\x3f\x81\x3d\x2a" ARCS_20, 0, 65, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid", "\x2a" ARCS_20, 61, ASN1_SUCCESS},
+  {ACT_WRITE, "oid", "1.2.3.5", 0, ASN1_SUCCESS},
+  {ACT_READ_OID_DER, "oid", "\x2a\x03\x05", 3, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_OID_DER, "1.2.840.113549", "\x2a\x86\x48\x86\xf7\x0d", 6,
+   ASN1_SUCCESS},
+  {ACT_OID_DER, "2.999.3", "\x88\x37\x03", 3, ASN1_SUCCESS},
+  {ACT_OID_DER, "0.39.4294967295", 0, 0, ASN1_SUCCESS},
+  {ACT_OID_DER, "1.40", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_OID_DER, "3.1", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_OID_DER, "1", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_OID_DER, "1.2.", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_OID_DER, "1..2", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_OID_DER_CMP, "1.2.3", "1.2.3", 0, ASN1_SUCCESS},
+  {ACT_OID_DER_CMP, "1.2.3", "1.2.3.1", -1, ASN1_SUCCESS},
+  {ACT_OID_DER_CMP, "1.2.200", "1.2.3", 1, ASN1_SUCCESS},
+  {ACT_OID_DER_CMP, "1.2.200", "1.2.201.5", -1, ASN1_SUCCESS},
+  {ACT_OID_DER_CMP, "1.39", "2.0", -1, ASN1_SUCCESS},
+  {ACT_OID_DER_CMP, "2.100", "2.99.1", 1, ASN1_SUCCESS},
+
   /* Test: ENCODING_LENGTH and READ_LEN */
   {ACT_CREATE, "TEST_TREE.OidAndTimeTest", 0, 0, ASN1_SUCCESS},
   {ACT_WRITE, "oid", "1.2.3.4", 0, ASN1_SUCCESS},
@@ -241,12 +525,238 @@ test_type test_array[] = {
   {ACT_CREATE, "TEST_TREE.OidAndTimeTest", 0, 0, ASN1_SUCCESS},
   {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
+
+  /* Test: time values */
+  {ACT_READ_TIME, "time1", "19980101120000", 883656000, ASN1_SUCCESS},
+  {ACT_READ_TIME, "time2", 0, 0, ASN1_VALUE_NOT_VALID},
+  {ACT_READ_TIME, "oid", 0, 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_WRITE, "time2", "20010101120001.12-0700", 1, ASN1_SUCCESS},
+  {ACT_READ_TIME, "time2", "20010101190001", 978375601, ASN1_SUCCESS},
+  {ACT_WRITE, "time2", "2001010112+0130", 1, ASN1_SUCCESS},
+  {ACT_READ_TIME, "time2", "20010101103000", 978345000, ASN1_SUCCESS},
+  {ACT_WRITE_TIME, "time2", 0, 978375601, ASN1_SUCCESS},
+  {ACT_READ, "time2", "20010101190001Z", 16, ASN1_SUCCESS},
+  {ACT_WRITE_TIME, "time1", 0, -1, ASN1_SUCCESS},
+  {ACT_READ, "time1", "691231235959Z", 14, ASN1_SUCCESS},
+  {ACT_READ_TIME, "time1", "19691231235959", -1, ASN1_SUCCESS},
+  {ACT_WRITE_TIME_TM, "time1", "20500101000000", 0, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_TIME_TM, "time2", "20501301000000", 0, ASN1_SUCCESS},
+  {ACT_READ, "time2", "20510101000000Z", 16, ASN1_SUCCESS},
+  {ACT_WRITE_TIME_TM, "time2", "20000229240000", 0, ASN1_SUCCESS},
+  {ACT_READ, "time2", "20000301000000Z", 16, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Validity", 0, 0, ASN1_SUCCESS},
+  {ACT_READ_TIME, "notBefore", 0, 0, ASN1_VALUE_NOT_FOUND},
+  {ACT_WRITE_TIME, "notBefore", 0, 883656000, ASN1_SUCCESS},
+  {ACT_WRITE_TIME_TM, "notAfter", "20500101000000", 0, ASN1_SUCCESS},
+  {ACT_READ, "notBefore.utcTime", "980101120000Z", 14, ASN1_SUCCESS},
+  {ACT_READ, "notAfter.generalTime", "20500101000000Z", 16, ASN1_SUCCESS},
+  {ACT_ENCODING, "", 0, 1024, ASN1_SUCCESS},
+  {ACT_PRINT_DER, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Validity", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_TIME, "notBefore", "19980101120000", 883656000, ASN1_SUCCESS},
+  {ACT_READ_TIME, "notAfter", "20500101000000", 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Validity", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_OFFSETS, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "notBefore", "START", 2, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "notBefore", "END", 16, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "notAfter.generalTime", "START", 17, ASN1_SUCCESS},
+  {ACT_READ_DER_OFFSETS, "notAfter", "END", 33, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+
+  /* Test: native integers */
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int1", "1", 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", 0, 0, ASN1_VALUE_NOT_FOUND},
+  {ACT_READ_INT64, "seq", 0, 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_WRITE_INT64, "int2", "128", 0, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\x00\x80", 2, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", "128", 0, ASN1_SUCCESS},
+  {ACT_WRITE_INT64, "int2", "-129", 0, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\xff\x7f", 2, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", "-129", 0, ASN1_SUCCESS},
+  {ACT_WRITE_INT64, "int2", "-9223372036854775808", 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", "-9223372036854775808", 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", 0, 1, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_INT64, "int2", "18446744073709551615", 1, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\x00\xff\xff\xff\xff\xff\xff\xff\xff", 9,
+   ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", "18446744073709551615", 1, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", 0, 0, ASN1_MEM_ERROR},
+  {ACT_WRITE, "int2", "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x05", 10,
+   ASN1_SUCCESS},
+  {ACT_READ_INT64, "int2", "5", 0, ASN1_SUCCESS},
+  {ACT_WRITE_INT64, "int1", "1", 0, ASN1_SUCCESS},
+  {ACT_READ_LENGTH, "int1", NULL, 1, ASN1_MEM_ERROR},
+  {ACT_WRITE_INT64, "int1", "2", 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int1", "2", 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_SET_DER, "\x30\x0e\x80\x01\x01\x02\x01\x05\x31\x00\x06\x02"
+   "\x2a\x03\x04\x00", 0, 16, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "int1", "1", 0, ASN1_SUCCESS},
+  {ACT_ENCODING_LENGTH, "", 0, 13, ASN1_MEM_ERROR},
+  {ACT_WRITE, "int1", "v3", 0, ASN1_SUCCESS},
+  {ACT_ENCODING_LENGTH, "", 0, 16, ASN1_MEM_ERROR},
+  {ACT_READ_FIELDS, 0, "2,5,-1,1.2.3,0,-1", 6, ASN1_SUCCESS},
+  {ACT_READ_FIELDS, 0, "seq.?1", 7, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_WRITE, "seq", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "seq.?LAST", "7", 0, ASN1_SUCCESS},
+  {ACT_READ_FIELDS, 0, "2,5,7,1.2.3,0,-1", 7, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* a decoded structure encodes its changes, not the input */
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_KEEP_DER, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE, "seq", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "seq.?LAST", "7", 0, ASN1_SUCCESS},
+  {ACT_ENCODING_LENGTH, "", 0, 16, ASN1_MEM_ERROR},
+  {ACT_ENCODING, "", 0, 16, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_KEEP_DER, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_FIELDS, 0, "1,5,7,1.2.3,0,-1", 7, ASN1_SUCCESS},
+  {ACT_WRITE, "int2", "6", 0, ASN1_SUCCESS},
+  {ACT_ENCODING, "", 0, 16, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ_FIELDS, 0, "1,6,7,1.2.3,0,-1", 7, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE_FIELDS, 0, "", 6, ASN1_SUCCESS},
+  {ACT_NUMBER_OF_ELEMENTS, "seq", "", 3, ASN1_SUCCESS},
+  {ACT_READ_LENGTH, "int1", NULL, 1, ASN1_MEM_ERROR},
+  {ACT_READ_FIELDS, 0, "1,-20000000000,3,1.2.3.4,2,-1", 6, ASN1_SUCCESS},
+  {ACT_ENCODING, "", 0, 1024, ASN1_SUCCESS},
+  {ACT_PRINT_DER, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  /* the SET OF items come back in DER order */
+  {ACT_READ_FIELDS, 0, "1,-20000000000,1,1.2.3.4,2,-1", 6, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE_FIELDS, 0, "any1", 7, ASN1_VALUE_NOT_FOUND},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.OidAndTimeTest", 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE_INT64, "enum", "-1", 0, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_INT64, "enum", "2", 0, ASN1_SUCCESS},
+  {ACT_READ_INT64, "enum", "2", 1, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "enum", "\x01", -1, ASN1_VALUE_NOT_VALID},
+  {ACT_WRITE_INT_MAG, "enum", "\x00\x00", -2, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "enum", "", 0, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+
+  /* Test: JSON */
+  {ACT_CREATE, "TEST_TREE.OidAndTimeTest", 0, 0, ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "", "{\"set\":[],\"bol2\":true,\"enum\":1}", 0,
+   ASN1_SUCCESS},
+  {ACT_WRITE, "set", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set.?LAST", "-129", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set.?LAST", "\x01\x00\x00\x00\x00\x00\x00\x00\x00", 9,
+   ASN1_SUCCESS},
+  {ACT_WRITE, "oid", "1.2.3.4", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "time2", "2001010112001.12-0700", 1, ASN1_SUCCESS},
+  {ACT_WRITE, "bol", "FALSE", 1, ASN1_SUCCESS},
+  {ACT_WRITE, "oct", "\x00\"\xff", 3, ASN1_SUCCESS},
+  {ACT_WRITE, "bit", "\xe0", 3, ASN1_SUCCESS},
+  {ACT_WRITE, "any", "\x05\x00", 2, ASN1_SUCCESS},
+  {ACT_WRITE, "time1", "9801011200Z", 1, ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "",
+   "{\"set\":[-129,\"18446744073709551616\"],\"oid\":\"1.2.3.4\","
+   "\"time2\":\"2001010112001.12-0700\",\"bol\":false,"
+   "\"oct\":\"0022ff\",\"bit\":{\"bits\":3,\"data\":\"e0\"},"
+   "\"bol2\":true,\"enum\":1,\"any\":\"0500\","
+   "\"time1\":\"9801011200Z\"}", 0, ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "oct", "\"ACL/\"", ASN1_JSON_BASE64,
+   ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "set", "[\n  -129,\n  \"18446744073709551616\"\n]",
+   ASN1_JSON_INDENT, ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "gen", "null", 0, ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "none", "", 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.OidAndTimeTest", 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set.?LAST", "\x1f\xff\xff\xff\xff\xff\xff", 7,
+   ASN1_SUCCESS},
+  {ACT_WRITE, "set", "NEW", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "set.?LAST", "\xe0\x00\x00\x00\x00\x00\x00", 7,
+   ASN1_SUCCESS},
+  /* 2^53 - 1, and -2^53 as a string */
+  {ACT_PRINT_JSON, "set", "[9007199254740991,\"-9007199254740992\"]", 0,
+   ASN1_SUCCESS},
+  /* a character, a byte out of a sequence, an overlong one and a
+     surrogate */
+  {ACT_WRITE, "time2", "2001\xc3\xa9" "\xff" "\xc0\xaf" "\xed\xa0\x80", 1,
+   ASN1_SUCCESS},
+  {ACT_PRINT_JSON, "time2",
+   "\"2001\xc3\xa9\\u00ff\\u00c0\\u00af\\u00ed\\u00a0\\u0080\"", 0,
+   ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Validity", 0, 0, ASN1_SUCCESS},
+  {ACT_WRITE, "notBefore", "utcTime", 0, ASN1_SUCCESS},
+  {ACT_WRITE, "notBefore.utcTime", "980101120000Z", 1, ASN1_SUCCESS},
+  /* an alternative not chosen yet */
+  {ACT_PRINT_JSON, "",
+   "{\n  \"notBefore\": {\n    \"utcTime\": \"980101120000Z\"\n  },\n"
+   "  \"notAfter\": null\n}", ASN1_JSON_INDENT, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+
+  /* Test: integers as magnitude and sign */
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int1", "\x01", 1, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", 0, 0, ASN1_VALUE_NOT_FOUND},
+  {ACT_READ_INT_MAG, "seq", 0, 0, ASN1_ELEMENT_NOT_FOUND},
+  {ACT_WRITE_INT_MAG, "int2", "\x00\x80", 2, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\x00\x80", 2, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x80", 1, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x80", -1, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x80", -1, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x81", -1, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\xff\x7f", 2, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x81", -1, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x01\x00", -2, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\xff\x00", 2, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x01\x00", -2, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x80\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00\x00\x00", -17, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\x80\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00", 17, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x80\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00\x00\x00", -17, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x80\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00\x00\x01", -17, ASN1_SUCCESS},
+  {ACT_READ, "int2", "\xff\x7f\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+   "\xff\xff\xff\xff\xff\xff\xff", 18, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x80\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00\x00\x01", -17, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int2", "\x00\xc1\x02\x03\x04\x05\x06\x07\x08"
+   "\x09\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14", 21,
+   ASN1_SUCCESS},
+  {ACT_READ, "int2", "\x00\xc1\x02\x03\x04\x05\x06\x07\x08\x09\x0a"
+   "\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14", 21, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\xc1\x02\x03\x04\x05\x06\x07\x08\x09"
+   "\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\x13\x14", 20, ASN1_SUCCESS},
+  {ACT_WRITE, "int2", "\xff\xff\xfe\x3f\xfd", 5, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int2", "\x01\xc0\x03", -3, ASN1_SUCCESS},
+  {ACT_WRITE_INT_MAG, "int1", "\x01", 1, ASN1_SUCCESS},
+  {ACT_READ_LENGTH, "int1", NULL, 1, ASN1_MEM_ERROR},
+  {ACT_WRITE_INT_MAG, "int1", "", 0, ASN1_SUCCESS},
+  {ACT_READ_INT_MAG, "int1", "", 0, ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
   /* Test: OID to STRUCTURE */
   {ACT_OID_2_STRUCTURE, "2.5.29.3", "", 0, ASN1_ELEMENT_NOT_FOUND},
   {ACT_OID_2_STRUCTURE, "1.2.29.2", "", 0, ASN1_ELEMENT_NOT_FOUND},
   {ACT_OID_2_STRUCTURE, "2.5.29.2", "anyTest2", 0, ASN1_SUCCESS},
+  {ACT_OID_2_STRUCTURE, "2.5.29.1", "id-anyTest2", 0, ASN1_SUCCESS},
+  {ACT_OID_2_STRUCTURE, "1.2.3.4", "Sequence_octetTest1", 0, ASN1_SUCCESS},
+  {ACT_OID_2_STRUCTURE, "2.5.29", "", 0, ASN1_ELEMENT_NOT_FOUND},
 
   /* Test: READ TAG and CLASS */
   {ACT_CREATE, "TEST_TREE.SequenceTestTag", 0, 0, ASN1_SUCCESS},
@@ -424,6 +934,44 @@ test_type test_array[] = {
   {ACT_VISIT, "", "", ASN1_PRINT_ALL, ASN1_SUCCESS},
   {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
 
+  /* Test: constructed OCTET STRING, made of segments */
+  {ACT_SET_DER, "\x24\x08\x04\x02\x61\x62\x04\x02\x63\x64", 0, 10,
+   ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.AnyTest2", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ, "str", "abcd", 4, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  {ACT_SET_DER, "\x24\x80\x04\x01\x61\x04\x03\x62\x63\x64\x00\x00",
+   0, 12, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.AnyTest2", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_SUCCESS},
+  {ACT_READ, "str", "abcd", 4, ASN1_SUCCESS},
+  {ACT_DELETE, "", "", 0, ASN1_SUCCESS},
+  /* a segment past the string */
+  {ACT_SET_DER, "\x24\x04\x04\x03\x61\x62\x63", 0, 7, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.AnyTest2", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_DER_ERROR},
+  /* no end-of-contents */
+  {ACT_SET_DER, "\x24\x80\x04\x01\x61", 0, 5, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.AnyTest2", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_DER_ERROR},
+  /* a segment that is not an OCTET STRING */
+  {ACT_SET_DER, "\x24\x03\x02\x01\x01", 0, 5, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.AnyTest2", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING, 0, 0, 0, ASN1_DER_ERROR},
+
+  /* Test: error context */
+  {ACT_SET_DER, "\x30\x09\x02\x01\x01\xa3\x00\xa2\x02\x31\x00", 0, 11,
+   ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.sequenceEmpty", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_ERROR, "seq1", "128,1,160,3", 5, ASN1_TAG_ERROR},
+  {ACT_SET_DER, "\x30\x03\x02\x05\x01", 0, 5, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.Sequence1", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_ERROR, "int2", "0,2,0,5", 3, ASN1_DER_ERROR},
+  {ACT_SET_DER, "\x30\x03\x04\x01\x00", 0, 5, ASN1_SUCCESS},
+  {ACT_CREATE, "TEST_TREE.sequenceEmpty", 0, 0, ASN1_SUCCESS},
+  {ACT_DECODING_ERROR, "int1", "0,2,0,4", 2, ASN1_TAG_ERROR},
+
   /* end */
   {ACT_NULL}
 
@@ -437,18 +985,34 @@ main (int argc, char *argv[])
   ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
   ASN1_TYPE asn1_element = ASN1_TYPE_EMPTY;
   char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
-  FILE *out;
+  FILE *out, *json;
   test_type *test;
   int errorCounter = 0, testCounter = 0, der_len;
   unsigned char value[1024], der[1024];
   int valueLen, tag = 0, class = 0;
   int k;
   int start, end;
+  asn1_error error;
+  int expected_class, found_class;
+  unsigned long expected_tag, found_tag;
+  char error_name[ASN1_MAX_NAME_SIZE + 1];
   const char *str_p = NULL;
+  struct tm tm;
+  time_t t;
+  int64_t ival;
+  uint64_t uval;
+  int negative;
+  const unsigned char *magnitude;
+  ASN1_TYPE node;
+  char path[128], element_value[128], *component;
+  fields_type fields;
   const char *treefile = getenv ("ASN1TREE");
+  const char *pkixfile = getenv ("ASN1PKIX");
 
   if (!treefile)
     treefile = "Test_tree.asn";
+  if (!pkixfile)
+    pkixfile = "pkix.asn";
 
   printf ("\n\n/****************************************/\n");
   printf ("/*     Test sequence : Test_tree        */\n");
@@ -523,6 +1087,172 @@ main (int argc, char *argv[])
 	  result =
 	    asn1_read_value (asn1_element, test->par1, value, &valueLen);
 	  break;
+	case ACT_READ_OID_DER:
+	  valueLen = sizeof (value);
+	  result =
+	    asn1_read_oid_der (asn1_element, test->par1, value, &valueLen);
+	  break;
+	case ACT_WRITE_OID_DER:
+	  result =
+	    asn1_write_oid_der (asn1_element, test->par1, test->par2,
+				test->par3);
+	  break;
+	case ACT_OID_DER:
+	  der_len = sizeof (der);
+	  result = asn1_oid_der (test->par1, der, &der_len);
+	  if (result == ASN1_SUCCESS)
+	    {
+	      valueLen = sizeof (value);
+	      result = asn1_get_oid_der (der, der_len, (char *) value,
+					 &valueLen);
+	    }
+	  break;
+	case ACT_OID_DER_CMP:
+	  der_len = sizeof (der);
+	  valueLen = sizeof (value);
+	  result = asn1_oid_der (test->par1, der, &der_len);
+	  if (result == ASN1_SUCCESS)
+	    result = asn1_oid_der ((char *) test->par2, value, &valueLen);
+	  if (result == ASN1_SUCCESS)
+	    {
+	      k = asn1_oid_der_cmp (der, der_len, value, valueLen);
+	      /* the comparison is antisymmetric */
+	      if (k != -asn1_oid_der_cmp (value, valueLen, der, der_len))
+		result = ASN1_GENERIC_ERROR;
+	    }
+	  break;
+	case ACT_WRITE_TIME:
+	  result = asn1_write_time (asn1_element, test->par1, test->par3);
+	  break;
+	case ACT_WRITE_TIME_TM:
+	  memset (&tm, 0, sizeof (tm));
+	  sscanf ((char *) test->par2, "%4d%2d%2d%2d%2d%2d", &tm.tm_year,
+		  &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min,
+		  &tm.tm_sec);
+	  tm.tm_year -= 1900;
+	  tm.tm_mon--;
+	  result = asn1_write_time_tm (asn1_element, test->par1, &tm);
+	  break;
+	case ACT_READ_TIME:
+	  t = 0;
+	  memset (&tm, 0, sizeof (tm));
+	  result = asn1_read_time_tm (asn1_element, test->par1, &tm);
+	  if (result == ASN1_SUCCESS && test->par3)
+	    result = asn1_read_time (asn1_element, test->par1, &t);
+	  sprintf ((char *) value, "%04d%02d%02d%02d%02d%02d",
+		   tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour,
+		   tm.tm_min, tm.tm_sec);
+	  break;
+	case ACT_WRITE_INT64:
+	  if (test->par3)
+	    result = asn1_write_uint64 (asn1_element, test->par1,
+					strtoull (test->par2, NULL, 10));
+	  else
+	    result = asn1_write_int64 (asn1_element, test->par1,
+				       strtoll (test->par2, NULL, 10));
+	  break;
+	case ACT_READ_INT64:
+	  if (test->par3)
+	    {
+	      result = asn1_read_uint64 (asn1_element, test->par1, &uval);
+	      sprintf ((char *) value, "%llu", (unsigned long long) uval);
+	    }
+	  else
+	    {
+	      result = asn1_read_int64 (asn1_element, test->par1, &ival);
+	      sprintf ((char *) value, "%lld", (long long) ival);
+	    }
+	  break;
+	case ACT_WRITE_INT_MAG:
+	  result =
+	    asn1_write_integer_magnitude (asn1_element, test->par1,
+					  test->par2, abs (test->par3),
+					  test->par3 < 0);
+	  break;
+	case ACT_READ_INT_MAG:
+	  valueLen = sizeof (value);
+	  negative = -1;
+	  result = asn1_read_integer_magnitude (asn1_element, test->par1,
+						value, &valueLen, &negative);
+	  if (result != ASN1_SUCCESS)
+	    break;
+	  /* without a sign, only values that are not negative are read */
+	  k = sizeof (value);
+	  if (asn1_read_integer_magnitude (asn1_element, test->par1, value,
+					   &k, NULL) !=
+	      (negative ? ASN1_VALUE_NOT_VALID : ASN1_SUCCESS))
+	    result = ASN1_GENERIC_ERROR;
+	  /* a reference to the value must match the copy */
+	  if (asn1_read_integer_magnitude_ref (asn1_element, test->par1,
+					       &magnitude, &k) !=
+	      (negative ? ASN1_VALUE_NOT_VALID : ASN1_SUCCESS)
+	      || (!negative && (k != valueLen
+				|| memcmp (magnitude, value, k))))
+	    result = ASN1_GENERIC_ERROR;
+	  /* a short buffer returns the needed length */
+	  k = valueLen - 1;
+	  if (valueLen > 0
+	      && (asn1_read_integer_magnitude (asn1_element, test->par1,
+					       value, &k, &negative) !=
+		  ASN1_MEM_ERROR || k != valueLen))
+	    result = ASN1_GENERIC_ERROR;
+	  break;
+	case ACT_ITERATE:
+	  /* PAR1 is "name.?.component": read the component of every
+	     element of the SEQUENCE OF or SET OF "name" */
+	  strcpy (path, test->par1);
+	  component = strstr (path, ".?");
+	  *component = 0;
+	  component += 2;
+	  if (*component == '.')
+	    component++;
+	  value[0] = 0;
+	  result = ASN1_SUCCESS;
+	  k = 0;
+	  for (node = asn1_first_element (asn1_element, path);
+	       node && result == ASN1_SUCCESS; node = asn1_next_element (node))
+	    {
+	      valueLen = sizeof (element_value);
+	      result = asn1_read_element_value (node, component,
+						element_value, &valueLen);
+	      if (result == ASN1_SUCCESS)
+		{
+		  if (k++)
+		    strcat ((char *) value, ",");
+		  strcat ((char *) value, element_value);
+		}
+	    }
+	  break;
+	case ACT_READ_FIELDS:
+	  memset (&fields, 0, sizeof (fields));
+	  fields.seq1 = -1;
+	  result = asn1_read_fields (asn1_element, fields_array, test->par3,
+				     &fields, errorDescription);
+	  if (result == ASN1_SUCCESS)
+	    sprintf ((char *) value, "%lld,%lld,%lld,%s,%d,%d",
+		     (long long) fields.int1, (long long) fields.int2,
+		     (long long) fields.seq1, fields.id, fields.oct_len,
+		     fields.any1_len);
+	  else
+	    strcpy ((char *) value, errorDescription);
+	  break;
+	case ACT_WRITE_FIELDS:
+	  memset (&fields, 0, sizeof (fields));
+	  fields.int1 = 1;
+	  fields.int2 = -20000000000LL;
+	  fields.seq = seq_values;
+	  fields.seq_len = sizeof (seq_values) / sizeof (seq_values[0]);
+	  strcpy (fields.id, "1.2.3.4");
+	  memcpy (fields.oct, "\x01\x02", 2);
+	  fields.oct_len = 2;
+	  fields.any1_len = -1;
+	  result = asn1_write_fields (asn1_element, write_fields_array,
+				      test->par3, &fields, errorDescription);
+	  if (result == ASN1_SUCCESS)
+	    value[0] = 0;
+	  else
+	    strcpy ((char *) value, errorDescription);
+	  break;
 	case ACT_READ_LENGTH:
 	  valueLen = 0;
 	  result =
@@ -541,6 +1271,11 @@ main (int argc, char *argv[])
 	  result = asn1_der_coding (asn1_element, test->par1, der, &der_len,
 				    errorDescription);
 	  break;
+	case ACT_ENCODING_CMP:
+	  valueLen = sizeof (value);
+	  result = asn1_der_coding (asn1_element, test->par1, value, &valueLen,
+				    errorDescription);
+	  break;
 	case ACT_ENCODING_LENGTH:
 	  der_len = 0;
 	  result = asn1_der_coding (asn1_element, test->par1, NULL, &der_len,
@@ -555,6 +1290,42 @@ main (int argc, char *argv[])
 	    asn1_der_decoding_element (&asn1_element, test->par1, der,
 				       der_len, errorDescription);
 	  break;
+	case ACT_DECODING_OFFSETS:
+	  result = asn1_der_decoding2 (&asn1_element, der, der_len,
+				       ASN1_DECODE_KEEP_OFFSETS, NULL);
+	  break;
+	case ACT_DECODING_KEEP_DER:
+	  result = asn1_der_decoding2 (&asn1_element, der, der_len,
+				       ASN1_DECODE_KEEP_DER, NULL);
+	  break;
+	case ACT_READ_DER_OFFSETS:
+	  result = asn1_read_der_offsets (asn1_element, test->par1, &start,
+					  &end);
+	  break;
+	case ACT_DECODING_ERROR:
+	  result = asn1_der_decoding2 (&asn1_element, der, der_len, 0, &error);
+	  asn1_error_tags (&error, &expected_class, &expected_tag,
+			   &found_class, &found_tag);
+	  sprintf ((char *) value, "%d,%lu,%d,%lu", expected_class,
+		   expected_tag, found_class, found_tag);
+	  asn1_error_description (&error, errorDescription);
+	  strcpy (error_name, error.node ? error.node->name : "");
+	  /* the element was kept for the error */
+	  asn1_delete_structure (&asn1_element);
+	  break;
+	case ACT_PRINT_JSON:
+	  value[0] = 0;
+	  json = tmpfile ();
+	  result = asn1_print_json (json, asn1_element, test->par1,
+				    test->par3);
+	  if (json)
+	    {
+	      rewind (json);
+	      k = fread (value, 1, sizeof (value) - 1, json);
+	      value[k] = 0;
+	      fclose (json);
+	    }
+	  break;
 	case ACT_DECODING_START_END:
 	  result =
 	    asn1_der_decoding_startEnd (asn1_element, der, der_len,
@@ -604,9 +1375,15 @@ main (int argc, char *argv[])
 	case ACT_DELETE:
 	case ACT_DELETE_ELEMENT:
 	case ACT_WRITE:
+	case ACT_WRITE_OID_DER:
+	case ACT_WRITE_TIME:
+	case ACT_WRITE_TIME_TM:
+	case ACT_WRITE_INT64:
 	case ACT_VISIT:
 	case ACT_ENCODING:
 	case ACT_DECODING:
+	case ACT_DECODING_OFFSETS:
+	case ACT_DECODING_KEEP_DER:
 	case ACT_PRINT_DER:
 	case ACT_EXPAND_ANY:
 	case ACT_EXPAND_OCTET:
@@ -648,6 +1425,23 @@ main (int argc, char *argv[])
 		      valueLen);
 	    }
 	  break;
+	case ACT_ENCODING_CMP:
+	  if ((result != test->errorNumber) || (valueLen != test->par3)
+	      || memcmp (value, test->par2, test->par3))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s - %d\n", test->action, test->par1,
+		      test->par3);
+	      printf ("  Error expected: %s\n",
+		      asn1_strerror (test->errorNumber));
+	      printf ("  Error detected: %s - %d - ", asn1_strerror (result),
+		      valueLen);
+	      for (k = 0; k < valueLen && k < (int) sizeof (value); k++)
+		printf ("%02x", value[k]);
+	      printf ("\n\n");
+	    }
+	  break;
 	case ACT_ENCODING_LENGTH:
 	  if ((result != test->errorNumber) || (der_len != test->par3))
 	    {
@@ -674,7 +1468,25 @@ main (int argc, char *argv[])
 	      printf ("  Value detected: %s\n\n", str_p);
 	    }
 	  break;
+	case ACT_DECODING_ERROR:
+	  if ((result != test->errorNumber) || (error.code != result)
+	      || strcmp (error_name, test->par1)
+	      || strcmp ((char *) value, test->par2)
+	      || (error.offset != test->par3))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s - %s - %d\n", test->action,
+		      test->par1, test->par2, test->par3);
+	      printf ("  Error expected: %s\n",
+		      asn1_strerror (test->errorNumber));
+	      printf ("  Error detected: %s - %s - %s - %d\n",
+		      asn1_strerror (result), error_name, value, error.offset);
+	      printf ("  Error description : %s\n\n", errorDescription);
+	    }
+	  break;
 	case ACT_DECODING_START_END:
+	case ACT_READ_DER_OFFSETS:
 	  if ((result != test->errorNumber) ||
 	      ((!strcmp (test->par2, "START")) && (start != test->par3)) ||
 	      ((!strcmp (test->par2, "END")) && (end != test->par3)))
@@ -709,9 +1521,116 @@ main (int argc, char *argv[])
 
 	  break;
 
+	case ACT_OID_DER:
+	  if ((result != test->errorNumber) ||
+	      ((result == ASN1_SUCCESS) &&
+	       (strcmp ((char *) value, test->par1) ||
+		(test->par2 && ((der_len != test->par3) ||
+				memcmp (der, test->par2, der_len))))))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s\n", test->action, test->par1);
+	      printf ("  Error expected: %s\n",
+		      asn1_strerror (test->errorNumber));
+	      printf ("  Error detected: %s - %s\n\n", asn1_strerror (result),
+		      (result == ASN1_SUCCESS) ? (char *) value : "");
+	    }
+	  break;
+	case ACT_READ_INT64:
+	  if ((result != test->errorNumber) ||
+	      ((result == ASN1_SUCCESS) && strcmp ((char *) value, test->par2)))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s\n", test->action, test->par1);
+	      printf ("  Error expected: %s - %s\n",
+		      asn1_strerror (test->errorNumber), test->par2);
+	      printf ("  Error detected: %s - %s\n\n",
+		      asn1_strerror (result), value);
+	    }
+	  break;
+	case ACT_READ_FIELDS:
+	case ACT_WRITE_FIELDS:
+	case ACT_PRINT_JSON:
+	  if ((result != test->errorNumber) || strcmp ((char *) value,
+						       test->par2))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %d\n", test->action, test->par3);
+	      printf ("  Error expected: %s - %s\n",
+		      asn1_strerror (test->errorNumber), test->par2);
+	      printf ("  Error detected: %s - %s\n\n",
+		      asn1_strerror (result), value);
+	    }
+	  break;
+	case ACT_ITERATE:
+	  if ((result != test->errorNumber) || (k != test->par3) ||
+	      ((result == ASN1_SUCCESS) && strcmp ((char *) value, test->par2)))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s\n", test->action, test->par1);
+	      printf ("  Error expected: %s - %d - %s\n",
+		      asn1_strerror (test->errorNumber), test->par3,
+		      test->par2);
+	      printf ("  Error detected: %s - %d - %s\n\n",
+		      asn1_strerror (result), k, value);
+	    }
+	  break;
+	case ACT_READ_INT_MAG:
+	  if ((result != test->errorNumber) ||
+	      ((result == ASN1_SUCCESS) &&
+	       ((valueLen != abs (test->par3))
+		|| (negative != (test->par3 < 0))
+		|| memcmp (value, test->par2, valueLen))))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s\n", test->action, test->par1);
+	      printf ("  Error expected: %s - %d\n",
+		      asn1_strerror (test->errorNumber), test->par3);
+	      printf ("  Error detected: %s - %d - ", asn1_strerror (result),
+		      negative ? -valueLen : valueLen);
+	      for (k = 0; k < valueLen && result == ASN1_SUCCESS; k++)
+		printf ("%02x", value[k]);
+	      printf ("\n\n");
+	    }
+	  break;
+	case ACT_READ_TIME:
+	  if ((result != test->errorNumber) ||
+	      ((result == ASN1_SUCCESS) &&
+	       (strcmp ((char *) value, test->par2) || (t != test->par3))))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s\n", test->action, test->par1);
+	      printf ("  Error expected: %s - %s - %d\n",
+		      asn1_strerror (test->errorNumber), test->par2,
+		      test->par3);
+	      printf ("  Error detected: %s - %s - %ld\n\n",
+		      asn1_strerror (result), value, (long) t);
+	    }
+	  break;
+	case ACT_OID_DER_CMP:
+	  if ((result != test->errorNumber) || (k != test->par3))
+	    {
+	      errorCounter++;
+	      printf ("ERROR N. %d:\n", errorCounter);
+	      printf ("  Action %d - %s - %s\n", test->action, test->par1,
+		      test->par2);
+	      printf ("  Error expected: %s - %d\n",
+		      asn1_strerror (test->errorNumber), test->par3);
+	      printf ("  Error detected: %s - %d\n\n", asn1_strerror (result),
+		      k);
+	    }
+	  break;
+
 	case ACT_READ:
 	case ACT_READ_DEFINITIONS:
 	case ACT_READ_BIT:
+	case ACT_READ_OID_DER:
 	  if (test->action == ACT_READ_BIT)
 	    {
 	      if ((valueLen - (valueLen / 8.0)) == 0)
@@ -723,6 +1642,8 @@ main (int argc, char *argv[])
 	      else
 		class = (test->par3 / 8) + 1;
 	    }
+	  else if (test->action == ACT_READ_OID_DER)
+	    class = test->par3;
 
 	  for (k = 0; k < class; k++)
 	    if (test->par2[k] != value[k])
@@ -757,6 +1678,8 @@ main (int argc, char *argv[])
       test++;
     }
 
+  testCounter++;
+  errorCounter += test_unique_ids (pkixfile);
 
   printf ("Total tests : %d\n", testCounter);
   printf ("Total errors: %d\n", errorCounter);
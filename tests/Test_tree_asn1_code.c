@@ -0,0 +1,2909 @@
+/* Generated from the ASN.1 module TEST_TREE.
+   Each SEQUENCE and CHOICE type has a structure, a test_tree_decode_<type>
+   and a test_tree_encode_<type> function.  BOOLEAN elements are int, INTEGER
+   and ENUMERATED ones int64_t: larger values fail with ASN1_DER_OVERFLOW.
+   Strings, OBJECT IDENTIFIER, time and SET elements point to their
+   content octets inside the decoded buffer, ANY elements to their
+   complete encoding.  SEQUENCE OF and SET OF elements point to their
+   content octets and have the number of elements, that test_tree_iter_init
+   and test_tree_next_<type>_<element> decode one at a time; they are encoded
+   from the items array instead if it is set, in the order of DER for a
+   SET OF.  Inline structures, lists and NULL inside a list are kept as
+   complete encodings.  OPTIONAL and DEFAULT elements have a _present
+   flag, a DEFAULT value must be left out by the caller to obtain DER.  */
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <string.h>
+#include <libtasn1.h>
+
+typedef struct
+{
+  const unsigned char *data;
+  int len;
+} test_tree_blob;
+
+typedef struct
+{
+  unsigned char *buf;
+  int size;
+  int pos;
+} test_tree_writer;
+
+typedef struct
+{
+  const unsigned char *p;
+  const unsigned char *end;
+} test_tree_iter;
+
+int test_tree_get_tag (const unsigned char **p, const unsigned char *end,
+	unsigned char cls, unsigned long tag);
+int test_tree_get_tl (const unsigned char **p, const unsigned char *end,
+	unsigned char cls, unsigned long tag, const unsigned char **content_end);
+int test_tree_get_tlv (const unsigned char **p, const unsigned char *end,
+	test_tree_blob *tlv);
+int test_tree_get_int (const unsigned char *p, const unsigned char *end,
+	int64_t *value);
+int test_tree_count (const unsigned char *p, const unsigned char *end, int *count);
+void test_tree_iter_init (test_tree_iter *it, const unsigned char *data, int len);
+int test_tree_peek (const unsigned char *p, const unsigned char *end,
+	unsigned char cls, unsigned long tag);
+void test_tree_put (test_tree_writer *w, const unsigned char *data, int len);
+void test_tree_put_byte (test_tree_writer *w, unsigned char c);
+void test_tree_put_int (test_tree_writer *w, int64_t value);
+void test_tree_put_tag (test_tree_writer *w, unsigned char cls, unsigned long tag);
+void test_tree_put_tl (test_tree_writer *w, unsigned char cls, unsigned long tag,
+	int len);
+int test_tree_finish (test_tree_writer *w, int *der_len);
+
+int
+test_tree_get_tag (const unsigned char **p, const unsigned char *end,
+	unsigned char cls, unsigned long tag)
+{
+  unsigned char c;
+  unsigned long t;
+  int tag_len;
+
+  if (asn1_get_tag_der (*p, end - *p, &c, &tag_len, &t) != ASN1_SUCCESS)
+    return ASN1_DER_ERROR;
+  if (c != cls || t != tag)
+    return ASN1_TAG_ERROR;
+  *p += tag_len;
+  return ASN1_SUCCESS;
+}
+
+int
+test_tree_get_tl (const unsigned char **p, const unsigned char *end,
+	unsigned char cls, unsigned long tag, const unsigned char **content_end)
+{
+  int result, len_len;
+  long len;
+
+  result = test_tree_get_tag (p, end, cls, tag);
+  if (result != ASN1_SUCCESS)
+    return result;
+  len = asn1_get_length_der (*p, end - *p, &len_len);
+  if (len < 0 || len_len == 0 || len > end - *p - len_len)
+    return ASN1_DER_ERROR;
+  *p += len_len;
+  *content_end = *p + len;
+  return ASN1_SUCCESS;
+}
+
+int
+test_tree_get_tlv (const unsigned char **p, const unsigned char *end,
+	test_tree_blob *tlv)
+{
+  unsigned char c;
+  unsigned long t;
+  int tag_len, len_len;
+  long len;
+
+  if (asn1_get_tag_der (*p, end - *p, &c, &tag_len, &t) != ASN1_SUCCESS)
+    return ASN1_DER_ERROR;
+  len = asn1_get_length_der (*p + tag_len, end - *p - tag_len, &len_len);
+  if (len < 0 || len_len == 0 || len > end - *p - tag_len - len_len)
+    return ASN1_DER_ERROR;
+  tlv->data = *p;
+  tlv->len = tag_len + len_len + len;
+  *p += tlv->len;
+  return ASN1_SUCCESS;
+}
+
+int
+test_tree_get_int (const unsigned char *p, const unsigned char *end,
+	int64_t *value)
+{
+  uint64_t v;
+
+  if (p >= end)
+    return ASN1_DER_ERROR;
+  if (end - p > 8)
+    return ASN1_DER_OVERFLOW;
+  v = (*p & 0x80) ? ~(uint64_t) 0 : 0;
+  for (; p < end; p++)
+    v = (v << 8) | *p;
+  *value = (int64_t) v;
+  return ASN1_SUCCESS;
+}
+
+int
+test_tree_count (const unsigned char *p, const unsigned char *end, int *count)
+{
+  test_tree_blob tlv;
+  int result;
+
+  for (*count = 0; p < end; (*count)++)
+    {
+      result = test_tree_get_tlv (&p, end, &tlv);
+      if (result != ASN1_SUCCESS)
+	return result;
+    }
+  return ASN1_SUCCESS;
+}
+
+void
+test_tree_iter_init (test_tree_iter *it, const unsigned char *data, int len)
+{
+  it->p = data;
+  it->end = data + len;
+}
+
+int
+test_tree_peek (const unsigned char *p, const unsigned char *end,
+	unsigned char cls, unsigned long tag)
+{
+  unsigned char c;
+  unsigned long t;
+  int len;
+
+  if (asn1_get_tag_der (p, end - p, &c, &len, &t) != ASN1_SUCCESS)
+    return 0;
+  return c == cls && t == tag;
+}
+
+void
+test_tree_put (test_tree_writer *w, const unsigned char *data, int len)
+{
+  w->pos -= len;
+  if (w->pos >= 0 && len > 0)
+    memcpy (w->buf + w->pos, data, len);
+}
+
+void
+test_tree_put_byte (test_tree_writer *w, unsigned char c)
+{
+  test_tree_put (w, &c, 1);
+}
+
+void
+test_tree_put_int (test_tree_writer *w, int64_t value)
+{
+  unsigned char tmp[8];
+  int k = sizeof (tmp);
+
+  do
+    {
+      tmp[--k] = value & 0xff;
+      value = (value < 0) ? ~(~value >> 8) : value >> 8;
+    }
+  while (k > 0 && value != ((tmp[k] & 0x80) ? -1 : 0));
+  test_tree_put (w, tmp + k, sizeof (tmp) - k);
+}
+
+void
+test_tree_put_tag (test_tree_writer *w, unsigned char cls, unsigned long tag)
+{
+  unsigned char tmp[16];
+  int k;
+
+  if (tag < 31)
+    {
+      test_tree_put_byte (w, cls | tag);
+      return;
+    }
+  k = sizeof (tmp);
+  tmp[--k] = tag & 0x7f;
+  for (tag >>= 7; tag; tag >>= 7)
+    tmp[--k] = 0x80 | (tag & 0x7f);
+  tmp[--k] = cls | 0x1f;
+  test_tree_put (w, tmp + k, sizeof (tmp) - k);
+}
+
+void
+test_tree_put_tl (test_tree_writer *w, unsigned char cls, unsigned long tag,
+	int len)
+{
+  unsigned char tmp[32];
+  int k;
+
+  asn1_length_der (len, tmp, &k);
+  test_tree_put (w, tmp, k);
+  test_tree_put_tag (w, cls, tag);
+}
+
+int
+test_tree_finish (test_tree_writer *w, int *der_len)
+{
+  *der_len = w->size - w->pos;
+  if (w->pos < 0)
+    return ASN1_MEM_ERROR;
+  if (w->pos > 0)
+    memmove (w->buf, w->buf + w->pos, *der_len);
+  return ASN1_SUCCESS;
+}
+
+struct test_tree_KrbError
+{
+  int64_t pvno;
+};
+
+struct test_tree_Checksum
+{
+  test_tree_blob checksum;
+};
+
+struct test_tree_AttributeTypeAndValue
+{
+  test_tree_blob type;
+  test_tree_blob value;	/* complete encoding */
+};
+
+struct test_tree_Name
+{
+  unsigned int choice;
+  /* choice == 1 */
+  struct
+  {
+    const unsigned char *data;	/* content octets */
+    int len;
+    int count;
+    const struct test_tree_AttributeTypeAndValue *items;	/* to encode, or NULL */
+  } rdnSequence;
+};
+
+struct test_tree_CertTemplate
+{
+  int version_present;
+  int64_t version;
+  int issuer_present;
+  struct test_tree_Name issuer;
+  int validity_present;
+  int64_t validity;
+};
+
+struct test_tree_Sequence_octetTest1
+{
+  int int__present;
+  int64_t int_;
+};
+
+struct test_tree_sequenceEmpty
+{
+  int64_t int1;
+  struct test_tree_Sequence_octetTest1 seq1;
+  struct
+  {
+    const unsigned char *data;	/* content octets */
+    int len;
+    int count;
+    const int64_t *items;	/* to encode, or NULL */
+  } set1;
+};
+
+struct test_tree_IndefiniteLengthTest
+{
+  struct test_tree_Sequence_octetTest1 seq1;
+  struct
+  {
+    const unsigned char *data;	/* content octets */
+    int len;
+    int count;
+    const test_tree_blob *items;	/* to encode, or NULL */
+  } set1;
+  int64_t int1;
+};
+
+struct test_tree_OidTest
+{
+  int oid3_present;
+  test_tree_blob oid3;
+  int oid_present;
+  test_tree_blob oid;
+  int oid2_present;
+  test_tree_blob oid2;
+};
+
+struct test_tree_OidAndTimeTest
+{
+  struct
+  {
+    const unsigned char *data;	/* content octets */
+    int len;
+    int count;
+    const int64_t *items;	/* to encode, or NULL */
+  } set;
+  test_tree_blob oid;
+  test_tree_blob time2;
+  int bol;
+  test_tree_blob oct;
+  int bit_present;
+  test_tree_blob bit;
+  int bol2_present;
+  int bol2;
+  int enum__present;
+  int64_t enum_;
+  int any_present;
+  test_tree_blob any;	/* complete encoding */
+  int gen_present;
+  test_tree_blob gen;
+  test_tree_blob time1;
+};
+
+struct test_tree_Time
+{
+  unsigned int choice;
+  /* choice == 1 */
+  test_tree_blob utcTime;
+  /* choice == 2 */
+  test_tree_blob generalTime;
+};
+
+struct test_tree_Validity
+{
+  struct test_tree_Time notBefore;
+  struct test_tree_Time notAfter;
+};
+
+struct test_tree_SequenceTestTag
+{
+  int64_t int1;
+  int64_t int2;
+  test_tree_blob str1;
+  test_tree_blob str2;
+  test_tree_blob str3;
+};
+
+struct test_tree_Sequence1
+{
+  int int1_present;
+  int64_t int1;
+  int64_t int2;
+  struct
+  {
+    const unsigned char *data;	/* content octets */
+    int len;
+    int count;
+    const int64_t *items;	/* to encode, or NULL */
+  } seq;
+  test_tree_blob id;
+  test_tree_blob oct;
+  int any1_present;
+  test_tree_blob any1;	/* complete encoding */
+};
+
+struct test_tree_DHParameter
+{
+  int64_t prime;
+  int64_t base;
+  int privateValueLength_present;
+  int64_t privateValueLength;
+};
+
+struct test_tree_AnyTest2
+{
+  unsigned int choice;
+  /* choice == 1 */
+  test_tree_blob str;
+  /* choice == 2 */
+  int64_t int_;
+};
+
+struct test_tree_Test3
+{
+  int64_t a;
+  test_tree_blob b;
+};
+
+struct test_tree_X520LocalityName
+{
+  unsigned int choice;
+  /* choice == 1 */
+  test_tree_blob teletexString;
+  /* choice == 2 */
+  test_tree_blob printableString;
+  /* choice == 3 */
+  test_tree_blob universalString;
+  /* choice == 4 */
+  test_tree_blob utf8String;
+  /* choice == 5 */
+  test_tree_blob bmpString;
+};
+
+int test_tree_decode_KrbError (const unsigned char *der, int der_len,
+	struct test_tree_KrbError *out);
+int test_tree_encode_KrbError (const struct test_tree_KrbError *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Checksum (const unsigned char *der, int der_len,
+	struct test_tree_Checksum *out);
+int test_tree_encode_Checksum (const struct test_tree_Checksum *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_CertTemplate (const unsigned char *der, int der_len,
+	struct test_tree_CertTemplate *out);
+int test_tree_encode_CertTemplate (const struct test_tree_CertTemplate *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Name (const unsigned char *der, int der_len,
+	struct test_tree_Name *out);
+int test_tree_encode_Name (const struct test_tree_Name *in, unsigned char *der,
+	int *der_len);
+int test_tree_next_Name_rdnSequence (test_tree_iter *it, struct test_tree_AttributeTypeAndValue *out);
+int test_tree_decode_AttributeTypeAndValue (const unsigned char *der, int der_len,
+	struct test_tree_AttributeTypeAndValue *out);
+int test_tree_encode_AttributeTypeAndValue (const struct test_tree_AttributeTypeAndValue *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_sequenceEmpty (const unsigned char *der, int der_len,
+	struct test_tree_sequenceEmpty *out);
+int test_tree_encode_sequenceEmpty (const struct test_tree_sequenceEmpty *in, unsigned char *der,
+	int *der_len);
+int test_tree_next_sequenceEmpty_set1 (test_tree_iter *it, int64_t *out);
+int test_tree_decode_IndefiniteLengthTest (const unsigned char *der, int der_len,
+	struct test_tree_IndefiniteLengthTest *out);
+int test_tree_encode_IndefiniteLengthTest (const struct test_tree_IndefiniteLengthTest *in, unsigned char *der,
+	int *der_len);
+int test_tree_next_IndefiniteLengthTest_set1 (test_tree_iter *it, test_tree_blob *out);
+int test_tree_decode_OidTest (const unsigned char *der, int der_len,
+	struct test_tree_OidTest *out);
+int test_tree_encode_OidTest (const struct test_tree_OidTest *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_OidAndTimeTest (const unsigned char *der, int der_len,
+	struct test_tree_OidAndTimeTest *out);
+int test_tree_encode_OidAndTimeTest (const struct test_tree_OidAndTimeTest *in, unsigned char *der,
+	int *der_len);
+int test_tree_next_OidAndTimeTest_set (test_tree_iter *it, int64_t *out);
+int test_tree_decode_Validity (const unsigned char *der, int der_len,
+	struct test_tree_Validity *out);
+int test_tree_encode_Validity (const struct test_tree_Validity *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Time (const unsigned char *der, int der_len,
+	struct test_tree_Time *out);
+int test_tree_encode_Time (const struct test_tree_Time *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_SequenceTestTag (const unsigned char *der, int der_len,
+	struct test_tree_SequenceTestTag *out);
+int test_tree_encode_SequenceTestTag (const struct test_tree_SequenceTestTag *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Sequence1 (const unsigned char *der, int der_len,
+	struct test_tree_Sequence1 *out);
+int test_tree_encode_Sequence1 (const struct test_tree_Sequence1 *in, unsigned char *der,
+	int *der_len);
+int test_tree_next_Sequence1_seq (test_tree_iter *it, int64_t *out);
+int test_tree_decode_DHParameter (const unsigned char *der, int der_len,
+	struct test_tree_DHParameter *out);
+int test_tree_encode_DHParameter (const struct test_tree_DHParameter *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Sequence_octetTest1 (const unsigned char *der, int der_len,
+	struct test_tree_Sequence_octetTest1 *out);
+int test_tree_encode_Sequence_octetTest1 (const struct test_tree_Sequence_octetTest1 *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_AnyTest2 (const unsigned char *der, int der_len,
+	struct test_tree_AnyTest2 *out);
+int test_tree_encode_AnyTest2 (const struct test_tree_AnyTest2 *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_Test3 (const unsigned char *der, int der_len,
+	struct test_tree_Test3 *out);
+int test_tree_encode_Test3 (const struct test_tree_Test3 *in, unsigned char *der,
+	int *der_len);
+int test_tree_decode_X520LocalityName (const unsigned char *der, int der_len,
+	struct test_tree_X520LocalityName *out);
+int test_tree_encode_X520LocalityName (const struct test_tree_X520LocalityName *in, unsigned char *der,
+	int *der_len);
+
+static int
+test_tree_dec_KrbError (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_KrbError *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x80, 0, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &out->pvno);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_KrbError (const struct test_tree_KrbError *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    test_tree_put_int (w, in->pvno);
+    test_tree_put_tl (w, 0x80, 0, mark1 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_KrbError (const unsigned char *der, int der_len,
+	struct test_tree_KrbError *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x60, 30, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_KrbError (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_KrbError (const struct test_tree_KrbError *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_KrbError (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x60, 30, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Checksum (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Checksum *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x80, 1, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->checksum.data = p;
+    out->checksum.len = end1 - p;
+    p = end1;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Checksum (const struct test_tree_Checksum *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    test_tree_put (w, in->checksum.data, in->checksum.len);
+    test_tree_put_tl (w, 0x80, 1, mark1 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_Checksum (const unsigned char *der, int der_len,
+	struct test_tree_Checksum *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Checksum (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Checksum (const struct test_tree_Checksum *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_Checksum (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_AttributeTypeAndValue (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_AttributeTypeAndValue *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x00, 6, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->type.data = p;
+    out->type.len = end1 - p;
+    p = end1;
+  }
+  result = test_tree_get_tlv (&p, end, &out->value);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_AttributeTypeAndValue (const struct test_tree_AttributeTypeAndValue *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  test_tree_put (w, in->value.data, in->value.len);
+  {
+    int mark1 = w->pos;
+    test_tree_put (w, in->type.data, in->type.len);
+    test_tree_put_tl (w, 0x00, 6, mark1 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_AttributeTypeAndValue (const unsigned char *der, int der_len,
+	struct test_tree_AttributeTypeAndValue *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_AttributeTypeAndValue (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_AttributeTypeAndValue (const struct test_tree_AttributeTypeAndValue *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_AttributeTypeAndValue (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Name (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Name *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x20, 17))
+    {
+      out->choice = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x20, 17, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->rdnSequence.data = p;
+        out->rdnSequence.len = end1 - p;
+        result = test_tree_count (p, end1, &out->rdnSequence.count);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end1;
+      }
+    }
+  else
+    return ASN1_TAG_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Name (const struct test_tree_Name *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  switch (in->choice)
+    {
+    case 1:
+      {
+        int mark1 = w->pos;
+        if (in->rdnSequence.items)
+          {
+            int i2;
+
+            for (i2 = in->rdnSequence.count - 1; i2 >= 0; i2--)
+              {
+                {
+                  int mark3 = w->pos;
+                  result = test_tree_enc_AttributeTypeAndValue (&in->rdnSequence.items[i2], w);
+                  if (result != ASN1_SUCCESS)
+                    return result;
+                  test_tree_put_tl (w, 0x20, 16, mark3 - w->pos);
+                }
+              }
+          }
+        else
+          test_tree_put (w, in->rdnSequence.data, in->rdnSequence.len);
+        test_tree_put_tl (w, 0x20, 17, mark1 - w->pos);
+      }
+      break;
+    default:
+      return ASN1_VALUE_NOT_FOUND;
+    }
+  return result;
+}
+
+int
+test_tree_decode_Name (const unsigned char *der, int der_len,
+	struct test_tree_Name *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  result = test_tree_dec_Name (&p, end, out);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Name (const struct test_tree_Name *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  result = test_tree_enc_Name (in, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+int
+test_tree_next_Name_rdnSequence (test_tree_iter *it, struct test_tree_AttributeTypeAndValue *out)
+{
+  const unsigned char *p = it->p;
+  int result = ASN1_SUCCESS;
+
+  if (p >= it->end)
+    return ASN1_ELEMENT_NOT_FOUND;
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, it->end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_AttributeTypeAndValue (&p, end1, &(*out));
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  it->p = p;
+  return result;
+}
+
+static int
+test_tree_dec_CertTemplate (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_CertTemplate *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x80, 0))
+    {
+      out->version_present = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x80, 0, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end1, &out->version);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end1;
+      }
+    }
+  if ((test_tree_peek (p, end, 0xa0, 3)))
+    {
+      out->issuer_present = 1;
+      if (test_tree_peek (p, end, 0xa0, 3))
+        {
+          out->issuer.choice = 1;
+          {
+            const unsigned char *end2;
+            result = test_tree_get_tl (&p, end, 0xa0, 3, &end2);
+            if (result != ASN1_SUCCESS)
+              return result;
+            out->issuer.rdnSequence.data = p;
+            out->issuer.rdnSequence.len = end2 - p;
+            result = test_tree_count (p, end2, &out->issuer.rdnSequence.count);
+            if (result != ASN1_SUCCESS)
+              return result;
+            p = end2;
+          }
+        }
+      else
+        return ASN1_TAG_ERROR;
+    }
+  if (test_tree_peek (p, end, 0x80, 4))
+    {
+      out->validity_present = 1;
+      {
+        const unsigned char *end3;
+        result = test_tree_get_tl (&p, end, 0x80, 4, &end3);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end3, &out->validity);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end3;
+      }
+    }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_CertTemplate (const struct test_tree_CertTemplate *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  if (in->validity_present)
+    {
+      {
+        int mark1 = w->pos;
+        test_tree_put_int (w, in->validity);
+        test_tree_put_tl (w, 0x80, 4, mark1 - w->pos);
+      }
+    }
+  if (in->issuer_present)
+    {
+      switch (in->issuer.choice)
+        {
+        case 1:
+          {
+            int mark2 = w->pos;
+            if (in->issuer.rdnSequence.items)
+              {
+                int i3;
+
+                for (i3 = in->issuer.rdnSequence.count - 1; i3 >= 0; i3--)
+                  {
+                    {
+                      int mark4 = w->pos;
+                      result = test_tree_enc_AttributeTypeAndValue (&in->issuer.rdnSequence.items[i3], w);
+                      if (result != ASN1_SUCCESS)
+                        return result;
+                      test_tree_put_tl (w, 0x20, 16, mark4 - w->pos);
+                    }
+                  }
+              }
+            else
+              test_tree_put (w, in->issuer.rdnSequence.data, in->issuer.rdnSequence.len);
+            test_tree_put_tl (w, 0xa0, 3, mark2 - w->pos);
+          }
+          break;
+        default:
+          return ASN1_VALUE_NOT_FOUND;
+        }
+    }
+  if (in->version_present)
+    {
+      {
+        int mark5 = w->pos;
+        test_tree_put_int (w, in->version);
+        test_tree_put_tl (w, 0x80, 0, mark5 - w->pos);
+      }
+    }
+  return result;
+}
+
+int
+test_tree_decode_CertTemplate (const unsigned char *der, int der_len,
+	struct test_tree_CertTemplate *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_CertTemplate (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_CertTemplate (const struct test_tree_CertTemplate *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_CertTemplate (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Sequence_octetTest1 (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Sequence_octetTest1 *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x00, 2))
+    {
+      out->int__present = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x00, 2, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end1, &out->int_);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end1;
+      }
+    }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Sequence_octetTest1 (const struct test_tree_Sequence_octetTest1 *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  if (in->int__present)
+    {
+      {
+        int mark1 = w->pos;
+        test_tree_put_int (w, in->int_);
+        test_tree_put_tl (w, 0x00, 2, mark1 - w->pos);
+      }
+    }
+  return result;
+}
+
+int
+test_tree_decode_Sequence_octetTest1 (const unsigned char *der, int der_len,
+	struct test_tree_Sequence_octetTest1 *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Sequence_octetTest1 (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Sequence_octetTest1 (const struct test_tree_Sequence_octetTest1 *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_Sequence_octetTest1 (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_sequenceEmpty (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_sequenceEmpty *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &out->int1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0xa0, 1, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Sequence_octetTest1 (&p, end2, &out->seq1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end2)
+      return ASN1_DER_ERROR;
+  }
+  {
+    const unsigned char *end3;
+    result = test_tree_get_tl (&p, end, 0xa0, 2, &end3);
+    if (result != ASN1_SUCCESS)
+      return result;
+    {
+      const unsigned char *end4;
+      result = test_tree_get_tl (&p, end3, 0x20, 17, &end4);
+      if (result != ASN1_SUCCESS)
+        return result;
+      out->set1.data = p;
+      out->set1.len = end4 - p;
+      result = test_tree_count (p, end4, &out->set1.count);
+      if (result != ASN1_SUCCESS)
+        return result;
+      p = end4;
+    }
+    if (p != end3)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_sequenceEmpty (const struct test_tree_sequenceEmpty *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    {
+      int mark2 = w->pos;
+      if (in->set1.items)
+        {
+          int i3;
+
+          for (i3 = in->set1.count - 1; i3 >= 0; i3--)
+            {
+              {
+                int mark4 = w->pos;
+                test_tree_put_int (w, in->set1.items[i3]);
+                test_tree_put_tl (w, 0x00, 2, mark4 - w->pos);
+              }
+            }
+        }
+      else
+        test_tree_put (w, in->set1.data, in->set1.len);
+      test_tree_put_tl (w, 0x20, 17, mark2 - w->pos);
+    }
+    test_tree_put_tl (w, 0xa0, 2, mark1 - w->pos);
+  }
+  {
+    int mark5 = w->pos;
+    result = test_tree_enc_Sequence_octetTest1 (&in->seq1, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0xa0, 1, mark5 - w->pos);
+  }
+  {
+    int mark6 = w->pos;
+    test_tree_put_int (w, in->int1);
+    test_tree_put_tl (w, 0x00, 2, mark6 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_sequenceEmpty (const unsigned char *der, int der_len,
+	struct test_tree_sequenceEmpty *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_sequenceEmpty (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_sequenceEmpty (const struct test_tree_sequenceEmpty *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_sequenceEmpty (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+int
+test_tree_next_sequenceEmpty_set1 (test_tree_iter *it, int64_t *out)
+{
+  const unsigned char *p = it->p;
+  int result = ASN1_SUCCESS;
+
+  if (p >= it->end)
+    return ASN1_ELEMENT_NOT_FOUND;
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, it->end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &(*out));
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  it->p = p;
+  return result;
+}
+
+static int
+test_tree_dec_IndefiniteLengthTest (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_IndefiniteLengthTest *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0xa0, 1, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Sequence_octetTest1 (&p, end1, &out->seq1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0x20, 17, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->set1.data = p;
+    out->set1.len = end2 - p;
+    result = test_tree_count (p, end2, &out->set1.count);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end2;
+  }
+  {
+    const unsigned char *end3;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end3);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end3, &out->int1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end3;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_IndefiniteLengthTest (const struct test_tree_IndefiniteLengthTest *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    test_tree_put_int (w, in->int1);
+    test_tree_put_tl (w, 0x00, 2, mark1 - w->pos);
+  }
+  {
+    int mark2 = w->pos;
+    if (in->set1.items)
+      {
+        int i3;
+
+        for (i3 = in->set1.count - 1; i3 >= 0; i3--)
+          {
+            {
+              int mark4 = w->pos;
+              test_tree_put (w, in->set1.items[i3].data, in->set1.items[i3].len);
+              test_tree_put_tl (w, 0x00, 6, mark4 - w->pos);
+            }
+          }
+      }
+    else
+      test_tree_put (w, in->set1.data, in->set1.len);
+    test_tree_put_tl (w, 0x20, 17, mark2 - w->pos);
+  }
+  {
+    int mark5 = w->pos;
+    result = test_tree_enc_Sequence_octetTest1 (&in->seq1, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0xa0, 1, mark5 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_IndefiniteLengthTest (const unsigned char *der, int der_len,
+	struct test_tree_IndefiniteLengthTest *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_IndefiniteLengthTest (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_IndefiniteLengthTest (const struct test_tree_IndefiniteLengthTest *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_IndefiniteLengthTest (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+int
+test_tree_next_IndefiniteLengthTest_set1 (test_tree_iter *it, test_tree_blob *out)
+{
+  const unsigned char *p = it->p;
+  int result = ASN1_SUCCESS;
+
+  if (p >= it->end)
+    return ASN1_ELEMENT_NOT_FOUND;
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, it->end, 0x00, 6, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    (*out).data = p;
+    (*out).len = end1 - p;
+    p = end1;
+  }
+  it->p = p;
+  return result;
+}
+
+static int
+test_tree_dec_OidTest (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_OidTest *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x80, 3))
+    {
+      out->oid3_present = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x80, 3, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->oid3.data = p;
+        out->oid3.len = end1 - p;
+        p = end1;
+      }
+    }
+  if (test_tree_peek (p, end, 0x80, 1))
+    {
+      out->oid_present = 1;
+      {
+        const unsigned char *end2;
+        result = test_tree_get_tl (&p, end, 0x80, 1, &end2);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->oid.data = p;
+        out->oid.len = end2 - p;
+        p = end2;
+      }
+    }
+  if (test_tree_peek (p, end, 0x80, 2))
+    {
+      out->oid2_present = 1;
+      {
+        const unsigned char *end3;
+        result = test_tree_get_tl (&p, end, 0x80, 2, &end3);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->oid2.data = p;
+        out->oid2.len = end3 - p;
+        p = end3;
+      }
+    }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_OidTest (const struct test_tree_OidTest *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  if (in->oid2_present)
+    {
+      {
+        int mark1 = w->pos;
+        test_tree_put (w, in->oid2.data, in->oid2.len);
+        test_tree_put_tl (w, 0x80, 2, mark1 - w->pos);
+      }
+    }
+  if (in->oid_present)
+    {
+      {
+        int mark2 = w->pos;
+        test_tree_put (w, in->oid.data, in->oid.len);
+        test_tree_put_tl (w, 0x80, 1, mark2 - w->pos);
+      }
+    }
+  if (in->oid3_present)
+    {
+      {
+        int mark3 = w->pos;
+        test_tree_put (w, in->oid3.data, in->oid3.len);
+        test_tree_put_tl (w, 0x80, 3, mark3 - w->pos);
+      }
+    }
+  return result;
+}
+
+int
+test_tree_decode_OidTest (const unsigned char *der, int der_len,
+	struct test_tree_OidTest *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_OidTest (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_OidTest (const struct test_tree_OidTest *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_OidTest (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_OidAndTimeTest (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_OidAndTimeTest *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 17, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->set.data = p;
+    out->set.len = end1 - p;
+    result = test_tree_count (p, end1, &out->set.count);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0x00, 6, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->oid.data = p;
+    out->oid.len = end2 - p;
+    p = end2;
+  }
+  {
+    const unsigned char *end3;
+    result = test_tree_get_tl (&p, end, 0x00, 24, &end3);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->time2.data = p;
+    out->time2.len = end3 - p;
+    p = end3;
+  }
+  {
+    const unsigned char *end4;
+    result = test_tree_get_tl (&p, end, 0x00, 1, &end4);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (end4 - p != 1)
+      return ASN1_DER_ERROR;
+    out->bol = (*p++ != 0);
+    if (p != end4)
+      return ASN1_DER_ERROR;
+  }
+  {
+    const unsigned char *end5;
+    result = test_tree_get_tl (&p, end, 0x00, 4, &end5);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->oct.data = p;
+    out->oct.len = end5 - p;
+    p = end5;
+  }
+  if (test_tree_peek (p, end, 0x00, 3))
+    {
+      out->bit_present = 1;
+      {
+        const unsigned char *end6;
+        result = test_tree_get_tl (&p, end, 0x00, 3, &end6);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->bit.data = p;
+        out->bit.len = end6 - p;
+        p = end6;
+      }
+    }
+  if (test_tree_peek (p, end, 0x00, 1))
+    {
+      out->bol2_present = 1;
+      {
+        const unsigned char *end7;
+        result = test_tree_get_tl (&p, end, 0x00, 1, &end7);
+        if (result != ASN1_SUCCESS)
+          return result;
+        if (end7 - p != 1)
+          return ASN1_DER_ERROR;
+        out->bol2 = (*p++ != 0);
+        if (p != end7)
+          return ASN1_DER_ERROR;
+      }
+    }
+  if (test_tree_peek (p, end, 0x00, 10))
+    {
+      out->enum__present = 1;
+      {
+        const unsigned char *end8;
+        result = test_tree_get_tl (&p, end, 0x00, 10, &end8);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end8, &out->enum_);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end8;
+      }
+    }
+  if (test_tree_peek (p, end, 0x80, 1))
+    {
+      out->any_present = 1;
+      result = test_tree_get_tag (&p, end, 0x80, 1);
+      if (result != ASN1_SUCCESS)
+        return result;
+      result = test_tree_get_tlv (&p, end, &out->any);
+      if (result != ASN1_SUCCESS)
+        return result;
+    }
+  if (test_tree_peek (p, end, 0x00, 27))
+    {
+      out->gen_present = 1;
+      {
+        const unsigned char *end9;
+        result = test_tree_get_tl (&p, end, 0x00, 27, &end9);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->gen.data = p;
+        out->gen.len = end9 - p;
+        p = end9;
+      }
+    }
+  {
+    const unsigned char *end10;
+    result = test_tree_get_tl (&p, end, 0x00, 23, &end10);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->time1.data = p;
+    out->time1.len = end10 - p;
+    p = end10;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_OidAndTimeTest (const struct test_tree_OidAndTimeTest *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    test_tree_put (w, in->time1.data, in->time1.len);
+    test_tree_put_tl (w, 0x00, 23, mark1 - w->pos);
+  }
+  if (in->gen_present)
+    {
+      {
+        int mark2 = w->pos;
+        test_tree_put (w, in->gen.data, in->gen.len);
+        test_tree_put_tl (w, 0x00, 27, mark2 - w->pos);
+      }
+    }
+  if (in->any_present)
+    {
+      test_tree_put (w, in->any.data, in->any.len);
+      test_tree_put_tag (w, 0x80, 1);
+    }
+  if (in->enum__present)
+    {
+      {
+        int mark3 = w->pos;
+        test_tree_put_int (w, in->enum_);
+        test_tree_put_tl (w, 0x00, 10, mark3 - w->pos);
+      }
+    }
+  if (in->bol2_present)
+    {
+      {
+        int mark4 = w->pos;
+        test_tree_put_byte (w, in->bol2 ? 0xff : 0x00);
+        test_tree_put_tl (w, 0x00, 1, mark4 - w->pos);
+      }
+    }
+  if (in->bit_present)
+    {
+      {
+        int mark5 = w->pos;
+        test_tree_put (w, in->bit.data, in->bit.len);
+        test_tree_put_tl (w, 0x00, 3, mark5 - w->pos);
+      }
+    }
+  {
+    int mark6 = w->pos;
+    test_tree_put (w, in->oct.data, in->oct.len);
+    test_tree_put_tl (w, 0x00, 4, mark6 - w->pos);
+  }
+  {
+    int mark7 = w->pos;
+    test_tree_put_byte (w, in->bol ? 0xff : 0x00);
+    test_tree_put_tl (w, 0x00, 1, mark7 - w->pos);
+  }
+  {
+    int mark8 = w->pos;
+    test_tree_put (w, in->time2.data, in->time2.len);
+    test_tree_put_tl (w, 0x00, 24, mark8 - w->pos);
+  }
+  {
+    int mark9 = w->pos;
+    test_tree_put (w, in->oid.data, in->oid.len);
+    test_tree_put_tl (w, 0x00, 6, mark9 - w->pos);
+  }
+  {
+    int mark10 = w->pos;
+    if (in->set.items)
+      {
+        int i11;
+
+        for (i11 = in->set.count - 1; i11 >= 0; i11--)
+          {
+            {
+              int mark12 = w->pos;
+              test_tree_put_int (w, in->set.items[i11]);
+              test_tree_put_tl (w, 0x00, 2, mark12 - w->pos);
+            }
+          }
+      }
+    else
+      test_tree_put (w, in->set.data, in->set.len);
+    test_tree_put_tl (w, 0x20, 17, mark10 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_OidAndTimeTest (const unsigned char *der, int der_len,
+	struct test_tree_OidAndTimeTest *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_OidAndTimeTest (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_OidAndTimeTest (const struct test_tree_OidAndTimeTest *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_OidAndTimeTest (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+int
+test_tree_next_OidAndTimeTest_set (test_tree_iter *it, int64_t *out)
+{
+  const unsigned char *p = it->p;
+  int result = ASN1_SUCCESS;
+
+  if (p >= it->end)
+    return ASN1_ELEMENT_NOT_FOUND;
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, it->end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &(*out));
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  it->p = p;
+  return result;
+}
+
+static int
+test_tree_dec_Time (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Time *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x00, 23))
+    {
+      out->choice = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x00, 23, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->utcTime.data = p;
+        out->utcTime.len = end1 - p;
+        p = end1;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 24))
+    {
+      out->choice = 2;
+      {
+        const unsigned char *end2;
+        result = test_tree_get_tl (&p, end, 0x00, 24, &end2);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->generalTime.data = p;
+        out->generalTime.len = end2 - p;
+        p = end2;
+      }
+    }
+  else
+    return ASN1_TAG_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Time (const struct test_tree_Time *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  switch (in->choice)
+    {
+    case 1:
+      {
+        int mark1 = w->pos;
+        test_tree_put (w, in->utcTime.data, in->utcTime.len);
+        test_tree_put_tl (w, 0x00, 23, mark1 - w->pos);
+      }
+      break;
+    case 2:
+      {
+        int mark2 = w->pos;
+        test_tree_put (w, in->generalTime.data, in->generalTime.len);
+        test_tree_put_tl (w, 0x00, 24, mark2 - w->pos);
+      }
+      break;
+    default:
+      return ASN1_VALUE_NOT_FOUND;
+    }
+  return result;
+}
+
+int
+test_tree_decode_Time (const unsigned char *der, int der_len,
+	struct test_tree_Time *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  result = test_tree_dec_Time (&p, end, out);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Time (const struct test_tree_Time *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  result = test_tree_enc_Time (in, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Validity (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Validity *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  result = test_tree_dec_Time (&p, end, &out->notBefore);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_dec_Time (&p, end, &out->notAfter);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Validity (const struct test_tree_Validity *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  result = test_tree_enc_Time (&in->notAfter, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_enc_Time (&in->notBefore, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  return result;
+}
+
+int
+test_tree_decode_Validity (const unsigned char *der, int der_len,
+	struct test_tree_Validity *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Validity (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Validity (const struct test_tree_Validity *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_Validity (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_SequenceTestTag (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_SequenceTestTag *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0xa0, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    {
+      const unsigned char *end2;
+      result = test_tree_get_tl (&p, end1, 0x00, 2, &end2);
+      if (result != ASN1_SUCCESS)
+        return result;
+      result = test_tree_get_int (p, end2, &out->int1);
+      if (result != ASN1_SUCCESS)
+        return result;
+      p = end2;
+    }
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  {
+    const unsigned char *end3;
+    result = test_tree_get_tl (&p, end, 0x80, 3, &end3);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end3, &out->int2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end3;
+  }
+  {
+    const unsigned char *end4;
+    result = test_tree_get_tl (&p, end, 0x80, 1, &end4);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->str1.data = p;
+    out->str1.len = end4 - p;
+    p = end4;
+  }
+  {
+    const unsigned char *end5;
+    result = test_tree_get_tl (&p, end, 0x00, 28, &end5);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->str2.data = p;
+    out->str2.len = end5 - p;
+    p = end5;
+  }
+  {
+    const unsigned char *end6;
+    result = test_tree_get_tl (&p, end, 0xa0, 2, &end6);
+    if (result != ASN1_SUCCESS)
+      return result;
+    {
+      const unsigned char *end7;
+      result = test_tree_get_tl (&p, end6, 0x00, 28, &end7);
+      if (result != ASN1_SUCCESS)
+        return result;
+      out->str3.data = p;
+      out->str3.len = end7 - p;
+      p = end7;
+    }
+    if (p != end6)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_SequenceTestTag (const struct test_tree_SequenceTestTag *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    {
+      int mark2 = w->pos;
+      test_tree_put (w, in->str3.data, in->str3.len);
+      test_tree_put_tl (w, 0x00, 28, mark2 - w->pos);
+    }
+    test_tree_put_tl (w, 0xa0, 2, mark1 - w->pos);
+  }
+  {
+    int mark3 = w->pos;
+    test_tree_put (w, in->str2.data, in->str2.len);
+    test_tree_put_tl (w, 0x00, 28, mark3 - w->pos);
+  }
+  {
+    int mark4 = w->pos;
+    test_tree_put (w, in->str1.data, in->str1.len);
+    test_tree_put_tl (w, 0x80, 1, mark4 - w->pos);
+  }
+  {
+    int mark5 = w->pos;
+    test_tree_put_int (w, in->int2);
+    test_tree_put_tl (w, 0x80, 3, mark5 - w->pos);
+  }
+  {
+    int mark6 = w->pos;
+    {
+      int mark7 = w->pos;
+      test_tree_put_int (w, in->int1);
+      test_tree_put_tl (w, 0x00, 2, mark7 - w->pos);
+    }
+    test_tree_put_tl (w, 0xa0, 2, mark6 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_SequenceTestTag (const unsigned char *der, int der_len,
+	struct test_tree_SequenceTestTag *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_SequenceTestTag (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_SequenceTestTag (const struct test_tree_SequenceTestTag *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_SequenceTestTag (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Sequence1 (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Sequence1 *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x80, 0))
+    {
+      out->int1_present = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x80, 0, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end1, &out->int1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end1;
+      }
+    }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end2, &out->int2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end2;
+  }
+  {
+    const unsigned char *end3;
+    result = test_tree_get_tl (&p, end, 0x20, 17, &end3);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->seq.data = p;
+    out->seq.len = end3 - p;
+    result = test_tree_count (p, end3, &out->seq.count);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end3;
+  }
+  {
+    const unsigned char *end4;
+    result = test_tree_get_tl (&p, end, 0x00, 6, &end4);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->id.data = p;
+    out->id.len = end4 - p;
+    p = end4;
+  }
+  {
+    const unsigned char *end5;
+    result = test_tree_get_tl (&p, end, 0x00, 4, &end5);
+    if (result != ASN1_SUCCESS)
+      return result;
+    out->oct.data = p;
+    out->oct.len = end5 - p;
+    p = end5;
+  }
+  if (p < end)
+    {
+      out->any1_present = 1;
+      result = test_tree_get_tlv (&p, end, &out->any1);
+      if (result != ASN1_SUCCESS)
+        return result;
+    }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Sequence1 (const struct test_tree_Sequence1 *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  if (in->any1_present)
+    {
+      test_tree_put (w, in->any1.data, in->any1.len);
+    }
+  {
+    int mark1 = w->pos;
+    test_tree_put (w, in->oct.data, in->oct.len);
+    test_tree_put_tl (w, 0x00, 4, mark1 - w->pos);
+  }
+  {
+    int mark2 = w->pos;
+    test_tree_put (w, in->id.data, in->id.len);
+    test_tree_put_tl (w, 0x00, 6, mark2 - w->pos);
+  }
+  {
+    int mark3 = w->pos;
+    if (in->seq.items)
+      {
+        int i4;
+
+        for (i4 = in->seq.count - 1; i4 >= 0; i4--)
+          {
+            {
+              int mark5 = w->pos;
+              test_tree_put_int (w, in->seq.items[i4]);
+              test_tree_put_tl (w, 0x00, 2, mark5 - w->pos);
+            }
+          }
+      }
+    else
+      test_tree_put (w, in->seq.data, in->seq.len);
+    test_tree_put_tl (w, 0x20, 17, mark3 - w->pos);
+  }
+  {
+    int mark6 = w->pos;
+    test_tree_put_int (w, in->int2);
+    test_tree_put_tl (w, 0x00, 2, mark6 - w->pos);
+  }
+  if (in->int1_present)
+    {
+      {
+        int mark7 = w->pos;
+        test_tree_put_int (w, in->int1);
+        test_tree_put_tl (w, 0x80, 0, mark7 - w->pos);
+      }
+    }
+  return result;
+}
+
+int
+test_tree_decode_Sequence1 (const unsigned char *der, int der_len,
+	struct test_tree_Sequence1 *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Sequence1 (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Sequence1 (const struct test_tree_Sequence1 *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_Sequence1 (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+int
+test_tree_next_Sequence1_seq (test_tree_iter *it, int64_t *out)
+{
+  const unsigned char *p = it->p;
+  int result = ASN1_SUCCESS;
+
+  if (p >= it->end)
+    return ASN1_ELEMENT_NOT_FOUND;
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, it->end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &(*out));
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  it->p = p;
+  return result;
+}
+
+static int
+test_tree_dec_DHParameter (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_DHParameter *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &out->prime);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end2, &out->base);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end2;
+  }
+  if (test_tree_peek (p, end, 0x00, 2))
+    {
+      out->privateValueLength_present = 1;
+      {
+        const unsigned char *end3;
+        result = test_tree_get_tl (&p, end, 0x00, 2, &end3);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end3, &out->privateValueLength);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end3;
+      }
+    }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_DHParameter (const struct test_tree_DHParameter *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  if (in->privateValueLength_present)
+    {
+      {
+        int mark1 = w->pos;
+        test_tree_put_int (w, in->privateValueLength);
+        test_tree_put_tl (w, 0x00, 2, mark1 - w->pos);
+      }
+    }
+  {
+    int mark2 = w->pos;
+    test_tree_put_int (w, in->base);
+    test_tree_put_tl (w, 0x00, 2, mark2 - w->pos);
+  }
+  {
+    int mark3 = w->pos;
+    test_tree_put_int (w, in->prime);
+    test_tree_put_tl (w, 0x00, 2, mark3 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_DHParameter (const unsigned char *der, int der_len,
+	struct test_tree_DHParameter *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_DHParameter (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_DHParameter (const struct test_tree_DHParameter *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_DHParameter (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_AnyTest2 (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_AnyTest2 *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x00, 4))
+    {
+      out->choice = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x00, 4, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->str.data = p;
+        out->str.len = end1 - p;
+        p = end1;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 2))
+    {
+      out->choice = 2;
+      {
+        const unsigned char *end2;
+        result = test_tree_get_tl (&p, end, 0x00, 2, &end2);
+        if (result != ASN1_SUCCESS)
+          return result;
+        result = test_tree_get_int (p, end2, &out->int_);
+        if (result != ASN1_SUCCESS)
+          return result;
+        p = end2;
+      }
+    }
+  else
+    return ASN1_TAG_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_AnyTest2 (const struct test_tree_AnyTest2 *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  switch (in->choice)
+    {
+    case 1:
+      {
+        int mark1 = w->pos;
+        test_tree_put (w, in->str.data, in->str.len);
+        test_tree_put_tl (w, 0x00, 4, mark1 - w->pos);
+      }
+      break;
+    case 2:
+      {
+        int mark2 = w->pos;
+        test_tree_put_int (w, in->int_);
+        test_tree_put_tl (w, 0x00, 2, mark2 - w->pos);
+      }
+      break;
+    default:
+      return ASN1_VALUE_NOT_FOUND;
+    }
+  return result;
+}
+
+int
+test_tree_decode_AnyTest2 (const unsigned char *der, int der_len,
+	struct test_tree_AnyTest2 *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  result = test_tree_dec_AnyTest2 (&p, end, out);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_AnyTest2 (const struct test_tree_AnyTest2 *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  result = test_tree_enc_AnyTest2 (in, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_Test3 (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_Test3 *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x00, 2, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_get_int (p, end1, &out->a);
+    if (result != ASN1_SUCCESS)
+      return result;
+    p = end1;
+  }
+  {
+    const unsigned char *end2;
+    result = test_tree_get_tl (&p, end, 0xa0, 1, &end2);
+    if (result != ASN1_SUCCESS)
+      return result;
+    {
+      const unsigned char *end3;
+      result = test_tree_get_tl (&p, end2, 0xa0, 2, &end3);
+      if (result != ASN1_SUCCESS)
+        return result;
+      {
+        const unsigned char *end4;
+        result = test_tree_get_tl (&p, end3, 0x00, 27, &end4);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->b.data = p;
+        out->b.len = end4 - p;
+        p = end4;
+      }
+      if (p != end3)
+        return ASN1_DER_ERROR;
+    }
+    if (p != end2)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_Test3 (const struct test_tree_Test3 *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  {
+    int mark1 = w->pos;
+    {
+      int mark2 = w->pos;
+      {
+        int mark3 = w->pos;
+        test_tree_put (w, in->b.data, in->b.len);
+        test_tree_put_tl (w, 0x00, 27, mark3 - w->pos);
+      }
+      test_tree_put_tl (w, 0xa0, 2, mark2 - w->pos);
+    }
+    test_tree_put_tl (w, 0xa0, 1, mark1 - w->pos);
+  }
+  {
+    int mark4 = w->pos;
+    test_tree_put_int (w, in->a);
+    test_tree_put_tl (w, 0x00, 2, mark4 - w->pos);
+  }
+  return result;
+}
+
+int
+test_tree_decode_Test3 (const unsigned char *der, int der_len,
+	struct test_tree_Test3 *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  {
+    const unsigned char *end1;
+    result = test_tree_get_tl (&p, end, 0x20, 16, &end1);
+    if (result != ASN1_SUCCESS)
+      return result;
+    result = test_tree_dec_Test3 (&p, end1, out);
+    if (result != ASN1_SUCCESS)
+      return result;
+    if (p != end1)
+      return ASN1_DER_ERROR;
+  }
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_Test3 (const struct test_tree_Test3 *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  {
+    int mark1 = w->pos;
+    result = test_tree_enc_Test3 (in, w);
+    if (result != ASN1_SUCCESS)
+      return result;
+    test_tree_put_tl (w, 0x20, 16, mark1 - w->pos);
+  }
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
+static int
+test_tree_dec_X520LocalityName (const unsigned char **pp, const unsigned char *end,
+	struct test_tree_X520LocalityName *out)
+{
+  const unsigned char *p = *pp;
+  int result = ASN1_SUCCESS;
+
+  if (test_tree_peek (p, end, 0x00, 20))
+    {
+      out->choice = 1;
+      {
+        const unsigned char *end1;
+        result = test_tree_get_tl (&p, end, 0x00, 20, &end1);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->teletexString.data = p;
+        out->teletexString.len = end1 - p;
+        p = end1;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 19))
+    {
+      out->choice = 2;
+      {
+        const unsigned char *end2;
+        result = test_tree_get_tl (&p, end, 0x00, 19, &end2);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->printableString.data = p;
+        out->printableString.len = end2 - p;
+        p = end2;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 28))
+    {
+      out->choice = 3;
+      {
+        const unsigned char *end3;
+        result = test_tree_get_tl (&p, end, 0x00, 28, &end3);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->universalString.data = p;
+        out->universalString.len = end3 - p;
+        p = end3;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 12))
+    {
+      out->choice = 4;
+      {
+        const unsigned char *end4;
+        result = test_tree_get_tl (&p, end, 0x00, 12, &end4);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->utf8String.data = p;
+        out->utf8String.len = end4 - p;
+        p = end4;
+      }
+    }
+  else if (test_tree_peek (p, end, 0x00, 30))
+    {
+      out->choice = 5;
+      {
+        const unsigned char *end5;
+        result = test_tree_get_tl (&p, end, 0x00, 30, &end5);
+        if (result != ASN1_SUCCESS)
+          return result;
+        out->bmpString.data = p;
+        out->bmpString.len = end5 - p;
+        p = end5;
+      }
+    }
+  else
+    return ASN1_TAG_ERROR;
+  *pp = p;
+  return result;
+}
+
+static int
+test_tree_enc_X520LocalityName (const struct test_tree_X520LocalityName *in, test_tree_writer *w)
+{
+  int result = ASN1_SUCCESS;
+
+  switch (in->choice)
+    {
+    case 1:
+      {
+        int mark1 = w->pos;
+        test_tree_put (w, in->teletexString.data, in->teletexString.len);
+        test_tree_put_tl (w, 0x00, 20, mark1 - w->pos);
+      }
+      break;
+    case 2:
+      {
+        int mark2 = w->pos;
+        test_tree_put (w, in->printableString.data, in->printableString.len);
+        test_tree_put_tl (w, 0x00, 19, mark2 - w->pos);
+      }
+      break;
+    case 3:
+      {
+        int mark3 = w->pos;
+        test_tree_put (w, in->universalString.data, in->universalString.len);
+        test_tree_put_tl (w, 0x00, 28, mark3 - w->pos);
+      }
+      break;
+    case 4:
+      {
+        int mark4 = w->pos;
+        test_tree_put (w, in->utf8String.data, in->utf8String.len);
+        test_tree_put_tl (w, 0x00, 12, mark4 - w->pos);
+      }
+      break;
+    case 5:
+      {
+        int mark5 = w->pos;
+        test_tree_put (w, in->bmpString.data, in->bmpString.len);
+        test_tree_put_tl (w, 0x00, 30, mark5 - w->pos);
+      }
+      break;
+    default:
+      return ASN1_VALUE_NOT_FOUND;
+    }
+  return result;
+}
+
+int
+test_tree_decode_X520LocalityName (const unsigned char *der, int der_len,
+	struct test_tree_X520LocalityName *out)
+{
+  const unsigned char *p = der;
+  const unsigned char *end = der + der_len;
+  int result = ASN1_SUCCESS;
+
+  memset (out, 0, sizeof (*out));
+  result = test_tree_dec_X520LocalityName (&p, end, out);
+  if (result != ASN1_SUCCESS)
+    return result;
+  if (p != end)
+    return ASN1_DER_ERROR;
+  return result;
+}
+
+int
+test_tree_encode_X520LocalityName (const struct test_tree_X520LocalityName *in, unsigned char *der,
+	int *der_len)
+{
+  test_tree_writer writer, *w = &writer;
+  int result = ASN1_SUCCESS;
+
+  w->buf = der;
+  w->size = der ? *der_len : 0;
+  w->pos = w->size;
+  result = test_tree_enc_X520LocalityName (in, w);
+  if (result != ASN1_SUCCESS)
+    return result;
+  result = test_tree_finish (w, der_len);
+  return result;
+}
+
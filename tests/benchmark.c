@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: benchmark.c                                 */
+/* Description: Measure the throughput of            */
+/*     asn1_parser2tree,                             */
+/*     asn1_array2tree,                              */
+/*     asn1_create_element,                          */
+/*     asn1_der_decoding,                            */
+/*     asn1_der_coding,                              */
+/*     asn1_read_value.                              */
+/*   Run it with "make bench".                       */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include "libtasn1.h"
+
+#include "Test_tree_asn1_tab.c"
+
+/* Number of entries of the generated CRL */
+#define CRL_ENTRIES 1000
+
+typedef struct
+{
+  const char *name;
+  void (*run) (void);		/* one operation */
+} bench_type;
+
+typedef struct
+{
+  const char *type;
+  unsigned char *der;
+  int der_len;
+  ASN1_TYPE element;		/* decoded from der */
+} sample_type;
+
+static const char *treefile;
+static ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+static sample_type certificate = { "PKIX1.Certificate", NULL, 0, NULL };
+static sample_type pfx = { "PKIX1.pkcs-12-PFX", NULL, 0, NULL };
+static sample_type crl = { "PKIX1.CertificateList", NULL, 0, NULL };
+static unsigned char coding[64 * 1024];
+
+/* Counts the allocations of the library, set with
+   asn1_set_allocator.  */
+static unsigned long allocations;
+
+static void *
+count_malloc (size_t size, void *ctx)
+{
+  allocations++;
+  return malloc (size);
+}
+
+static void *
+count_realloc (void *ptr, size_t size, void *ctx)
+{
+  allocations++;
+  return realloc (ptr, size);
+}
+
+static void
+count_free (void *ptr, void *ctx)
+{
+  free (ptr);
+}
+
+static void
+check (const char *what, asn1_retCode result)
+{
+  if (result != ASN1_SUCCESS)
+    {
+      printf ("%s: %s\n", what, asn1_strerror (result));
+      exit (1);
+    }
+}
+
+static double
+now (void)
+{
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void
+read_sample (sample_type * sample, const char *file_name)
+{
+  FILE *fd;
+  long size;
+
+  fd = fopen (file_name, "rb");
+  if (fd == NULL || fseek (fd, 0, SEEK_END) || (size = ftell (fd)) <= 0)
+    {
+      printf ("Cannot read file %s\n", file_name);
+      exit (1);
+    }
+  rewind (fd);
+  sample->der = malloc (size);
+  if (sample->der == NULL
+      || (sample->der_len = fread (sample->der, 1, size, fd)) != size)
+    {
+      printf ("Cannot read from file %s\n", file_name);
+      exit (1);
+    }
+  fclose (fd);
+}
+
+/* Writes a CRL of CRL_ENTRIES revoked certificates.  */
+static ASN1_TYPE
+write_crl (void)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+  unsigned char signature[128];
+  char serial[16];
+  int k;
+
+  check ("write CRL",
+	 asn1_create_element (definitions, crl.type, &element));
+
+#define WRITE(name, value, len) \
+  check (name, asn1_write_value (element, name, value, len))
+
+  WRITE ("tbsCertList.version", "v2", 0);
+  WRITE ("tbsCertList.signature.algorithm", "1.2.840.113549.1.1.5", 0);
+  WRITE ("tbsCertList.signature.parameters", "\x05\x00", 2);
+  WRITE ("tbsCertList.issuer", "rdnSequence", 0);
+  WRITE ("tbsCertList.issuer.rdnSequence", "NEW", 0);
+  WRITE ("tbsCertList.issuer.rdnSequence.?LAST", "NEW", 0);
+  WRITE ("tbsCertList.issuer.rdnSequence.?LAST.?LAST.type", "2.5.4.3", 0);
+  WRITE ("tbsCertList.issuer.rdnSequence.?LAST.?LAST.value",
+	 "\x13\x07Test CA", 9);
+  WRITE ("tbsCertList.thisUpdate", "utcTime", 0);
+  WRITE ("tbsCertList.thisUpdate.utcTime", "110101000000Z", 1);
+  WRITE ("tbsCertList.nextUpdate", NULL, 0);
+  for (k = 0; k < CRL_ENTRIES; k++)
+    {
+      sprintf (serial, "%d", 1000000 + k);
+      WRITE ("tbsCertList.revokedCertificates", "NEW", 1);
+      WRITE ("tbsCertList.revokedCertificates.?LAST.userCertificate",
+	     serial, 0);
+      WRITE ("tbsCertList.revokedCertificates.?LAST.revocationDate",
+	     "utcTime", 0);
+      WRITE ("tbsCertList.revokedCertificates.?LAST.revocationDate.utcTime",
+	     "110101000000Z", 1);
+      WRITE ("tbsCertList.revokedCertificates.?LAST.crlEntryExtensions",
+	     NULL, 0);
+    }
+  WRITE ("tbsCertList.crlExtensions", NULL, 0);
+  WRITE ("signatureAlgorithm.algorithm", "1.2.840.113549.1.1.5", 0);
+  WRITE ("signatureAlgorithm.parameters", "\x05\x00", 2);
+  memset (signature, 0x5a, sizeof (signature));
+  WRITE ("signature", signature, sizeof (signature) * 8);
+
+#undef WRITE
+
+  return element;
+}
+
+static void
+generate_crl (sample_type * sample)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  ASN1_TYPE element = write_crl ();
+
+  sample->der_len = sizeof (coding);
+  check ("generate CRL",
+	 asn1_der_coding (element, "", coding, &sample->der_len,
+			  errorDescription));
+  sample->der = malloc (sample->der_len);
+  if (sample->der == NULL)
+    {
+      printf ("generate CRL: memory exhausted\n");
+      exit (1);
+    }
+  memcpy (sample->der, coding, sample->der_len);
+
+  asn1_delete_structure (&element);
+}
+
+static void
+decode_sample (sample_type * sample, ASN1_TYPE * element)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+
+  check (sample->type, asn1_create_element (definitions, sample->type,
+					    element));
+  check (sample->type, asn1_der_decoding (element, sample->der,
+					  sample->der_len, errorDescription));
+}
+
+static void
+code_sample (sample_type * sample)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  int len = sizeof (coding);
+
+  check (sample->type, asn1_der_coding (sample->element, "", coding, &len,
+					errorDescription));
+}
+
+static void
+bench_write_crl (void)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  ASN1_TYPE element = write_crl ();
+  int len = sizeof (coding);
+
+  check ("CRL", asn1_der_coding (element, "", coding, &len,
+				 errorDescription));
+  asn1_delete_structure (&element);
+}
+
+/* Changes one entry of the decoded CRL, so that only the elements
+   holding it are encoded again.  */
+static void
+bench_modify_crl (void)
+{
+  static unsigned int k;
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  char path[64];
+  int len = sizeof (coding);
+
+  sprintf (path, "tbsCertList.revokedCertificates.?%u.userCertificate",
+	   k % CRL_ENTRIES + 1);
+  check (path, asn1_write_value (crl.element, path, "1", 0));
+  check ("CRL", asn1_der_coding (crl.element, "", coding, &len,
+				 errorDescription));
+  k++;
+}
+
+static void
+bench_parser2tree (void)
+{
+  ASN1_TYPE tree = ASN1_TYPE_EMPTY;
+
+  check ("asn1_parser2tree", asn1_parser2tree (treefile, &tree, NULL));
+  asn1_delete_structure (&tree);
+}
+
+static void
+bench_array2tree (void)
+{
+  ASN1_TYPE tree = ASN1_TYPE_EMPTY;
+
+  check ("asn1_array2tree", asn1_array2tree (Test_tree_asn1_tab, &tree,
+					     NULL));
+  asn1_delete_structure (&tree);
+}
+
+static void
+bench_create_element (void)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY;
+
+  check ("asn1_create_element",
+	 asn1_create_element (definitions, certificate.type, &element));
+  asn1_delete_structure (&element);
+}
+
+#define BENCH_SAMPLE(sample)				\
+  static void						\
+  bench_decode_##sample (void)				\
+  {							\
+    ASN1_TYPE element = ASN1_TYPE_EMPTY;		\
+    decode_sample (&sample, &element);			\
+    asn1_delete_structure (&element);			\
+  }							\
+  static void						\
+  bench_code_##sample (void)				\
+  {							\
+    code_sample (&sample);				\
+  }
+
+BENCH_SAMPLE (certificate)
+BENCH_SAMPLE (pfx)
+BENCH_SAMPLE (crl)
+
+static const char *certificate_paths[] = {
+  "tbsCertificate.serialNumber",
+  "tbsCertificate.signature.algorithm",
+  "tbsCertificate.issuer.rdnSequence.?1.?1.value",
+  "tbsCertificate.validity.notAfter.utcTime",
+  "tbsCertificate.subject.rdnSequence.?3.?1.type",
+  "tbsCertificate.subjectPublicKeyInfo.subjectPublicKey",
+  "signatureAlgorithm.algorithm",
+  "signature"
+};
+
+#define PATHS (sizeof (certificate_paths) / sizeof (certificate_paths[0]))
+
+static void
+bench_read_certificate (void)
+{
+  static unsigned int k;
+  int len = sizeof (coding);
+
+  check (certificate_paths[k % PATHS],
+	 asn1_read_value (certificate.element, certificate_paths[k % PATHS],
+			  coding, &len));
+  k++;
+}
+
+static void
+bench_read_crl (void)
+{
+  static unsigned int k;
+  char path[64];
+  int len = sizeof (coding);
+
+  sprintf (path, "tbsCertList.revokedCertificates.?%u.userCertificate",
+	   k % CRL_ENTRIES + 1);
+  check (path, asn1_read_value (crl.element, path, coding, &len));
+  k++;
+}
+
+/* Decoded elements keep their encoding, which asn1_der_coding copies
+   while they do not change.  */
+static const bench_type bench_array[] = {
+  {"parser2tree pkix.asn", bench_parser2tree},
+  {"array2tree Test_tree", bench_array2tree},
+  {"create_element Certificate", bench_create_element},
+  {"der_decoding Certificate", bench_decode_certificate},
+  {"der_decoding pkcs-12-PFX", bench_decode_pfx},
+  {"der_decoding CRL", bench_decode_crl},
+  {"der_coding Certificate", bench_code_certificate},
+  {"der_coding pkcs-12-PFX", bench_code_pfx},
+  {"der_coding CRL", bench_code_crl},
+  {"der_coding modified CRL", bench_modify_crl},
+  {"write+der_coding CRL", bench_write_crl},
+  {"read_value Certificate", bench_read_certificate},
+  {"read_value CRL ?N", bench_read_crl},
+
+  /* end */
+  {NULL}
+};
+
+/* Runs BENCH for SECONDS, doubling the number of operations between
+   two readings of the clock.  */
+static void
+measure (const bench_type * bench, double seconds)
+{
+  unsigned long n, k, ops = 0;
+  double start, elapsed;
+
+  bench->run ();
+
+  allocations = 0;
+  start = now ();
+  for (n = 1;; n *= 2)
+    {
+      for (k = 0; k < n; k++)
+	bench->run ();
+      ops += n;
+      elapsed = now () - start;
+      if (elapsed >= seconds)
+	break;
+    }
+
+  printf ("%-28s %12.0f %14.1f", bench->name, ops / elapsed,
+	  elapsed * 1e9 / ops);
+  printf (" %11.1f\n", (double) allocations / ops);
+}
+
+int
+main (int argc, char *argv[])
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  const bench_type *bench;
+  const char *certfile = getenv ("ASN1CRLF");
+  const char *indeffile = getenv ("ASN1INDEF");
+  const char *benchtime = getenv ("BENCH_TIME");
+  double seconds = benchtime ? atof (benchtime) : 0.5;
+  int k;
+
+  treefile = getenv ("ASN1PKIX");
+  if (!treefile)
+    treefile = "pkix.asn";
+  if (!certfile)
+    certfile = "crlf.cer";
+  if (!indeffile)
+    indeffile = "TestIndef.p12";
+
+  check ("asn1_set_allocator", asn1_set_allocator (count_malloc,
+						   count_realloc,
+						   count_free, NULL));
+  check ("asn1_parser2tree", asn1_parser2tree (treefile, &definitions,
+					       errorDescription));
+
+  read_sample (&certificate, certfile);
+  read_sample (&pfx, indeffile);
+  generate_crl (&crl);
+
+  decode_sample (&certificate, &certificate.element);
+  decode_sample (&pfx, &pfx.element);
+  decode_sample (&crl, &crl.element);
+
+  printf ("Certificate: %d bytes, pkcs-12-PFX: %d bytes, CRL: %d bytes\n\n",
+	  certificate.der_len, pfx.der_len, crl.der_len);
+  printf ("%-28s %12s %14s %11s\n", "benchmark", "ops/s", "ns/op",
+	  "allocs/op");
+
+  /* The arguments select the benchmarks whose name contains one of
+     them.  */
+  for (bench = bench_array; bench->name; bench++)
+    {
+      for (k = 1; k < argc; k++)
+	if (strstr (bench->name, argv[k]))
+	  break;
+      if (argc == 1 || k < argc)
+	measure (bench, seconds);
+    }
+
+  asn1_delete_structure (&certificate.element);
+  asn1_delete_structure (&pfx.element);
+  asn1_delete_structure (&crl.element);
+  asn1_delete_structure (&definitions);
+  free (certificate.der);
+  free (pfx.der);
+  free (crl.der);
+
+  exit (0);
+}
@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2011 Free Software Foundation, Inc.
+ *
+ * This file is part of LIBTASN1.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*****************************************************/
+/* File: fuzz.c                                      */
+/* Description: Fuzzing targets for                  */
+/*     asn1_der_decoding,                            */
+/*     asn1_der_decoding2,                           */
+/*     asn1_der_decoding_options,                    */
+/*     asn1_decoder_decode,                          */
+/*     asn1_der_decoding_startEnd,                   */
+/*     asn1_get_length_ber,                          */
+/*     asn1_parser2tree.                             */
+/*   fuzz_der aborts when the decoders disagree, or  */
+/*   when an element encodes otherwise than one      */
+/*   decoded without keeping its encoding.           */
+/*   Built as fuzz_der and fuzz_parser, which take   */
+/*   the files to run as arguments, as AFL does.     */
+/*   With -DFUZZ_LIBFUZZER they have the entry point */
+/*   of libFuzzer instead.  The definitions are read */
+/*   from $ASN1PKIX, or pkix.asn.  Test_fuzz         */
+/*   includes this file to replay the inputs in      */
+/*   "make check".                                   */
+/*****************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "libtasn1.h"
+
+/* Types of pkix.asn decoded by fuzz_der, with an element read by
+   asn1_der_decoding_startEnd */
+static const struct
+{
+  const char *type;
+  const char *name;
+} fuzz_types[] =
+{
+  {"PKIX1.Certificate", "tbsCertificate.subject"},
+  {"PKIX1.CertificateList", "tbsCertList.issuer"},
+  {"PKIX1.pkcs-12-PFX", "authSafe.content"},
+  {"PKIX1.pkcs-7-ContentInfo", "content"},
+  {"PKIX1.Name", "rdnSequence"}
+};
+
+#define FUZZ_TYPES (sizeof (fuzz_types) / sizeof (fuzz_types[0]))
+
+/* Limits of asn1_der_decoding_options and of the decoders, low
+   enough for the inputs to reach them */
+static const asn1_decode_options fuzz_options = {
+  sizeof (asn1_decode_options), ASN1_DECODE_KEEP_DER,
+  16,				/* max_depth */
+  4096,				/* max_nodes */
+  64 * 1024,			/* max_value_bytes */
+  4,				/* max_indefinite */
+  16 * 1024			/* max_pool_bytes */
+};
+
+/* Decodings of an input as each type by fuzz_der: two with
+   asn1_der_decoding, four with asn1_der_decoding2, one with
+   asn1_der_decoding_options and one with the decoder */
+#define FUZZ_PASSES 8
+
+/* Memory recycled by asn1_set_recycling while decoding with
+   asn1_der_decoding2 */
+#define FUZZ_RECYCLING (64 * 1024)
+
+int fuzz_der (const unsigned char *data, size_t size);
+asn1_retCode fuzz_parser (const unsigned char *data, size_t size);
+
+static ASN1_TYPE fuzz_definitions = ASN1_TYPE_EMPTY;
+
+/* A decoder for each type of fuzz_types, kept from an input to the
+   next so that they reuse their memory */
+static asn1_decoder *fuzz_decoders[FUZZ_TYPES];
+
+/* Parses the definitions of pkix.asn and creates the decoders,
+   once.  */
+static void
+fuzz_init (void)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  const char *treefile = getenv ("ASN1PKIX");
+  asn1_retCode result;
+  size_t k;
+
+  if (fuzz_definitions != ASN1_TYPE_EMPTY)
+    return;
+
+  if (!treefile)
+    treefile = "pkix.asn";
+
+  result = asn1_parser2tree (treefile, &fuzz_definitions, errorDescription);
+  if (result != ASN1_SUCCESS)
+    {
+      asn1_perror (result);
+      printf ("ErrorDescription = %s\n\n", errorDescription);
+      exit (1);
+    }
+
+  for (k = 0; k < FUZZ_TYPES; k++)
+    {
+      result = asn1_decoder_init (fuzz_definitions, fuzz_types[k].type,
+				  &fuzz_options, &fuzz_decoders[k]);
+      if (result != ASN1_SUCCESS)
+	{
+	  asn1_perror (result);
+	  exit (1);
+	}
+    }
+}
+
+/* Deletes what fuzz_init created.  */
+static void
+fuzz_deinit (void)
+{
+  size_t k;
+
+  for (k = 0; k < FUZZ_TYPES; k++)
+    asn1_decoder_deinit (&fuzz_decoders[k]);
+  asn1_delete_structure (&fuzz_definitions);
+}
+
+/* Stops the fuzzer on the input decoded as the type K, on which
+   WHAT differs from asn1_der_decoding.  */
+static void
+fuzz_fail (size_t k, const char *what)
+{
+  printf ("%s: %s differs from asn1_der_decoding\n", fuzz_types[k].type,
+	  what);
+  fflush (stdout);
+  abort ();
+}
+
+/* Encodes ELEMENT in a new buffer of *LEN bytes.  Returns NULL if it
+   could not be.  */
+static unsigned char *
+fuzz_encode (ASN1_TYPE element, int *len)
+{
+  unsigned char *coding;
+
+  *len = 0;
+  if (asn1_der_coding (element, "", NULL, len, NULL) != ASN1_MEM_ERROR)
+    return NULL;
+
+  coding = malloc (*len);
+  if (coding != NULL
+      && asn1_der_coding (element, "", coding, len, NULL) != ASN1_SUCCESS)
+    {
+      free (coding);
+      coding = NULL;
+    }
+
+  return coding;
+}
+
+/* Encodes ELEMENT, decoded as the type K, and calls fuzz_fail with
+   WHAT unless it gives the LEN bytes of CODING, or fails when CODING
+   is NULL.  */
+static void
+fuzz_compare (size_t k, ASN1_TYPE element, const unsigned char *coding,
+	      int len, const char *what)
+{
+  unsigned char *other;
+  int other_len;
+
+  other = fuzz_encode (element, &other_len);
+  if ((other == NULL) != (coding == NULL)
+      || (coding != NULL
+	  && (other_len != len || memcmp (other, coding, len) != 0)))
+    fuzz_fail (k, what);
+  free (other);
+}
+
+/* Decodes DATA, of SIZE bytes, as the type K with
+   asn1_der_decoding2 and each combination of its flags, recycling the
+   memory.
+   RESULT is that of asn1_der_decoding, and CODING and EXPANDED are
+   the encodings of its element before and after
+   asn1_expand_any_defined_by, which the elements decoded here must
+   give too, once encoded before.  */
+static void
+fuzz_kept (size_t k, const unsigned char *data, int size,
+	   asn1_retCode result, const unsigned char *coding, int coding_len,
+	   const unsigned char *expanded, int expanded_len)
+{
+  ASN1_TYPE element;
+  unsigned int flags;
+  int start, len;
+
+  asn1_set_recycling (FUZZ_RECYCLING);
+
+  for (flags = 0;
+       flags <= (ASN1_DECODE_KEEP_OFFSETS | ASN1_DECODE_KEEP_DER); flags++)
+    {
+      element = ASN1_TYPE_EMPTY;
+      if (asn1_create_element (fuzz_definitions, fuzz_types[k].type,
+			       &element) != ASN1_SUCCESS)
+	continue;
+
+      if (asn1_der_decoding2 (&element, data, size, flags, NULL) != result)
+	fuzz_fail (k, "asn1_der_decoding2");
+      if (result == ASN1_SUCCESS)
+	{
+	  asn1_read_der_offsets (element, fuzz_types[k].name, &start, &len);
+
+	  /* the second time from what the first one kept */
+	  fuzz_compare (k, element, coding, coding_len, "encoding");
+	  fuzz_compare (k, element, coding, coding_len, "encoding");
+
+	  asn1_expand_any_defined_by (fuzz_definitions, &element);
+	  fuzz_compare (k, element, expanded, expanded_len,
+			"encoding once expanded");
+	}
+
+      asn1_delete_structure (&element);
+    }
+
+  asn1_set_recycling (0);
+}
+
+/* Decodes DATA, of SIZE bytes, as the type K with the limits of
+   fuzz_options, and with the decoder of the type.  RESULT and CODING
+   are as for fuzz_kept; a limit can only make the decoding fail.  */
+static void
+fuzz_limited (size_t k, const unsigned char *data, int size,
+	      asn1_retCode result, const unsigned char *coding,
+	      int coding_len)
+{
+  ASN1_TYPE element = ASN1_TYPE_EMPTY, decoded;
+  asn1_retCode limited;
+
+  if (asn1_create_element (fuzz_definitions, fuzz_types[k].type,
+			   &element) != ASN1_SUCCESS)
+    return;
+
+  limited = asn1_der_decoding_options (&element, data, size, &fuzz_options,
+				       NULL);
+  if (limited == ASN1_SUCCESS && result != ASN1_SUCCESS)
+    fuzz_fail (k, "asn1_der_decoding_options");
+  if (limited == ASN1_SUCCESS)
+    fuzz_compare (k, element, coding, coding_len, "encoding with limits");
+  asn1_delete_structure (&element);
+
+  if (asn1_decoder_decode (fuzz_decoders[k], data, size, &decoded, NULL)
+      != limited)
+    fuzz_fail (k, "asn1_decoder_decode");
+  if (limited == ASN1_SUCCESS)
+    {
+      fuzz_compare (k, decoded, coding, coding_len, "decoder encoding");
+      fuzz_compare (k, decoded, coding, coding_len, "decoder encoding");
+    }
+}
+
+/* Decodes DATA as each type of fuzz_types, and uses what was
+   decoded.  Returns the number of types decoded.  */
+int
+fuzz_der (const unsigned char *data, size_t size)
+{
+  ASN1_TYPE element;
+  unsigned char *coding, *expanded;
+  int der_len, coding_len, expanded_len, start, end, len, decoded = 0;
+  asn1_retCode result;
+  size_t k;
+
+  fuzz_init ();
+
+  if (size > 1024 * 1024)
+    return 0;
+  der_len = size;
+
+  asn1_get_length_ber (data, der_len, &len);
+  asn1_get_length_der (data, der_len, &len);
+
+  for (k = 0; k < FUZZ_TYPES; k++)
+    {
+      element = ASN1_TYPE_EMPTY;
+      if (asn1_create_element (fuzz_definitions, fuzz_types[k].type,
+			       &element) != ASN1_SUCCESS)
+	continue;
+
+      coding = expanded = NULL;
+      coding_len = expanded_len = 0;
+      result = asn1_der_decoding (&element, data, der_len, NULL);
+      if (result == ASN1_SUCCESS)
+	{
+	  decoded++;
+	  asn1_der_decoding_startEnd (element, data, der_len,
+				      fuzz_types[k].name, &start, &end);
+
+	  /* The value decoded is encoded again, and so is a copy of
+	     it expanded, which was not encoded before */
+	  coding = fuzz_encode (element, &coding_len);
+	  asn1_delete_structure (&element);
+	  if (asn1_create_element (fuzz_definitions, fuzz_types[k].type,
+				   &element) == ASN1_SUCCESS
+	      && asn1_der_decoding (&element, data, der_len,
+				    NULL) == ASN1_SUCCESS)
+	    {
+	      asn1_expand_any_defined_by (fuzz_definitions, &element);
+	      expanded = fuzz_encode (element, &expanded_len);
+	    }
+	}
+      asn1_delete_structure (&element);
+
+      fuzz_kept (k, data, der_len, result, coding, coding_len, expanded,
+		 expanded_len);
+      fuzz_limited (k, data, der_len, result, coding, coding_len);
+
+      free (coding);
+      free (expanded);
+    }
+
+  return decoded;
+}
+
+/* Parses DATA as definitions, from a file since the parser reads
+   one.  Returns the result of asn1_parser2tree.  */
+asn1_retCode
+fuzz_parser (const unsigned char *data, size_t size)
+{
+  char errorDescription[ASN1_MAX_ERROR_DESCRIPTION_SIZE];
+  ASN1_TYPE definitions = ASN1_TYPE_EMPTY;
+  char file_name[64];
+  asn1_retCode result;
+  FILE *fd;
+
+  sprintf (file_name, "fuzz_parser-%ld.asn", (long) getpid ());
+  fd = fopen (file_name, "wb");
+  if (fd == NULL)
+    return ASN1_FILE_NOT_FOUND;
+  if (fwrite (data, 1, size, fd) != size)
+    size = 0;
+  if (fclose (fd) != 0 || size == 0)
+    {
+      remove (file_name);
+      return ASN1_FILE_NOT_FOUND;
+    }
+
+  result = asn1_parser2tree (file_name, &definitions, errorDescription);
+  remove (file_name);
+  asn1_delete_structure (&definitions);
+
+  return result;
+}
+
+#ifdef FUZZ_TARGET
+
+#ifdef FUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput (const unsigned char *data, size_t size);
+
+int
+LLVMFuzzerTestOneInput (const unsigned char *data, size_t size)
+{
+  FUZZ_TARGET (data, size);
+  return 0;
+}
+
+#else
+
+int
+main (int argc, char *argv[])
+{
+  static unsigned char data[1024 * 1024];
+  size_t size;
+  FILE *fd;
+  int k;
+
+  /* Read from the standard input without arguments, as AFL runs it
+     when "@@" is not given */
+  for (k = argc > 1 ? 1 : 0; k < argc; k++)
+    {
+      fd = k ? fopen (argv[k], "rb") : stdin;
+      if (fd == NULL)
+	{
+	  printf ("Cannot read file %s\n", argv[k]);
+	  exit (1);
+	}
+      size = fread (data, 1, sizeof (data), fd);
+      if (k)
+	fclose (fd);
+
+      FUZZ_TARGET (data, size);
+    }
+
+  fuzz_deinit ();
+
+  exit (0);
+}
+
+#endif
+
+#endif